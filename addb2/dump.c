@@ -1099,6 +1099,7 @@ struct m0_addb2__id_intrp ids[] = {
 	{ M0_AVI_LOCALITY_CHAN_WAIT, "loc-wait-hist",  { HIST } },
 	{ M0_AVI_LOCALITY_CHAN_CB,   "loc-cb-hist",    { HIST } },
 	{ M0_AVI_LOCALITY_CHAN_QUEUE,"loc-queue-hist", { HIST } },
+	{ M0_AVI_LOCALITY_STEAL,     "loc-steal-hist", { HIST } },
 	{ M0_AVI_IOS_IO_DESCR,    "ios-io-descr",    { FID, FID,
 						       &hex, &hex, &dec, &dec,
 						       &dec, &dec, &dec },
@@ -1128,6 +1129,8 @@ struct m0_addb2__id_intrp ids[] = {
 	{ M0_AVI_STOB_IOQ_INFLIGHT, "stob-ioq-inflight", { HIST } },
 	{ M0_AVI_STOB_IOQ_QUEUED, "stob-ioq-queued", { HIST } },
 	{ M0_AVI_STOB_IOQ_GOT,    "stob-ioq-got",    { HIST } },
+	{ M0_AVI_STOB_CACHE_HIT,  "stob-cache-hit",  { COUNTER } },
+	{ M0_AVI_STOB_CACHE_MISS, "stob-cache-miss", { COUNTER } },
 
 	{ M0_AVI_RPC_LOCK,        "rpc-machine-lock", { &ptr } },
 	{ M0_AVI_RPC_REPLIED,     "rpc-replied",      { &ptr, &rpcop } },
@@ -1152,6 +1155,10 @@ struct m0_addb2__id_intrp ids[] = {
 	  .ii_spec   = &beop_state_counter },
 	{ M0_AVI_BE_TX_TO_GROUP,  "tx-to-gr", { &dec, &dec, &dec },
 	  { "tx_id", "gr_id", "inout" } },
+	{ M0_AVI_BE_ALLOC_ZONE_WAIT,  "be-alloc-zone-wait",  { COUNTER } },
+	{ M0_AVI_BE_ALLOC_ARENA_WAIT, "be-alloc-arena-wait", { COUNTER } },
+	{ M0_AVI_BE_RECOVERY_PROGRESS, "be-recovery-progress",
+	  { &dec, &dec, &dec }, { "done", "total", "bytes/sec" } },
 	{ M0_AVI_NET_BUF,         "net-buf",         { &ptr, &dec, &_clock,
 						       &duration, &dec, &dec },
 	  { "buf", "qtype", "time", "duration", "status", "len" } },
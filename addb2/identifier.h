@@ -99,6 +99,8 @@ enum m0_addb2_value_id {
 	M0_AVI_LONG_LOCK,
 	/** Measurement: generic attribute. */
 	M0_AVI_ATTR,
+	/** Measurement: run-queue length of a locality a fom is stolen from. */
+	M0_AVI_LOCALITY_STEAL,
 
 	M0_AVI_LIB_RANGE_START     = 0x3000,
 	/** Measurement: memory allocation. */
@@ -278,6 +278,8 @@ M0_INTERNAL int m0_addb2_net_module_init(void)
 			 .fom_ops   = &m0_addb2__fom_type_ops,
 			 .sm        = &m0_addb2__sm_conf,
 			 .svc_type  = &m0_addb2_service_type);
+	/* addb2 foms are spread over localities round-robin. */
+	net_fopt.ft_fom_type.ft_numa_steered = true;
 	return 0;
 }
 
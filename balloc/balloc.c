@@ -37,6 +37,7 @@
 #include "lib/arith.h"	  /* min_check, m0_is_po2 */
 #include "lib/memory.h"
 #include "lib/locality.h" /* m0_locality0_get */
+#include "lib/byteorder.h" /* m0_byteorder_be64_to_cpu */
 #include "balloc.h"
 #include "motr/magic.h"
 
@@ -87,6 +88,18 @@ static inline int btree_insert_sync(struct m0_be_btree  *tree,
 	                         bo_u.u_btree.t_rc);
 }
 
+static inline int btree_insert_batch_sync(struct m0_be_btree  *tree,
+					  struct m0_be_tx     *tx,
+					  const struct m0_buf *keys,
+					  const struct m0_buf *vals,
+					  m0_bcount_t          nr)
+{
+	return M0_BE_OP_SYNC_RET(op,
+				 m0_be_btree_insert_batch(tree, tx, &op,
+							  keys, vals, nr),
+				 bo_u.u_btree.t_rc);
+}
+
 static inline int btree_update_sync(struct m0_be_btree  *tree,
 			       struct m0_be_tx     *tx,
 			       const struct m0_buf *key,
@@ -336,6 +349,188 @@ M0_INTERNAL void m0_balloc_unlock_group(struct m0_balloc_group_info *grp)
 	m0_mutex_unlock(bgi_mutex(grp));
 }
 
+/*
+ * Free-space index.
+ *
+ * A max-tree over groups, keyed by the largest free chunk of a group
+ * (m0_balloc_group_info::bgi_fsi_key). With w being the smallest power of 2
+ * not less than the number of groups, leaf w + n stands for group n and
+ * leaves past the last group are 0. Internal node k (0 < k < w) is the
+ * maximum of its children 2k and 2k + 1 and is stored in group k / 2, so the
+ * index needs no memory besides the group info array.
+ *
+ * The index is a filter: it lets the allocator skip groups that cannot
+ * satisfy a request without touching them. Any group it suggests is checked
+ * again under the group lock.
+ */
+
+static m0_bcount_t group_fsi_key(struct m0_balloc_group_info *grp)
+{
+	return max_check(group_maxchunk_get(grp),
+			 group_spare_maxchunk_get(grp));
+}
+
+static m0_bcount_t balloc_fsi_width(const struct m0_balloc *bal)
+{
+	m0_bcount_t width = 1;
+
+	while (width < bal->cb_sb.bsb_groupcount)
+		width <<= 1;
+	return width;
+}
+
+static m0_bcount_t *balloc_fsi_node(struct m0_balloc *bal, m0_bcount_t k)
+{
+	return &bal->cb_group_info[k / 2].bgi_fsi[k % 2];
+}
+
+static m0_bcount_t balloc_fsi_get(struct m0_balloc *bal, m0_bcount_t width,
+				  m0_bcount_t k)
+{
+	if (k < width)
+		return *balloc_fsi_node(bal, k);
+	k -= width;
+	return k < bal->cb_sb.bsb_groupcount ?
+		bal->cb_group_info[k].bgi_fsi_key : 0;
+}
+
+static m0_bcount_t balloc_fsi_children(struct m0_balloc *bal,
+				       m0_bcount_t width, m0_bcount_t k)
+{
+	return max_check(balloc_fsi_get(bal, width, 2 * k),
+			 balloc_fsi_get(bal, width, 2 * k + 1));
+}
+
+static void balloc_fsi_build(struct m0_balloc *bal)
+{
+	m0_bcount_t width = balloc_fsi_width(bal);
+	m0_bcount_t i;
+
+	for (i = 0; i < bal->cb_sb.bsb_groupcount; ++i)
+		bal->cb_group_info[i].bgi_fsi_key =
+			group_fsi_key(&bal->cb_group_info[i]);
+	for (i = width - 1; i > 0; --i)
+		*balloc_fsi_node(bal, i) = balloc_fsi_children(bal, width, i);
+}
+
+/** Publishes the current largest free chunk of the group in the index. */
+static void balloc_fsi_update(struct m0_balloc *bal,
+			      struct m0_balloc_group_info *grp)
+{
+	m0_bcount_t  width = balloc_fsi_width(bal);
+	m0_bcount_t  k;
+	m0_bcount_t *node;
+	m0_bcount_t  key;
+
+	M0_PRE(m0_mutex_is_locked(&bal->cb_sb_mutex.bm_u.mutex));
+
+	grp->bgi_fsi_key = group_fsi_key(grp);
+	for (k = (width + grp->bgi_groupno) / 2; k > 0; k /= 2) {
+		node = balloc_fsi_node(bal, k);
+		key  = balloc_fsi_children(bal, width, k);
+		if (*node == key)
+			break;
+		*node = key;
+	}
+}
+
+/**
+ * Returns the first group not less than "start" whose largest free chunk is
+ * at least "len" blocks, or the number of groups if there is no such group.
+ */
+static m0_bcount_t balloc_fsi_find(struct m0_balloc *bal, m0_bcount_t start,
+				   m0_bcount_t len)
+{
+	m0_bcount_t ngroups = bal->cb_sb.bsb_groupcount;
+	m0_bcount_t width   = balloc_fsi_width(bal);
+	m0_bcount_t k       = width + start;
+
+	M0_PRE(m0_mutex_is_locked(&bal->cb_sb_mutex.bm_u.mutex));
+	M0_PRE(len > 0);
+
+	if (start >= ngroups)
+		return ngroups;
+	/* Climb to the leftmost subtree to the right of start that fits. */
+	while (balloc_fsi_get(bal, width, k) < len) {
+		while (k & 1)
+			k >>= 1;
+		if (k == 0)
+			return ngroups;
+		++k;
+	}
+	/* Descend to its leftmost fitting leaf. */
+	while (k < width)
+		k = balloc_fsi_get(bal, width, 2 * k) >= len ? 2 * k : 2 * k + 1;
+	return k - width;
+}
+
+enum {
+	/**
+	 * Number of candidate groups balloc_regular_allocator() takes from
+	 * the index at once.
+	 */
+	BALLOC_FSI_BATCH = 16,
+};
+
+/**
+ * Fills "out" with up to "nr" groups whose largest free chunk is at least
+ * "len" blocks, taking the superblock lock once.
+ *
+ * Groups are visited cyclically starting from "start". "*pos" is the number
+ * of groups after "start" visited by the previous calls, it is advanced past
+ * the last returned group and reaches the number of groups when the whole
+ * cycle is visited. Returns the number of groups placed into "out".
+ */
+static int balloc_fsi_collect(struct m0_balloc *bal, m0_bcount_t start,
+			      m0_bcount_t *pos, m0_bcount_t len,
+			      m0_bcount_t *out, int nr)
+{
+	m0_bcount_t ngroups = bal->cb_sb.bsb_groupcount;
+	m0_bcount_t group;
+	int         got = 0;
+
+	M0_PRE(start < ngroups);
+
+	m0_mutex_lock(&bal->cb_sb_mutex.bm_u.mutex);
+	while (got < nr && *pos < ngroups) {
+		group = balloc_fsi_find(bal, (start + *pos) % ngroups, len);
+		if (start + *pos < ngroups) {
+			/* Not wrapped yet: continue from group 0 if no fit. */
+			if (group == ngroups) {
+				*pos = ngroups - start;
+				continue;
+			}
+			*pos = group - start;
+		} else {
+			/* Wrapped: groups from "start" on are visited. */
+			if (group >= start) {
+				*pos = ngroups;
+				break;
+			}
+			*pos = group + ngroups - start;
+		}
+		out[got++] = group;
+		++*pos;
+	}
+	m0_mutex_unlock(&bal->cb_sb_mutex.bm_u.mutex);
+	return got;
+}
+
+M0_INTERNAL bool m0_balloc_fsi_invariant(struct m0_balloc *cb)
+{
+	m0_bcount_t width = balloc_fsi_width(cb);
+	bool        result;
+
+	m0_mutex_lock(&cb->cb_sb_mutex.bm_u.mutex);
+	result = m0_forall(i, cb->cb_sb.bsb_groupcount,
+			   cb->cb_group_info[i].bgi_fsi_key ==
+			   group_fsi_key(&cb->cb_group_info[i])) &&
+		 m0_forall(k, width, k == 0 || *balloc_fsi_node(cb, k) ==
+			   balloc_fsi_children(cb, width, k));
+	m0_mutex_unlock(&cb->cb_sb_mutex.bm_u.mutex);
+	return result;
+}
+
 #define MAX_ALLOCATION_CHUNK 2048ULL
 
 M0_INTERNAL void m0_balloc_group_desc_init(struct m0_balloc_group_desc *desc)
@@ -425,6 +620,8 @@ static int balloc_group_info_load(struct m0_balloc *bal)
 	while (rc != 0 && i > 0) {
 		balloc_group_info_fini(&bal->cb_group_info[--i]);
 	}
+	if (rc == 0)
+		balloc_fsi_build(bal);
 	return M0_RC(rc);
 }
 
@@ -468,11 +665,18 @@ static int ge_tree_cmp(const void *k0, const void *k1)
 	return M0_3WAY(*bn0, *bn1);
 }
 
+static uint64_t ge_tree_key_prefix(const void *k)
+{
+	return *(const m0_bindex_t *)k;
+}
+
 static const struct m0_be_btree_kv_ops ge_btree_ops = {
-	.ko_type    = M0_BBT_BALLOC_GROUP_EXTENTS,
-	.ko_ksize   = ge_tree_kv_size,
-	.ko_vsize   = ge_tree_kv_size,
-	.ko_compare = ge_tree_cmp
+	.ko_type              = M0_BBT_BALLOC_GROUP_EXTENTS,
+	.ko_ksize             = ge_tree_kv_size,
+	.ko_vsize             = ge_tree_kv_size,
+	.ko_compare           = ge_tree_cmp,
+	.ko_key_prefix        = ge_tree_key_prefix,
+	.ko_key_prefix_is_key = true
 };
 
 static m0_bcount_t gd_tree_key_size(const void *k)
@@ -490,11 +694,24 @@ static int gd_tree_cmp(const void *k0, const void *k1)
 	return memcmp(k0, k1, gd_tree_key_size(NULL));
 }
 
+/**
+ * Keys are compared by memcmp(), so the prefix reads the bytes of a key most
+ * significant first.
+ */
+static uint64_t gd_tree_key_prefix(const void *k)
+{
+	M0_CASSERT(sizeof ((struct m0_balloc_group_desc*)0)->bgd_groupno ==
+		   sizeof(uint64_t));
+	return m0_byteorder_be64_to_cpu(*(const uint64_t *)k);
+}
+
 static const struct m0_be_btree_kv_ops gd_btree_ops = {
-	.ko_type    = M0_BBT_BALLOC_GROUP_DESC,
-	.ko_ksize   = gd_tree_key_size,
-	.ko_vsize   = gd_tree_val_size,
-	.ko_compare = gd_tree_cmp
+	.ko_type              = M0_BBT_BALLOC_GROUP_DESC,
+	.ko_ksize             = gd_tree_key_size,
+	.ko_vsize             = gd_tree_val_size,
+	.ko_compare           = gd_tree_cmp,
+	.ko_key_prefix        = gd_tree_key_prefix,
+	.ko_key_prefix_is_key = true
 };
 
 static void balloc_sb_sync(struct m0_balloc *cb, struct m0_be_tx *tx)
@@ -621,9 +838,20 @@ static int balloc_sb_write(struct m0_balloc            *bal,
 	return M0_RC(rc);
 }
 
+enum {
+	/** Number of groups written in one transaction during format. */
+	BALLOC_FORMAT_GROUPS_PER_TX = 8,
+};
+M0_BASSERT((BALLOC_FORMAT_GROUPS_PER_TX &
+	    (BALLOC_FORMAT_GROUPS_PER_TX - 1)) == 0 &&
+	   BALLOC_FORMAT_GROUPS_PER_TX <= 0x100);
+
 struct balloc_group_write_cfg {
 	struct m0_balloc *bgc_bal;
+	/** The first group to write. */
 	m0_bcount_t       bgc_i;
+	/** Number of groups to write. */
+	m0_bcount_t       bgc_nr;
 };
 
 struct balloc_groups_write_cfg {
@@ -638,12 +866,13 @@ static void
 balloc_group_write_credit(struct m0_balloc               *bal,
                           struct m0_be_tx_bulk           *tb,
                           struct balloc_groups_write_cfg *bgs,
+                          m0_bcount_t                     nr,
                           struct m0_be_tx_credit         *credit)
 {
-	m0_be_btree_insert_credit(&bal->cb_db_group_extents, 2,
+	m0_be_btree_insert_batch_credit(&bal->cb_db_group_extents, 2 * nr,
 		M0_MEMBER_SIZE(struct m0_ext, e_start),
 		M0_MEMBER_SIZE(struct m0_ext, e_end), credit);
-	m0_be_btree_insert_credit(&bal->cb_db_group_desc, 2,
+	m0_be_btree_insert_batch_credit(&bal->cb_db_group_desc, nr,
 		M0_MEMBER_SIZE(struct m0_balloc_group_desc, bgd_groupno),
 		sizeof(struct m0_balloc_group_desc), credit);
 }
@@ -658,19 +887,21 @@ static void balloc_group_work_put(struct m0_balloc               *bal,
 	bool                           put_successful;
 	int                            rc;
 
-	for (i = 0; i < bgs->bgs_max; ++i) {
+	for (i = 0; i < bgs->bgs_max; i += BALLOC_FORMAT_GROUPS_PER_TX) {
 		m0_mutex_lock(&bgs->bgs_lock);
 		rc = bgs->bgs_rc;
 		m0_mutex_unlock(&bgs->bgs_lock);
 		if (rc != 0)
 			break;
-		bgc  = &bgs->bgs_bgc[i];
+		bgc  = &bgs->bgs_bgc[i / BALLOC_FORMAT_GROUPS_PER_TX];
 		*bgc = (struct balloc_group_write_cfg){
 			.bgc_bal = bgs->bgs_bal,
 			.bgc_i   = i,
+			.bgc_nr  = min64u(bgs->bgs_max - i,
+					  BALLOC_FORMAT_GROUPS_PER_TX),
 		};
 		credit = M0_BE_TX_CREDIT(0, 0);
-		balloc_group_write_credit(bal, tb, bgs, &credit);
+		balloc_group_write_credit(bal, tb, bgs, bgc->bgc_nr, &credit);
 		M0_BE_OP_SYNC(op, put_successful =
 			      m0_be_tx_bulk_put(tb, &op, &credit, 0, 0, bgc));
 		if (!put_successful)
@@ -679,6 +910,16 @@ static void balloc_group_work_put(struct m0_balloc               *bal,
 	m0_be_tx_bulk_end(tb);
 }
 
+/**
+ * Writes extents and descriptors of groups [bgc_i, bgc_i + bgc_nr).
+ *
+ * Keys of both trees grow with the group number, so the records are inserted
+ * with m0_be_btree_insert_batch(), which fills a leaf without descending from
+ * the root for every record. The descriptor tree compares group numbers with
+ * memcmp(), but the group numbers of a batch start at a multiple of
+ * BALLOC_FORMAT_GROUPS_PER_TX and differ in the lowest byte only, so they are
+ * ascending in this order too.
+ */
 static void balloc_group_write_do(struct m0_be_tx_bulk *tb,
                                   struct m0_be_tx      *tx,
                                   struct m0_be_op      *op,
@@ -690,69 +931,79 @@ static void balloc_group_write_do(struct m0_be_tx_bulk *tb,
 	struct balloc_groups_write_cfg *bgs = datum;
 	struct balloc_group_write_cfg  *bgc = user;
 	struct m0_balloc               *bal = bgc->bgc_bal;
-	struct m0_balloc_group_desc     gd;
+	struct m0_balloc_group_desc     gd[BALLOC_FORMAT_GROUPS_PER_TX];
 	struct m0_balloc_super_block   *sb = &bal->cb_sb;
-	struct m0_ext                   ext;
-	struct m0_buf                   key;
-	struct m0_buf                   val;
-	m0_bcount_t                     i = bgc->bgc_i;
+	struct m0_ext                   ext[2 * BALLOC_FORMAT_GROUPS_PER_TX];
+	struct m0_buf                   ext_key[ARRAY_SIZE(ext)];
+	struct m0_buf                   ext_val[ARRAY_SIZE(ext)];
+	struct m0_buf                   gd_key[ARRAY_SIZE(gd)];
+	struct m0_buf                   gd_val[ARRAY_SIZE(gd)];
+	m0_bcount_t                     i;
+	m0_bcount_t                     j;
+	m0_bcount_t                     ext_nr = 0;
 	m0_bcount_t                     spare_size;
 	int                             rc;
 
+	M0_PRE(bgc->bgc_nr <= ARRAY_SIZE(gd));
+	M0_PRE(bgc->bgc_i % BALLOC_FORMAT_GROUPS_PER_TX == 0);
+
 	m0_be_op_active(op);
 
-	M0_LOG(M0_DEBUG, "creating group_extents for group %llu",
-	       (unsigned long long)i);
 	spare_size = m0_stob_ad_spares_calc(sb->bsb_groupsize);
-	/* Insert non-spare extents. */
-	ext.e_start = i << sb->bsb_gsbits;
-	ext.e_end = ext.e_start + sb->bsb_groupsize - spare_size;
-	m0_ext_init(&ext);
-	balloc_debug_dump_extent("create...", &ext);
-
-	key = (struct m0_buf)M0_BUF_INIT_PTR(&ext.e_end);
-	val = (struct m0_buf)M0_BUF_INIT_PTR(&ext.e_start);
-	rc = btree_insert_sync(&bal->cb_db_group_extents, tx, &key, &val);
-	if (rc != 0) {
-		M0_LOG(M0_ERROR, "insert extent failed: group=%llu "
-				 "rc=%d", (unsigned long long)i, rc);
-		goto out;
-	}
+	for (j = 0; j < bgc->bgc_nr; ++j) {
+		i = bgc->bgc_i + j;
+		M0_LOG(M0_DEBUG, "creating group_extents for group %llu",
+		       (unsigned long long)i);
+		/* Insert non-spare extents. */
+		ext[ext_nr].e_start = i << sb->bsb_gsbits;
+		ext[ext_nr].e_end = ext[ext_nr].e_start + sb->bsb_groupsize -
+			spare_size;
+		m0_ext_init(&ext[ext_nr]);
+		balloc_debug_dump_extent("create...", &ext[ext_nr]);
+		++ext_nr;
 #ifdef __SPARE_SPACE__
-	/* Insert extents reserved for spare. */
-	ext.e_start = (i << sb->bsb_gsbits) + sb->bsb_groupsize -
-		spare_size;
-	ext.e_end = ext.e_start + spare_size;
-	key = (struct m0_buf)M0_BUF_INIT_PTR(&ext.e_end);
-	val = (struct m0_buf)M0_BUF_INIT_PTR(&ext.e_start);
-	rc = btree_insert_sync(&bal->cb_db_group_extents, tx, &key, &val);
-	if (rc != 0) {
-		M0_LOG(M0_ERROR, "insert extent failed for spares: group=%llu "
-				 "rc=%d", (unsigned long long)i, rc);
-		goto out;
-	}
+		/* Insert extents reserved for spare. */
+		ext[ext_nr].e_start = (i << sb->bsb_gsbits) +
+			sb->bsb_groupsize - spare_size;
+		ext[ext_nr].e_end = ext[ext_nr].e_start + spare_size;
+		++ext_nr;
 #endif
-	M0_LOG(M0_DEBUG, "creating group_desc for group %llu",
-	       (unsigned long long)i);
-	gd.bgd_groupno = i;
+		M0_LOG(M0_DEBUG, "creating group_desc for group %llu",
+		       (unsigned long long)i);
+		gd[j].bgd_groupno = i;
 #ifdef __SPARE_SPACE__
-	gd.bgd_spare_freeblocks = sb->bsb_sparesize;
-	gd.bgd_sparestart = (i << sb->bsb_gsbits) + sb->bsb_groupsize -
-				sb->bsb_sparesize;
-	gd.bgd_spare_frags = 1;
-	gd.bgd_spare_maxchunk = sb->bsb_sparesize;
+		gd[j].bgd_spare_freeblocks = sb->bsb_sparesize;
+		gd[j].bgd_sparestart = (i << sb->bsb_gsbits) +
+			sb->bsb_groupsize - sb->bsb_sparesize;
+		gd[j].bgd_spare_frags = 1;
+		gd[j].bgd_spare_maxchunk = sb->bsb_sparesize;
 #endif
-	gd.bgd_freeblocks = sb->bsb_groupsize - spare_size;
-	gd.bgd_maxchunk   = sb->bsb_groupsize - spare_size;
-	gd.bgd_fragments  = 1;
-	m0_balloc_group_desc_init(&gd);
-	key = (struct m0_buf)M0_BUF_INIT_PTR(&gd.bgd_groupno);
-	val = (struct m0_buf)M0_BUF_INIT_PTR(&gd);
+		gd[j].bgd_freeblocks = sb->bsb_groupsize - spare_size;
+		gd[j].bgd_maxchunk   = sb->bsb_groupsize - spare_size;
+		gd[j].bgd_fragments  = 1;
+		m0_balloc_group_desc_init(&gd[j]);
+		gd_key[j] = (struct m0_buf)M0_BUF_INIT_PTR(&gd[j].bgd_groupno);
+		gd_val[j] = (struct m0_buf)M0_BUF_INIT_PTR(&gd[j]);
+	}
+	for (j = 0; j < ext_nr; ++j) {
+		ext_key[j] = (struct m0_buf)M0_BUF_INIT_PTR(&ext[j].e_end);
+		ext_val[j] = (struct m0_buf)M0_BUF_INIT_PTR(&ext[j].e_start);
+	}
 
-	rc = btree_insert_sync(&bal->cb_db_group_desc, tx, &key, &val);
+	rc = btree_insert_batch_sync(&bal->cb_db_group_extents, tx,
+				     ext_key, ext_val, ext_nr);
 	if (rc != 0) {
-		M0_LOG(M0_ERROR, "insert gd failed: group=%llu rc=%d",
-			(unsigned long long)i, rc);
+		M0_LOG(M0_ERROR, "insert extents failed: groups=[%llu, %llu) "
+				 "rc=%d", (unsigned long long)bgc->bgc_i,
+		       (unsigned long long)(bgc->bgc_i + bgc->bgc_nr), rc);
+		goto out;
+	}
+	rc = btree_insert_batch_sync(&bal->cb_db_group_desc, tx,
+				     gd_key, gd_val, bgc->bgc_nr);
+	if (rc != 0) {
+		M0_LOG(M0_ERROR, "insert gd failed: groups=[%llu, %llu) rc=%d",
+		       (unsigned long long)bgc->bgc_i,
+		       (unsigned long long)(bgc->bgc_i + bgc->bgc_nr), rc);
 	}
 out:
 	if (rc != 0) {
@@ -1360,6 +1611,9 @@ M0_INTERNAL int m0_balloc_load_extents(struct m0_balloc *cb,
 	else {
 		grp->bgi_normal.bzp_fragments = normal_frags;
 		grp->bgi_spare.bzp_fragments = spare_frags;
+		m0_mutex_lock(&cb->cb_sb_mutex.bm_u.mutex);
+		balloc_fsi_update(cb, grp);
+		m0_mutex_unlock(&cb->cb_sb_mutex.bm_u.mutex);
 	}
 
 	return M0_RC(rc);
@@ -1677,6 +1931,7 @@ static int balloc_alloc_db_update(struct m0_balloc *motr, struct m0_be_tx *tx,
 	else
 #endif
 		motr->cb_sb.bsb_freeblocks -= m0_ext_length(tgt);
+	balloc_fsi_update(motr, grp);
 	motr->cb_sb.bsb_state |= M0_BALLOC_SB_DIRTY;
 	balloc_sb_sync(motr, tx);
 	m0_mutex_unlock(&motr->cb_sb_mutex.bm_u.mutex);
@@ -1927,6 +2182,7 @@ static int balloc_free_db_update(struct m0_balloc *motr,
 #endif
 	else
 		motr->cb_sb.bsb_freeblocks += m0_ext_length(tgt);
+	balloc_fsi_update(motr, grp);
 	motr->cb_sb.bsb_state |= M0_BALLOC_SB_DIRTY;
 	balloc_sb_sync(motr, tx);
 	m0_mutex_unlock(&motr->cb_sb_mutex.bm_u.mutex);
@@ -1936,72 +2192,66 @@ static int balloc_free_db_update(struct m0_balloc *motr,
 	return M0_RC(rc);
 }
 
-#if 0
-static int balloc_find_by_goal(struct m0_balloc_allocation_context *bac)
-{
-	m0_bindex_t group = balloc_bn2gn(bac->bac_goal.e_start,
-					 bac->bac_ctxt);
-	struct m0_balloc_group_info *grp = m0_balloc_gn2info(bac->bac_ctxt,
-							     group);
-	struct m0_be_tx *tx  = bac->bac_tx;
-	struct m0_ext	 ex  = { 0 };
-	int		 found;
-	int		 ret = 0;
-	M0_ENTRY();
+/**
+ * Tries to allocate at the goal itself, so that an object written sequentially
+ * gets its extents back-to-back on the device.
+ *
+ * Succeeds only if the free extent containing the goal is long enough for the
+ * whole request; otherwise the regular allocator takes over.
+ */
+static int balloc_find_by_goal(struct balloc_allocation_context *bac)
+{
+	struct m0_balloc               *bal   = bac->bac_ctxt;
+	m0_bindex_t                     start = bac->bac_goal.e_start;
+	m0_bcount_t                     len   = m0_ext_length(&bac->bac_goal);
+	m0_bcount_t                     group = balloc_bn2gn(start, bal);
+	enum m0_balloc_allocation_flag  zone;
+	struct m0_balloc_group_info    *grp;
+	struct m0_balloc_zone_param    *zp;
+	struct m0_lext                 *le;
+	struct m0_ext                  *cur = NULL;
+	int                             rc  = 0;
+
+	M0_ENTRY("goal="EXT_F, EXT_P(&bac->bac_goal));
+
+	if (!(bac->bac_flags & M0_BALLOC_HINT_TRY_GOAL) ||
+	    group >= bal->cb_sb.bsb_groupcount)
+		return M0_RC(0);
 
-	if (!(bac->bac_flags & M0_BALLOC_HINT_TRY_GOAL))
+	grp = m0_balloc_gn2info(bal, group);
+	m0_balloc_lock_group(grp);
+	zone = m0_ext_is_in(&grp->bgi_normal.bzp_range, start) ?
+		M0_BALLOC_NORMAL_ZONE : M0_BALLOC_SPARE_ZONE;
+	zp = is_spare(zone) ? &grp->bgi_spare : &grp->bgi_normal;
+	if (!(bac->bac_flags & zone) || zp->bzp_maxchunk < len)
 		goto out;
 
-	M0_LOG(M0_DEBUG, "groupno=%llu start=%llu len=%llu groupsize=%llu",
-		(unsigned long long)group,
-		(unsigned long long)bac->bac_goal.e_start,
-		(unsigned long long)m0_ext_length(&bac->bac_goal),
-		(unsigned long long)bac->bac_ctxt->cb_sb.bsb_groupsize
-	);
-
-	m0_balloc_lock_group(grp);
-	if (grp->bgi_maxchunk < m0_ext_length(&bac->bac_goal)) {
-		M0_LEAVE();
-		goto out_unlock;
-	}
-	if (grp->bgi_freeblocks < m0_ext_length(&bac->bac_goal)) {
-		M0_LEAVE();
-		goto out_unlock;
-	}
+	rc = m0_balloc_load_extents(bal, grp);
+	if (rc != 0)
+		goto out;
 
-	ret = m0_balloc_load_extents(bac->bac_ctxt, grp);
-	if (ret) {
-		M0_LEAVE();
-		goto out_unlock;
+	m0_list_for_each_entry(&zp->bzp_extents, le, struct m0_lext, le_link) {
+		if (m0_ext_is_in(&le->le_ext, start)) {
+			cur = &le->le_ext;
+			break;
+		}
+		if (le->le_ext.e_start > start)
+			break;
 	}
-
-	found = balloc_find_extent_exact(bac, grp, &bac->bac_goal, &ex);
-	M0_LOG(M0_DEBUG, "found?max len = %llu",
-	       (unsigned long long)m0_ext_length(&ex));
-
-	if (found) {
+	if (cur != NULL && cur->e_end - start >= len) {
 		bac->bac_found++;
-		bac->bac_best.e_start = bac->bac_goal.e_start;
-		bac->bac_best.e_end   = ex.e_end;
-		ret = balloc_use_best_found(bac);
-	}
-
-	/* update db according to the allocation result */
-	if (ret == 0 && bac->bac_status == M0_BALLOC_AC_FOUND) {
-		if (bac->bac_goal.e_end < bac->bac_best.e_end)
-			balloc_new_preallocation(bac);
-
-		ret = balloc_alloc_db_update(bac->bac_ctxt, tx, grp,
-					  &bac->bac_final);
+		bac->bac_best.e_start = start;
+		bac->bac_best.e_end   = cur->e_end;
+		balloc_use_best_found(bac, start);
+		balloc_new_preallocation(bac);
+		balloc_debug_dump_extent(__func__, &bac->bac_final);
+		rc = balloc_alloc_db_update(bal, bac->bac_tx, grp,
+					    &bac->bac_final, zone, cur);
 	}
-
-	m0_balloc_release_extents(grp);
-out_unlock:
-	m0_balloc_unlock_group(grp);
 out:
-	return M0_RC(ret);
+	m0_balloc_unlock_group(grp);
+	return M0_RC(rc);
 }
-#endif
 
 /* group is locked */
 static int balloc_is_good_group(struct balloc_allocation_context *bac,
@@ -2112,6 +2362,52 @@ static int balloc_simple_scan_group(struct balloc_allocation_context *bac,
 	return 0;
 }
 
+/**
+ * Striped allocation: takes the first free extent of the requested length that
+ * starts on a stripe boundary of the zone (any block, if the stripe size is
+ * not set). In the group of the goal the search begins at the goal, so that an
+ * object whose goal was taken by another writer keeps growing forward.
+ *
+ * Group is locked.
+ */
+static int balloc_striped_scan_group(struct balloc_allocation_context *bac,
+				     struct m0_balloc_group_info *grp,
+				     enum m0_balloc_allocation_flag alloc_flag)
+{
+	struct m0_balloc_zone_param *zp;
+	struct m0_lext              *le;
+	m0_bcount_t                  len = m0_ext_length(&bac->bac_goal);
+	m0_bcount_t                  stripe;
+	m0_bindex_t                  zstart;
+	m0_bindex_t                  from;
+	m0_bindex_t                  start;
+
+	M0_ENTRY();
+	M0_PRE(m0_mutex_is_locked(bgi_mutex(grp)));
+
+	stripe = bac->bac_ctxt->cb_sb.bsb_stripe_size ?: 1;
+	zp     = is_spare(alloc_flag) ? &grp->bgi_spare : &grp->bgi_normal;
+	zstart = zp->bzp_range.e_start;
+	from   = m0_ext_is_in(&zp->bzp_range, bac->bac_goal.e_start) ?
+		bac->bac_goal.e_start : zstart;
+
+	m0_list_for_each_entry(&zp->bzp_extents, le, struct m0_lext, le_link) {
+		start = max_check(le->le_ext.e_start, from) - zstart;
+		start = zstart + (start + stripe - 1) / stripe * stripe;
+		if (start < le->le_ext.e_end &&
+		    le->le_ext.e_end - start >= len) {
+			bac->bac_found++;
+			bac->bac_best.e_start = start;
+			bac->bac_best.e_end   = le->le_ext.e_end;
+			balloc_use_best_found(bac, start);
+			break;
+		}
+	}
+
+	M0_LEAVE();
+	return 0;
+}
+
 static m0_bindex_t zone_start_get(struct m0_balloc_group_info *grp,
 				  enum m0_balloc_allocation_flag alloc_flag)
 {
@@ -2398,10 +2694,15 @@ static int
 balloc_regular_allocator(struct balloc_allocation_context *bac)
 {
 	m0_bcount_t ngroups;
+	m0_bcount_t start;
 	m0_bcount_t group;
-	m0_bcount_t i;
+	m0_bcount_t pos;
 	m0_bcount_t len;
+	m0_bcount_t need;
+	m0_bcount_t cand[BALLOC_FSI_BATCH];
+	int         cand_nr;
 	int         cr;
+	int         c;
 	int         rc = 0;
 
 	ngroups = bac->bac_ctxt->cb_sb.bsb_groupcount;
@@ -2410,7 +2711,6 @@ balloc_regular_allocator(struct balloc_allocation_context *bac)
 	M0_ENTRY("goal=0x%lx len=%d",
 		(unsigned long)bac->bac_goal.e_start, (int)len);
 
-#if 0
 	/* first, try the goal */
 	rc = balloc_find_by_goal(bac);
 	if (rc != 0 || bac->bac_status == M0_BALLOC_AC_FOUND ||
@@ -2418,7 +2718,6 @@ balloc_regular_allocator(struct balloc_allocation_context *bac)
 		M0_LEAVE();
 		return M0_RC(rc);
 	}
-#endif
 
 	bac->bac_order2 = 0;
 	/*
@@ -2431,7 +2730,7 @@ balloc_regular_allocator(struct balloc_allocation_context *bac)
 	cr = bac->bac_order2 ? 0 : 1;
 	/*
 	 * cr == 0 try to get exact allocation,
-	 * cr == 1 striped allocation. Not implemented currently.
+	 * cr == 1 striped allocation, see balloc_striped_scan_group(),
 	 * cr == 2 try to get anything
 	 */
 repeat:
@@ -2442,13 +2741,34 @@ repeat:
 		 * searching for the right group start
 		 * from the goal value specified
 		 */
-		group = balloc_bn2gn(bac->bac_goal.e_start, bac->bac_ctxt);
+		start = balloc_bn2gn(bac->bac_goal.e_start, bac->bac_ctxt);
+		if (start >= ngroups)
+			start = 0;
+		/*
+		 * Both the exact and the striped criteria need a group
+		 * whose largest free chunk is at least len: the average
+		 * chunk never exceeds the largest one.
+		 */
+		need = cr < 2 ? len : 1;
 
-		for (i = 0; i < ngroups; group++, i++) {
+		/*
+		 * The groups that cannot fit the request are skipped by the
+		 * free-space index. Candidates are taken from it in batches,
+		 * so usually the index is queried once per criterion.
+		 */
+		for (pos = 0, c = cand_nr = 0;; ++c) {
 			struct m0_balloc_group_info *grp;
 
-			if (group >= ngroups)
-				group = 0;
+			if (c == cand_nr) {
+				cand_nr = balloc_fsi_collect(bac->bac_ctxt,
+							     start, &pos, need,
+							     cand,
+							     ARRAY_SIZE(cand));
+				if (cand_nr == 0)
+					break;
+				c = 0;
+			}
+			group = cand[c];
 
 			grp = m0_balloc_gn2info(bac->bac_ctxt, group);
 			// m0_balloc_debug_dump_group("searching group ...",
@@ -2547,9 +2867,10 @@ static int allocate_blocks(int cr, struct balloc_allocation_context *bac,
 	M0_PRE(!is_any(alloc_type));
 	M0_PRE(is_spare(alloc_type) || is_normal(alloc_type));
 
-	if (cr == 0 ||
-	    (cr == 1 && len == bac->bac_ctxt->cb_sb.bsb_stripe_size))
+	if (cr == 0)
 		rc = balloc_simple_scan_group(bac, grp, alloc_type);
+	else if (cr == 1)
+		rc = balloc_striped_scan_group(bac, grp, alloc_type);
 	else
 		rc = balloc_wild_scan_group(bac, grp, alloc_type);
 
@@ -2884,6 +3205,8 @@ static int balloc_alloc(struct m0_ad_balloc *ballroom, struct m0_dtx *tx,
 #else
 	req.bar_flags = M0_BALLOC_NORMAL_ZONE;
 #endif
+	if (req.bar_goal != 0)
+		req.bar_flags |= M0_BALLOC_HINT_TRY_GOAL;
 
 	M0_SET0(out);
 
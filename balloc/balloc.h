@@ -159,6 +159,19 @@ struct m0_balloc_group_info {
 	struct m0_lext              *bgi_extents;
 	/** per-group lock */
 	struct m0_be_mutex           bgi_mutex;
+	/**
+	 * Largest free chunk of the group, as last published to the free-space
+	 * index of the allocator.
+	 *
+	 * The index is a max-tree over groups that finds the next group with a
+	 * large enough free chunk in O(log(groups)). Its internal nodes 2 * n
+	 * and 2 * n + 1 are stored in bgi_fsi[] of group n, so that the index
+	 * does not change the layout of struct m0_balloc.
+	 *
+	 * Both fields are protected by m0_balloc::cb_sb_mutex.
+	 */
+	m0_bcount_t                  bgi_fsi_key;
+	m0_bcount_t                  bgi_fsi[2];
 };
 
 enum m0_balloc_group_info_state {
@@ -377,6 +390,7 @@ M0_INTERNAL void m0_balloc_debug_dump_group(const char *tag,
 M0_INTERNAL void m0_balloc_lock_group(struct m0_balloc_group_info *grp);
 M0_INTERNAL int m0_balloc_trylock_group(struct m0_balloc_group_info *grp);
 M0_INTERNAL void m0_balloc_unlock_group(struct m0_balloc_group_info *grp);
+M0_INTERNAL bool m0_balloc_fsi_invariant(struct m0_balloc *cb);
 
 /** @} end of balloc */
 
@@ -194,6 +194,7 @@ int test_balloc_ut_ops(struct m0_be_ut_backend *ut_be, struct m0_be_seg *seg,
 			m0_balloc_unlock_group(grp);
 		}
 	}
+	M0_UT_ASSERT(m0_balloc_fsi_invariant(motr_balloc));
 
 	/* randomize the array */
 	for (i = 0; i < MAX; ++i) {
@@ -255,6 +256,7 @@ int test_balloc_ut_ops(struct m0_be_ut_backend *ut_be, struct m0_be_seg *seg,
 			m0_balloc_unlock_group(grp);
 		}
 	}
+	M0_UT_ASSERT(m0_balloc_fsi_invariant(motr_balloc));
 
 	motr_balloc->cb_ballroom.ab_ops->bo_fini(&motr_balloc->cb_ballroom);
 
@@ -299,6 +301,174 @@ void test_reserve_extent()
 	m0_be_ut_backend_fini(&ut_be);
 }
 
+enum {
+	GOAL_STREAM_NR = 2,
+	GOAL_ALLOC_NR  = 8,
+	GOAL_LEN       = 24,
+};
+
+/*
+ * Allocations of interleaved streams, each asking for the end of its previous
+ * extent as the goal, get exactly that.
+ */
+void test_goal()
+{
+	struct m0_be_ut_backend	 ut_be;
+	struct m0_be_ut_seg	 ut_seg;
+	struct m0_sm_group      *grp;
+	struct m0_balloc        *bal;
+	struct m0_ad_balloc     *ballroom;
+	struct m0_dtx            dtx = {};
+	struct m0_be_tx         *tx  = &dtx.tx_betx;
+	struct m0_be_tx_credit   cred;
+	struct m0_ext            ext[GOAL_STREAM_NR][GOAL_ALLOC_NR];
+	m0_bindex_t              goal;
+	m0_bcount_t              free;
+	int                      i;
+	int                      j;
+	int                      rc;
+
+	M0_SET0(&ut_be);
+	m0_be_ut_backend_init(&ut_be);
+	m0_be_ut_seg_init(&ut_seg, &ut_be, 1ULL << 24);
+	grp = m0_be_ut_backend_sm_group_lookup(&ut_be);
+	rc = m0_balloc_create(0, ut_seg.bus_seg, grp, &bal,
+			      &M0_FID_INIT(0, 1));
+	M0_UT_ASSERT(rc == 0);
+	ballroom = &bal->cb_ballroom;
+	rc = ballroom->ab_ops->bo_init(ballroom, ut_seg.bus_seg,
+			BALLOC_DEF_BLOCK_SHIFT, BALLOC_DEF_CONTAINER_SIZE,
+			BALLOC_DEF_BLOCKS_PER_GROUP,
+			m0_stob_ad_spares_calc(BALLOC_DEF_BLOCKS_PER_GROUP));
+	M0_UT_ASSERT(rc == 0);
+	free = bal->cb_sb.bsb_freeblocks;
+
+	for (i = 0; i < GOAL_ALLOC_NR; ++i) {
+		for (j = 0; j < GOAL_STREAM_NR; ++j) {
+			/* Stream j starts at the beginning of group j + 1. */
+			goal = i == 0 ? (j + 1) * BALLOC_DEF_BLOCKS_PER_GROUP :
+				ext[j][i - 1].e_end;
+			ext[j][i].e_start = ext[j][i].e_end = goal;
+			cred = M0_BE_TX_CREDIT(0, 0);
+			ballroom->ab_ops->bo_alloc_credit(ballroom, 1, &cred);
+			m0_ut_be_tx_begin(tx, &ut_be, &cred);
+			rc = ballroom->ab_ops->bo_alloc(ballroom, &dtx,
+							GOAL_LEN, &ext[j][i],
+							M0_BALLOC_NORMAL_ZONE);
+			m0_ut_be_tx_end(tx);
+			M0_UT_ASSERT(rc == 0);
+			M0_UT_ASSERT(ext[j][i].e_start == goal);
+			M0_UT_ASSERT(m0_ext_length(&ext[j][i]) == GOAL_LEN);
+		}
+	}
+	M0_UT_ASSERT(m0_balloc_fsi_invariant(bal));
+
+	for (i = 0; i < GOAL_ALLOC_NR; ++i) {
+		for (j = 0; j < GOAL_STREAM_NR; ++j) {
+			cred = M0_BE_TX_CREDIT(0, 0);
+			ballroom->ab_ops->bo_free_credit(ballroom, 1, &cred);
+			m0_ut_be_tx_begin(tx, &ut_be, &cred);
+			rc = ballroom->ab_ops->bo_free(ballroom, &dtx,
+						       &ext[j][i]);
+			m0_ut_be_tx_end(tx);
+			M0_UT_ASSERT(rc == 0);
+		}
+	}
+	M0_UT_ASSERT(bal->cb_sb.bsb_freeblocks == free);
+
+	ballroom->ab_ops->bo_fini(ballroom);
+	m0_be_ut_seg_fini(&ut_seg);
+	m0_be_ut_backend_fini(&ut_be);
+}
+
+enum {
+	FSI_FRAG_NR  = 3,
+	FSI_FRAG_LEN = 16,
+};
+
+/*
+ * An allocation skips the groups whose largest free chunk is too small and
+ * lands in the first group after the goal that fits.
+ */
+void test_fsi()
+{
+	struct m0_be_ut_backend	 ut_be;
+	struct m0_be_ut_seg	 ut_seg;
+	struct m0_sm_group      *grp;
+	struct m0_balloc        *bal;
+	struct m0_ad_balloc     *ballroom;
+	struct m0_dtx            dtx = {};
+	struct m0_be_tx         *tx  = &dtx.tx_betx;
+	struct m0_be_tx_credit   cred;
+	struct m0_ext            ext[FSI_FRAG_NR + 1];
+	m0_bcount_t              gs = BALLOC_DEF_BLOCKS_PER_GROUP;
+	m0_bcount_t              len;
+	m0_bcount_t              free;
+	int                      i;
+	int                      rc;
+
+	M0_SET0(&ut_be);
+	m0_be_ut_backend_init(&ut_be);
+	m0_be_ut_seg_init(&ut_seg, &ut_be, 1ULL << 24);
+	grp = m0_be_ut_backend_sm_group_lookup(&ut_be);
+	rc = m0_balloc_create(0, ut_seg.bus_seg, grp, &bal,
+			      &M0_FID_INIT(0, 1));
+	M0_UT_ASSERT(rc == 0);
+	ballroom = &bal->cb_ballroom;
+	rc = ballroom->ab_ops->bo_init(ballroom, ut_seg.bus_seg,
+			BALLOC_DEF_BLOCK_SHIFT, BALLOC_DEF_CONTAINER_SIZE,
+			BALLOC_DEF_BLOCKS_PER_GROUP,
+			m0_stob_ad_spares_calc(BALLOC_DEF_BLOCKS_PER_GROUP));
+	M0_UT_ASSERT(rc == 0);
+	free = bal->cb_sb.bsb_freeblocks;
+
+	/*
+	 * Split groups 1..FSI_FRAG_NR in the middle, so that their largest
+	 * free chunk is less than half of the group.
+	 */
+	for (i = 0; i <= FSI_FRAG_NR; ++i) {
+		if (i < FSI_FRAG_NR) {
+			ext[i].e_start = (i + 1) * gs + gs / 2 -
+				FSI_FRAG_LEN / 2;
+			len = FSI_FRAG_LEN;
+		} else {
+			/* Half of a group does not fit the split groups. */
+			ext[i].e_start = gs;
+			len = gs / 2;
+		}
+		ext[i].e_end = ext[i].e_start;
+		cred = M0_BE_TX_CREDIT(0, 0);
+		ballroom->ab_ops->bo_alloc_credit(ballroom, 1, &cred);
+		m0_ut_be_tx_begin(tx, &ut_be, &cred);
+		rc = ballroom->ab_ops->bo_alloc(ballroom, &dtx, len, &ext[i],
+						M0_BALLOC_NORMAL_ZONE);
+		m0_ut_be_tx_end(tx);
+		M0_UT_ASSERT(rc == 0);
+		M0_UT_ASSERT(m0_ext_length(&ext[i]) == len);
+	}
+	for (i = 0; i < FSI_FRAG_NR; ++i)
+		M0_UT_ASSERT(bal->cb_group_info[i + 1].bgi_normal.bzp_maxchunk <
+			     gs / 2);
+	M0_UT_ASSERT(ext[FSI_FRAG_NR].e_start >> bal->cb_sb.bsb_gsbits ==
+		     FSI_FRAG_NR + 1);
+	M0_UT_ASSERT(m0_balloc_fsi_invariant(bal));
+
+	for (i = 0; i <= FSI_FRAG_NR; ++i) {
+		cred = M0_BE_TX_CREDIT(0, 0);
+		ballroom->ab_ops->bo_free_credit(ballroom, 1, &cred);
+		m0_ut_be_tx_begin(tx, &ut_be, &cred);
+		rc = ballroom->ab_ops->bo_free(ballroom, &dtx, &ext[i]);
+		m0_ut_be_tx_end(tx);
+		M0_UT_ASSERT(rc == 0);
+	}
+	M0_UT_ASSERT(bal->cb_sb.bsb_freeblocks == free);
+	M0_UT_ASSERT(m0_balloc_fsi_invariant(bal));
+
+	ballroom->ab_ops->bo_fini(ballroom);
+	m0_be_ut_seg_fini(&ut_seg);
+	m0_be_ut_backend_fini(&ut_be);
+}
+
 struct m0_ut_suite balloc_ut = {
         .ts_name  = "balloc-ut",
 	.ts_init = NULL,
@@ -306,6 +476,8 @@ struct m0_ut_suite balloc_ut = {
         .ts_tests = {
 		{ "balloc", test_balloc},
 		{ "reserve blocks for extmap", test_reserve_extent},
+		{ "goal", test_goal},
+		{ "fsi first fit", test_fsi},
 		{ NULL, NULL }
         }
 };
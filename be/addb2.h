@@ -52,6 +52,16 @@ enum m0_avi_be_labels {
 	M0_AVI_BE_TX_ATTR_RA_PREP_TC_REG_SIZE,
 	M0_AVI_BE_TX_ATTR_RA_CAPT_TC_REG_NR,
 	M0_AVI_BE_TX_ATTR_RA_CAPT_TC_REG_SIZE,
+
+	/** Time spent waiting for the lock of an allocator zone. */
+	M0_AVI_BE_ALLOC_ZONE_WAIT,
+	/** Time spent waiting for the lock of an allocator arena. */
+	M0_AVI_BE_ALLOC_ARENA_WAIT,
+	/**
+	 * Recovery progress: bytes of log records re-applied, total bytes of
+	 * log records to re-apply and re-apply throughput in bytes per second.
+	 */
+	M0_AVI_BE_RECOVERY_PROGRESS,
 } M0_XCA_ENUM;
 
 /** @} end of be group */
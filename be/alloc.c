@@ -31,8 +31,13 @@
 #include "lib/memory.h"         /* m0_addr_is_aligned */
 #include "lib/errno.h"          /* ENOSPC */
 #include "lib/misc.h"           /* memset, M0_BITS, m0_forall */
+#include "lib/finject.h"        /* M0_FI_ENABLED */
+#include "lib/locality.h"       /* m0_locality_here */
+#include "lib/time.h"           /* m0_time_now */
+#include "addb2/counter.h"      /* m0_addb2_local_counter */
 #include "motr/magic.h"
 #include "be/domain.h"          /* m0_be_domain */
+#include "be/addb2.h"           /* M0_AVI_BE_ALLOC_ZONE_WAIT */
 
 /*
  * @addtogroup be
@@ -167,10 +172,60 @@
  * - allocator credit includes 2 * size requested for alignment shift greater
  *   than M0_BE_ALLOC_SHIFT_MIN;
  * - it is not truly O(1) allocator; see m0_be_fl documentation for explanation;
- * - there is one big allocator lock that protects all allocations/deallocation.
+ * - allocations which don't fit into arenas and all allocations in
+ *   M0_BAP_REPAIR zone are serialised by one allocator lock.
  *
  * Locks
- * Allocator lock (m0_mutex) is used to protect all allocator data.
+ * Allocator lock (m0_mutex) is used to protect all zone data. Every arena has
+ * its own lock which protects arena data.
+ *
+ * Time spent waiting for the locks is accounted in per-locality addb2
+ * counters M0_AVI_BE_ALLOC_ZONE_WAIT and M0_AVI_BE_ALLOC_ARENA_WAIT.
+ *
+ * Arenas
+ * ------
+ *
+ * To let allocations from different localities proceed in parallel, part of
+ * M0_BAP_NORMAL zone is split into M0_BE_ALLOC_ARENA_NR arenas. Arena is a
+ * chunk of the zone which is managed as an independent allocator space with
+ * own m0_be_allocator_header (see be_alloc_arena). The share of the zone given
+ * to arenas is m0_be_allocator_cfg::bac_arena_percent, 0 disables them.
+ * Segments which are too small for arenas (see BE_ALLOC_ARENA_ZONE_MIN) and
+ * segments created before arenas were introduced have no arenas.
+ *
+ * Arena chunks and slab region are recorded in be_alloc_index. The index is
+ * allocated first after zones creation, so it is always the first chunk of
+ * M0_BAP_NORMAL zone, and m0_be_allocator_init() reads it from there.
+ *
+ * m0_be_alloc_aligned() for M0_BAP_NORMAL zone first tries the arena of the
+ * current locality and falls back to the zone itself if the arena has no
+ * space. If the zone is full too, the other arenas are tried. Allocations
+ * larger than BE_ALLOC_ARENA_ALLOC_MAX always go to the zone, so they can use
+ * only (100 - bac_arena_percent)% of it: -ENOSPC for large objects comes
+ * earlier than without arenas. m0_be_free_aligned() returns the chunk to the
+ * arena or zone it was allocated from, as recorded in
+ * be_alloc_chunk::bac_zone. Internally arenas are addressed as zones with
+ * indices starting from M0_BAP_NR.
+ *
+ * Slab
+ * ----
+ *
+ * Objects not larger than be_alloc_slab::bsl_obj_max are allocated without
+ * be_alloc_chunk header in slab pages. Slab region is a chunk of M0_BAP_NORMAL
+ * zone allocated after arenas, it is split into pages of
+ * BE_ALLOC_SLAB_PAGE_SIZE bytes. Every page holds objects of one size class
+ * (multiple of 1 << M0_BE_ALLOC_SLAB_CLASS_SHIFT bytes) and a bitmap of used
+ * objects. Pages of a class are kept in a list with non-full pages at the
+ * head, so allocation takes the first zero bit of the head page and free
+ * clears the bit of the page found by address. Empty pages, except the last
+ * one of a class, are returned to the list of free pages. Pages are
+ * initialised on first use, so slab creation doesn't depend on slab size.
+ * The share of the zone given to slab region is
+ * m0_be_allocator_cfg::bac_slab_percent, 0 disables the slab.
+ *
+ * All slab metadata is in the segment and is captured, so it is recovered
+ * like the rest of the allocator. Each size class has its own lock. If slab
+ * has no free space the object is allocated as a regular chunk.
  *
  * Space reservation for DIX recovery
  * ----------------------------------
@@ -212,13 +267,26 @@ enum {
 	BE_ALLOC_HEADER_SHIFT = 3,
 	/** Alignment for zone's size. */
 	BE_ALLOC_ZONE_SIZE_SHIFT = 3,
+	/** Arenas are created in M0_BAP_NORMAL zone of at least this size. */
+	BE_ALLOC_ARENA_ZONE_MIN = 1 << 30,
+	/** Larger allocations always go to the zone. */
+	BE_ALLOC_ARENA_ALLOC_MAX = 1 << 20,
 };
 
+static struct m0_addb2_local_counter be_alloc_zone_wait;
+static struct m0_addb2_local_counter be_alloc_arena_wait;
+
 M0_BE_LIST_DESCR_DEFINE(chunks_all, "list of all chunks in m0_be_allocator",
 			static, struct be_alloc_chunk, bac_linkage, bac_magic,
 			M0_BE_ALLOC_ALL_LINK_MAGIC, M0_BE_ALLOC_ALL_MAGIC);
 M0_BE_LIST_DEFINE(chunks_all, static, struct be_alloc_chunk);
 
+M0_BE_LIST_DESCR_DEFINE(slab_pages, "list of slab pages in m0_be_allocator",
+			static, struct be_alloc_slab_page, bsp_linkage,
+			bsp_link_magic, M0_BE_ALLOC_SLAB_LINK_MAGIC,
+			M0_BE_ALLOC_SLAB_LIST_MAGIC);
+M0_BE_LIST_DEFINE(slab_pages, static, struct be_alloc_slab_page);
+
 static const char *be_alloc_zone_name(enum m0_be_alloc_zone_type type)
 {
 	static const char *zone_names[] = {
@@ -411,7 +479,7 @@ static bool be_alloc_chunk_invariant(struct m0_be_allocator *a,
 	struct be_alloc_chunk         *cprev;
 	struct be_alloc_chunk         *cnext;
 
-	M0_PRE(ztype < M0_BAP_NR);
+	M0_PRE(ztype < M0_BAP_NR + a->ba_arena_nr);
 
 	h = a->ba_h[ztype];
 	cprev = chunks_all_be_list_prev(&h->bah_chunks, c);
@@ -716,6 +784,617 @@ static bool be_alloc_chunk_trymerge(struct m0_be_allocator *a,
 	return chunks_were_merged;
 }
 
+M0_INTERNAL int m0_be_alloc_mod_init(void)
+{
+	int rc;
+
+	rc = m0_addb2_local_counter_init(&be_alloc_zone_wait,
+					 M0_AVI_BE_ALLOC_ZONE_WAIT,
+					 M0_AVI_BE_ALLOC_ZONE_WAIT);
+	if (rc != 0)
+		return M0_ERR(rc);
+	rc = m0_addb2_local_counter_init(&be_alloc_arena_wait,
+					 M0_AVI_BE_ALLOC_ARENA_WAIT,
+					 M0_AVI_BE_ALLOC_ARENA_WAIT);
+	if (rc != 0)
+		m0_locality_data_free(be_alloc_zone_wait.lc_key);
+	return M0_RC(rc);
+}
+
+M0_INTERNAL void m0_be_alloc_mod_fini(void)
+{
+	m0_locality_data_free(be_alloc_arena_wait.lc_key);
+	m0_locality_data_free(be_alloc_zone_wait.lc_key);
+}
+
+static bool be_alloc_is_arena(enum m0_be_alloc_zone_type ztype)
+{
+	return ztype >= M0_BAP_NR;
+}
+
+static struct m0_mutex *be_alloc_lock_get(struct m0_be_allocator     *a,
+					  enum m0_be_alloc_zone_type  ztype)
+{
+	return be_alloc_is_arena(ztype) ?
+		&a->ba_arena_lock[ztype - M0_BAP_NR] : &a->ba_lock;
+}
+
+/**
+ * Takes the lock of zone or arena @ztype. Time spent waiting for the lock is
+ * added to the addb2 counter of the current locality.
+ */
+static void be_alloc_lock(struct m0_be_allocator     *a,
+			  enum m0_be_alloc_zone_type  ztype)
+{
+	struct m0_mutex *lock = be_alloc_lock_get(a, ztype);
+	m0_time_t        start;
+
+	if (m0_mutex_trylock(lock) != 0) {
+		start = m0_time_now();
+		m0_mutex_lock(lock);
+		m0_addb2_local_counter_mod(be_alloc_is_arena(ztype) ?
+					   &be_alloc_arena_wait :
+					   &be_alloc_zone_wait,
+					   m0_time_now() - start, ztype);
+	}
+}
+
+static void be_alloc_unlock(struct m0_be_allocator     *a,
+			    enum m0_be_alloc_zone_type  ztype)
+{
+	m0_mutex_unlock(be_alloc_lock_get(a, ztype));
+}
+
+static bool be_alloc_zone_invariant(struct m0_be_allocator     *a,
+				    enum m0_be_alloc_zone_type  ztype)
+{
+	return be_alloc_is_arena(ztype) ?
+		m0_mutex_is_locked(be_alloc_lock_get(a, ztype)) :
+		m0_be_allocator__invariant(a);
+}
+
+/** Arena which should be used by the current locality. */
+static enum m0_be_alloc_zone_type
+be_alloc_arena_here(const struct m0_be_allocator *a)
+{
+	M0_PRE(a->ba_arena_nr > 0);
+	return M0_BAP_NR + m0_locality_here()->lo_idx % a->ba_arena_nr;
+}
+
+/**
+ * Allocates chunk with at least @size bytes of user data aligned on @shift in
+ * zone or arena @ztype. The lock of @ztype should be held.
+ *
+ * User data of the chunk is neither zeroed nor captured.
+ */
+static struct be_alloc_chunk *
+be_alloc_chunk_get(struct m0_be_allocator     *a,
+		   enum m0_be_alloc_zone_type  ztype,
+		   struct m0_be_tx            *tx,
+		   m0_bcount_t                 size,
+		   unsigned                    shift)
+{
+	struct be_alloc_chunk *c;
+	m0_bcount_t            size_to_pick;
+
+	M0_PRE(m0_mutex_is_locked(be_alloc_lock_get(a, ztype)));
+
+	size_to_pick = (1UL << shift) - (1UL << M0_BE_ALLOC_SHIFT_MIN) +
+		       m0_align(size, 1UL << M0_BE_ALLOC_SHIFT_MIN);
+	c = m0_be_fl_pick(&a->ba_h[ztype]->bah_fl, size_to_pick);
+	if (c != NULL) {
+		c = be_alloc_chunk_trysplit(a, ztype, tx, c, size, shift);
+		M0_ASSERT(c != NULL);
+		M0_ASSERT(c->bac_zone == ztype);
+		be_allocator_stats_update(&a->ba_h[ztype]->bah_stats,
+					  c->bac_size, true, false);
+		be_allocator_stats_capture(a, ztype, tx);
+
+		M0_POST(!c->bac_free);
+		M0_POST(c->bac_size >= size);
+		M0_POST(m0_addr_is_aligned(&c->bac_mem, shift));
+		M0_POST(be_alloc_chunk_is_in(a, ztype, c));
+	}
+	return c;
+}
+
+/**
+ * Frees chunk @c in zone or arena @ztype. The lock of @ztype should be held.
+ */
+static void be_alloc_chunk_put(struct m0_be_allocator     *a,
+			       enum m0_be_alloc_zone_type  ztype,
+			       struct m0_be_tx            *tx,
+			       struct be_alloc_chunk      *c)
+{
+	struct be_alloc_chunk *prev;
+	struct be_alloc_chunk *next;
+	bool                   chunks_were_merged;
+
+	M0_PRE(m0_mutex_is_locked(be_alloc_lock_get(a, ztype)));
+	M0_PRE(be_alloc_chunk_invariant(a, c));
+	M0_PRE(!c->bac_free);
+	M0_PRE(c->bac_zone == ztype);
+
+	be_alloc_chunk_mark_free(a, ztype, tx, c);
+	/* update stats before c->bac_size gets modified due to merge */
+	be_allocator_stats_update(&a->ba_h[ztype]->bah_stats,
+			c->bac_size, false, false);
+	prev = be_alloc_chunk_prev(a, ztype, c);
+	next = be_alloc_chunk_next(a, ztype, c);
+	chunks_were_merged = be_alloc_chunk_trymerge(a, ztype, tx,
+			prev, c);
+	if (chunks_were_merged)
+		c = prev;
+	be_alloc_chunk_trymerge(a, ztype, tx, c, next);
+	be_allocator_stats_capture(a, ztype, tx);
+
+	M0_POST(c->bac_free);
+	M0_POST(c->bac_size > 0);
+	M0_POST(be_alloc_chunk_invariant(a, c));
+}
+
+static struct be_alloc_arena *be_alloc_arena(struct be_alloc_chunk *c)
+{
+	return (struct be_alloc_arena *)&c->bac_mem;
+}
+
+static struct be_alloc_chunk *be_alloc_arena_chunk(struct m0_be_allocator *a,
+						   int                     i)
+{
+	return be_alloc_chunk_addr(container_of(a->ba_h[M0_BAP_NR + i],
+						struct be_alloc_arena, baa_h));
+}
+
+/** Allocates chunk in arena @ztype under the arena lock. */
+static struct be_alloc_chunk *
+be_alloc_arena_get(struct m0_be_allocator     *a,
+		   enum m0_be_alloc_zone_type  ztype,
+		   struct m0_be_tx            *tx,
+		   m0_bcount_t                 size,
+		   unsigned                    shift)
+{
+	struct be_alloc_chunk *c;
+
+	M0_PRE(be_alloc_is_arena(ztype));
+	be_alloc_lock(a, ztype);
+	M0_PRE_EX(be_alloc_zone_invariant(a, ztype));
+	c = be_alloc_chunk_get(a, ztype, tx, size, shift);
+	M0_POST_EX(be_alloc_zone_invariant(a, ztype));
+	be_alloc_unlock(a, ztype);
+	return c;
+}
+
+/**
+ * Returns index created by be_allocator_index_get(), NULL if there is none.
+ * The index is the first chunk of M0_BAP_NORMAL zone.
+ */
+static struct be_alloc_index *be_allocator_index(struct m0_be_allocator *a)
+{
+	struct m0_be_allocator_header *h = a->ba_h[M0_BAP_NORMAL];
+	struct be_alloc_chunk         *c;
+	struct be_alloc_index         *idx;
+
+	/* Header of a segment without allocator is zeroed. */
+	if (h->bah_size == 0)
+		return NULL;
+	c = chunks_all_be_list_head(&h->bah_chunks);
+	if (c == NULL || c->bac_free || c->bac_size < sizeof *idx)
+		return NULL;
+	idx = (struct be_alloc_index *)&c->bac_mem;
+	return idx->bai_magic == M0_BE_ALLOC_INDEX_MAGIC ? idx : NULL;
+}
+
+/**
+ * Returns the index, allocating it if it doesn't exist yet. It is called
+ * before anything else is allocated in M0_BAP_NORMAL zone, so the index
+ * becomes the first chunk of the zone. ba_lock should be held.
+ */
+static struct be_alloc_index *be_allocator_index_get(struct m0_be_allocator *a,
+						     struct m0_be_tx        *tx)
+{
+	struct m0_be_allocator_header *h = a->ba_h[M0_BAP_NORMAL];
+	struct be_alloc_chunk         *c;
+	struct be_alloc_index         *idx = be_allocator_index(a);
+
+	if (idx != NULL)
+		return idx;
+	c = be_alloc_chunk_get(a, M0_BAP_NORMAL, tx, sizeof *idx,
+			       M0_BE_ALLOC_SHIFT_MIN);
+	M0_ASSERT(c != NULL);
+	M0_ASSERT(c == chunks_all_be_list_head(&h->bah_chunks));
+	idx = (struct be_alloc_index *)&c->bac_mem;
+	*idx = (struct be_alloc_index){ .bai_magic = M0_BE_ALLOC_INDEX_MAGIC };
+	M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, idx);
+	return idx;
+}
+
+/** Returns the index to M0_BAP_NORMAL zone. ba_lock should be held. */
+static void be_allocator_index_put(struct m0_be_allocator *a,
+				   struct m0_be_tx        *tx)
+{
+	struct be_alloc_index *idx = be_allocator_index(a);
+
+	if (idx == NULL)
+		return;
+	M0_PRE(idx->bai_arena_nr == 0 && idx->bai_slab == NULL);
+	idx->bai_magic = 0;
+	M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &idx->bai_magic);
+	be_alloc_chunk_put(a, M0_BAP_NORMAL, tx, be_alloc_chunk_addr(idx));
+}
+
+/** Finds arenas created by be_allocator_arenas_create() in the index. */
+static void be_allocator_arenas_find(struct m0_be_allocator *a)
+{
+	struct be_alloc_index *idx = be_allocator_index(a);
+	struct be_alloc_arena *arena;
+	int                    i;
+
+	a->ba_arena_nr = 0;
+	if (idx == NULL)
+		return;
+	M0_ASSERT(idx->bai_arena_nr <= M0_BE_ALLOC_ARENA_NR);
+	for (i = 0; i < idx->bai_arena_nr; ++i) {
+		arena = idx->bai_arena[i];
+		M0_ASSERT(arena->baa_magic == M0_BE_ALLOC_ARENA_MAGIC);
+		M0_ASSERT(arena->baa_index == i);
+		a->ba_h[M0_BAP_NR + i] = &arena->baa_h;
+	}
+	a->ba_arena_nr = idx->bai_arena_nr;
+	M0_LOG(M0_DEBUG, "a=%p arenas=%u", a, a->ba_arena_nr);
+}
+
+static int be_allocator_header_create(struct m0_be_allocator     *a,
+				      enum m0_be_alloc_zone_type  ztype,
+				      struct m0_be_tx            *tx,
+				      uintptr_t                   offset,
+				      m0_bcount_t                 size);
+
+static void be_allocator_header_destroy(struct m0_be_allocator     *a,
+					enum m0_be_alloc_zone_type  ztype,
+					struct m0_be_tx            *tx);
+
+/** Carves arenas from M0_BAP_NORMAL zone. ba_lock should be held. */
+static void be_allocator_arenas_create(struct m0_be_allocator *a,
+				       struct m0_be_tx        *tx)
+{
+	struct m0_be_allocator_header *h = a->ba_h[M0_BAP_NORMAL];
+	struct be_alloc_index         *idx;
+	struct be_alloc_arena         *arena;
+	struct be_alloc_chunk         *c;
+	m0_bcount_t                    size;
+	uintptr_t                      start;
+	uintptr_t                      end;
+	uint32_t                       percent = a->ba_cfg.bac_arena_percent;
+	int                            rc;
+	int                            i;
+
+	M0_PRE(a->ba_arena_nr == 0);
+	M0_PRE(percent < 100);
+
+	if (percent == 0 || (h->bah_size < BE_ALLOC_ARENA_ZONE_MIN &&
+			     !M0_FI_ENABLED("any_zone_size")))
+		return;
+	idx = be_allocator_index_get(a, tx);
+	size = h->bah_size / 100 * percent / M0_BE_ALLOC_ARENA_NR;
+	for (i = 0; i < M0_BE_ALLOC_ARENA_NR; ++i) {
+		c = be_alloc_chunk_get(a, M0_BAP_NORMAL, tx, size,
+				       M0_BE_ALLOC_SHIFT_MIN);
+		M0_ASSERT(c != NULL);
+		arena = be_alloc_arena(c);
+		arena->baa_magic = M0_BE_ALLOC_ARENA_MAGIC;
+		arena->baa_index = i;
+		M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &arena->baa_magic);
+		M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &arena->baa_index);
+		a->ba_h[M0_BAP_NR + i] = &arena->baa_h;
+		a->ba_arena_nr = i + 1;
+		idx->bai_arena[i] = arena;
+
+		start = m0_align((uintptr_t)(arena + 1),
+				 1UL << M0_BE_ALLOC_SHIFT_MIN);
+		end   = (uintptr_t)&c->bac_mem[c->bac_size];
+		rc = be_allocator_header_create(a, M0_BAP_NR + i, tx, start,
+						end - start);
+		M0_ASSERT(rc == 0);
+	}
+	idx->bai_arena_nr = a->ba_arena_nr;
+	M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, idx);
+}
+
+/** Returns arenas to M0_BAP_NORMAL zone. ba_lock should be held. */
+static void be_allocator_arenas_destroy(struct m0_be_allocator *a,
+					struct m0_be_tx        *tx)
+{
+	struct be_alloc_index *idx = be_allocator_index(a);
+	struct be_alloc_arena *arena;
+	struct be_alloc_chunk *c;
+	int                    i;
+
+	if (idx != NULL) {
+		idx->bai_arena_nr = 0;
+		M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &idx->bai_arena_nr);
+	}
+	for (i = a->ba_arena_nr - 1; i >= 0; --i) {
+		c = be_alloc_arena_chunk(a, i);
+		arena = be_alloc_arena(c);
+		be_allocator_header_destroy(a, M0_BAP_NR + i, tx);
+		arena->baa_magic = 0;
+		M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &arena->baa_magic);
+		be_alloc_chunk_put(a, M0_BAP_NORMAL, tx, c);
+	}
+	a->ba_arena_nr = 0;
+}
+
+static uint32_t be_alloc_slab_class(m0_bcount_t size)
+{
+	return size == 0 ? 0 : (size - 1) >> M0_BE_ALLOC_SLAB_CLASS_SHIFT;
+}
+
+static m0_bcount_t be_alloc_slab_class_size(uint32_t cls)
+{
+	return (m0_bcount_t)(cls + 1) << M0_BE_ALLOC_SLAB_CLASS_SHIFT;
+}
+
+/** Offset of the first object in a slab page. */
+static m0_bcount_t be_alloc_slab_obj_offset(void)
+{
+	return m0_align(sizeof(struct be_alloc_slab_page),
+			1UL << M0_BE_ALLOC_SLAB_CLASS_SHIFT);
+}
+
+static uint32_t be_alloc_slab_obj_nr(uint32_t cls)
+{
+	return (BE_ALLOC_SLAB_PAGE_SIZE - be_alloc_slab_obj_offset()) /
+		be_alloc_slab_class_size(cls);
+}
+
+static bool be_alloc_slab_is_in(const struct m0_be_allocator *a,
+				const void                   *ptr)
+{
+	const struct be_alloc_slab *s = a->ba_slab;
+
+	return s != NULL && ptr >= s->bsl_pages &&
+	       ptr < s->bsl_pages + s->bsl_page_nr * BE_ALLOC_SLAB_PAGE_SIZE;
+}
+
+static bool be_alloc_slab_fits(const struct m0_be_allocator *a,
+			       m0_bcount_t                   size,
+			       unsigned                      shift,
+			       uint64_t                      zonemask)
+{
+	return a->ba_slab != NULL && zonemask == M0_BITS(M0_BAP_NORMAL) &&
+	       shift <= M0_BE_ALLOC_SLAB_CLASS_SHIFT &&
+	       size <= a->ba_slab->bsl_obj_max;
+}
+
+static struct be_alloc_slab_page *be_alloc_slab_page_of(const void *ptr)
+{
+	return (struct be_alloc_slab_page *)
+		((uintptr_t)ptr & ~((uintptr_t)BE_ALLOC_SLAB_PAGE_SIZE - 1));
+}
+
+static bool be_alloc_slab_page_invariant(const struct be_alloc_slab_page *p,
+					 uint32_t                         cls)
+{
+	return _0C(p->bsp_magic == M0_BE_ALLOC_SLAB_PAGE_MAGIC) &&
+	       _0C(p->bsp_class == cls) &&
+	       _0C(p->bsp_free <= be_alloc_slab_obj_nr(cls));
+}
+
+/**
+ * Takes a free slab page for size class @cls and puts it at the head of the
+ * class list. The lock of @cls should be held.
+ */
+static struct be_alloc_slab_page *
+be_alloc_slab_page_get(struct m0_be_allocator *a,
+		       struct m0_be_tx        *tx,
+		       uint32_t                cls)
+{
+	struct be_alloc_slab      *s = a->ba_slab;
+	struct be_alloc_slab_page *p;
+
+	m0_mutex_lock(&a->ba_slab_free_lock);
+	p = slab_pages_be_list_head(&s->bsl_free);
+	if (p != NULL) {
+		slab_pages_be_list_del(&s->bsl_free, tx, p);
+	} else if (s->bsl_page_used < s->bsl_page_nr) {
+		p = s->bsl_pages + s->bsl_page_used * BE_ALLOC_SLAB_PAGE_SIZE;
+		++s->bsl_page_used;
+		M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &s->bsl_page_used);
+		p->bsp_magic = M0_BE_ALLOC_SLAB_PAGE_MAGIC;
+		slab_pages_be_tlink_create(p, tx);
+	}
+	m0_mutex_unlock(&a->ba_slab_free_lock);
+	if (p != NULL) {
+		p->bsp_class = cls;
+		p->bsp_free  = be_alloc_slab_obj_nr(cls);
+		M0_SET_ARR0(p->bsp_map);
+		M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, p);
+		slab_pages_be_list_add(&s->bsl_class[cls], tx, p);
+	}
+	return p;
+}
+
+/** Allocates object of @size bytes in slab. Returns NULL if slab is full. */
+static void *be_alloc_slab_get(struct m0_be_allocator *a,
+			       struct m0_be_tx        *tx,
+			       m0_bcount_t             size)
+{
+	struct be_alloc_slab      *s = a->ba_slab;
+	struct m0_be_list         *list;
+	struct be_alloc_slab_page *p;
+	uint32_t                   cls = be_alloc_slab_class(size);
+	uint64_t                  *word;
+	uint32_t                   idx;
+	void                      *obj = NULL;
+
+	M0_PRE(cls < M0_BE_ALLOC_SLAB_CLASS_NR);
+
+	list = &s->bsl_class[cls];
+	m0_mutex_lock(&a->ba_slab_lock[cls]);
+	p = slab_pages_be_list_head(list);
+	if (p == NULL || p->bsp_free == 0)
+		p = be_alloc_slab_page_get(a, tx, cls);
+	if (p != NULL) {
+		M0_ASSERT(be_alloc_slab_page_invariant(p, cls));
+		M0_ASSERT(p->bsp_free > 0);
+		for (idx = 0; p->bsp_map[idx / 64] == ~0ULL; idx += 64)
+			;
+		word = &p->bsp_map[idx / 64];
+		idx += __builtin_ctzll(~*word);
+		M0_ASSERT(idx < be_alloc_slab_obj_nr(cls));
+		*word |= 1ULL << (idx % 64);
+		--p->bsp_free;
+		M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, word);
+		M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &p->bsp_free);
+		if (p->bsp_free == 0) {
+			/* Full pages are kept at the tail. */
+			slab_pages_be_list_del(list, tx, p);
+			slab_pages_be_list_add_tail(list, tx, p);
+		}
+		obj = (void *)p + be_alloc_slab_obj_offset() +
+			idx * be_alloc_slab_class_size(cls);
+	}
+	m0_mutex_unlock(&a->ba_slab_lock[cls]);
+	return obj;
+}
+
+static void be_alloc_slab_put(struct m0_be_allocator *a,
+			      struct m0_be_tx        *tx,
+			      void                   *ptr)
+{
+	struct be_alloc_slab      *s = a->ba_slab;
+	struct be_alloc_slab_page *p = be_alloc_slab_page_of(ptr);
+	struct m0_be_list         *list;
+	m0_bcount_t                offset;
+	uint64_t                  *word;
+	uint64_t                   bit;
+	uint32_t                   cls;
+	uint32_t                   idx;
+
+	/* Class of a page with used objects doesn't change. */
+	cls  = p->bsp_class;
+	M0_PRE(cls < M0_BE_ALLOC_SLAB_CLASS_NR);
+	list = &s->bsl_class[cls];
+	m0_mutex_lock(&a->ba_slab_lock[cls]);
+	M0_PRE(be_alloc_slab_page_invariant(p, cls));
+	offset = ptr - (void *)p - be_alloc_slab_obj_offset();
+	M0_PRE(offset % be_alloc_slab_class_size(cls) == 0);
+	idx  = offset / be_alloc_slab_class_size(cls);
+	word = &p->bsp_map[idx / 64];
+	bit  = 1ULL << (idx % 64);
+	M0_PRE((*word & bit) != 0);
+
+	*word &= ~bit;
+	++p->bsp_free;
+	M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, word);
+	M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &p->bsp_free);
+	if (p->bsp_free == be_alloc_slab_obj_nr(cls) &&
+	    (slab_pages_be_list_head(list) != p ||
+	     slab_pages_be_list_tail(list) != p)) {
+		slab_pages_be_list_del(list, tx, p);
+		m0_mutex_lock(&a->ba_slab_free_lock);
+		slab_pages_be_list_add(&s->bsl_free, tx, p);
+		m0_mutex_unlock(&a->ba_slab_free_lock);
+	} else if (p->bsp_free == 1) {
+		/* The page is not full anymore, move it to the head. */
+		slab_pages_be_list_del(list, tx, p);
+		slab_pages_be_list_add(list, tx, p);
+	}
+	m0_mutex_unlock(&a->ba_slab_lock[cls]);
+}
+
+static bool be_alloc_slab_page_is_empty(const struct be_alloc_slab_page *p)
+{
+	return p->bsp_free == be_alloc_slab_obj_nr(p->bsp_class);
+}
+
+static bool be_alloc_slab_is_empty(struct be_alloc_slab *s)
+{
+	return m0_forall(i, M0_BE_ALLOC_SLAB_CLASS_NR,
+			 m0_be_list_forall(slab_pages, p, &s->bsl_class[i],
+					   be_alloc_slab_page_is_empty(p)));
+}
+
+/** Finds slab region created by be_allocator_slab_create() in the index. */
+static void be_allocator_slab_find(struct m0_be_allocator *a)
+{
+	struct be_alloc_index *idx = be_allocator_index(a);
+
+	a->ba_slab = idx == NULL ? NULL : idx->bai_slab;
+	M0_ASSERT(ergo(a->ba_slab != NULL,
+		       a->ba_slab->bsl_magic == M0_BE_ALLOC_SLAB_MAGIC));
+	M0_LOG(M0_DEBUG, "a=%p slab=%p", a, a->ba_slab);
+}
+
+/** Allocates slab region in M0_BAP_NORMAL zone. ba_lock should be held. */
+static void be_allocator_slab_create(struct m0_be_allocator *a,
+				     struct m0_be_tx        *tx)
+{
+	struct m0_be_allocator_header *h = a->ba_h[M0_BAP_NORMAL];
+	struct be_alloc_index         *idx;
+	struct be_alloc_chunk         *c;
+	struct be_alloc_slab          *s;
+	uintptr_t                      pages;
+	uint32_t                       percent;
+	m0_bcount_t                    obj_max;
+	int                            i;
+
+	percent = a->ba_cfg.bac_slab_percent;
+	obj_max = a->ba_cfg.bac_slab_obj_max ?: M0_BE_ALLOC_SLAB_OBJ_MAX;
+	M0_PRE(a->ba_slab == NULL);
+	M0_PRE(percent < 100);
+	M0_PRE(obj_max <=
+	       be_alloc_slab_class_size(M0_BE_ALLOC_SLAB_CLASS_NR - 1));
+
+	if (percent == 0 || (h->bah_size < BE_ALLOC_ARENA_ZONE_MIN &&
+			     !M0_FI_ENABLED("any_zone_size")))
+		return;
+	idx = be_allocator_index_get(a, tx);
+	c = be_alloc_chunk_get(a, M0_BAP_NORMAL, tx,
+			       h->bah_size / 100 * percent,
+			       BE_ALLOC_SLAB_PAGE_SHIFT);
+	if (c == NULL)
+		return;
+	s = (struct be_alloc_slab *)&c->bac_mem;
+	pages = m0_align((uintptr_t)(s + 1), BE_ALLOC_SLAB_PAGE_SIZE);
+	s->bsl_magic     = M0_BE_ALLOC_SLAB_MAGIC;
+	s->bsl_obj_max   = obj_max;
+	s->bsl_pages     = (void *)pages;
+	s->bsl_page_nr   = ((uintptr_t)&c->bac_mem[c->bac_size] - pages) /
+			   BE_ALLOC_SLAB_PAGE_SIZE;
+	s->bsl_page_used = 0;
+	slab_pages_be_list_create(&s->bsl_free, tx);
+	for (i = 0; i < ARRAY_SIZE(s->bsl_class); ++i)
+		slab_pages_be_list_create(&s->bsl_class[i], tx);
+	M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, s);
+	a->ba_slab = s;
+	idx->bai_slab = s;
+	M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &idx->bai_slab);
+}
+
+/**
+ * Returns slab region to M0_BAP_NORMAL zone. ba_lock should be held.
+ *
+ * Page lists are not destroyed one by one: their memory goes back to the
+ * zone together with the region.
+ */
+static void be_allocator_slab_destroy(struct m0_be_allocator *a,
+				      struct m0_be_tx        *tx)
+{
+	struct be_alloc_index *idx = be_allocator_index(a);
+	struct be_alloc_slab  *s = a->ba_slab;
+
+	if (s == NULL)
+		return;
+	M0_PRE_EX(be_alloc_slab_is_empty(s));
+	idx->bai_slab = NULL;
+	M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &idx->bai_slab);
+	s->bsl_magic = 0;
+	M0_BE_TX_CAPTURE_PTR(a->ba_seg, tx, &s->bsl_magic);
+	be_alloc_chunk_put(a, M0_BAP_NORMAL, tx, be_alloc_chunk_addr(s));
+	a->ba_slab = NULL;
+}
+
 M0_INTERNAL int m0_be_allocator_init(struct m0_be_allocator *a,
 				     struct m0_be_seg *seg)
 {
@@ -730,6 +1409,16 @@ M0_INTERNAL int m0_be_allocator_init(struct m0_be_allocator *a,
 	/* See comment in m0_be_btree_init(). */
 	M0_SET0(&a->ba_lock);
 	m0_mutex_init(&a->ba_lock);
+	for (i = 0; i < M0_BE_ALLOC_ARENA_NR; ++i) {
+		M0_SET0(&a->ba_arena_lock[i]);
+		m0_mutex_init(&a->ba_arena_lock[i]);
+	}
+	for (i = 0; i < M0_BE_ALLOC_SLAB_CLASS_NR; ++i) {
+		M0_SET0(&a->ba_slab_lock[i]);
+		m0_mutex_init(&a->ba_slab_lock[i]);
+	}
+	M0_SET0(&a->ba_slab_free_lock);
+	m0_mutex_init(&a->ba_slab_free_lock);
 
 	a->ba_seg = seg;
 	seg_hdr = (struct m0_be_seg_hdr *)seg->bs_addr;
@@ -738,6 +1427,8 @@ M0_INTERNAL int m0_be_allocator_init(struct m0_be_allocator *a,
 		M0_ASSERT(m0_addr_is_aligned(a->ba_h[i],
 					     BE_ALLOC_HEADER_SHIFT));
 	}
+	be_allocator_arenas_find(a);
+	be_allocator_slab_find(a);
 
 	return 0;
 }
@@ -748,8 +1439,13 @@ M0_INTERNAL void m0_be_allocator_fini(struct m0_be_allocator *a)
 
 	M0_ENTRY("a=%p", a);
 
-	for (i = 0; i < M0_BAP_NR; ++i)
+	for (i = 0; i < M0_BAP_NR + a->ba_arena_nr; ++i)
 		be_allocator_stats_print(&a->ba_h[i]->bah_stats);
+	m0_mutex_fini(&a->ba_slab_free_lock);
+	for (i = 0; i < M0_BE_ALLOC_SLAB_CLASS_NR; ++i)
+		m0_mutex_fini(&a->ba_slab_lock[i]);
+	for (i = 0; i < M0_BE_ALLOC_ARENA_NR; ++i)
+		m0_mutex_fini(&a->ba_arena_lock[i]);
 	m0_mutex_fini(&a->ba_lock);
 
 	M0_LEAVE();
@@ -774,7 +1470,7 @@ static int be_allocator_header_create(struct m0_be_allocator     *a,
 	struct m0_be_allocator_header *h = a->ba_h[ztype];
 	struct be_alloc_chunk         *c;
 
-	M0_PRE(ztype < M0_BAP_NR);
+	M0_PRE(ztype < M0_BAP_NR + a->ba_arena_nr);
 
 	if (size != 0 && size < sizeof *c + 1)
 		return M0_ERR(-ENOSPC);
@@ -867,11 +1563,14 @@ M0_INTERNAL int m0_be_allocator_create(struct m0_be_allocator *a,
 		rc = be_allocator_header_create(a, i, tx, 0, 0);
 		M0_ASSERT(rc == 0);
 	}
+	be_allocator_arenas_create(a, tx);
+	be_allocator_slab_create(a, tx);
 
 	M0_LOG(M0_DEBUG, "free_space=%"PRIu64, free_space);
 	for (i = 0; i < zones_nr; ++i)
 		M0_LOG(M0_DEBUG, "%s zone size=%"PRIu64,
 		       be_alloc_zone_name(i), a->ba_h[i]->bah_size);
+	M0_LOG(M0_DEBUG, "arenas=%u slab=%p", a->ba_arena_nr, a->ba_slab);
 
 	M0_POST(m0_be_allocator__invariant(a));
 	m0_mutex_unlock(&a->ba_lock);
@@ -890,6 +1589,9 @@ M0_INTERNAL void m0_be_allocator_destroy(struct m0_be_allocator *a,
 	m0_mutex_lock(&a->ba_lock);
 	M0_PRE_EX(m0_be_allocator__invariant(a));
 
+	be_allocator_slab_destroy(a, tx);
+	be_allocator_arenas_destroy(a, tx);
+	be_allocator_index_put(a, tx);
 	for (z = 0; z < M0_BAP_NR; ++z)
 		be_allocator_header_destroy(a, z, tx);
 
@@ -924,8 +1626,15 @@ M0_INTERNAL void m0_be_allocator_credit(struct m0_be_allocator *a,
 	struct m0_be_tx_credit         cred_free_flag;
 	struct m0_be_tx_credit         cred_chunk_size;
 	struct m0_be_tx_credit         stats_credit;
+	struct m0_be_tx_credit         cred_arena = {};
+	struct m0_be_tx_credit         cred_slab_alloc = {};
+	struct m0_be_tx_credit         cred_slab_free = {};
 	struct m0_be_tx_credit         tmp;
 	struct be_alloc_chunk          chunk;
+	struct be_alloc_arena          arena;
+	struct be_alloc_index          index;
+	struct be_alloc_slab           slab;
+	struct be_alloc_slab_page      page;
 
 	chunk_credit    = M0_BE_TX_CREDIT_TYPE(struct be_alloc_chunk);
 	cred_free_flag  = M0_BE_TX_CREDIT_PTR(&chunk.bac_free);
@@ -974,6 +1683,28 @@ M0_INTERNAL void m0_be_allocator_credit(struct m0_be_allocator *a,
 	m0_be_tx_credit_add(&cred_mark_free, &cred_free_flag);
 	m0_be_fl_credit(&h->bah_fl, M0_BFL_ADD, &cred_mark_free);
 
+	m0_be_tx_credit_add(&cred_arena,
+			    &M0_BE_TX_CREDIT_PTR(&arena.baa_magic));
+	m0_be_tx_credit_add(&cred_arena,
+			    &M0_BE_TX_CREDIT_PTR(&arena.baa_index));
+
+	/* object bit and page free counter */
+	m0_be_tx_credit_add(&cred_slab_free,
+			    &M0_BE_TX_CREDIT_PTR(&page.bsp_map[0]));
+	m0_be_tx_credit_add(&cred_slab_free,
+			    &M0_BE_TX_CREDIT_PTR(&page.bsp_free));
+	/* page is moved between lists */
+	slab_pages_be_list_credit(M0_BLO_DEL, 1, &cred_slab_free);
+	slab_pages_be_list_credit(M0_BLO_ADD, 1, &cred_slab_free);
+	/* new page is taken from free list or initialised */
+	slab_pages_be_list_credit(M0_BLO_DEL,          1, &cred_slab_alloc);
+	slab_pages_be_list_credit(M0_BLO_TLINK_CREATE, 1, &cred_slab_alloc);
+	m0_be_tx_credit_add(&cred_slab_alloc,
+			    &M0_BE_TX_CREDIT_PTR(&slab.bsl_page_used));
+	m0_be_tx_credit_add(&cred_slab_alloc, &M0_BE_TX_CREDIT_PTR(&page));
+	slab_pages_be_list_credit(M0_BLO_ADD, 1, &cred_slab_alloc);
+	m0_be_tx_credit_add(&cred_slab_alloc, &cred_slab_free);
+
 	switch (optype) {
 		case M0_BAO_CREATE:
 			tmp = M0_BE_TX_CREDIT(0, 0);
@@ -982,28 +1713,74 @@ M0_INTERNAL void m0_be_allocator_credit(struct m0_be_allocator *a,
 			m0_be_tx_credit_add(&tmp, &chunk_add_after_credit);
 			m0_be_tx_credit_add(&tmp, &cred_allocator);
 			m0_be_tx_credit_add(&tmp, &stats_credit);
-			m0_be_tx_credit_mac(accum, &tmp, M0_BAP_NR);
+			/* arena carving */
+			m0_be_tx_credit_add(&tmp, &cred_split);
+			m0_be_tx_credit_add(&tmp, &stats_credit);
+			m0_be_tx_credit_add(&tmp, &cred_arena);
+			m0_be_tx_credit_mac(accum, &tmp,
+					    M0_BAP_NR + M0_BE_ALLOC_ARENA_NR);
+			/* index: created, filled by arenas and slab */
+			m0_be_tx_credit_add(accum, &cred_split);
+			m0_be_tx_credit_add(accum, &stats_credit);
+			m0_be_tx_credit_mac(accum,
+					    &M0_BE_TX_CREDIT_PTR(&index), 3);
+			/* slab region */
+			m0_be_tx_credit_add(accum, &cred_split);
+			m0_be_tx_credit_add(accum, &stats_credit);
+			slab_pages_be_list_credit(M0_BLO_CREATE,
+						  M0_BE_ALLOC_SLAB_CLASS_NR + 1,
+						  accum);
+			m0_be_tx_credit_add(accum, &M0_BE_TX_CREDIT_PTR(&slab));
 			break;
 		case M0_BAO_DESTROY:
 			tmp = M0_BE_TX_CREDIT(0, 0);
 			m0_be_fl_credit(&h->bah_fl, M0_BFL_DESTROY, &tmp);
 			m0_be_tx_credit_add(&tmp, &chunk_del_fini_credit);
 			m0_be_tx_credit_mac(&tmp, &cred_list_destroy, 2);
-			m0_be_tx_credit_mac(accum, &tmp, M0_BAP_NR);
+			/* arena release */
+			m0_be_tx_credit_add(&tmp, &cred_arena);
+			m0_be_tx_credit_add(&tmp, &cred_mark_free);
+			m0_be_tx_credit_mac(&tmp, &chunk_trymerge_credit, 2);
+			m0_be_tx_credit_add(&tmp, &stats_credit);
+			m0_be_tx_credit_mac(accum, &tmp,
+					    M0_BAP_NR + M0_BE_ALLOC_ARENA_NR);
+			/* slab region */
+			m0_be_tx_credit_add(accum,
+				    &M0_BE_TX_CREDIT_PTR(&slab.bsl_magic));
+			m0_be_tx_credit_add(accum, &cred_mark_free);
+			m0_be_tx_credit_mac(accum, &chunk_trymerge_credit, 2);
+			m0_be_tx_credit_add(accum, &stats_credit);
+			/* index */
+			m0_be_tx_credit_add(accum,
+				    &M0_BE_TX_CREDIT_PTR(&index.bai_arena_nr));
+			m0_be_tx_credit_add(accum,
+				    &M0_BE_TX_CREDIT_PTR(&index.bai_slab));
+			m0_be_tx_credit_add(accum,
+				    &M0_BE_TX_CREDIT_PTR(&index.bai_magic));
+			m0_be_tx_credit_add(accum, &cred_mark_free);
+			m0_be_tx_credit_mac(accum, &chunk_trymerge_credit, 2);
+			m0_be_tx_credit_add(accum, &stats_credit);
 			break;
 		case M0_BAO_ALLOC_ALIGNED:
-			m0_be_tx_credit_add(accum, &cred_split);
+			tmp = M0_BE_TX_CREDIT(0, 0);
+			m0_be_tx_credit_add(&tmp, &cred_split);
+			m0_be_tx_credit_add(&tmp, &stats_credit);
+			/* either slab object or chunk is allocated */
+			m0_be_tx_credit_max(&tmp, &tmp, &cred_slab_alloc);
+			m0_be_tx_credit_add(accum, &tmp);
 			m0_be_tx_credit_add(accum, &mem_zero_credit);
-			m0_be_tx_credit_add(accum, &stats_credit);
 			break;
 		case M0_BAO_ALLOC:
 			m0_be_allocator_credit(a, M0_BAO_ALLOC_ALIGNED, size,
 					       M0_BE_ALLOC_SHIFT_MIN, accum);
 			break;
 		case M0_BAO_FREE_ALIGNED:
-			m0_be_tx_credit_add(accum, &cred_mark_free);
-			m0_be_tx_credit_mac(accum, &chunk_trymerge_credit, 2);
-			m0_be_tx_credit_add(accum, &stats_credit);
+			tmp = M0_BE_TX_CREDIT(0, 0);
+			m0_be_tx_credit_add(&tmp, &cred_mark_free);
+			m0_be_tx_credit_mac(&tmp, &chunk_trymerge_credit, 2);
+			m0_be_tx_credit_add(&tmp, &stats_credit);
+			m0_be_tx_credit_max(&tmp, &tmp, &cred_slab_free);
+			m0_be_tx_credit_add(accum, &tmp);
 			break;
 		case M0_BAO_FREE:
 			m0_be_allocator_credit(a, M0_BAO_FREE_ALIGNED, size,
@@ -1025,10 +1802,12 @@ M0_INTERNAL void m0_be_alloc_aligned(struct m0_be_allocator *a,
 				     unsigned shift,
 				     uint64_t zonemask)
 {
-	enum  m0_be_alloc_zone_type  ztype;
+	enum  m0_be_alloc_zone_type  ztype = M0_BAP_NORMAL;
 	struct be_alloc_chunk       *c = NULL;
-	m0_bcount_t                  size_to_pick;
+	void                        *mem = NULL;
+	bool                         arena;
 	int                          z;
+	int                          i;
 
 	shift = max_check(shift, (unsigned) M0_BE_ALLOC_SHIFT_MIN);
 	M0_ASSERT_INFO(size <= (M0_BCOUNT_MAX - (1UL << shift)) / 2,
@@ -1036,53 +1815,64 @@ M0_INTERNAL void m0_be_alloc_aligned(struct m0_be_allocator *a,
 
 	m0_be_op_active(op);
 
-	m0_mutex_lock(&a->ba_lock);
-	M0_PRE_EX(m0_be_allocator__invariant(a));
-
 	/* algorithm starts here */
-	size_to_pick = (1UL << shift) - (1UL << M0_BE_ALLOC_SHIFT_MIN) +
-		       m0_align(size, 1UL << M0_BE_ALLOC_SHIFT_MIN);
-	for (z = 0; z < M0_BAP_NR; ++z) {
-		if ((zonemask & M0_BITS(z)) != 0)
-			c = m0_be_fl_pick(&a->ba_h[z]->bah_fl, size_to_pick);
-		if (c != NULL)
-			break;
+	if (be_alloc_slab_fits(a, size, shift, zonemask))
+		mem = be_alloc_slab_get(a, tx, size);
+	arena = mem == NULL && a->ba_arena_nr > 0 &&
+		zonemask == M0_BITS(M0_BAP_NORMAL) &&
+		size <= BE_ALLOC_ARENA_ALLOC_MAX;
+	if (arena) {
+		ztype = be_alloc_arena_here(a);
+		c = be_alloc_arena_get(a, ztype, tx, size, shift);
 	}
-	/* XXX If allocation fails then stats are updated for normal zone. */
-	ztype = c != NULL ? z : M0_BAP_NORMAL;
-	if (c != NULL) {
-		c = be_alloc_chunk_trysplit(a, ztype, tx, c, size, shift);
-		M0_ASSERT(c != NULL);
-		M0_ASSERT(c->bac_zone == ztype);
-		memset(&c->bac_mem, 0, size);
-		m0_be_tx_capture(tx, &M0_BE_REG(a->ba_seg, size, &c->bac_mem));
+	if (mem == NULL && c == NULL) {
+		be_alloc_lock(a, M0_BAP_NORMAL);
+		M0_PRE_EX(m0_be_allocator__invariant(a));
+		for (z = 0; z < M0_BAP_NR; ++z) {
+			if ((zonemask & M0_BITS(z)) != 0)
+				c = be_alloc_chunk_get(a, z, tx, size, shift);
+			if (c != NULL)
+				break;
+		}
+		ztype = c != NULL ? z : M0_BAP_NORMAL;
+		/*
+		 * unlock mutex after post-conditions which are using allocator
+		 * internals
+		 */
+		M0_POST_EX(m0_be_allocator__invariant(a));
+		be_alloc_unlock(a, M0_BAP_NORMAL);
 	}
-	*ptr = c == NULL ? NULL : &c->bac_mem;
-	be_allocator_stats_update(&a->ba_h[ztype]->bah_stats,
-				  c == NULL ? size : c->bac_size, true, c == 0);
-	be_allocator_stats_capture(a, ztype, tx);
-	/* and ends here */
-
-	M0_LOG(M0_DEBUG, "allocator=%p size=%"PRIu64" shift=%u "
-	       "c=%p c->bac_size=%"PRIu64" ptr=%p", a, size, shift, c,
-	       c == NULL ? 0 : c->bac_size, *ptr);
-	if (*ptr == NULL) {
+	/* The zone is full, other arenas may still have space. */
+	for (i = 1; arena && c == NULL && i < a->ba_arena_nr; ++i) {
+		ztype = M0_BAP_NR + (be_alloc_arena_here(a) - M0_BAP_NR + i) %
+			a->ba_arena_nr;
+		c = be_alloc_arena_get(a, ztype, tx, size, shift);
+	}
+	if (mem == NULL && c == NULL) {
+		ztype = M0_BAP_NORMAL;
+		be_alloc_lock(a, ztype);
+		/* XXX If allocation fails then stats are updated for normal
+		 * zone. */
+		be_allocator_stats_update(&a->ba_h[ztype]->bah_stats,
+					  size, true, true);
+		be_allocator_stats_capture(a, ztype, tx);
 		be_allocator_stats_print(&a->ba_h[ztype]->bah_stats);
-		M0_ASSERT(m0_be_allocator__invariant(a));
+		M0_POST_EX(m0_be_allocator__invariant(a));
+		be_alloc_unlock(a, ztype);
 	}
-
-	if (c != NULL) {
-		M0_POST(!c->bac_free);
-		M0_POST(c->bac_size >= size);
-		M0_POST(m0_addr_is_aligned(&c->bac_mem, shift));
-		M0_POST(be_alloc_chunk_is_in(a, ztype, c));
+	if (c != NULL)
+		mem = &c->bac_mem;
+	/* The memory belongs to the caller now, no need to hold the lock. */
+	if (mem != NULL) {
+		memset(mem, 0, size);
+		m0_be_tx_capture(tx, &M0_BE_REG(a->ba_seg, size, mem));
 	}
-	/*
-	 * unlock mutex after post-conditions which are using allocator
-	 * internals
-	 */
-	M0_POST_EX(m0_be_allocator__invariant(a));
-	m0_mutex_unlock(&a->ba_lock);
+	*ptr = mem;
+	/* and ends here */
+
+	M0_LOG(M0_DEBUG, "allocator=%p size=%"PRIu64" shift=%u zone=%d "
+	       "c=%p c->bac_size=%"PRIu64" ptr=%p", a, size, shift, ztype, c,
+	       c == NULL ? 0 : c->bac_size, *ptr);
 
 	/* set op state after post-conditions because they are using op */
 	m0_be_op_done(op);
@@ -1105,9 +1895,6 @@ M0_INTERNAL void m0_be_free_aligned(struct m0_be_allocator *a,
 {
 	enum m0_be_alloc_zone_type  ztype;
 	struct be_alloc_chunk      *c;
-	struct be_alloc_chunk      *prev;
-	struct be_alloc_chunk      *next;
-	bool		            chunks_were_merged;
 
 	M0_PRE(ptr != NULL);
 	M0_PRE(m0_reduce(z, M0_BAP_NR, 0,
@@ -1115,35 +1902,26 @@ M0_INTERNAL void m0_be_free_aligned(struct m0_be_allocator *a,
 
 	m0_be_op_active(op);
 
-	m0_mutex_lock(&a->ba_lock);
-	M0_PRE_EX(m0_be_allocator__invariant(a));
-
+	if (be_alloc_slab_is_in(a, ptr)) {
+		M0_LOG(M0_DEBUG, "allocator=%p slab ptr=%p", a, ptr);
+		be_alloc_slab_put(a, tx, ptr);
+		m0_be_op_done(op);
+		return;
+	}
 	c = be_alloc_chunk_addr(ptr);
-	M0_PRE(be_alloc_chunk_invariant(a, c));
-	M0_PRE(!c->bac_free);
+	/* Zone of a used chunk doesn't change, it's safe to read it here. */
 	ztype = c->bac_zone;
+	M0_PRE(ztype < M0_BAP_NR + a->ba_arena_nr);
+
+	be_alloc_lock(a, ztype);
+	M0_PRE_EX(be_alloc_zone_invariant(a, ztype));
 	M0_LOG(M0_DEBUG, "allocator=%p c=%p c->bac_size=%"PRIu64" zone=%d "
 			"data=%p", a, c, c->bac_size, c->bac_zone, &c->bac_mem);
 	/* algorithm starts here */
-	be_alloc_chunk_mark_free(a, ztype, tx, c);
-	/* update stats before c->bac_size gets modified due to merge */
-	be_allocator_stats_update(&a->ba_h[ztype]->bah_stats,
-			c->bac_size, false, false);
-	prev = be_alloc_chunk_prev(a, ztype, c);
-	next = be_alloc_chunk_next(a, ztype, c);
-	chunks_were_merged = be_alloc_chunk_trymerge(a, ztype, tx,
-			prev, c);
-	if (chunks_were_merged)
-		c = prev;
-	be_alloc_chunk_trymerge(a, ztype, tx, c, next);
-	be_allocator_stats_capture(a, ztype, tx);
+	be_alloc_chunk_put(a, ztype, tx, c);
 	/* and ends here */
-	M0_POST(c->bac_free);
-	M0_POST(c->bac_size > 0);
-	M0_POST(be_alloc_chunk_invariant(a, c));
-
-	M0_POST_EX(m0_be_allocator__invariant(a));
-	m0_mutex_unlock(&a->ba_lock);
+	M0_POST_EX(be_alloc_zone_invariant(a, ztype));
+	be_alloc_unlock(a, ztype);
 
 	m0_be_op_done(op);
 }
@@ -1156,13 +1934,64 @@ M0_INTERNAL void m0_be_free(struct m0_be_allocator *a,
 	m0_be_free_aligned(a, tx, op, ptr);
 }
 
+static void
+be_allocator_call_stats_add(struct m0_be_allocator_call_stats       *cs,
+			    const struct m0_be_allocator_call_stats *add)
+{
+#define ACS_ADD(field)							\
+	be_allocator_call_stat_update(&cs->field, add->field.bcs_nr,	\
+				      add->field.bcs_size)
+	ACS_ADD(bacs_alloc_success);
+	ACS_ADD(bacs_alloc_failure);
+	ACS_ADD(bacs_free);
+#undef ACS_ADD
+}
+
+/**
+ * Arenas are accounted in M0_BAP_NORMAL zone as used chunks, so their free
+ * space is moved back to free and their calls are added to the zone's ones.
+ */
+static void be_allocator_stats_add_arena(struct m0_be_allocator_stats       *s,
+					 const struct m0_be_allocator_stats *as)
+{
+	s->bas_space_used -= as->bas_space_free;
+	s->bas_space_free += as->bas_space_free;
+	be_allocator_call_stats_add(&s->bas_total, &as->bas_total);
+	be_allocator_call_stats_add(&s->bas_stat0, &as->bas_stat0);
+	be_allocator_call_stats_add(&s->bas_stat1, &as->bas_stat1);
+}
+
 M0_INTERNAL void m0_be_alloc_stats(struct m0_be_allocator *a,
 				   struct m0_be_allocator_stats *out)
 {
+	struct m0_be_allocator_stats arena;
+	m0_bcount_t                  slab_free;
+	int                          i;
+
 	m0_mutex_lock(&a->ba_lock);
 	M0_PRE_EX(m0_be_allocator__invariant(a));
 	*out = a->ba_h[M0_BAP_NORMAL]->bah_stats;
 	m0_mutex_unlock(&a->ba_lock);
+
+	for (i = 0; i < a->ba_arena_nr; ++i) {
+		m0_mutex_lock(&a->ba_arena_lock[i]);
+		arena = a->ba_h[M0_BAP_NR + i]->bah_stats;
+		m0_mutex_unlock(&a->ba_arena_lock[i]);
+		be_allocator_stats_add_arena(out, &arena);
+	}
+	if (a->ba_slab != NULL) {
+		/*
+		 * Only pages which were never used are counted as free, free
+		 * objects in used pages and pages in free list are not.
+		 */
+		m0_mutex_lock(&a->ba_slab_free_lock);
+		slab_free = (a->ba_slab->bsl_page_nr -
+			     a->ba_slab->bsl_page_used) *
+			    BE_ALLOC_SLAB_PAGE_SIZE;
+		m0_mutex_unlock(&a->ba_slab_free_lock);
+		out->bas_space_used -= slab_free;
+		out->bas_space_free += slab_free;
+	}
 }
 
 M0_INTERNAL void m0_be_alloc_stats_credit(struct m0_be_allocator *a,
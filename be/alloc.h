@@ -45,6 +45,53 @@ enum {
 	 * @see m0_be_alloc(), m0_be_allocator_credit().
 	 */
 	M0_BE_ALLOC_SHIFT_MIN  = 3,
+	/**
+	 * Maximum number of arenas carved from M0_BAP_NORMAL zone.
+	 * @see m0_be_allocator.ba_arena_nr.
+	 */
+	M0_BE_ALLOC_ARENA_NR   = 8,
+	/** Granularity of slab size classes, see be_alloc_slab. */
+	M0_BE_ALLOC_SLAB_CLASS_SHIFT = 4,
+	/** Number of slab size classes. */
+	M0_BE_ALLOC_SLAB_CLASS_NR    = 16,
+	/**
+	 * Default maximum size of objects allocated in slab pages.
+	 * It can't be larger than the largest size class.
+	 */
+	M0_BE_ALLOC_SLAB_OBJ_MAX     = 128,
+	/** Default percentage of M0_BAP_NORMAL zone given to slab region. */
+	M0_BE_ALLOC_SLAB_PERCENT     = 10,
+	/** Default percentage of M0_BAP_NORMAL zone given to arenas. */
+	M0_BE_ALLOC_ARENA_PERCENT    = 25,
+};
+
+/**
+ * Allocator parameters which are used by m0_be_allocator_create().
+ *
+ * They are stored in the segment on creation, so they can't be changed for
+ * an existing allocator. Zeroed structure gives an allocator without arenas
+ * and slab.
+ */
+struct m0_be_allocator_cfg {
+	/**
+	 * Percentage of M0_BAP_NORMAL zone given to arenas, 0 means no arenas.
+	 * Allocations larger than 1MB never go to arenas, so only the rest
+	 * of the zone is available to them.
+	 * m0_be_ut_backend_cfg_default() sets it to M0_BE_ALLOC_ARENA_PERCENT.
+	 */
+	uint32_t    bac_arena_percent;
+	/**
+	 * Percentage of M0_BAP_NORMAL zone given to slab region, 0 means no
+	 * slab. m0_be_ut_backend_cfg_default() sets it to
+	 * M0_BE_ALLOC_SLAB_PERCENT.
+	 */
+	uint32_t    bac_slab_percent;
+	/**
+	 * Objects up to this size are allocated in slab pages. It can't be
+	 * larger than the largest size class.
+	 * 0 means M0_BE_ALLOC_SLAB_OBJ_MAX.
+	 */
+	m0_bcount_t bac_slab_obj_max;
 };
 
 struct m0_be_allocator_call_stat {
@@ -127,6 +174,7 @@ struct m0_be_allocator_stats {
 } M0_XCA_RECORD M0_XCA_DOMAIN(be);
 
 struct m0_be_allocator_header;
+struct be_alloc_slab;
 
 /** @brief Allocator */
 struct m0_be_allocator {
@@ -141,10 +189,35 @@ struct m0_be_allocator {
 	 * (but not allocated memory).
 	 */
 	struct m0_mutex		       ba_lock;
-	/** Internal allocator data. It is stored inside the segment. */
-	struct m0_be_allocator_header *ba_h[M0_BAP_NR];
+	/** Number of arenas in the allocator, 0 if there are none. */
+	uint32_t                       ba_arena_nr;
+	/**
+	 * Per-arena locks. They protect lists and chunks of the arenas and
+	 * are taken instead of ba_lock for allocations inside arenas.
+	 */
+	struct m0_mutex                ba_arena_lock[M0_BE_ALLOC_ARENA_NR];
+	/** Slab region, NULL if there is none. It is stored in the segment. */
+	struct be_alloc_slab          *ba_slab;
+	/** Locks of slab size classes. */
+	struct m0_mutex                ba_slab_lock[M0_BE_ALLOC_SLAB_CLASS_NR];
+	/**
+	 * Lock of free slab pages. It is taken under the lock of a size
+	 * class.
+	 */
+	struct m0_mutex                ba_slab_free_lock;
+	/** Set by the user before m0_be_allocator_create(). */
+	struct m0_be_allocator_cfg     ba_cfg;
+	/**
+	 * Internal allocator data. It is stored inside the segment.
+	 * Zone headers are followed by arena headers.
+	 */
+	struct m0_be_allocator_header *ba_h[M0_BAP_NR + M0_BE_ALLOC_ARENA_NR];
 };
 
+/** Initialises allocator module: contention counters. */
+M0_INTERNAL int m0_be_alloc_mod_init(void);
+M0_INTERNAL void m0_be_alloc_mod_fini(void);
+
 /**
  * Initialize allocator structure.
  *
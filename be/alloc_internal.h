@@ -111,6 +111,100 @@ struct m0_be_allocator_header {
 	void			     *bah_addr;		/**< memory address */
 } M0_XCA_RECORD M0_XCA_DOMAIN(be);
 
+/**
+ * @brief Allocator arena.
+ *
+ * - resides in the user data of a chunk of M0_BAP_NORMAL zone;
+ * - arena chunks are allocated in m0_be_allocator_create() and freed in
+ *   m0_be_allocator_destroy(), they are recorded in be_alloc_index;
+ * - arena space follows the arena in the chunk.
+ */
+struct be_alloc_arena {
+	/** M0_BE_ALLOC_ARENA_MAGIC */
+	uint64_t                      baa_magic;
+	/** Index of the arena. */
+	uint64_t                      baa_index;
+	/** Header of arena space. */
+	struct m0_be_allocator_header baa_h;
+} M0_XCA_RECORD M0_XCA_DOMAIN(be);
+
+enum {
+	/** Size of a slab page. */
+	BE_ALLOC_SLAB_PAGE_SHIFT = 12,
+	BE_ALLOC_SLAB_PAGE_SIZE  = 1 << BE_ALLOC_SLAB_PAGE_SHIFT,
+	/** Number of words in the bitmap of a slab page. */
+	BE_ALLOC_SLAB_MAP_NR     = (BE_ALLOC_SLAB_PAGE_SIZE >>
+				    M0_BE_ALLOC_SLAB_CLASS_SHIFT) / 64,
+};
+
+/**
+ * @brief Slab page.
+ *
+ * - resides at the beginning of a page of slab region;
+ * - objects of one size class follow the header;
+ * - pages of a size class are in be_alloc_slab::bsl_class list, pages with
+ *   free objects before the full ones;
+ * - unused pages are in be_alloc_slab::bsl_free list or were never used, see
+ *   be_alloc_slab::bsl_page_used.
+ */
+struct be_alloc_slab_page {
+	/** M0_BE_ALLOC_SLAB_PAGE_MAGIC */
+	uint64_t               bsp_magic;
+	/** for be_alloc_slab::bsl_class[] and be_alloc_slab::bsl_free lists */
+	struct m0_be_list_link bsp_linkage;
+	/** magic for bsp_linkage */
+	uint64_t               bsp_link_magic;
+	/** size class index */
+	uint32_t               bsp_class;
+	/** number of free objects */
+	uint32_t               bsp_free;
+	/** bitmap of used objects */
+	uint64_t               bsp_map[BE_ALLOC_SLAB_MAP_NR];
+} M0_XCA_RECORD M0_XCA_DOMAIN(be);
+
+/**
+ * @brief Slab region.
+ *
+ * - resides in the user data of a chunk of M0_BAP_NORMAL zone, which is
+ *   recorded in be_alloc_index;
+ * - slab pages follow the region header, aligned on page size.
+ */
+struct be_alloc_slab {
+	/** M0_BE_ALLOC_SLAB_MAGIC */
+	uint64_t          bsl_magic;
+	/** objects up to this size are allocated in slab pages */
+	m0_bcount_t       bsl_obj_max;
+	/** address of the first page */
+	void             *bsl_pages;
+	/** number of pages */
+	uint64_t          bsl_page_nr;
+	/** pages with larger indices have never been used */
+	uint64_t          bsl_page_used;
+	/** free pages */
+	struct m0_be_list bsl_free;
+	/** pages of size classes */
+	struct m0_be_list bsl_class[M0_BE_ALLOC_SLAB_CLASS_NR];
+} M0_XCA_RECORD M0_XCA_DOMAIN(be);
+
+/**
+ * @brief Allocator index.
+ *
+ * - resides in the user data of the first chunk of M0_BAP_NORMAL zone, it is
+ *   allocated in m0_be_allocator_create() before arenas and slab region;
+ * - records where arenas and slab region are, so m0_be_allocator_init()
+ *   doesn't need to look for them.
+ */
+struct be_alloc_index {
+	/** M0_BE_ALLOC_INDEX_MAGIC */
+	uint64_t               bai_magic;
+	/** number of arenas */
+	uint64_t               bai_arena_nr;
+	/** arenas, in the order of their indices */
+	struct be_alloc_arena *bai_arena[M0_BE_ALLOC_ARENA_NR];
+	/** slab region, NULL if there is none */
+	struct be_alloc_slab  *bai_slab;
+} M0_XCA_RECORD M0_XCA_DOMAIN(be);
+
 /** @} end of be group */
 
 #endif /* __MOTR_BE_ALLOC_INTERNAL_H__ */
@@ -28,6 +28,7 @@
 #include "be/tx_group_fom.h"    /* m0_be_tx_group_fom_mod_init */
 #include "be/tx_internal.h"     /* m0_be_tx_mod_init */
 #include "be/btree.h"           /* m0_be_fid_type */
+#include "be/alloc.h"           /* m0_be_alloc_mod_init */
 
 /**
  * @addtogroup be
@@ -150,13 +151,16 @@
 M0_INTERNAL int m0_backend_init(void)
 {
 	m0_fid_type_register(&m0_btree_fid_type);
-	return m0_be_tx_mod_init() ?: (m0_be_tx_group_fom_mod_init(), 0);
+	return m0_be_btree_mod_init() ?: m0_be_alloc_mod_init() ?:
+		m0_be_tx_mod_init() ?: (m0_be_tx_group_fom_mod_init(), 0);
 }
 
 M0_INTERNAL void m0_backend_fini(void)
 {
 	m0_be_tx_group_fom_mod_fini();
 	m0_be_tx_mod_fini();
+	m0_be_alloc_mod_fini();
+	m0_be_btree_mod_fini();
 	m0_fid_type_unregister(&m0_btree_fid_type);
 }
 
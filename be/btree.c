@@ -32,6 +32,9 @@
 #include "lib/errno.h"
 #include "lib/finject.h"       /* M0_FI_ENABLED() */
 #include "lib/misc.h"          /* offsetof */
+#include "lib/cond.h"          /* m0_cond */
+#include "lib/hash.h"          /* m0_hash */
+#include "lib/memory.h"        /* M0_ALLOC_ARR */
 #include "be/alloc.h"
 #include "be/btree.h"
 #include "be/btree_internal.h" /* m0_be_bnode */
@@ -41,6 +44,10 @@
 /* btree constants */
 enum {
 	BTREE_ALLOC_SHIFT = 0,
+	/** Number of subtree locks of a tree. */
+	BTREE_SUBTREE_LOCK_NR = 16,
+	/** Number of buckets in the registry of subtree locks. */
+	BTREE_SUBLOCKS_BUCKET_NR = 1024,
 };
 
 enum btree_save_optype {
@@ -54,6 +61,115 @@ struct btree_node_pos {
 	unsigned int        bnp_index;
 };
 
+/**
+ * Volatile locks of the subtrees of root children of a tree.
+ *
+ * A child with index i in the root array is protected by
+ * bsl_lock[i % BTREE_SUBTREE_LOCK_NR].
+ *
+ * The locks are not part of struct m0_be_btree, which is stored in segments:
+ * they are kept in a registry, keyed by the tree address (see
+ * btree_sublocks()).
+ *
+ * @see btree_subtree_lock(), btree_shared_lock()
+ */
+struct m0_be_btree_sublocks {
+	/** The tree these locks belong to, registry key. */
+	struct m0_be_btree *bsl_tree;
+	struct m0_rwlock    bsl_lock[BTREE_SUBTREE_LOCK_NR];
+	/** Linkage into btree_sublocks_registry. */
+	struct m0_hlink     bsl_hlink;
+	uint64_t            bsl_magic;
+};
+
+static uint64_t btree_sublocks_hash(const struct m0_htable *htable,
+				    const void             *key)
+{
+	const struct m0_be_btree *tree = *(const struct m0_be_btree **)key;
+
+	return m0_hash((uint64_t)tree) % htable->h_bucket_nr;
+}
+
+static bool btree_sublocks_key_eq(const void *key1, const void *key2)
+{
+	return *(const struct m0_be_btree **)key1 ==
+	       *(const struct m0_be_btree **)key2;
+}
+
+M0_HT_DESCR_DEFINE(btree_sublocks, "btree subtree locks", static,
+		   struct m0_be_btree_sublocks, bsl_hlink, bsl_magic,
+		   M0_BE_BTREE_SUBLOCKS_MAGIC, M0_BE_BTREE_SUBLOCKS_HEAD_MAGIC,
+		   bsl_tree, btree_sublocks_hash, btree_sublocks_key_eq);
+M0_HT_DEFINE(btree_sublocks, static, struct m0_be_btree_sublocks,
+	     struct m0_be_btree *);
+
+/** Subtree locks of all initialised trees, see m0_be_btree_mod_init(). */
+static struct m0_htable btree_sublocks_registry;
+static bool             btree_sublocks_registry_on = false;
+
+M0_INTERNAL int m0_be_btree_mod_init(void)
+{
+	int rc;
+
+	rc = btree_sublocks_htable_init(&btree_sublocks_registry,
+					BTREE_SUBLOCKS_BUCKET_NR);
+	btree_sublocks_registry_on = rc == 0;
+	return M0_RC(rc);
+}
+
+M0_INTERNAL void m0_be_btree_mod_fini(void)
+{
+	if (btree_sublocks_registry_on) {
+		btree_sublocks_registry_on = false;
+		btree_sublocks_htable_fini(&btree_sublocks_registry);
+	}
+}
+
+/**
+ * Returns subtree locks of @tree or NULL, if the tree has none: the module
+ * is not initialised or m0_be_btree_init() failed to allocate them.
+ */
+static struct m0_be_btree_sublocks *btree_sublocks(struct m0_be_btree *tree)
+{
+	const struct m0_be_btree *key = tree;
+
+	return btree_sublocks_registry_on ?
+		btree_sublocks_htable_cc_lookup(&btree_sublocks_registry,
+						&key) : NULL;
+}
+
+static void btree_sublocks_register(struct m0_be_btree *tree)
+{
+	struct m0_be_btree_sublocks *sl;
+	int                          i;
+
+	/* m0_be_btree_init() may be called again for an initialised tree. */
+	if (!btree_sublocks_registry_on || btree_sublocks(tree) != NULL)
+		return;
+	M0_ALLOC_PTR(sl);
+	if (sl == NULL)
+		return;
+	sl->bsl_tree = tree;
+	for (i = 0; i < ARRAY_SIZE(sl->bsl_lock); ++i)
+		m0_rwlock_init(&sl->bsl_lock[i]);
+	btree_sublocks_tlink_init(sl);
+	btree_sublocks_htable_cc_add(&btree_sublocks_registry, sl);
+}
+
+static void btree_sublocks_unregister(struct m0_be_btree *tree)
+{
+	struct m0_be_btree_sublocks *sl = btree_sublocks(tree);
+	int                          i;
+
+	if (sl == NULL)
+		return;
+	btree_sublocks_htable_cc_del(&btree_sublocks_registry, sl);
+	btree_sublocks_tlink_fini(sl);
+	for (i = 0; i < ARRAY_SIZE(sl->bsl_lock); ++i)
+		m0_rwlock_fini(&sl->bsl_lock[i]);
+	m0_free(sl);
+}
+
 M0_INTERNAL const struct m0_fid_type m0_btree_fid_type = {
 	.ft_id   = 'b',
 	.ft_name = "btree fid",
@@ -64,6 +180,9 @@ static struct m0_rwlock *btree_rwlock(struct m0_be_btree *tree);
 
 static struct be_btree_key_val *be_btree_search(struct m0_be_btree *btree,
 						void *key);
+static struct be_btree_key_val *be_btree_subtree_search(struct m0_be_btree *btree,
+							struct m0_be_bnode *top,
+							void               *key);
 
 static void btree_root_set(struct m0_be_btree *btree,
 			   struct m0_be_bnode *new_root)
@@ -183,6 +302,155 @@ static inline int key_eq(const struct m0_be_btree *btree,
 {
 	return be_btree_compare(btree, key0, key1) ==  0;
 }
+
+static uint64_t be_btree_key_prefix(const struct m0_be_btree *btree,
+				    const void *key)
+{
+	return btree->bb_ops->ko_key_prefix(key);
+}
+
+static uint32_t btree_node_version(const struct m0_be_bnode *node)
+{
+	struct m0_format_tag tag;
+
+	m0_format_header_unpack(&tag, &node->bt_header);
+	return tag.ot_version;
+}
+
+/**
+ * Returns the size of a node allocated for @btree. Credits of a tree without
+ * operations vector are calculated for the larger format.
+ */
+static m0_bcount_t btree_node_size(const struct m0_be_btree *btree)
+{
+	return sizeof(struct m0_be_bnode) +
+		(btree->bb_ops == NULL || btree->bb_ops->ko_key_prefix != NULL ?
+		 sizeof(struct m0_be_bnode_pfx) : 0);
+}
+
+/**
+ * Returns key prefixes of @node, or NULL if @node has format version 1 or
+ * @btree does not use key prefixes.
+ */
+static struct m0_be_bnode_pfx *btree_node_pfx(const struct m0_be_btree *btree,
+					      const struct m0_be_bnode *node)
+{
+	return btree->bb_ops->ko_key_prefix != NULL &&
+	       btree_node_version(node) == M0_BE_BNODE_FORMAT_VERSION_2 ?
+		(struct m0_be_bnode_pfx *)(node + 1) : NULL;
+}
+
+/** Returns the footer, which m0_be_bnode::bt_header points to. */
+static struct m0_format_footer *btree_node_footer(struct m0_be_bnode *node)
+{
+	return btree_node_version(node) == M0_BE_BNODE_FORMAT_VERSION_2 ?
+		&((struct m0_be_bnode_pfx *)(node + 1))->bp_footer :
+		&node->bt_footer;
+}
+
+/**
+ * Sets record @index of @node to @kv.
+ *
+ * Records of a node are modified only by this function, btree_node_kv_copy()
+ * and btree_node_kv_open(), which keep key prefixes in sync with the keys.
+ */
+static void btree_node_kv_set(const struct m0_be_btree      *btree,
+			      struct m0_be_bnode            *node,
+			      unsigned int                   index,
+			      const struct be_btree_key_val *kv)
+{
+	struct m0_be_bnode_pfx *pfx = btree_node_pfx(btree, node);
+
+	node->bt_kv_arr[index] = *kv;
+	if (pfx != NULL)
+		pfx->bp_prefix[index] = be_btree_key_prefix(btree,
+							    kv->btree_key);
+}
+
+/** Copies record @sidx of @src to record @didx of @dst. */
+static void btree_node_kv_copy(const struct m0_be_btree *btree,
+			       struct m0_be_bnode       *dst,
+			       unsigned int              didx,
+			       const struct m0_be_bnode *src,
+			       unsigned int              sidx)
+{
+	struct m0_be_bnode_pfx *dpfx = btree_node_pfx(btree, dst);
+	struct m0_be_bnode_pfx *spfx = btree_node_pfx(btree, src);
+	const void             *key  = src->bt_kv_arr[sidx].btree_key;
+
+	dst->bt_kv_arr[didx] = src->bt_kv_arr[sidx];
+	/* @src has format version 1 while the tree is being converted. */
+	if (dpfx != NULL)
+		dpfx->bp_prefix[didx] = spfx != NULL ? spfx->bp_prefix[sidx] :
+					be_btree_key_prefix(btree, key);
+}
+
+/** Moves records [index, bt_num_active_key) of @node one slot right. */
+static void btree_node_kv_open(const struct m0_be_btree *btree,
+			       struct m0_be_bnode       *node,
+			       unsigned int              index)
+{
+	struct m0_be_bnode_pfx *pfx = btree_node_pfx(btree, node);
+	unsigned int            nr  = node->bt_num_active_key - index;
+
+	M0_PRE(node->bt_num_active_key < KV_NR);
+	memmove(&node->bt_kv_arr[index + 1], &node->bt_kv_arr[index],
+		nr * sizeof node->bt_kv_arr[0]);
+	if (pfx != NULL)
+		memmove(&pfx->bp_prefix[index + 1], &pfx->bp_prefix[index],
+			nr * sizeof pfx->bp_prefix[0]);
+}
+
+/**
+ * Looks up @key among the keys of @node using binary search.
+ *
+ * Keys are not stored in the node itself, so every comparison dereferences a
+ * pointer into the segment.  Binary search touches O(log(KV_NR)) keys per node
+ * instead of up to KV_NR keys touched by a linear scan.
+ *
+ * A node of format version 2 keeps the prefixes of its keys inline (see
+ * m0_be_bnode_pfx). They are compared first, and a key is dereferenced only
+ * when its prefix is equal to the prefix of @key.
+ *
+ * @param found set to true iff the key at the returned index is equal to @key.
+ * @return the index of the first key in @node which is not less than @key,
+ *         or node->bt_num_active_key if all keys in @node are less than @key.
+ */
+static unsigned int be_btree_node_search(const struct m0_be_btree *btree,
+					 const struct m0_be_bnode *node,
+					 const void               *key,
+					 bool                     *found)
+{
+	const struct m0_be_bnode_pfx *pfx = btree_node_pfx(btree, node);
+	uint64_t                      prefix = 0;
+	unsigned int                  lo = 0;
+	unsigned int                  hi = node->bt_num_active_key;
+	unsigned int                  mid;
+	int                           diff;
+
+	if (pfx != NULL)
+		prefix = be_btree_key_prefix(btree, key);
+	*found = false;
+	while (lo < hi) {
+		mid  = lo + (hi - lo) / 2;
+		if (pfx != NULL && pfx->bp_prefix[mid] != prefix)
+			diff = prefix < pfx->bp_prefix[mid] ? -1 : 1;
+		else if (pfx != NULL && btree->bb_ops->ko_key_prefix_is_key)
+			diff = 0;
+		else
+			diff = be_btree_compare(btree, key,
+						node->bt_kv_arr[mid].btree_key);
+		if (diff == 0) {
+			*found = true;
+			return mid;
+		}
+		if (diff > 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
 
 /* ------------------------------------------------------------------
  * Btree internals implementation
@@ -208,6 +476,10 @@ static struct btree_node_pos be_btree_get_btree_node(
 					struct m0_be_btree_cursor *it,
 					const void *key, bool slant);
 
+static struct btree_node_pos be_btree_node_get(struct m0_be_btree_cursor *it,
+					       struct m0_be_bnode        *top,
+					       const void *key, bool slant);
+
 static void be_btree_delete_key_from_node(struct m0_be_btree *tree,
 					  struct m0_be_tx *tx,
 					  struct btree_node_pos *node_pos);
@@ -294,7 +566,13 @@ static bool btree_node_invariant(const struct m0_be_btree *btree,
 		_0C(ergo(node->bt_num_active_key > 1,
 			 m0_forall(i, node->bt_num_active_key - 1,
 				   key_gt(btree, node->bt_kv_arr[i+1].btree_key,
-					  node->bt_kv_arr[i].btree_key))));
+					  node->bt_kv_arr[i].btree_key)))) &&
+		/* Key prefixes match the keys. */
+		_0C(ergo(btree_node_pfx(btree, node) != NULL,
+			 m0_forall(i, node->bt_num_active_key,
+				   btree_node_pfx(btree, node)->bp_prefix[i] ==
+				   be_btree_key_prefix(btree, node->bt_kv_arr[i].
+						       btree_key))));
 }
 
 /* ------------------------------------------------------------------
@@ -345,6 +623,8 @@ static void btree_node_update(struct m0_be_bnode       *node,
 			      const struct m0_be_btree *btree,
 			      struct m0_be_tx          *tx)
 {
+	struct m0_be_bnode_pfx *pfx = btree_node_pfx(btree, node);
+
 	mem_update(btree, tx, node, offsetof(struct m0_be_bnode, bt_kv_arr));
 
 	if (node->bt_num_active_key > 0) {
@@ -353,9 +633,14 @@ static void btree_node_update(struct m0_be_bnode       *node,
 		mem_update(btree, tx, node->bt_child_arr,
 			   sizeof(*node->bt_child_arr) *
 			   (node->bt_num_active_key + 1));
+		if (pfx != NULL)
+			mem_update(btree, tx, pfx->bp_prefix,
+				   sizeof(*pfx->bp_prefix) *
+				   node->bt_num_active_key);
 	}
 
-	mem_update(btree, tx, &node->bt_footer, sizeof(node->bt_footer));
+	mem_update(btree, tx, btree_node_footer(node),
+		   sizeof(struct m0_format_footer));
 }
 
 static void btree_node_keyval_update(struct m0_be_bnode       *node,
@@ -363,10 +648,16 @@ static void btree_node_keyval_update(struct m0_be_bnode       *node,
 				     struct m0_be_tx          *tx,
 				     unsigned int              index)
 {
+	struct m0_be_bnode_pfx *pfx = btree_node_pfx(btree, node);
+
 	m0_format_footer_update(node);
 	mem_update(btree, tx, &node->bt_kv_arr[index],
 			   sizeof node->bt_kv_arr[index]);
-	mem_update(btree, tx, &node->bt_footer, sizeof node->bt_footer);
+	if (pfx != NULL)
+		mem_update(btree, tx, &pfx->bp_prefix[index],
+			   sizeof pfx->bp_prefix[index]);
+	mem_update(btree, tx, btree_node_footer(node),
+		   sizeof(struct m0_format_footer));
 }
 
 /**
@@ -406,6 +697,9 @@ static void be_btree_set_node_params(struct m0_be_bnode *p_node,
 /**
  * This function is used to allocate memory for the btree node
  *
+ * The node has format version 2 if the tree defines key prefixes, and version 1
+ * otherwise.
+ *
  * @param btree the btree node to which the node is to be allocated
  * @param tx    the pointer to tx
  * @return      the allocated btree node
@@ -414,17 +708,21 @@ static struct m0_be_bnode *
 be_btree_node_alloc(const struct m0_be_btree *btree, struct m0_be_tx *tx)
 {
 	struct m0_be_bnode *node;
+	m0_bcount_t         size = btree_node_size(btree);
+	bool                v2 = size > sizeof *node;
 
 	/*  Allocate memory for the node */
-	node = (struct m0_be_bnode *)mem_alloc(btree, tx,
-					       sizeof(struct m0_be_bnode),
+	node = (struct m0_be_bnode *)mem_alloc(btree, tx, size,
 					       M0_BITS(M0_BAP_NORMAL));
 	M0_ASSERT(node != NULL);	/* @todo: analyse return code */
 
 	m0_format_header_pack(&node->bt_header, &(struct m0_format_tag){
-		.ot_version = M0_BE_BNODE_FORMAT_VERSION,
+		.ot_version = v2 ? M0_BE_BNODE_FORMAT_VERSION_2 :
+				   M0_BE_BNODE_FORMAT_VERSION,
 		.ot_type    = M0_FORMAT_TYPE_BE_BNODE,
-		.ot_footer_offset = offsetof(struct m0_be_bnode, bt_footer)
+		.ot_footer_offset = v2 ? sizeof *node +
+				    offsetof(struct m0_be_bnode_pfx, bp_footer) :
+				    offsetof(struct m0_be_bnode, bt_footer)
 	});
 
 	be_btree_set_node_params(node, 0, 0, true);
@@ -432,7 +730,7 @@ be_btree_node_alloc(const struct m0_be_btree *btree, struct m0_be_tx *tx)
 	node->bt_backlink = btree->bb_backlink;
 
 	m0_format_footer_update(node);
-	mem_update(btree, tx, node, sizeof *node);
+	mem_update(btree, tx, node, size);
 
 	return node;
 }
@@ -475,7 +773,8 @@ static void be_btree_split_child(struct m0_be_btree *btree,
 	/* Copy the latter half keys from the current child to the new child */
 	i = 0;
 	while (i < new_child->bt_num_active_key) {
-		new_child->bt_kv_arr[i] = child->bt_kv_arr[i + BTREE_FAN_OUT];
+		btree_node_kv_copy(btree, new_child, i,
+				   child, i + BTREE_FAN_OUT);
 		i++;
 	}
 
@@ -500,12 +799,12 @@ static void be_btree_split_child(struct m0_be_btree *btree,
 	/* In the parent node's arr, make space for the new child */
 	for (i = parent->bt_num_active_key + 1; i > index + 1; i--) {
 		parent->bt_child_arr[i] = parent->bt_child_arr[i - 1];
-		parent->bt_kv_arr[i - 1] = parent->bt_kv_arr[i - 2];
+		btree_node_kv_copy(btree, parent, i - 1, parent, i - 2);
 	}
 
 	/*  Update parent */
 	parent->bt_child_arr[index + 1] = new_child;
-	parent->bt_kv_arr[index] = child->bt_kv_arr[BTREE_FAN_OUT - 1];
+	btree_node_kv_copy(btree, parent, index, child, BTREE_FAN_OUT - 1);
 	parent->bt_num_active_key++;
 
 	/* re-calculate checksum after all fields has been updated */
@@ -531,15 +830,14 @@ static void be_btree_insert_into_nonfull(struct m0_be_btree      *btree,
 					 struct m0_be_bnode      *node,
 					 struct be_btree_key_val *kv)
 {
-	void *key = kv->btree_key;
-	int i = node->bt_num_active_key - 1;
+	void         *key = kv->btree_key;
+	unsigned int  i;
+	bool          found;
 
 	while (!node->bt_isleaf)
 	{
-		while (i >= 0 &&
-		       key_lt(btree, key, node->bt_kv_arr[i].btree_key))
-			i--;
-		i++;
+		i = be_btree_node_search(btree, node, key, &found);
+		M0_ASSERT(!found);
 
 		if (node->bt_child_arr[i]->bt_num_active_key == KV_NR) {
 			be_btree_split_child(btree, tx, node, i);
@@ -547,15 +845,12 @@ static void be_btree_insert_into_nonfull(struct m0_be_btree      *btree,
 				i++;
 		}
 		node = node->bt_child_arr[i];
-		i = node->bt_num_active_key - 1;
 	}
 
-	while (i >= 0 &&
-	       key_lt(btree, key, node->bt_kv_arr[i].btree_key)) {
-		node->bt_kv_arr[i + 1] = node->bt_kv_arr[i];
-		i--;
-	}
-	node->bt_kv_arr[i + 1] = *kv;
+	i = be_btree_node_search(btree, node, key, &found);
+	M0_ASSERT(!found);
+	btree_node_kv_open(btree, node, i);
+	btree_node_kv_set(btree, node, i, kv);
 	node->bt_num_active_key++;
 
 	m0_format_footer_update(node);
@@ -608,6 +903,28 @@ static void be_btree_insert_newkey(struct m0_be_btree      *btree,
 	M0_POST_EX(btree_node_subtree_invariant(btree, btree->bb_root));
 }
 
+/**
+ * Inserts @kv entry into the subtree rooted at non-full, non-root node @top.
+ *
+ * Only @top and its descendants are modified, see btree_subtree_lock().
+ */
+static void be_btree_subtree_insert(struct m0_be_btree      *btree,
+				    struct m0_be_tx         *tx,
+				    struct m0_be_bnode      *top,
+				    struct be_btree_key_val *kv)
+{
+	M0_PRE(top != btree->bb_root);
+	M0_PRE(top->bt_num_active_key < KV_NR);
+	M0_PRE(btree_node_invariant(btree, top, false));
+	M0_PRE_EX(btree_node_subtree_invariant(btree, top));
+	M0_PRE_EX(be_btree_subtree_search(btree, top, kv->btree_key) == NULL);
+
+	be_btree_insert_into_nonfull(btree, tx, top, kv);
+
+	M0_POST(btree_node_invariant(btree, top, false));
+	M0_POST_EX(btree_node_subtree_invariant(btree, top));
+}
+
 /**
 *   Get maxinimum key position in btree.
 *
@@ -645,7 +962,8 @@ static void be_btree_get_min_key_pos(struct m0_be_bnode    *node,
 	pos->bnp_index = 0;
 }
 
-static void be_btree_shift_key_vals(struct m0_be_bnode *dest,
+static void be_btree_shift_key_vals(struct m0_be_btree *tree,
+				    struct m0_be_bnode *dest,
 				    struct m0_be_bnode *src,
 				    unsigned int        start_index,
 				    unsigned int        key_src_offset,
@@ -657,8 +975,8 @@ static void be_btree_shift_key_vals(struct m0_be_bnode *dest,
 	unsigned int i = start_index;
 	while (i < stop_index)
 	{
-		dest->bt_kv_arr[i + key_dest_offset] =
-					src->bt_kv_arr[i + key_src_offset];
+		btree_node_kv_copy(tree, dest, i + key_dest_offset,
+				   src, i + key_src_offset);
 		dest->bt_child_arr[i + child_dest_offset ] =
 				src->bt_child_arr[i + child_src_offset];
 		++i;
@@ -693,11 +1011,13 @@ be_btree_merge_siblings(struct m0_be_tx    *tx,
 	node1 = parent->bt_child_arr[idx];
 	node2 = parent->bt_child_arr[idx + 1];
 
-	node1->bt_kv_arr[node1->bt_num_active_key++] = parent->bt_kv_arr[idx];
+	btree_node_kv_copy(tree, node1, node1->bt_num_active_key++,
+			   parent, idx);
 
 	M0_ASSERT(node1->bt_num_active_key + node2->bt_num_active_key <= KV_NR);
 
-	be_btree_shift_key_vals(node1, node2, 0, 0, node1->bt_num_active_key, 0,
+	be_btree_shift_key_vals(tree, node1, node2, 0, 0,
+				node1->bt_num_active_key, 0,
 				node1->bt_num_active_key,
 				node2->bt_num_active_key);
 
@@ -709,7 +1029,7 @@ be_btree_merge_siblings(struct m0_be_tx    *tx,
 	m0_format_footer_update(node1);
 
 	/* update parent */
-	be_btree_shift_key_vals(parent, parent, idx, 1, 0, 2, 1,
+	be_btree_shift_key_vals(tree, parent, parent, idx, 1, 0, 2, 1,
 				parent->bt_num_active_key - 1);
 
 	parent->bt_num_active_key--;
@@ -734,7 +1054,8 @@ be_btree_merge_siblings(struct m0_be_tx    *tx,
 }
 
 
-static void be_btree_move_parent_key_to_right_child(struct m0_be_bnode *parent,
+static void be_btree_move_parent_key_to_right_child(struct m0_be_btree *tree,
+						    struct m0_be_bnode *parent,
 						    struct m0_be_bnode *lch,
 						    struct m0_be_bnode *rch,
 						    unsigned int        idx)
@@ -742,37 +1063,37 @@ static void be_btree_move_parent_key_to_right_child(struct m0_be_bnode *parent,
 	unsigned int i = rch->bt_num_active_key;
 
 	while (i > 0) {
-		rch->bt_kv_arr[i] = rch->bt_kv_arr[i - 1];
+		btree_node_kv_copy(tree, rch, i, rch, i - 1);
 		rch->bt_child_arr[i + 1] = rch->bt_child_arr[i];
 		--i;
 	}
 	rch->bt_child_arr[1] = rch->bt_child_arr[0];
-	rch->bt_kv_arr[0] = parent->bt_kv_arr[idx];
+	btree_node_kv_copy(tree, rch, 0, parent, idx);
 	rch->bt_child_arr[0] =
 			lch->bt_child_arr[lch->bt_num_active_key];
 	lch->bt_child_arr[lch->bt_num_active_key] = NULL;
-	parent->bt_kv_arr[idx] =
-			lch->bt_kv_arr[lch->bt_num_active_key-1];
+	btree_node_kv_copy(tree, parent, idx,
+			   lch, lch->bt_num_active_key - 1);
 	lch->bt_num_active_key--;
 	rch->bt_num_active_key++;
 }
 
-static void be_btree_move_parent_key_to_left_child(struct m0_be_bnode *parent,
+static void be_btree_move_parent_key_to_left_child(struct m0_be_btree *tree,
+						   struct m0_be_bnode *parent,
 						   struct m0_be_bnode *lch,
 						   struct m0_be_bnode *rch,
 						   unsigned int        idx)
 {
 	unsigned int i;
 
-	lch->bt_kv_arr[lch->bt_num_active_key] =
-					parent->bt_kv_arr[idx];
+	btree_node_kv_copy(tree, lch, lch->bt_num_active_key, parent, idx);
 	lch->bt_child_arr[lch->bt_num_active_key + 1] =
 					rch->bt_child_arr[0];
 	lch->bt_num_active_key++;
-	parent->bt_kv_arr[idx] = rch->bt_kv_arr[0];
+	btree_node_kv_copy(tree, parent, idx, rch, 0);
 	i = 0;
 	while (i < rch->bt_num_active_key - 1) {
-		rch->bt_kv_arr[i] = rch->bt_kv_arr[i + 1];
+		btree_node_kv_copy(tree, rch, i, rch, i + 1);
 		rch->bt_child_arr[i] = rch->bt_child_arr[i + 1];
 		++i;
 	}
@@ -810,9 +1131,11 @@ static void be_btree_move_parent_key(struct m0_be_btree	  *tree,
 	rch = parent->bt_child_arr[idx + 1];
 
 	if (pos == P_LEFT)
-		be_btree_move_parent_key_to_left_child(parent, lch, rch, idx);
+		be_btree_move_parent_key_to_left_child(tree, parent,
+						       lch, rch, idx);
 	else
-		be_btree_move_parent_key_to_right_child(parent, lch, rch, idx);
+		be_btree_move_parent_key_to_right_child(tree, parent,
+							lch, rch, idx);
 
 	/* re-calculate checksum after all fields has been updated */
 	m0_format_footer_update(lch);
@@ -841,6 +1164,7 @@ void be_btree_delete_key_from_node(struct m0_be_btree	 *tree,
 				   struct btree_node_pos *bnode_pos)
 {
 	struct 		m0_be_bnode *bnode = bnode_pos->bnp_node;
+	struct		m0_be_bnode_pfx *pfx = btree_node_pfx(tree, bnode);
 	unsigned int 	idx;
 
 	if (bnode->bt_isleaf) {
@@ -849,7 +1173,7 @@ void be_btree_delete_key_from_node(struct m0_be_btree	 *tree,
 		btree_pair_release(tree, tx, &bnode->bt_kv_arr[idx]);
 
 		while (idx < bnode->bt_num_active_key - 1) {
-			bnode->bt_kv_arr[idx] = bnode->bt_kv_arr[idx+1];
+			btree_node_kv_copy(tree, bnode, idx, bnode, idx + 1);
 			++idx;
 		}
 		/*
@@ -863,6 +1187,11 @@ void be_btree_delete_key_from_node(struct m0_be_btree	 *tree,
 				   &bnode->bt_kv_arr[bnode_pos->bnp_index],
 				   sizeof
 				   bnode->bt_kv_arr[bnode_pos->bnp_index]);
+			if (pfx != NULL)
+				mem_update(tree, tx,
+					   &pfx->bp_prefix[bnode_pos->bnp_index],
+					   sizeof
+					   pfx->bp_prefix[bnode_pos->bnp_index]);
 		}
 
 		bnode->bt_num_active_key--;
@@ -885,12 +1214,15 @@ static void btree_node_child_delete(struct m0_be_btree    *btree,
 				    struct btree_node_pos *child,
 				    bool		   left)
 {
+	struct be_btree_key_val kv = node->bt_kv_arr[index];
+
 	M0_ASSERT(child->bnp_node->bt_isleaf);
 	M0_LOG(M0_DEBUG, "swap%s with n=%p i=%d", left ? "L" : "R",
 						  child->bnp_node,
 						  child->bnp_index);
-	M0_SWAP(child->bnp_node->bt_kv_arr[child->bnp_index],
-		node->bt_kv_arr[index]);
+	btree_node_kv_copy(btree, node, index,
+			   child->bnp_node, child->bnp_index);
+	btree_node_kv_set(btree, child->bnp_node, child->bnp_index, &kv);
 	/*
 	 * Update checksum for parent, for child it will be updated
 	 * in delete_key_from_node().
@@ -922,10 +1254,13 @@ static int be_btree_delete_key(struct m0_be_btree *tree,
 	int			rc = -1;
 	unsigned int		iter;
 	unsigned int		idx;
+	bool			found;
+	struct m0_be_bnode     *top = bnode;
+	bool			whole = bnode == tree->bb_root;
 
 	M0_PRE(btree_invariant(tree));
-	M0_PRE(btree_node_invariant(tree, tree->bb_root, true));
-	M0_PRE_EX(btree_node_subtree_invariant(tree, tree->bb_root));
+	M0_PRE(btree_node_invariant(tree, top, whole));
+	M0_PRE_EX(btree_node_subtree_invariant(tree, top));
 
 	M0_ENTRY("n=%p", bnode);
 
@@ -939,17 +1274,11 @@ static int be_btree_delete_key(struct m0_be_btree *tree,
 
 			/*  Retrieve index of the key equal to or greater than*/
 			/*  key being searched */
-			iter = 0;
-			while (iter < bnode->bt_num_active_key &&
-			       key_gt(tree, key,
-				      bnode->bt_kv_arr[iter].btree_key))
-				iter++;
-
+			iter = be_btree_node_search(tree, bnode, key, &found);
 			idx = iter;
 
 			/* check if key is found */
-			if (iter < bnode->bt_num_active_key &&
-			    key_eq(tree, key, bnode->bt_kv_arr[iter].btree_key))
+			if (found)
 				break;
 
 			/* Reached leaf node, nothing left to search */
@@ -1056,9 +1385,16 @@ static int be_btree_delete_key(struct m0_be_btree *tree,
 		continue;
 	}
 
+	/*
+	 * The root can be freed by merge, but a node at the top of the subtree
+	 * has more than BTREE_FAN_OUT - 1 keys (see btree_subtree_safe()) and
+	 * is never freed.
+	 */
+	if (whole)
+		top = tree->bb_root;
 	M0_POST(btree_invariant(tree));
-	M0_POST(btree_node_invariant(tree, tree->bb_root, true));
-	M0_POST_EX(btree_node_subtree_invariant(tree, tree->bb_root));
+	M0_POST(btree_node_invariant(tree, top, whole));
+	M0_POST_EX(btree_node_subtree_invariant(tree, top));
 	M0_LEAVE("rc=%d", rc);
 	return M0_RC(rc);
 }
@@ -1100,10 +1436,22 @@ static struct m0_be_bnode *node_pop(struct m0_be_btree_cursor *it, int *idx)
 */
 struct btree_node_pos
 be_btree_get_btree_node(struct m0_be_btree_cursor *it, const void *key, bool slant)
+{
+	return be_btree_node_get(it, it->bc_tree->bb_root, key, slant);
+}
+
+/**
+ * Same as be_btree_get_btree_node(), but the search is limited to the subtree
+ * rooted at @top.
+ */
+static struct btree_node_pos be_btree_node_get(struct m0_be_btree_cursor *it,
+					       struct m0_be_bnode        *top,
+					       const void *key, bool slant)
 {
 	int 			 idx;
+	bool			 found;
 	struct m0_be_btree 	*tree = it->bc_tree;
-	struct m0_be_bnode 	*bnode = tree->bb_root;
+	struct m0_be_bnode 	*bnode = top;
 	struct btree_node_pos    bnode_pos = { .bnp_node = NULL };
 
 	it->bc_stack_pos = 0;
@@ -1111,15 +1459,10 @@ be_btree_get_btree_node(struct m0_be_btree_cursor *it, const void *key, bool sla
 	while (true) {
 		/*  Retrieve index of the key equal to or greater than */
 		/*  the key being searched */
-		idx = 0;
-		while (idx < bnode->bt_num_active_key &&
-		       key_gt(tree, key, bnode->bt_kv_arr[idx].btree_key)) {
-			idx++;
-		}
+		idx = be_btree_node_search(tree, bnode, key, &found);
 
 		/*  If key is found, copy key-value pair */
-		if (idx < bnode->bt_num_active_key &&
-		    key_eq(tree, key, bnode->bt_kv_arr[idx].btree_key)) {
+		if (found) {
 			bnode_pos.bnp_node = bnode;
 			bnode_pos.bnp_index = idx;
 			break;
@@ -1294,13 +1637,24 @@ static void btree_truncate(struct m0_be_btree *btree, struct m0_be_tx *tx,
  */
 static struct be_btree_key_val *be_btree_search(struct m0_be_btree *btree,
 						void *key)
+{
+	return be_btree_subtree_search(btree, btree->bb_root, key);
+}
+
+/*
+ * Same as be_btree_search(), but the search is limited to the subtree rooted
+ * at @top.
+ */
+static struct be_btree_key_val *be_btree_subtree_search(struct m0_be_btree *btree,
+							struct m0_be_bnode *top,
+							void               *key)
 {
 	struct m0_be_btree_cursor btree_cursor;
 	struct btree_node_pos	  node_pos;
 	struct be_btree_key_val   *key_val = NULL;
 
 	btree_cursor.bc_tree = btree;
-	node_pos = be_btree_get_btree_node(&btree_cursor, key, false);
+	node_pos = be_btree_node_get(&btree_cursor, top, key, false);
 
 	if (node_pos.bnp_node)
 		key_val = &node_pos.bnp_node->bt_kv_arr[node_pos.bnp_index];
@@ -1352,6 +1706,189 @@ static void btree_pair_release(struct m0_be_btree *btree, struct m0_be_tx *tx,
 	mem_free(btree, tx, kv->btree_key);
 }
 
+/* ------------------------------------------------------------------
+ * Subtree locking
+ *
+ * The tree lock (m0_be_btree::bb_lock) is taken for writing by operations
+ * which may change the root node: creation, destruction, truncation, in-place
+ * operations and any insertion or deletion which can split or merge a child of
+ * the root. Such operations exclude everything else, as before.
+ *
+ * Insertions, deletions and lookups whose key falls into the subtree of a root
+ * child, which is known in advance not to split or to merge (see
+ * btree_subtree_safe()), take the tree lock for reading and then lock only
+ * that subtree. The root does not change while the tree lock is held for
+ * reading, so a subtree is identified by the index of its top in the root
+ * child array. Each tree has its own array of subtree locks
+ * (m0_be_btree_sublocks), indexed by this index modulo
+ * BTREE_SUBTREE_LOCK_NR. Operations in different subtrees of the same tree
+ * proceed in parallel and operations on different trees never share a lock.
+ *
+ * Remaining readers (cursors, minkey/maxkey, in-place lookups) may visit any
+ * node, so they take the tree lock and the locks of all subtrees for reading.
+ * They run in parallel with each other and with subtree lookups, and wait
+ * only for subtree updates already in progress, which are short. Subtree
+ * locks are always taken in ascending order. In-place lookups keep these locks
+ * across FOM phases until m0_be_btree_release(), updates wait for them just as
+ * they wait for the tree lock.
+ *
+ * Subtree locks are volatile and m0_be_btree is persistent, so the locks are
+ * kept in a registry keyed by the tree address, like the tree lock is kept in
+ * the volatile part of m0_be_btree. An operation looks the locks up once in
+ * btree_subtree_lock() or btree_shared_lock() and once more on unlock, each
+ * lookup takes a registry bucket mutex for a short list walk.
+ *
+ * A tree without subtree locks (allocation failed in m0_be_btree_init() or
+ * the module is not initialised) executes all updates under the tree write
+ * lock.
+ * ------------------------------------------------------------------ */
+
+enum btree_subtree_mode {
+	/** Lookup, the subtree is not modified. */
+	BTREE_SUBTREE_READ,
+	/** A key may be inserted into the subtree. */
+	BTREE_SUBTREE_INSERT,
+	/** A key may be deleted from the subtree. */
+	BTREE_SUBTREE_DELETE,
+	/** A key may be deleted and then inserted again (value overflow). */
+	BTREE_SUBTREE_SAVE,
+};
+
+static struct m0_rwlock *
+btree_subtree_rwlock(struct m0_be_btree_sublocks *sl, unsigned int idx)
+{
+	return &sl->bsl_lock[idx % BTREE_SUBTREE_LOCK_NR];
+}
+
+/** Returns the number of subtree locks protecting root children. */
+static unsigned int
+btree_subtree_lock_nr(const struct m0_be_btree          *tree,
+		      const struct m0_be_btree_sublocks *sl)
+{
+	const struct m0_be_bnode *root = tree->bb_root;
+
+	if (sl == NULL || root == NULL || root->bt_isleaf)
+		return 0;
+	return min_check(root->bt_num_active_key + 1,
+			 (unsigned int)BTREE_SUBTREE_LOCK_NR);
+}
+
+/**
+ * Locks the tree for a reader, which can visit any node of the tree.
+ */
+static void btree_shared_lock(struct m0_be_btree *tree)
+{
+	struct m0_be_btree_sublocks *sl = btree_sublocks(tree);
+	unsigned int                 nr;
+	unsigned int                 i;
+
+	m0_rwlock_read_lock(btree_rwlock(tree));
+	nr = btree_subtree_lock_nr(tree, sl);
+	for (i = 0; i < nr; ++i)
+		m0_rwlock_read_lock(btree_subtree_rwlock(sl, i));
+}
+
+static void btree_shared_unlock(struct m0_be_btree *tree)
+{
+	struct m0_be_btree_sublocks *sl = btree_sublocks(tree);
+	unsigned int                 nr = btree_subtree_lock_nr(tree, sl);
+	unsigned int                 i;
+
+	for (i = nr; i > 0; --i)
+		m0_rwlock_read_unlock(btree_subtree_rwlock(sl, i - 1));
+	m0_rwlock_read_unlock(btree_rwlock(tree));
+}
+
+/**
+ * Returns true iff an operation in @mode can be completed inside the subtree
+ * rooted at @node, i.e., @node itself is neither split nor merged.
+ *
+ * be_btree_insert_into_nonfull() splits full nodes on the way down and
+ * be_btree_delete_key() refills nodes with BTREE_FAN_OUT - 1 keys on the way
+ * down, so only the top of the subtree has to be checked.
+ */
+static bool btree_subtree_safe(const struct m0_be_bnode *node,
+			       enum btree_subtree_mode   mode)
+{
+	bool ins = node->bt_num_active_key < KV_NR;
+	bool del = node->bt_num_active_key > BTREE_FAN_OUT - 1;
+
+	switch (mode) {
+	case BTREE_SUBTREE_READ:
+		return true;
+	case BTREE_SUBTREE_INSERT:
+		return ins;
+	case BTREE_SUBTREE_DELETE:
+		return del;
+	case BTREE_SUBTREE_SAVE:
+		return ins && del;
+	}
+	return false;
+}
+
+/**
+ * Locks the subtree of a root child, which @key belongs to.
+ *
+ * @param idx  index of the returned node in the root child array.
+ * @return the locked root child, or NULL if the operation has to be executed
+ *         under the tree lock: the root is a leaf, @key is in the root, the
+ *         operation is not safe in the subtree or the tree has no subtree
+ *         locks.
+ */
+static struct m0_be_bnode *btree_subtree_lock(struct m0_be_btree     *tree,
+					      const void             *key,
+					      enum btree_subtree_mode mode,
+					      unsigned int           *idx)
+{
+	struct m0_be_btree_sublocks *sl = btree_sublocks(tree);
+	struct m0_be_bnode          *root;
+	struct m0_be_bnode          *child;
+	struct m0_rwlock            *lock;
+	bool                         write = mode != BTREE_SUBTREE_READ;
+	bool                         found;
+
+	if (sl == NULL)
+		return NULL;
+
+	m0_rwlock_read_lock(btree_rwlock(tree));
+	root = tree->bb_root;
+	if (root->bt_isleaf)
+		goto unlock;
+	*idx = be_btree_node_search(tree, root, key, &found);
+	if (found)
+		goto unlock;
+	child = root->bt_child_arr[*idx];
+	lock = btree_subtree_rwlock(sl, *idx);
+	if (write)
+		m0_rwlock_write_lock(lock);
+	else
+		m0_rwlock_read_lock(lock);
+	if (btree_subtree_safe(child, mode))
+		return child;
+
+	if (write)
+		m0_rwlock_write_unlock(lock);
+	else
+		m0_rwlock_read_unlock(lock);
+unlock:
+	m0_rwlock_read_unlock(btree_rwlock(tree));
+	return NULL;
+}
+
+static void btree_subtree_unlock(struct m0_be_btree      *tree,
+				 unsigned int             idx,
+				 enum btree_subtree_mode  mode)
+{
+	struct m0_be_btree_sublocks *sl = btree_sublocks(tree);
+
+	M0_PRE(sl != NULL);
+	if (mode != BTREE_SUBTREE_READ)
+		m0_rwlock_write_unlock(btree_subtree_rwlock(sl, idx));
+	else
+		m0_rwlock_read_unlock(btree_subtree_rwlock(sl, idx));
+	m0_rwlock_read_unlock(btree_rwlock(tree));
+}
+
 /**
  * Inserts or updates value by key
  * @param tree The btree
@@ -1376,6 +1913,10 @@ static void btree_save(struct m0_be_btree        *tree,
 	struct be_btree_key_val   new_kv;
 	struct be_btree_key_val  *cur_kv;
 	bool               val_overflow = false;
+	struct m0_be_bnode       *top = NULL;
+	unsigned int              idx;
+	enum btree_subtree_mode   mode = optype == BTREE_SAVE_INSERT ?
+		BTREE_SUBTREE_INSERT : BTREE_SUBTREE_SAVE;
 
 	M0_ENTRY("tree=%p", tree);
 
@@ -1398,7 +1939,11 @@ static void btree_save(struct m0_be_btree        *tree,
 		      M0_BBO_UPDATE : M0_BBO_INSERT, NULL);
 
 	m0_be_op_active(op);
-	m0_rwlock_write_lock(btree_rwlock(tree));
+	/* Anchored operations keep the tree locked until m0_be_btree_release(). */
+	if (anchor == NULL)
+		top = btree_subtree_lock(tree, key->b_addr, mode, &idx);
+	if (top == NULL)
+		m0_rwlock_write_lock(btree_rwlock(tree));
 	if (anchor != NULL) {
 		anchor->ba_tree = tree;
 		anchor->ba_write = true;
@@ -1411,7 +1956,8 @@ static void btree_save(struct m0_be_btree        *tree,
 		goto fi_exist;
 
 	op_tree(op)->t_rc = 0;
-	cur_kv = be_btree_search(tree, key->b_addr);
+	cur_kv = top == NULL ? be_btree_search(tree, key->b_addr) :
+		be_btree_subtree_search(tree, top, key->b_addr);
 	if ((cur_kv == NULL && optype != BTREE_SAVE_UPDATE) ||
 	    (cur_kv != NULL && optype == BTREE_SAVE_UPDATE) ||
 	    optype == BTREE_SAVE_OVERWRITE) {
@@ -1425,7 +1971,7 @@ static void btree_save(struct m0_be_btree        *tree,
 				 */
 				op_tree(op)->t_rc =
 					be_btree_delete_key(tree, tx,
-							 tree->bb_root,
+							 top ?: tree->bb_root,
 							 cur_kv->btree_key);
 				val_overflow = true;
 			} else {
@@ -1464,7 +2010,10 @@ static void btree_save(struct m0_be_btree        *tree,
 				anchor->ba_value.b_addr = new_kv.btree_val;
 			}
 
-			be_btree_insert_newkey(tree, tx, &new_kv);
+			if (top == NULL)
+				be_btree_insert_newkey(tree, tx, &new_kv);
+			else
+				be_btree_subtree_insert(tree, tx, top, &new_kv);
 		}
 	} else {
 fi_exist:
@@ -1473,7 +2022,9 @@ fi_exist:
 			key->b_addr);
 	}
 
-	if (anchor == NULL)
+	if (top != NULL)
+		btree_subtree_unlock(tree, idx, mode);
+	else if (anchor == NULL)
 		m0_rwlock_write_unlock(btree_rwlock(tree));
 	m0_be_op_done(op);
 	M0_LEAVE("tree=%p", tree);
@@ -1494,6 +2045,7 @@ M0_INTERNAL void m0_be_btree_init(struct m0_be_btree *tree,
 	m0_rwlock_init(btree_rwlock(tree));
 	tree->bb_ops = ops;
 	tree->bb_seg = seg;
+	btree_sublocks_register(tree);
 
 	if (!m0_be_seg_contains(seg, tree->bb_root))
 		tree->bb_root = NULL;
@@ -1505,6 +2057,7 @@ M0_INTERNAL void m0_be_btree_fini(struct m0_be_btree *tree)
 	M0_ENTRY("tree=%p", tree);
 	M0_PRE(ergo(tree->bb_root != NULL && tree->bb_header.hd_magic != 0,
 		    btree_invariant(tree)));
+	btree_sublocks_unregister(tree);
 	m0_rwlock_fini(btree_rwlock(tree));
 	M0_LEAVE();
 }
@@ -1590,17 +2143,22 @@ M0_INTERNAL void m0_be_btree_truncate(struct m0_be_btree *tree,
 static void btree_node_alloc_credit(const struct m0_be_btree     *tree,
 					  struct m0_be_tx_credit *accum)
 {
-	btree_mem_alloc_credit(tree, sizeof(struct m0_be_bnode), accum);
+	btree_mem_alloc_credit(tree, btree_node_size(tree), accum);
 }
 
-static void btree_node_update_credit(struct m0_be_tx_credit *accum,
-				     m0_bcount_t nr)
+static void btree_node_update_credit(const struct m0_be_btree *tree,
+				     struct m0_be_tx_credit   *accum,
+				     m0_bcount_t               nr)
 {
 	struct m0_be_tx_credit cred = {};
 
 	/* struct m0_be_bnode update x2 */
 	m0_be_tx_credit_mac(&cred,
 			    &M0_BE_TX_CREDIT_TYPE(struct m0_be_bnode), 2);
+	/* and key prefixes of format version 2 */
+	if (btree_node_size(tree) > sizeof(struct m0_be_bnode))
+		m0_be_tx_credit_add(&cred,
+			&M0_BE_TX_CREDIT_TYPE(struct m0_be_bnode_pfx));
 
 	m0_be_tx_credit_mac(accum, &cred, nr);
 }
@@ -1608,10 +2166,10 @@ static void btree_node_update_credit(struct m0_be_tx_credit *accum,
 static void btree_node_free_credit(const struct m0_be_btree     *tree,
 					 struct m0_be_tx_credit *accum)
 {
-	btree_mem_free_credit(tree, sizeof(struct m0_be_bnode), accum);
+	btree_mem_free_credit(tree, btree_node_size(tree), accum);
 	m0_be_tx_credit_add(accum,
 			    &M0_BE_TX_CREDIT_TYPE(uint64_t));
-	btree_node_update_credit(accum, 1); /* for parent */
+	btree_node_update_credit(tree, accum, 1); /* for parent */
 }
 
 /* XXX */
@@ -1630,7 +2188,7 @@ static void btree_rebalance_credit(const struct m0_be_btree *tree,
 	struct m0_be_tx_credit cred = {};
 
 	btree_node_alloc_credit(tree, &cred);
-	btree_node_update_credit(&cred, 1);
+	btree_node_update_credit(tree, &cred, 1);
 	btree_credit(tree, &cred);
 
 	m0_be_tx_credit_add(accum, &cred);
@@ -1668,7 +2226,7 @@ static void btree_node_split_child_credit(const struct m0_be_btree *tree,
 					  struct m0_be_tx_credit   *accum)
 {
 	btree_node_alloc_credit(tree, accum);
-	btree_node_update_credit(accum, 3);
+	btree_node_update_credit(tree, accum, 3);
 }
 
 static void insert_credit(const struct m0_be_btree *tree,
@@ -1689,7 +2247,7 @@ static void insert_credit(const struct m0_be_btree *tree,
 	/* for be_btree_insert_into_nonfull() */
 	btree_node_split_child_credit(tree, &cred);
 	m0_be_tx_credit_mul(&cred, height);
-	btree_node_update_credit(&cred, 1);
+	btree_node_update_credit(tree, &cred, 1);
 
 	/* for be_btree_insert_newkey() */
 	btree_node_alloc_credit(tree, &cred);
@@ -1710,13 +2268,88 @@ static void delete_credit(const struct m0_be_btree *tree,
 	struct m0_be_tx_credit cred = {};
 
 	kv_delete_credit(tree, ksize, vsize, &cred);
-	btree_node_update_credit(&cred, 1);
+	btree_node_update_credit(tree, &cred, 1);
 	btree_node_free_credit(tree, &cred);
 	btree_rebalance_credit(tree, &cred);
 	m0_be_tx_credit_mac(accum, &cred, nr);
 }
 
 
+/** Maximum number of keys in a non-root subtree of height @level. */
+static m0_bcount_t btree_subtree_max(unsigned int level)
+{
+	m0_bcount_t nr = KV_NR;
+
+	while (level-- > 0)
+		nr = KV_NR + (KV_NR + 1) * nr;
+	return nr;
+}
+
+/** Minimum number of keys in a non-root subtree of height @level. */
+static m0_bcount_t btree_subtree_min(unsigned int level)
+{
+	m0_bcount_t nr = BTREE_FAN_OUT - 1;
+
+	while (level-- > 0)
+		nr = BTREE_FAN_OUT - 1 + BTREE_FAN_OUT * nr;
+	return nr;
+}
+
+M0_INTERNAL void m0_be_btree_bulk_load_credit(const struct m0_be_btree *tree,
+					      m0_bcount_t               nr,
+					      m0_bcount_t               ksize,
+					      m0_bcount_t               vsize,
+					      struct m0_be_tx_credit   *accum)
+{
+	struct m0_be_tx_credit cred = {};
+	m0_bcount_t            nodes;
+
+	/*
+	 * Every non-root node has at least BTREE_FAN_OUT - 1 keys, the number
+	 * of internal nodes is less than the number of leaves.
+	 */
+	nodes = 2 * (nr / (BTREE_FAN_OUT - 1) + 1);
+	btree_node_alloc_credit(tree, &cred);
+	btree_node_update_credit(tree, &cred, 1);
+	m0_be_tx_credit_mul(&cred, nodes);
+	m0_be_tx_credit_add(&cred,
+			    &M0_BE_TX_CREDIT(1, sizeof(struct m0_be_btree)));
+	m0_be_tx_credit_add(accum, &cred);
+
+	M0_SET0(&cred);
+	kv_insert_credit(tree, ksize, vsize, &cred);
+	m0_be_tx_credit_mac(accum, &cred, nr);
+}
+
+M0_INTERNAL void
+m0_be_btree_insert_batch_credit(const struct m0_be_btree *tree,
+				m0_bcount_t               nr,
+				m0_bcount_t               ksize,
+				m0_bcount_t               vsize,
+				struct m0_be_tx_credit   *accum)
+{
+	/*
+	 * In the worst case every record lands into a different full leaf,
+	 * which is split.
+	 */
+	insert_credit(tree, nr, ksize, vsize, accum, false);
+}
+
+M0_INTERNAL void m0_be_btree_convert_credit(const struct m0_be_btree *tree,
+					    m0_bcount_t               limit,
+					    struct m0_be_tx_credit   *accum)
+{
+	struct m0_be_tx_credit cred = {};
+
+	/* new node, old node and the parent slot or the root pointer */
+	btree_node_alloc_credit(tree, &cred);
+	btree_node_update_credit(tree, &cred, 1);
+	btree_node_free_credit(tree, &cred);
+	m0_be_tx_credit_add(&cred,
+			    &M0_BE_TX_CREDIT(1, sizeof(struct m0_be_btree)));
+	m0_be_tx_credit_mac(accum, &cred, limit);
+}
+
 M0_INTERNAL void m0_be_btree_insert_credit(const struct m0_be_btree *tree,
 					   m0_bcount_t               nr,
 					   m0_bcount_t               ksize,
@@ -1787,7 +2420,7 @@ M0_INTERNAL void m0_be_btree_create_credit(const struct m0_be_btree     *tree,
 	struct m0_be_tx_credit cred = {};
 
 	btree_node_alloc_credit(tree, &cred);
-	btree_node_update_credit(&cred, 1);
+	btree_node_update_credit(tree, &cred, 1);
 	m0_be_tx_credit_mac(accum, &cred, nr);
 }
 
@@ -1960,7 +2593,9 @@ M0_INTERNAL void m0_be_btree_delete(struct m0_be_btree *tree,
 				    struct m0_be_op *op,
 				    const struct m0_buf *key)
 {
-	int rc;
+	struct m0_be_bnode *top;
+	unsigned int        idx;
+	int                 rc;
 
 	M0_ENTRY("tree=%p", tree);
 	M0_PRE(tree->bb_root != NULL && tree->bb_ops != NULL);
@@ -1970,18 +2605,357 @@ M0_INTERNAL void m0_be_btree_delete(struct m0_be_btree *tree,
 	btree_op_fill(op, tree, tx, M0_BBO_DELETE, NULL);
 
 	m0_be_op_active(op);
-	m0_rwlock_write_lock(btree_rwlock(tree));
+	top = btree_subtree_lock(tree, key->b_addr, BTREE_SUBTREE_DELETE, &idx);
+	if (top == NULL)
+		m0_rwlock_write_lock(btree_rwlock(tree));
 
-	op_tree(op)->t_rc = rc = be_btree_delete_key(tree, tx, tree->bb_root,
+	op_tree(op)->t_rc = rc = be_btree_delete_key(tree, tx,
+						     top ?: tree->bb_root,
 						     key->b_addr);
 	if (rc != 0)
 		op_tree(op)->t_rc = -ENOENT;
 
-	m0_rwlock_write_unlock(btree_rwlock(tree));
+	if (top != NULL)
+		btree_subtree_unlock(tree, idx, BTREE_SUBTREE_DELETE);
+	else
+		m0_rwlock_write_unlock(btree_rwlock(tree));
 	m0_be_op_done(op);
 	M0_LEAVE("tree=%p", tree);
 }
 
+/**
+ * Allocates the record for @key and @val in the segment and fills @kv.
+ */
+static void btree_kv_make(struct m0_be_btree      *tree,
+			  struct m0_be_tx         *tx,
+			  const struct m0_buf     *key,
+			  const struct m0_buf     *val,
+			  struct be_btree_key_val *kv)
+{
+	m0_bcount_t ksz = m0_align(key->b_nob, sizeof(void*));
+
+	kv->btree_key = mem_alloc(tree, tx, ksz + val->b_nob,
+				  M0_BITS(M0_BAP_NORMAL));
+	kv->btree_val = kv->btree_key + ksz;
+	memcpy(kv->btree_key, key->b_addr, key->b_nob);
+	memset(kv->btree_key + key->b_nob, 0, ksz - key->b_nob);
+	memcpy(kv->btree_val, val->b_addr, val->b_nob);
+	mem_update(tree, tx, kv->btree_key, ksz + val->b_nob);
+}
+
+/**
+ * Builds the subtree of height @level, containing records @kv[0, nr), in
+ * @node, which is allocated if NULL.
+ *
+ * Every internal node gets the minimal number of children which can hold the
+ * records, but not less than the occupancy rules require, and the records are
+ * spread evenly between the children. Given that @nr fits into a subtree of
+ * height @level, children counts stay within [btree_subtree_min(level - 1),
+ * btree_subtree_max(level - 1)].
+ */
+static struct m0_be_bnode *btree_bulk_build(struct m0_be_btree      *tree,
+					    struct m0_be_tx         *tx,
+					    struct m0_be_bnode      *node,
+					    struct be_btree_key_val *kv,
+					    m0_bcount_t              nr,
+					    unsigned int             level)
+{
+	m0_bcount_t children;
+	m0_bcount_t child_nr;
+	m0_bcount_t extra;
+	m0_bcount_t cap;
+	m0_bcount_t pos = 0;
+	m0_bcount_t i;
+	bool        root = node != NULL;
+
+	M0_PRE(root || nr >= btree_subtree_min(level));
+	M0_PRE(nr <= btree_subtree_max(level));
+
+	if (node == NULL)
+		node = be_btree_node_alloc(tree, tx);
+	if (level == 0) {
+		M0_ASSERT(nr <= KV_NR);
+		for (i = 0; i < nr; ++i)
+			btree_node_kv_set(tree, node, i, &kv[i]);
+		be_btree_set_node_params(node, nr, 0, true);
+	} else {
+		cap      = btree_subtree_max(level - 1) + 1;
+		children = max64u((nr + cap) / cap, root ? 2 : BTREE_FAN_OUT);
+		M0_ASSERT(children <= KV_NR + 1);
+		child_nr = (nr - (children - 1)) / children;
+		extra    = (nr - (children - 1)) % children;
+		for (i = 0; i < children; ++i) {
+			m0_bcount_t cnr = child_nr + (i < extra ? 1 : 0);
+
+			node->bt_child_arr[i] = btree_bulk_build(tree, tx, NULL,
+								 kv + pos, cnr,
+								 level - 1);
+			pos += cnr;
+			if (i < children - 1)
+				btree_node_kv_set(tree, node, i, &kv[pos++]);
+		}
+		M0_ASSERT(pos == nr);
+		be_btree_set_node_params(node, children - 1, level, false);
+	}
+	m0_format_footer_update(node);
+	btree_node_update(node, tree, tx);
+	return node;
+}
+
+M0_INTERNAL void m0_be_btree_bulk_load(struct m0_be_btree  *tree,
+				       struct m0_be_tx     *tx,
+				       struct m0_be_op     *op,
+				       const struct m0_buf *keys,
+				       const struct m0_buf *vals,
+				       m0_bcount_t          nr)
+{
+	struct be_btree_key_val *kv;
+	m0_bcount_t              i;
+	unsigned int             level = 0;
+
+	M0_ENTRY("tree=%p nr=%"PRIu64, tree, nr);
+	M0_PRE(tree->bb_root != NULL && tree->bb_ops != NULL);
+	M0_PRE(m0_forall(j, nr,
+			 keys[j].b_nob == be_btree_ksize(tree, keys[j].b_addr) &&
+			 vals[j].b_nob == be_btree_vsize(tree, vals[j].b_addr)));
+	M0_PRE(m0_forall(j, nr, j == 0 ||
+			 key_lt(tree, keys[j - 1].b_addr, keys[j].b_addr)));
+
+	btree_op_fill(op, tree, tx, M0_BBO_INSERT, NULL);
+	m0_be_op_active(op);
+
+	if (nr > 0 && M0_ALLOC_ARR(kv, nr) == NULL) {
+		op_tree(op)->t_rc = M0_ERR(-ENOMEM);
+		m0_be_op_done(op);
+		return;
+	}
+	while (nr > btree_subtree_max(level))
+		++level;
+	M0_ASSERT(level < BTREE_HEIGHT_MAX);
+
+	m0_rwlock_write_lock(btree_rwlock(tree));
+	M0_PRE(btree_invariant(tree));
+	M0_PRE(tree->bb_root->bt_num_active_key == 0 &&
+	       tree->bb_root->bt_isleaf);
+	for (i = 0; i < nr; ++i)
+		btree_kv_make(tree, tx, &keys[i], &vals[i], &kv[i]);
+	if (nr > 0)
+		btree_bulk_build(tree, tx, tree->bb_root, kv, nr, level);
+	op_tree(op)->t_rc = 0;
+
+	M0_POST(btree_invariant(tree));
+	M0_POST(btree_node_invariant(tree, tree->bb_root, true));
+	M0_POST_EX(btree_node_subtree_invariant(tree, tree->bb_root));
+	m0_rwlock_write_unlock(btree_rwlock(tree));
+	m0_free(kv);
+	m0_be_op_done(op);
+	M0_LEAVE();
+}
+
+/**
+ * Finds the leaf where @key is to be inserted.
+ *
+ * @param bound  set to the least key of the tree which is greater than all keys
+ *               that belong to the leaf, or to NULL if there is no such key.
+ * @return the leaf, or NULL if @key is in an internal node.
+ */
+static struct m0_be_bnode *btree_leaf_find(struct m0_be_btree  *tree,
+					   const void          *key,
+					   void               **bound)
+{
+	struct m0_be_bnode *node = tree->bb_root;
+	unsigned int        i;
+	bool                found;
+
+	*bound = NULL;
+	while (!node->bt_isleaf) {
+		i = be_btree_node_search(tree, node, key, &found);
+		if (found)
+			return NULL;
+		if (i < node->bt_num_active_key)
+			*bound = node->bt_kv_arr[i].btree_key;
+		node = node->bt_child_arr[i];
+	}
+	return node;
+}
+
+M0_INTERNAL void m0_be_btree_insert_batch(struct m0_be_btree  *tree,
+					  struct m0_be_tx     *tx,
+					  struct m0_be_op     *op,
+					  const struct m0_buf *keys,
+					  const struct m0_buf *vals,
+					  m0_bcount_t          nr)
+{
+	struct be_btree_key_val  kv;
+	struct m0_be_bnode      *leaf = NULL;
+	void                    *bound = NULL;
+	void                    *key;
+	unsigned int             pos;
+	bool                     dirty = false;
+	bool                     found = false;
+	m0_bcount_t              i;
+
+	M0_ENTRY("tree=%p nr=%"PRIu64, tree, nr);
+	M0_PRE(tree->bb_root != NULL && tree->bb_ops != NULL);
+	M0_PRE(m0_forall(j, nr,
+			 keys[j].b_nob == be_btree_ksize(tree, keys[j].b_addr) &&
+			 vals[j].b_nob == be_btree_vsize(tree, vals[j].b_addr)));
+	M0_PRE(m0_forall(j, nr, j == 0 ||
+			 key_lt(tree, keys[j - 1].b_addr, keys[j].b_addr)));
+
+	btree_op_fill(op, tree, tx, M0_BBO_INSERT, NULL);
+	m0_be_op_active(op);
+	m0_rwlock_write_lock(btree_rwlock(tree));
+	M0_PRE(btree_invariant(tree));
+
+	op_tree(op)->t_rc = 0;
+	for (i = 0; i < nr; ++i) {
+		key = keys[i].b_addr;
+		/*
+		 * Keys are sorted, so the key goes into the leaf of the
+		 * previous one, unless it reaches the bound of the leaf.
+		 */
+		if (leaf == NULL || leaf->bt_num_active_key == KV_NR ||
+		    (bound != NULL && !key_lt(tree, key, bound))) {
+			if (dirty) {
+				m0_format_footer_update(leaf);
+				btree_node_update(leaf, tree, tx);
+				dirty = false;
+			}
+			leaf = btree_leaf_find(tree, key, &bound);
+		}
+		if (leaf != NULL)
+			pos = be_btree_node_search(tree, leaf, key, &found);
+		if (leaf == NULL || found) {
+			op_tree(op)->t_rc = -EEXIST;
+			M0_LOG(M0_NOTICE, "the key entry at %p already exist",
+			       key);
+			break;
+		}
+		btree_kv_make(tree, tx, &keys[i], &vals[i], &kv);
+		if (leaf->bt_num_active_key == KV_NR) {
+			/* The leaf is split on the way down from the root. */
+			be_btree_insert_newkey(tree, tx, &kv);
+			leaf = NULL;
+			continue;
+		}
+		btree_node_kv_open(tree, leaf, pos);
+		btree_node_kv_set(tree, leaf, pos, &kv);
+		leaf->bt_num_active_key++;
+		/* The leaf is captured once, when the batch leaves it. */
+		dirty = true;
+	}
+	if (dirty) {
+		m0_format_footer_update(leaf);
+		btree_node_update(leaf, tree, tx);
+	}
+
+	M0_POST(btree_invariant(tree));
+	M0_POST(btree_node_invariant(tree, tree->bb_root, true));
+	M0_POST_EX(btree_node_subtree_invariant(tree, tree->bb_root));
+	m0_rwlock_write_unlock(btree_rwlock(tree));
+	m0_be_op_done(op);
+	M0_LEAVE("rc=%d", op_tree(op)->t_rc);
+}
+
+/**
+ * Re-allocates @node in the format of @tree and replaces it with the new node
+ * in child slot @index of @parent, or at the root if @parent is NULL.
+ */
+static struct m0_be_bnode *btree_node_convert(struct m0_be_btree *tree,
+					      struct m0_be_tx    *tx,
+					      struct m0_be_bnode *node,
+					      struct m0_be_bnode *parent,
+					      unsigned int        index)
+{
+	struct m0_be_bnode *copy = be_btree_node_alloc(tree, tx);
+	unsigned int        i;
+
+	be_btree_set_node_params(copy, node->bt_num_active_key,
+				 node->bt_level, node->bt_isleaf);
+	for (i = 0; i < node->bt_num_active_key; ++i)
+		btree_node_kv_copy(tree, copy, i, node, i);
+	if (!node->bt_isleaf)
+		memcpy(copy->bt_child_arr, node->bt_child_arr,
+		       (node->bt_num_active_key + 1) *
+		       sizeof node->bt_child_arr[0]);
+	m0_format_footer_update(copy);
+	btree_node_update(copy, tree, tx);
+
+	if (parent == NULL) {
+		btree_root_set(tree, copy);
+		mem_update(tree, tx, tree, sizeof(struct m0_be_btree));
+	} else {
+		parent->bt_child_arr[index] = copy;
+		m0_format_footer_update(parent);
+		mem_update(tree, tx, &parent->bt_child_arr[index],
+			   sizeof parent->bt_child_arr[index]);
+		mem_update(tree, tx, btree_node_footer(parent),
+			   sizeof(struct m0_format_footer));
+	}
+	btree_node_free(node, tree, tx);
+	return copy;
+}
+
+/**
+ * Converts nodes of the subtree rooted at @node, which is child @index of
+ * @parent, in pre-order, decrementing @limit for every converted node.
+ *
+ * @return false iff @limit is exhausted before the whole subtree is converted.
+ */
+static bool btree_subtree_convert(struct m0_be_btree *tree,
+				  struct m0_be_tx    *tx,
+				  struct m0_be_bnode *node,
+				  struct m0_be_bnode *parent,
+				  unsigned int        index,
+				  m0_bcount_t        *limit)
+{
+	unsigned int i;
+
+	if (btree_node_pfx(tree, node) == NULL) {
+		if (*limit == 0)
+			return false;
+		node = btree_node_convert(tree, tx, node, parent, index);
+		--*limit;
+	}
+	if (!node->bt_isleaf) {
+		for (i = 0; i <= node->bt_num_active_key; ++i) {
+			if (!btree_subtree_convert(tree, tx,
+						   node->bt_child_arr[i],
+						   node, i, limit))
+				return false;
+		}
+	}
+	return true;
+}
+
+M0_INTERNAL void m0_be_btree_convert(struct m0_be_btree *tree,
+				     struct m0_be_tx    *tx,
+				     struct m0_be_op    *op,
+				     m0_bcount_t         limit)
+{
+	bool done;
+
+	M0_ENTRY("tree=%p limit=%"PRIu64, tree, limit);
+	M0_PRE(tree->bb_root != NULL && tree->bb_ops != NULL);
+	M0_PRE(tree->bb_ops->ko_key_prefix != NULL);
+
+	btree_op_fill(op, tree, tx, M0_BBO_UPDATE, NULL);
+	m0_be_op_active(op);
+	m0_rwlock_write_lock(btree_rwlock(tree));
+	M0_PRE(btree_invariant(tree));
+
+	done = btree_subtree_convert(tree, tx, tree->bb_root, NULL, 0, &limit);
+	op_tree(op)->t_rc = done ? 0 : -EAGAIN;
+
+	M0_POST(btree_invariant(tree));
+	M0_POST(btree_node_invariant(tree, tree->bb_root, true));
+	M0_POST_EX(btree_node_subtree_invariant(tree, tree->bb_root));
+	m0_rwlock_write_unlock(btree_rwlock(tree));
+	m0_be_op_done(op);
+	M0_LEAVE("rc=%d", op_tree(op)->t_rc);
+}
+
 static void be_btree_lookup(struct m0_be_btree *tree,
 			    struct m0_be_op *op,
 			    const struct m0_buf *key_in,
@@ -1993,6 +2967,10 @@ static void be_btree_lookup(struct m0_be_btree *tree,
 	struct be_btree_key_val   *kv;
 	m0_bcount_t                ksize;
 	m0_bcount_t                vsize;
+	struct m0_be_bnode        *top;
+	struct m0_be_bnode        *root;
+	unsigned int               idx;
+	bool                       slant = key_out != NULL;
 
 	M0_ENTRY("tree=%p key_in=%p key_out=%p value=%p",
 		 tree, key_in, key_out, value);
@@ -2001,11 +2979,25 @@ static void be_btree_lookup(struct m0_be_btree *tree,
 	btree_op_fill(op, tree, NULL, M0_BBO_LOOKUP, NULL);
 
 	m0_be_op_active(op);
-	m0_rwlock_read_lock(btree_rwlock(tree));
-
 	it.bc_tree = tree;
-	kp = be_btree_get_btree_node(&it, key_in->b_addr,
-			    /* slant: */ key_out == NULL ? false : true);
+	top = btree_subtree_lock(tree, key_in->b_addr, BTREE_SUBTREE_READ, &idx);
+	if (top == NULL) {
+		btree_shared_lock(tree);
+		kp = be_btree_get_btree_node(&it, key_in->b_addr, slant);
+	} else {
+		kp = be_btree_node_get(&it, top, key_in->b_addr, slant);
+		root = tree->bb_root;
+		/*
+		 * All keys in the subtree are less than @key_in, the next key
+		 * is the separator in the root, which is stable under the tree
+		 * lock.
+		 */
+		if (slant && kp.bnp_node == NULL &&
+		    idx < root->bt_num_active_key) {
+			kp.bnp_node  = root;
+			kp.bnp_index = idx;
+		}
+	}
 	if (kp.bnp_node) {
 		kv = &kp.bnp_node->bt_kv_arr[kp.bnp_index];
 
@@ -2025,7 +3017,10 @@ static void be_btree_lookup(struct m0_be_btree *tree,
 	} else
 		op_tree(op)->t_rc = -ENOENT;
 
-	m0_rwlock_read_unlock(btree_rwlock(tree));
+	if (top != NULL)
+		btree_subtree_unlock(tree, idx, BTREE_SUBTREE_READ);
+	else
+		btree_shared_unlock(tree);
 	m0_be_op_done(op);
 	M0_LEAVE("rc=%d", op_tree(op)->t_rc);
 }
@@ -2057,13 +3052,13 @@ M0_INTERNAL void m0_be_btree_maxkey(struct m0_be_btree *tree,
 	btree_op_fill(op, tree, NULL, M0_BBO_MAXKEY, NULL);
 
 	m0_be_op_active(op);
-	m0_rwlock_read_lock(btree_rwlock(tree));
+	btree_shared_lock(tree);
 
 	key = be_btree_get_max_key(tree);
 	op_tree(op)->t_rc = key == NULL ? -ENOENT : 0;
 	m0_buf_init(out, key, key == NULL ? 0 : be_btree_ksize(tree, key));
 
-	m0_rwlock_read_unlock(btree_rwlock(tree));
+	btree_shared_unlock(tree);
 	m0_be_op_done(op);
 }
 
@@ -2078,13 +3073,13 @@ M0_INTERNAL void m0_be_btree_minkey(struct m0_be_btree *tree,
 	btree_op_fill(op, tree, NULL, M0_BBO_MINKEY, NULL);
 
 	m0_be_op_active(op);
-	m0_rwlock_read_lock(btree_rwlock(tree));
+	btree_shared_lock(tree);
 
 	key = be_btree_get_min_key(tree);
 	op_tree(op)->t_rc = key == NULL ? -ENOENT : 0;
 	m0_buf_init(out, key, key == NULL ? 0 : be_btree_ksize(tree, key));
 
-	m0_rwlock_read_unlock(btree_rwlock(tree));
+	btree_shared_unlock(tree);
 	m0_be_op_done(op);
 }
 
@@ -2162,7 +3157,7 @@ M0_INTERNAL void m0_be_btree_lookup_inplace(struct m0_be_btree        *tree,
 	btree_op_fill(op, tree, NULL, M0_BBO_INSERT, anchor);
 
 	m0_be_op_active(op);
-	m0_rwlock_read_lock(btree_rwlock(tree));
+	btree_shared_lock(tree);
 
 	anchor->ba_tree = tree;
 	anchor->ba_write = false;
@@ -2194,7 +3189,7 @@ M0_INTERNAL void m0_be_btree_release(struct m0_be_tx           *tx,
 			}
 			m0_rwlock_write_unlock(btree_rwlock(tree));
 		} else
-			m0_rwlock_read_unlock(btree_rwlock(tree));
+			btree_shared_unlock(tree);
 		anchor->ba_tree = NULL;
 	}
 	M0_LEAVE();
@@ -2303,7 +3298,7 @@ M0_INTERNAL void m0_be_btree_cursor_get(struct m0_be_btree_cursor *cur,
 	btree_op_fill(op, tree, NULL, M0_BBO_CURSOR_GET, NULL);
 
 	m0_be_op_active(op);
-	m0_rwlock_read_lock(btree_rwlock(tree));
+	btree_shared_lock(tree);
 
 	last = be_btree_get_btree_node(cur, key->b_addr, slant);
 
@@ -2324,7 +3319,7 @@ M0_INTERNAL void m0_be_btree_cursor_get(struct m0_be_btree_cursor *cur,
 		op_tree(op)->t_rc = 0;
 	}
 
-	m0_rwlock_read_unlock(btree_rwlock(tree));
+	btree_shared_unlock(tree);
 	m0_be_op_done(op);
 }
 
@@ -2365,7 +3360,7 @@ M0_INTERNAL void m0_be_btree_cursor_next(struct m0_be_btree_cursor *cur)
 	btree_op_fill(op, tree, NULL, M0_BBO_CURSOR_NEXT, NULL);
 
 	m0_be_op_active(op);
-	m0_rwlock_read_lock(btree_rwlock(tree));
+	btree_shared_lock(tree);
 
 	node = cur->bc_node;
 	if (node == NULL) {
@@ -2404,7 +3399,7 @@ M0_INTERNAL void m0_be_btree_cursor_next(struct m0_be_btree_cursor *cur)
 	m0_buf_init(&op_tree(op)->t_out_key, kv->btree_key,
 		    be_btree_ksize(tree, kv->btree_key));
 out:
-	m0_rwlock_read_unlock(btree_rwlock(tree));
+	btree_shared_unlock(tree);
 	m0_be_op_done(op);
 }
 
@@ -2418,7 +3413,7 @@ M0_INTERNAL void m0_be_btree_cursor_prev(struct m0_be_btree_cursor *cur)
 	btree_op_fill(op, tree, NULL, M0_BBO_CURSOR_PREV, NULL);
 
 	m0_be_op_active(op);
-	m0_rwlock_read_lock(btree_rwlock(tree));
+	btree_shared_lock(tree);
 
 	node = cur->bc_node;
 
@@ -2457,7 +3452,7 @@ M0_INTERNAL void m0_be_btree_cursor_prev(struct m0_be_btree_cursor *cur)
 	m0_buf_init(&op_tree(op)->t_out_key, kv->btree_key,
 		    be_btree_ksize(tree, kv->btree_key));
 out:
-	m0_rwlock_read_unlock(btree_rwlock(tree));
+	btree_shared_unlock(tree);
 	m0_be_op_done(op);
 }
 
@@ -111,6 +111,24 @@ struct m0_be_btree_kv_ops {
 	 * XXX RENAMEME? s/ko_compare/ko_key_cmp/
 	 */
 	int         (*ko_compare)(const void *key0, const void *key1);
+
+	/**
+	 * Optional. Returns the 64-bit prefix of a key, which is stored inline
+	 * in the nodes of the tree (node format version 2) and compared
+	 * before the key itself is dereferenced.
+	 *
+	 * The prefix must preserve key ordering: ko_compare(key0, key1) < 0
+	 * implies ko_key_prefix(key0) <= ko_key_prefix(key1).
+	 *
+	 * Trees without this function use node format version 1. Nodes of an
+	 * existing tree are switched to version 2 by m0_be_btree_convert().
+	 */
+	uint64_t    (*ko_key_prefix)(const void *key);
+	/**
+	 * True iff keys with equal prefixes are equal, i.e. ko_key_prefix() is
+	 * the whole key. Then node search never dereferences keys.
+	 */
+	bool          ko_key_prefix_is_key;
 };
 
 /** Stored in m0_be_btree_backlink::bl_type */
@@ -157,6 +175,14 @@ M0_EXTERN const struct m0_fid_type m0_btree_fid_type;
  * Btree construction
  * ------------------------------------------------------------------ */
 
+/**
+ * Initialises btree module: the registry of volatile subtree locks.
+ * Trees initialised without the module execute all updates under the tree
+ * lock.
+ */
+M0_INTERNAL int m0_be_btree_mod_init(void);
+M0_INTERNAL void m0_be_btree_mod_fini(void);
+
 /**
  * Initalises internal structures of the @tree (e.g., mutexes, @ops),
  * located in virtual memory of the program and not in mmaped() segment
@@ -352,6 +378,102 @@ M0_INTERNAL void m0_be_btree_insert(struct m0_be_btree *tree,
 				    const struct m0_buf *key,
 				    const struct m0_buf *value);
 
+/**
+ * Calculates credit for m0_be_btree_bulk_load() of @nr records.
+ *
+ * @param ksize  Maximum key data size.
+ * @param vsize  Maximum value data size.
+ */
+M0_INTERNAL void m0_be_btree_bulk_load_credit(const struct m0_be_btree *tree,
+					      m0_bcount_t               nr,
+					      m0_bcount_t               ksize,
+					      m0_bcount_t               vsize,
+					      struct m0_be_tx_credit   *accum);
+
+/**
+ * Loads @nr records into an empty btree. Operation is asynchronous.
+ *
+ * @keys must be sorted in strictly ascending order. The tree is built bottom-up
+ * with nodes packed as densely as the B-tree occupancy rules allow. Every node
+ * is written and captured exactly once, compared to repeated descents and
+ * splits done by @nr calls to m0_be_btree_insert().
+ *
+ * Credits for this operation should be calculated by
+ * m0_be_btree_bulk_load_credit().
+ *
+ * -ENOMEM is set to @op->bo_u.u_btree.t_rc if there is not enough volatile
+ * memory for the temporary index of the records.
+ */
+M0_INTERNAL void m0_be_btree_bulk_load(struct m0_be_btree  *tree,
+				       struct m0_be_tx     *tx,
+				       struct m0_be_op     *op,
+				       const struct m0_buf *keys,
+				       const struct m0_buf *vals,
+				       m0_bcount_t          nr);
+
+/**
+ * Calculates credit for m0_be_btree_insert_batch() of @nr records.
+ *
+ * @param ksize  Maximum key data size.
+ * @param vsize  Maximum value data size.
+ */
+M0_INTERNAL void
+m0_be_btree_insert_batch_credit(const struct m0_be_btree *tree,
+				m0_bcount_t               nr,
+				m0_bcount_t               ksize,
+				m0_bcount_t               vsize,
+				struct m0_be_tx_credit   *accum);
+
+/**
+ * Inserts @nr records into a btree, which may be non-empty. Operation is
+ * asynchronous.
+ *
+ * @keys must be sorted in strictly ascending order. While the keys fall into
+ * the same leaf, they are inserted without descending from the root, and the
+ * leaf is captured once for all of them. A full leaf is split as by
+ * m0_be_btree_insert().
+ *
+ * If a key already exists, -EEXIST is set to @op->bo_u.u_btree.t_rc. Records
+ * preceding it are inserted, the rest are not.
+ *
+ * Credits for this operation should be calculated by
+ * m0_be_btree_insert_batch_credit().
+ */
+M0_INTERNAL void m0_be_btree_insert_batch(struct m0_be_btree  *tree,
+					  struct m0_be_tx     *tx,
+					  struct m0_be_op     *op,
+					  const struct m0_buf *keys,
+					  const struct m0_buf *vals,
+					  m0_bcount_t          nr);
+
+/**
+ * Calculates credit for m0_be_btree_convert() of at most @limit nodes.
+ */
+M0_INTERNAL void m0_be_btree_convert_credit(const struct m0_be_btree *tree,
+					    m0_bcount_t               limit,
+					    struct m0_be_tx_credit   *accum);
+
+/**
+ * Converts at most @limit nodes of the tree, created before the tree type
+ * defined m0_be_btree_kv_ops::ko_key_prefix(), to node format version 2.
+ * Operation is asynchronous.
+ *
+ * Every converted node is re-allocated and the old node is freed, the records
+ * themselves are not moved. The tree stays usable between calls, nodes of
+ * both formats can be mixed in it.
+ *
+ * -EAGAIN is set to @op->bo_u.u_btree.t_rc if nodes of format version 1
+ * remain, 0 if the whole tree has been converted. The caller repeats the call
+ * in new transactions until it gets 0.
+ *
+ * Credits for this operation should be calculated by
+ * m0_be_btree_convert_credit().
+ */
+M0_INTERNAL void m0_be_btree_convert(struct m0_be_btree *tree,
+				     struct m0_be_tx    *tx,
+				     struct m0_be_op    *op,
+				     m0_bcount_t         limit);
+
 /**
  * This function:
  * - Inserts given @key and @value in btree if @key does not exist.
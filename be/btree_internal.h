@@ -60,14 +60,38 @@ struct m0_be_bnode {
 } M0_XCA_RECORD M0_XCA_DOMAIN(be);
 M0_BASSERT(sizeof(bool) == 1);
 
+/**
+ * Tail of a node of format version 2, placed right after struct m0_be_bnode in
+ * the same allocation.
+ *
+ * bp_prefix[i] is m0_be_btree_kv_ops::ko_key_prefix() of
+ * bt_kv_arr[i].btree_key, for i in [0, bt_num_active_key). Node search
+ * compares these inline prefixes and dereferences a key only when prefixes are
+ * equal.
+ *
+ * The header of such a node points to bp_footer, m0_be_bnode::bt_footer is not
+ * used.
+ */
+struct m0_be_bnode_pfx {
+	uint64_t                     bp_prefix[KV_NR];
+	struct m0_format_footer      bp_footer;
+} M0_XCA_RECORD M0_XCA_DOMAIN(be);
+
 enum m0_be_bnode_format_version {
 	M0_BE_BNODE_FORMAT_VERSION_1 = 1,
+	/**
+	 * Node followed by struct m0_be_bnode_pfx. Used by the trees which
+	 * define m0_be_btree_kv_ops::ko_key_prefix().
+	 */
+	M0_BE_BNODE_FORMAT_VERSION_2,
 
 	/* future versions, uncomment and update M0_BE_BNODE_FORMAT_VERSION */
-	/*M0_BE_BNODE_FORMAT_VERSION_2,*/
 	/*M0_BE_BNODE_FORMAT_VERSION_3,*/
 
-	/** Current version, should point to the latest version present */
+	/**
+	 * Version of the nodes of the trees without key prefixes. Version 2
+	 * does not replace it: a tree selects the format by its kv_ops.
+	 */
 	M0_BE_BNODE_FORMAT_VERSION = M0_BE_BNODE_FORMAT_VERSION_1
 };
 
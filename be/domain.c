@@ -191,6 +191,7 @@ static int be_domain_seg_structs_create(struct m0_be_domain *dom,
 		rc = 0;
 		tx_is_open = false;
 	}
+	m0_be_seg_allocator(seg)->ba_cfg = dom->bd_cfg.bc_alloc_cfg;
 	rc = rc ?: m0_be_allocator_create(m0_be_seg_allocator(seg), tx,
 					  dom->bd_cfg.bc_zone_pcnt,
 					  ARRAY_SIZE(dom->bd_cfg.bc_zone_pcnt));
@@ -226,9 +227,15 @@ static int be_domain_seg_close(struct m0_be_domain *dom,
 	return M0_RC(rc);
 }
 
-static int be_domain_seg_open(struct m0_be_domain *dom,
-			      struct m0_be_seg    *seg,
-			      uint64_t             stob_key)
+/**
+ * Opens segment with the given open cfg. Segments which are opened only to
+ * be destroyed or right after creation use the default (zeroed) cfg, so that
+ * m0_be_domain_cfg::bc_seg_open_cfg doesn't make them read in as a whole.
+ */
+static int be_domain_seg_open_cfg(struct m0_be_domain             *dom,
+				  struct m0_be_seg                *seg,
+				  uint64_t                         stob_key,
+				  const struct m0_be_seg_open_cfg *open_cfg)
 {
 	struct m0_stob *stob;
 	int             rc;
@@ -237,6 +244,7 @@ static int be_domain_seg_open(struct m0_be_domain *dom,
 	if (rc == 0) {
 		m0_be_seg_init(seg, stob, dom, M0_BE_SEG_FAKE_ID);
 		m0_stob_put(stob);
+		seg->bs_open_cfg = *open_cfg;
 		rc = m0_be_seg_open(seg);
 		if (rc == 0) {
 			(void)m0_be_allocator_init(m0_be_seg_allocator(seg),
@@ -253,12 +261,21 @@ static int be_domain_seg_open(struct m0_be_domain *dom,
 	return M0_RC(rc);
 }
 
+static int be_domain_seg_open(struct m0_be_domain *dom,
+			      struct m0_be_seg    *seg,
+			      uint64_t             stob_key)
+{
+	return be_domain_seg_open_cfg(dom, seg, stob_key,
+				      &dom->bd_cfg.bc_seg_open_cfg);
+}
+
 static int be_domain_seg_destroy(struct m0_be_domain *dom,
 				 uint64_t             seg_id)
 {
-	struct m0_be_seg seg;
+	struct m0_be_seg_open_cfg open_cfg = {};
+	struct m0_be_seg          seg;
 
-	return be_domain_seg_open(dom, &seg, seg_id) ?:
+	return be_domain_seg_open_cfg(dom, &seg, seg_id, &open_cfg) ?:
 	       be_domain_seg_close(dom, &seg, true);
 }
 
@@ -267,9 +284,10 @@ static int be_domain_seg_create(struct m0_be_domain              *dom,
 				struct m0_be_seg                 *seg,
 				const struct m0_be_0type_seg_cfg *seg_cfg)
 {
-	struct m0_stob *stob;
-	int             rc;
-	int             rc1;
+	struct m0_be_seg_open_cfg open_cfg = {};
+	struct m0_stob           *stob;
+	int                       rc;
+	int                       rc1;
 
 	rc = be_domain_stob_open(dom, seg_cfg->bsc_stob_key,
 				 seg_cfg->bsc_stob_create_cfg, &stob, true);
@@ -281,7 +299,8 @@ static int be_domain_seg_create(struct m0_be_domain              *dom,
 	m0_be_seg_fini(seg);
 	if (rc != 0)
 		goto out;
-	rc = be_domain_seg_open(dom, seg, seg_cfg->bsc_stob_key);
+	rc = be_domain_seg_open_cfg(dom, seg, seg_cfg->bsc_stob_key,
+				    &open_cfg);
 	if (rc != 0) {
 		M0_LOG(M0_ERROR, "can't open segment after successful "
 		       "creation. seg_cfg->bsc_stob_key = %"PRIu64", rc = %d",
@@ -101,6 +101,8 @@ struct m0_be_domain_cfg {
 	 * The sum of all array elements should be 100.
 	 */
 	uint32_t                     bc_zone_pcnt[M0_BAP_NR];
+	/** Allocator parameters for segments created by the domain. */
+	struct m0_be_allocator_cfg   bc_alloc_cfg;
 
 	/*
 	 * Next fields are for mkfs mode only.
@@ -128,6 +130,8 @@ struct m0_be_domain_cfg {
 	unsigned                     bc_seg_nr;
 	struct m0_be_pd_cfg          bc_pd_cfg;
 	struct m0_be_log_discard_cfg bc_log_discard_cfg;
+	/** Used for every segment opened by the domain, including seg0. */
+	struct m0_be_seg_open_cfg    bc_seg_open_cfg;
 };
 
 struct m0_be_domain {
@@ -32,6 +32,7 @@
 #include "lib/assert.h" /* M0_PRE */
 #include "lib/errno.h"  /* ENOENT */
 #include "lib/memory.h" /* M0_ALLOC */
+#include "lib/hash.h"   /* m0_htable */
 #include "lib/trace.h"
 #include "dtm0/fop.h"  /* dtm0_req_fop */
 #include "motr/magic.h"
@@ -48,6 +49,47 @@ M0_BE_LIST_DESCR_DEFINE(lrec, "DTM0 PLog", static, struct m0_dtm0_log_rec,
 			M0_BE_DTM0_LOG_MAGIX);
 M0_BE_LIST_DEFINE(lrec, static, struct m0_dtm0_log_rec);
 
+static uint64_t lrec_index_hash(const struct m0_htable  *htable,
+				const struct m0_dtm0_tid *id)
+{
+	return (m0_hash(id->dti_ts.dts_phys) ^ m0_fid_hash(&id->dti_fid)) %
+		htable->h_bucket_nr;
+}
+
+/*
+ * Equivalent to m0_dtm0_tid_cmp() == M0_DTS_EQ: all clock sources order
+ * timestamps by dts_phys.
+ */
+static bool lrec_index_key_eq(const struct m0_dtm0_tid *id1,
+			      const struct m0_dtm0_tid *id2)
+{
+	return id1->dti_ts.dts_phys == id2->dti_ts.dts_phys &&
+	       m0_fid_eq(&id1->dti_fid, &id2->dti_fid);
+}
+
+M0_HT_DESCR_DEFINE(lrec_index, "DTM0 Log index", static,
+		   struct m0_dtm0_log_rec, dlr_hlink, dlr_hmagic,
+		   M0_BE_DTM0_LOG_INDEX_MAGIX, M0_BE_DTM0_LOG_INDEX_HEAD_MAGIX,
+		   dlr_txd.dtd_id, lrec_index_hash, lrec_index_key_eq);
+M0_HT_DEFINE(lrec_index, static, struct m0_dtm0_log_rec, struct m0_dtm0_tid);
+
+static void dtm0_log_index_add(struct m0_be_dtm0_log  *log,
+			       struct m0_dtm0_log_rec *rec)
+{
+	M0_PRE(lrec_index_htable_lookup(&log->dl_index,
+					&rec->dlr_txd.dtd_id) == NULL);
+	/* BE allocator does not zero memory, persistent records need this. */
+	m0_tlink_init(&lrec_index_tl, rec);
+	lrec_index_htable_add(&log->dl_index, rec);
+}
+
+static void dtm0_log_index_del(struct m0_be_dtm0_log  *log,
+			       struct m0_dtm0_log_rec *rec)
+{
+	lrec_index_htable_del(&log->dl_index, rec);
+	m0_tlink_fini(&lrec_index_tl, rec);
+}
+
 
 static bool m0_be_dtm0_log__invariant(const struct m0_be_dtm0_log *log)
 {
@@ -95,20 +137,42 @@ M0_INTERNAL int m0_be_dtm0_log_init(struct m0_be_dtm0_log  *log,
 				    struct m0_dtm0_clk_src *cs,
 				    bool                    is_plog)
 {
+	struct m0_dtm0_log_rec *rec;
+	int                     rc;
+
 	M0_PRE(log != NULL);
 	M0_PRE(cs != NULL);
 
+	rc = lrec_index_htable_init(&log->dl_index,
+				    M0_BE_DTM0_LOG_INDEX_BUCKET_NR);
+	if (rc != 0)
+		return M0_ERR(rc);
 	m0_mutex_init(&log->dl_lock);
 	log->dl_is_persistent = is_plog;
 	log->dl_cs = cs;
+	if (is_plog) {
+		m0_be_list_for(lrec, log->u.dl_persist, rec) {
+			dtm0_log_index_add(log, rec);
+		} m0_be_list_endfor;
+	}
 	return 0;
 }
 
 M0_INTERNAL void m0_be_dtm0_log_fini(struct m0_be_dtm0_log *log)
 {
+	struct m0_dtm0_log_rec *rec;
+
 	M0_PRE(m0_be_dtm0_log__invariant(log));
+	if (log->dl_is_persistent) {
+		/* Records stay in BE, only the volatile index goes away. */
+		m0_be_list_for(lrec, log->u.dl_persist, rec) {
+			dtm0_log_index_del(log, rec);
+		} m0_be_list_endfor;
+	} else {
+		lrec_tlist_fini(log->u.dl_inmem);
+	}
+	lrec_index_htable_fini(&log->dl_index);
 	m0_mutex_fini(&log->dl_lock);
-	lrec_tlist_fini(log->u.dl_inmem);
 	log->dl_cs = NULL;
 }
 
@@ -249,24 +313,17 @@ M0_INTERNAL
 struct m0_dtm0_log_rec *m0_be_dtm0_log_find(struct m0_be_dtm0_log    *log,
 					    const struct m0_dtm0_tid *id)
 {
+	struct m0_dtm0_log_rec *rec;
+
 	M0_PRE(m0_be_dtm0_log__invariant(log));
 	M0_PRE(m0_dtm0_tid__invariant(id));
 	M0_PRE(m0_mutex_is_locked(&log->dl_lock));
 
-	if (log->dl_is_persistent) {
-		struct m0_dtm0_log_rec *lrec;
-
-		m0_be_list_for(lrec, log->u.dl_persist, lrec) {
-			if (m0_dtm0_tid_cmp(log->dl_cs, &lrec->dlr_txd.dtd_id,
-					    id) == M0_DTS_EQ)
-				break;
-		} m0_be_list_endfor;
-		return lrec;
-	} else {
-		return m0_tl_find(lrec, rec, log->u.dl_inmem,
-				  m0_dtm0_tid_cmp(log->dl_cs, &rec->dlr_txd.dtd_id,
-						  id) == M0_DTS_EQ);
-	}
+	rec = lrec_index_htable_lookup(&log->dl_index, id);
+	M0_POST(ergo(rec != NULL,
+		     m0_dtm0_tid_cmp(log->dl_cs, &rec->dlr_txd.dtd_id,
+				     id) == M0_DTS_EQ));
+	return rec;
 }
 
 static int log_rec_init(struct m0_dtm0_log_rec **rec,
@@ -395,6 +452,7 @@ static int dtm0_log__insert(struct m0_be_dtm0_log  *log,
 			return rc;
 		lrec_tlink_init_at_tail(rec, log->u.dl_inmem);
 	}
+	dtm0_log_index_add(log, rec);
 
 	return rc;
 }
@@ -465,10 +523,14 @@ M0_INTERNAL int m0_be_dtm0_log_prune(struct m0_be_dtm0_log    *log,
 	M0_PRE(m0_dtm0_tid__invariant(id));
 	M0_PRE(m0_mutex_is_locked(&log->dl_lock));
 
+	if (m0_be_dtm0_log_find(log, id) == NULL)
+		return -ENOENT;
+
 	/*
 	 * Iterate over the log records from the begining and check whether all
 	 * the records preceeding this are persistent. If not, we cannot prune
-	 * the record with the given id.
+	 * the record with the given id. The cost of the walk is proportional
+	 * to the number of records pruned.
 	 */
 
 	m0_tl_for (lrec, log->u.dl_inmem, rec) {
@@ -488,9 +550,11 @@ M0_INTERNAL int m0_be_dtm0_log_prune(struct m0_be_dtm0_log    *log,
 	 * previous records and then this record. */
 	while ((currec = lrec_tlist_pop(log->u.dl_inmem)) != rec) {
 		M0_ASSERT(m0_dtm0_log_rec__invariant(currec));
+		dtm0_log_index_del(log, currec);
 		log_rec_fini(&currec, tx);
 	}
 
+	dtm0_log_index_del(log, rec);
 	log_rec_fini(&rec, tx);
 	return rc;
 }
@@ -510,6 +574,7 @@ M0_INTERNAL void m0_be_dtm0_log_clear(struct m0_be_dtm0_log *log)
 		M0_ASSERT(m0_dtm0_log_rec__invariant(rec));
 		M0_ASSERT(m0_dtm0_tx_desc_state_eq(&rec->dlr_dtx.dd_txd,
 						   M0_DTPS_PERSISTENT));
+		dtm0_log_index_del(log, rec);
 		log_rec_fini(&rec, NULL);
 	}
 	M0_POST(lrec_tlist_is_empty(log->u.dl_inmem));
@@ -527,6 +592,7 @@ M0_INTERNAL int m0_be_dtm0_volatile_log_insert(struct m0_be_dtm0_log  *log,
 		return M0_ERR(rc);
 
 	lrec_tlink_init_at_tail(rec, log->u.dl_inmem);
+	dtm0_log_index_add(log, rec);
 	return M0_RC(rc);
 }
 
@@ -562,6 +628,9 @@ M0_INTERNAL bool m0_be_dtm0_plog_can_prune(struct m0_be_dtm0_log    *log,
 	M0_PRE(m0_dtm0_tid__invariant(id));
 	M0_PRE(m0_mutex_is_locked(&log->dl_lock));
 
+	if (m0_be_dtm0_log_find(log, id) == NULL)
+		return false;
+
 	m0_be_list_for(lrec, persist, rec) {
 		if (!m0_dtm0_tx_desc_state_eq(&rec->dlr_txd, M0_DTPS_PERSISTENT))
 			return false;
@@ -594,9 +663,14 @@ M0_INTERNAL int m0_be_dtm0_plog_prune(struct m0_be_dtm0_log    *log,
 	M0_PRE(m0_dtm0_tid__invariant(id));
 	M0_PRE(m0_mutex_is_locked(&log->dl_lock));
 
+	/* Without this check a missing id would prune the whole log. */
+	if (m0_be_dtm0_log_find(log, id) == NULL)
+		return M0_ERR(-ENOENT);
+
 	m0_be_list_for(lrec, log->u.dl_persist, rec) {
 		cur_id = rec->dlr_txd.dtd_id;
 
+		dtm0_log_index_del(log, rec);
 		lrec_be_list_del(log->u.dl_persist, tx, rec);
 		lrec_be_tlink_destroy(rec, tx);
 		plog_rec_fini(&rec, log, tx);
@@ -27,6 +27,7 @@
 #include "dtm0/tx_desc.h"       /* m0_dtm0_tx_desc */
 #include "fid/fid.h"            /* m0_fid */
 #include "lib/buf.h"            /* m0_buf */
+#include "lib/hash.h"           /* m0_htable */
 #include "dtm0/dtx.h"           /* struct m0_dtm0_dtx */
 
 struct m0_be_tx;
@@ -155,6 +156,8 @@ enum m0_be_dtm0_log_credit_op {
  * - dlr_dtx: This stores dtx information related to dtm0 client.
  * - dlr_txd: This stores the states of the participants.
  * - dlr_payload: This stores the original request.
+ * - dlr_hlink: Linkage into m0_be_dtm0_log::dl_index. It is volatile even
+ *   for the records of a persistent log, its value in BE is meaningless.
  */
 
 struct m0_dtm0_log_rec {
@@ -176,6 +179,8 @@ struct m0_dtm0_log_rec {
 						   */
 	} u;
 	struct m0_buf          dlr_payload;
+	struct m0_hlink        dlr_hlink;
+	uint64_t               dlr_hmagic;
 };
 
 /**
@@ -187,8 +192,16 @@ struct m0_dtm0_log_rec {
  * (client-side) log and a persistent (server-side) log.
  * - dl_cs: A pointer to the type of clock used to generate the timestamps
  * for the log records.
+ * - dl_index: Volatile hash of the log records keyed by their tx id, used by
+ * m0_be_dtm0_log_find() instead of the list scan. The list stays the
+ * ordered (insertion order) store used for pruning.
  */
 
+enum {
+	/** Number of buckets in m0_be_dtm0_log::dl_index. */
+	M0_BE_DTM0_LOG_INDEX_BUCKET_NR = 4096,
+};
+
 struct m0_be_dtm0_log {
 	/** Indicates if the structure is a persistent or volatile */
 	bool                       dl_is_persistent;
@@ -205,6 +218,12 @@ struct m0_be_dtm0_log {
 		/** Volatile list, used if !dl_is_persistent */
 		struct m0_tl      *dl_inmem;
 	} u;
+	/**
+	 * Index of the records in the list by m0_dtm0_tx_desc::dtd_id.
+	 * Volatile, protected by dl_lock. For a persistent log it is rebuilt
+	 * from the list by m0_be_dtm0_log_init().
+	 */
+	struct m0_htable           dl_index;
 };
 
 /**
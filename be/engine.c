@@ -507,8 +507,12 @@ static bool be_engine_recovery_is_finished(struct m0_be_engine *en)
 
 static void be_engine_recovery_finish(struct m0_be_engine *en)
 {
+	size_t i;
+
 	M0_PRE(be_engine_is_locked(en));
 
+	for (i = 0; i < en->eng_group_nr; ++i)
+		m0_be_tx_group_recovery_done(&en->eng_group[i]);
 	en->eng_recovery_finished = true;
 	m0_semaphore_up(&en->eng_recovery_wait_sem);
 }
@@ -33,6 +33,7 @@
 #include "lib/memory.h"
 #include "lib/tlist.h"
 #include "lib/ext.h"            /* M0_EXT */
+#include "lib/string.h"         /* memcpy */
 #include "motr/magic.h"
 #include "module/instance.h"    /* m0_get */
 
@@ -85,6 +86,7 @@ static int be_log_level_enter(struct m0_module *module)
 		log->lg_prev_record      = 0;
 		log->lg_prev_record_size = 0;
 		log->lg_unplaced_exists  = false;
+		log->lg_ra               = (struct m0_be_log_ra){};
 		m0_mutex_init(&log->lg_record_state_lock);
 		record_tlist_init(&log->lg_records);
 		m0_be_op_init(&log->lg_header_read_op);
@@ -1031,6 +1033,191 @@ out:
 	return rc;
 }
 
+static int be_log_ra_window_init(struct m0_be_log           *log,
+				 struct m0_be_log_ra_window *win,
+				 m0_bcount_t                 size)
+{
+	struct m0_be_io_credit iocred = M0_BE_IO_CREDIT(1, size, 1);
+	uint32_t               bshift = m0_be_log_bshift(log);
+	int                    rc;
+
+	*win = (struct m0_be_log_ra_window){};
+	win->lrw_buf = m0_alloc_aligned(size, bshift);
+	if (win->lrw_buf == NULL)
+		return M0_ERR(-ENOMEM);
+	be_log_io_credit(log, &iocred);
+	rc = m0_be_io_init(&win->lrw_io);
+	if (rc == 0) {
+		rc = m0_be_io_allocate(&win->lrw_io, &iocred);
+		if (rc != 0)
+			m0_be_io_fini(&win->lrw_io);
+	}
+	if (rc != 0) {
+		m0_free_aligned(win->lrw_buf, size, bshift);
+		return M0_ERR(rc);
+	}
+	m0_be_op_init(&win->lrw_op);
+	return 0;
+}
+
+static void be_log_ra_window_launch(struct m0_be_log           *log,
+				    struct m0_be_log_ra_window *win,
+				    m0_bindex_t                 pos)
+{
+	M0_PRE(!win->lrw_inflight);
+	M0_PRE(m0_is_aligned(pos, 1ULL << m0_be_log_bshift(log)));
+
+	win->lrw_pos      = pos;
+	win->lrw_size     = 0;
+	win->lrw_inflight = true;
+	m0_be_io_reset(&win->lrw_io);
+	m0_be_io_add_nostob(&win->lrw_io, win->lrw_buf, 0, log->lg_ra.lra_size);
+	m0_be_log_store_io_translate(&log->lg_store, pos, &win->lrw_io);
+	m0_be_io_configure(&win->lrw_io, SIO_READ);
+	m0_be_op_reset(&win->lrw_op);
+	m0_be_io_launch(&win->lrw_io, &win->lrw_op);
+}
+
+static int be_log_ra_window_wait(struct m0_be_log           *log,
+				 struct m0_be_log_ra_window *win)
+{
+	int rc = 0;
+
+	if (win->lrw_inflight) {
+		m0_be_op_wait(&win->lrw_op);
+		rc = win->lrw_op.bo_sm.sm_rc;
+		win->lrw_inflight = false;
+		win->lrw_size     = rc == 0 ? log->lg_ra.lra_size : 0;
+	}
+	return rc;
+}
+
+static void be_log_ra_window_fini(struct m0_be_log           *log,
+				  struct m0_be_log_ra_window *win)
+{
+	(void)be_log_ra_window_wait(log, win);
+	m0_be_op_fini(&win->lrw_op);
+	m0_be_io_deallocate(&win->lrw_io);
+	m0_be_io_fini(&win->lrw_io);
+	m0_free_aligned(win->lrw_buf, log->lg_ra.lra_size,
+			m0_be_log_bshift(log));
+}
+
+static bool be_log_ra_window_has(const struct m0_be_log_ra_window *win,
+				 m0_bindex_t                       pos,
+				 m0_bcount_t                       size)
+{
+	return !win->lrw_inflight && win->lrw_size != 0 &&
+	       win->lrw_pos <= pos &&
+	       pos + size <= win->lrw_pos + win->lrw_size;
+}
+
+M0_INTERNAL int m0_be_log_ra_init(struct m0_be_log *log, m0_bcount_t size)
+{
+	struct m0_be_log_ra *ra    = &log->lg_ra;
+	uint64_t             align = 1ULL << m0_be_log_bshift(log);
+	int                  rc    = 0;
+	int                  i;
+
+	M0_PRE(ra->lra_size == 0);
+
+	size = min_check(size, m0_be_log_store_buf_size(&log->lg_store));
+	size &= ~(align - 1);
+	if (size == 0)
+		return 0;
+	for (i = 0; i < ARRAY_SIZE(ra->lra_win); ++i) {
+		rc = be_log_ra_window_init(log, &ra->lra_win[i], size);
+		if (rc != 0)
+			break;
+	}
+	ra->lra_size = size;
+	if (rc != 0) {
+		while (--i >= 0)
+			be_log_ra_window_fini(log, &ra->lra_win[i]);
+		*ra = (struct m0_be_log_ra){};
+	}
+	return M0_RC(rc);
+}
+
+M0_INTERNAL void m0_be_log_ra_fini(struct m0_be_log *log)
+{
+	struct m0_be_log_ra *ra = &log->lg_ra;
+	int                  i;
+
+	if (ra->lra_size == 0)
+		return;
+	M0_LOG(M0_DEBUG, "lra_size=%"PRIu64" lra_hits=%"PRIu64
+	       " lra_misses=%"PRIu64" lra_backward=%"PRIu64, ra->lra_size,
+	       ra->lra_hits, ra->lra_misses, ra->lra_backward);
+	for (i = 0; i < ARRAY_SIZE(ra->lra_win); ++i)
+		be_log_ra_window_fini(log, &ra->lra_win[i]);
+	*ra = (struct m0_be_log_ra){};
+}
+
+/**
+ * Serves the read from the read-ahead windows and keeps the window following
+ * the current one in flight, so sequential scanning waits for I/O only when
+ * it outruns the read-ahead.
+ */
+static int be_log_ra_read(struct m0_be_log *log,
+			  m0_bindex_t       pos,
+			  m0_bcount_t       size,
+			  void             *out)
+{
+	struct m0_be_log_ra        *ra   = &log->lg_ra;
+	struct m0_be_log_ra_window *win  = &ra->lra_win[ra->lra_cur];
+	struct m0_be_log_ra_window *next = &ra->lra_win[!ra->lra_cur];
+	m0_bindex_t                 next_pos;
+	int                         rc;
+
+	M0_PRE(size <= ra->lra_size);
+
+	if (be_log_ra_window_has(win, pos, size)) {
+		++ra->lra_hits;
+	} else if (be_log_ra_window_wait(log, next) == 0 &&
+		   be_log_ra_window_has(next, pos, size)) {
+		++ra->lra_hits;
+		ra->lra_cur = !ra->lra_cur;
+		M0_SWAP(win, next);
+	} else {
+		++ra->lra_misses;
+		be_log_ra_window_launch(log, win, pos);
+		rc = be_log_ra_window_wait(log, win);
+		if (rc != 0) {
+			m0_be_io_err_send(-rc, M0_BE_LOC_LOG, SIO_READ);
+			return M0_ERR(rc);
+		}
+	}
+	memcpy(out, win->lrw_buf + (pos - win->lrw_pos), size);
+
+	next_pos = win->lrw_pos + ra->lra_size;
+	if (!next->lrw_inflight &&
+	    !(next->lrw_size != 0 && next->lrw_pos == next_pos))
+		be_log_ra_window_launch(log, next, next_pos);
+	return 0;
+}
+
+static int be_log_read(struct m0_be_log *log,
+		       m0_bindex_t       pos,
+		       m0_bcount_t       size,
+		       void             *out)
+{
+	struct m0_be_log_ra        *ra = &log->lg_ra;
+	struct m0_be_log_ra_window *win;
+	bool                        backward;
+
+	if (ra->lra_size == 0 || size > ra->lra_size)
+		return be_log_read_plain(log, pos, size, out);
+	backward = pos < ra->lra_pos;
+	ra->lra_pos = pos;
+	win = &ra->lra_win[ra->lra_cur];
+	if (backward && !be_log_ra_window_has(win, pos, size)) {
+		++ra->lra_backward;
+		return be_log_read_plain(log, pos, size, out);
+	}
+	return be_log_ra_read(log, pos, size, out);
+}
+
 M0_INTERNAL bool m0_be_fmt_log_record_header__invariant(
 				struct m0_be_fmt_log_record_header *header,
 				struct m0_be_log                   *log)
@@ -1097,7 +1284,7 @@ static int be_log_record_iter_read(struct m0_be_log             *log,
 	bvec     = M0_BUFVEC_INIT_BUF(&addr_fmt, &size_fmt);
 	m0_bufvec_cursor_init(&cur, &bvec);
 	pos &= ~((m0_bindex_t)align - 1);
-	rc   = be_log_read_plain(log, pos, size, data);
+	rc   = be_log_read(log, pos, size, data);
 	rc   = rc ?: m0_be_fmt_log_record_header_decode(&header, &cur,
 						M0_BE_FMT_DECODE_CFG_DEFAULT);
 	if (rc == -EPROTO)
@@ -1115,8 +1302,8 @@ static int be_log_record_iter_read(struct m0_be_log             *log,
 		addr_fmt = data + size - size_fmt;
 		bvec     = M0_BUFVEC_INIT_BUF(&addr_fmt, &size_fmt);
 		m0_bufvec_cursor_init(&cur, &bvec);
-		rc = be_log_read_plain(log, pos + header->lrh_size - size,
-				       size, data);
+		rc = be_log_read(log, pos + header->lrh_size - size,
+				 size, data);
 		rc = rc ?: m0_be_fmt_log_record_footer_decode(&footer, &cur,
 					      M0_BE_FMT_DECODE_CFG_DEFAULT);
 		if (rc == 0) {
@@ -257,6 +257,51 @@ struct m0_be_log_cfg {
 	bool                        lc_skip_recovery;
 };
 
+enum {
+	/** Default size of a read-ahead window, see m0_be_log_ra_init(). */
+	M0_BE_LOG_RA_SIZE = 1 << 22,
+};
+
+/** Contiguous piece of the log read (or being read) into memory. */
+struct m0_be_log_ra_window {
+	char           *lrw_buf;
+	/** Log position of lrw_buf[0]. */
+	m0_bindex_t     lrw_pos;
+	/** Number of valid bytes in lrw_buf, 0 if nothing was read yet. */
+	m0_bcount_t     lrw_size;
+	/** Read for the window was launched and its op is not waited yet. */
+	bool            lrw_inflight;
+	struct m0_be_io lrw_io;
+	struct m0_be_op lrw_op;
+};
+
+/**
+ * Read-ahead for sequential log scanning.
+ *
+ * Log records are scanned during recovery by reading header and footer of
+ * each record. Without read-ahead it is two small synchronous reads per
+ * record. When read-ahead is enabled, log is read by lra_size windows: reads
+ * are served from the current window while the next window is read
+ * asynchronously.
+ *
+ * Only forward scanning is read ahead. A read before the previous one, which
+ * is not in the current window, is done directly without touching the
+ * windows: m0_be_log_record_prev() would never get to the next window.
+ */
+struct m0_be_log_ra {
+	/** Window size, 0 if read-ahead is disabled. */
+	m0_bcount_t                lra_size;
+	struct m0_be_log_ra_window lra_win[2];
+	/** Index of the window reads are served from. */
+	unsigned                   lra_cur;
+	/** Log position of the previous read. */
+	m0_bindex_t                lra_pos;
+	uint64_t                   lra_hits;
+	uint64_t                   lra_misses;
+	/** Backward reads done without read-ahead. */
+	uint64_t                   lra_backward;
+};
+
 /** This structure encapsulates internals of transactional log. */
 struct m0_be_log {
 	struct m0_be_log_cfg     lg_cfg;
@@ -312,6 +357,8 @@ struct m0_be_log {
 	struct m0_be_op          lg_header_read_op;
 	/* op for log header write */
 	struct m0_be_op          lg_header_write_op;
+	/** Read-ahead for m0_be_log_record_initial/next/prev(). */
+	struct m0_be_log_ra      lg_ra;
 };
 
 /* m0_be_log */
@@ -496,6 +543,16 @@ M0_INTERNAL int m0_be_log_record_next(struct m0_be_log                   *log,
 M0_INTERNAL int m0_be_log_record_prev(struct m0_be_log *log,
 				      const struct m0_be_log_record_iter *curr,
 				      struct m0_be_log_record_iter       *prev);
+/**
+ * Enables read-ahead for m0_be_log_record_initial/next/prev().
+ *
+ * Window size is limited by the size of the log.
+ *
+ * @see m0_be_log_ra
+ */
+M0_INTERNAL int m0_be_log_ra_init(struct m0_be_log *log, m0_bcount_t size);
+/** Waits for the pending read-ahead and disables read-ahead. */
+M0_INTERNAL void m0_be_log_ra_fini(struct m0_be_log *log);
 M0_INTERNAL bool m0_be_fmt_log_record_header__invariant(
 				struct m0_be_fmt_log_record_header *header,
 				struct m0_be_log                   *log);
@@ -28,8 +28,10 @@
 #include "lib/arith.h"          /* max_check */
 #include "lib/errno.h"          /* -ENOSYS */
 #include "lib/memory.h"
+#include "addb2/addb2.h"        /* M0_ADDB2_ADD */
 #include "be/fmt.h"
 #include "be/log.h"
+#include "be/addb2.h"           /* M0_AVI_BE_RECOVERY_PROGRESS */
 #include "motr/magic.h"         /* M0_BE_RECOVERY_MAGIC */
 
 /**
@@ -138,8 +140,17 @@
  * Note: BE log operates with a log record that is representation of
  * transactional group in the log.
  *
+ * Scanning reads only headers and footers of log records, but it walks the
+ * whole log-only part of the log. Log read-ahead (m0_be_log_ra) is enabled for
+ * the forward part of the scan, so the log is read by large windows and the
+ * next window is read asynchronously while the current one is decoded. It is
+ * disabled before the backward walk to the last discarded record, which
+ * reads records in the opposite direction.
+ *
  * <b>Iterative interface for looking over groups that need to be re-applied</b>
- * Recovery provides interface for pick next group for re-applying.
+ * Recovery provides interface for pick next group for re-applying. Regions of
+ * a group don't overlap, so tx_group copies them to segments in parallel, see
+ * m0_be_tx_group_reapply().
  */
 
 M0_TL_DESCR_DEFINE(log_record_iter, "m0_be_log_record_iter list in recovery",
@@ -150,7 +161,10 @@ M0_TL_DEFINE(log_record_iter, static, struct m0_be_log_record_iter);
 M0_INTERNAL void m0_be_recovery_init(struct m0_be_recovery     *rvr,
                                      struct m0_be_recovery_cfg *cfg)
 {
-	rvr->brec_cfg = *cfg;
+	rvr->brec_cfg   = *cfg;
+	rvr->brec_total = 0;
+	rvr->brec_done  = 0;
+	rvr->brec_start = 0;
 	m0_mutex_init(&rvr->brec_lock);
 	log_record_iter_tlist_init(&rvr->brec_iters);
 }
@@ -190,6 +204,7 @@ M0_INTERNAL int m0_be_recovery_run(struct m0_be_recovery *rvr)
 	m0_bindex_t                   last_discarded;
 	m0_bindex_t                   log_discarded;
 	m0_bindex_t                   next_pos = M0_BINDEX_MAX;
+	m0_time_t                     start;
 	int                           rc;
 
 	M0_ENTRY("rvr = %p, log = %p", rvr, log);
@@ -202,6 +217,11 @@ M0_INTERNAL int m0_be_recovery_run(struct m0_be_recovery *rvr)
 	log_discarded = log_hdr.flh_discarded;
 	M0_LOG(M0_DEBUG, "log_discarded=%"PRIu64, log_discarded);
 
+	start = m0_time_now();
+	rc = m0_be_log_ra_init(log, M0_BE_LOG_RA_SIZE);
+	if (rc != 0)
+		M0_LOG(M0_WARN, "log read-ahead is disabled: rc=%d", rc);
+
 	rc = be_recovery_log_record_iter_new(&iter);
 	rc = rc ?: m0_be_log_record_initial(log, iter);
 	while (rc == 0) {
@@ -240,6 +260,7 @@ M0_INTERNAL int m0_be_recovery_run(struct m0_be_recovery *rvr)
 		goto empty;
 	}
 
+	m0_be_log_ra_fini(log);
 	rc = 0;
 	while (rc == 0 && prev->lri_header.lrh_pos > last_discarded) {
 		rc = be_recovery_log_record_iter_new(&iter);
@@ -266,6 +287,13 @@ M0_INTERNAL int m0_be_recovery_run(struct m0_be_recovery *rvr)
 	rvr->brec_current          = rvr->brec_last_record_pos +
 				     rvr->brec_last_record_size;
 	rvr->brec_discarded        = prev->lri_header.lrh_pos;
+	rvr->brec_total            = m0_tl_reduce(log_record_iter, scan,
+						  &rvr->brec_iters,
+						  (m0_bcount_t)0,
+						  + scan->lri_header.lrh_size);
+	M0_LOG(M0_INFO, "Recovery scan: %"PRIu64" bytes to re-apply, "
+	       "scanned in "TIME_F, rvr->brec_total,
+	       TIME_P(m0_time_sub(m0_time_now(), start)));
 	M0_LOG(M0_DEBUG, "Recovery scan complete : last_record_pos=%"PRIu64
 			 " last_record_size=%"PRIu64
 			 " current position=%"PRIu64
@@ -301,6 +329,7 @@ empty:
 			 rvr->brec_discarded);
 	M0_POST(log_record_iter_tlist_is_empty(&rvr->brec_iters));
 out:
+	m0_be_log_ra_fini(log);
 	m0_be_fmt_log_header_fini(&log_hdr);
 	M0_LEAVE();
 	return rc;
@@ -323,9 +352,20 @@ m0_be_recovery_log_record_get(struct m0_be_recovery        *rvr,
 			      struct m0_be_log_record_iter *iter)
 {
 	struct m0_be_log_record_iter *next;
+	uint64_t                      elapsed;
 
 	m0_mutex_lock(&rvr->brec_lock);
 	next = log_record_iter_tlist_pop(&rvr->brec_iters);
+	if (next != NULL) {
+		if (rvr->brec_start == 0)
+			rvr->brec_start = m0_time_now();
+		rvr->brec_done += next->lri_header.lrh_size;
+	}
+	elapsed = m0_time_sub(m0_time_now(), rvr->brec_start) /
+		  M0_TIME_ONE_MSEC;
+	M0_ADDB2_ADD(M0_AVI_BE_RECOVERY_PROGRESS, rvr->brec_done,
+		     rvr->brec_total,
+		     rvr->brec_done * 1000 / max_check(elapsed, (uint64_t)1));
 	m0_mutex_unlock(&rvr->brec_lock);
 	M0_ASSERT(next != NULL);
 	m0_be_log_record_iter_copy(iter, next);
@@ -28,6 +28,7 @@
 #include "lib/tlist.h"          /* m0_tl */
 #include "lib/mutex.h"          /* m0_mutex */
 #include "lib/types.h"          /* bool */
+#include "lib/time.h"           /* m0_time_t */
 
 /**
  * @page recovery-fspec Recovery Functional Specification
@@ -68,6 +69,12 @@ struct m0_be_recovery {
 	m0_bcount_t               brec_last_record_size;
 	m0_bindex_t               brec_current;
 	m0_bindex_t               brec_discarded;
+	/** Total size of log records to be re-applied. */
+	m0_bcount_t               brec_total;
+	/** Size of log records given by m0_be_recovery_log_record_get(). */
+	m0_bcount_t               brec_done;
+	/** Time of the first m0_be_recovery_log_record_get() call. */
+	m0_time_t                 brec_start;
 };
 
 M0_INTERNAL void m0_be_recovery_init(struct m0_be_recovery     *rvr,
@@ -76,6 +83,9 @@ M0_INTERNAL void m0_be_recovery_fini(struct m0_be_recovery *rvr);
 /**
  * Scans log for all log records that need to be re-applied and stores them in
  * the list of log-only records.
+ *
+ * Log is read with read-ahead (see m0_be_log_ra), so the scan issues large
+ * asynchronous reads instead of two small reads per log record.
  */
 M0_INTERNAL int m0_be_recovery_run(struct m0_be_recovery *rvr);
 
@@ -87,6 +97,9 @@ m0_be_recovery_log_record_available(struct m0_be_recovery *rvr);
  * Picks the next log record from the list of log-only records. Must not be
  * called if m0_be_recovery_log_record_available() returns false.
  *
+ * Adds M0_AVI_BE_RECOVERY_PROGRESS addb2 record with the recovery progress and
+ * throughput.
+ *
  * @param iter Log record iterator where header of the log record is stored.
  */
 M0_INTERNAL void
@@ -30,6 +30,7 @@
 #include "lib/errno.h"        /* ENOMEM */
 #include "lib/time.h"         /* m0_time_now */
 #include "lib/atomic.h"       /* m0_atomic64 */
+#include "lib/thread_pool.h"  /* m0_parallel_pool */
 
 #include "motr/version.h"     /* m0_build_info_get */
 
@@ -321,13 +322,137 @@ static void be_seg_madvise(struct m0_be_seg *seg, m0_bcount_t dump_limit,
 
 }
 
+static bool be_seg_is_anon(const struct m0_be_seg *seg)
+{
+	return seg->bs_open_cfg.soc_prefault == M0_BE_SEG_PREFAULT_READ ||
+	       seg->bs_open_cfg.soc_hugepage != M0_BE_SEG_HUGEPAGE_NONE;
+}
+
+static int be_seg_map(struct m0_be_seg *seg, const struct m0_be_seg_geom *g)
+{
+	const struct m0_be_seg_open_cfg *cfg   = &seg->bs_open_cfg;
+	int                              flags;
+	int                              fd;
+	off_t                            offset;
+	void                            *p;
+
+	flags = MAP_FIXED | MAP_PRIVATE;
+	if (be_seg_is_anon(seg)) {
+		/*
+		 * Anonymous pages can't be dropped and read again from the
+		 * stob, so the whole segment is reserved at mmap() time:
+		 * without it a hugetlb pool shortage or an overcommit would
+		 * show up as SIGBUS or OOM on access instead of an error here.
+		 */
+		fd     = -1;
+		offset = 0;
+		flags |= MAP_ANONYMOUS;
+		if (cfg->soc_hugepage == M0_BE_SEG_HUGEPAGE_HUGETLB)
+			flags |= MAP_HUGETLB;
+	} else {
+		fd     = m0_stob_fd(seg->bs_stob);
+		offset = g->sg_offset;
+		flags |= MAP_NORESERVE;
+		if (cfg->soc_prefault == M0_BE_SEG_PREFAULT_POPULATE)
+			flags |= MAP_POPULATE;
+	}
+	p = mmap(g->sg_addr, g->sg_size, PROT_READ | PROT_WRITE,
+		 flags, fd, offset);
+	if (p != g->sg_addr)
+		return M0_ERR_INFO(-errno, "p=%p g->sg_addr=%p fd=%d flags=%x",
+				   p, g->sg_addr, fd, flags);
+	/* THP is an optimisation only, the segment is usable without it. */
+	if (cfg->soc_hugepage == M0_BE_SEG_HUGEPAGE_THP &&
+	    madvise(g->sg_addr, g->sg_size, MADV_HUGEPAGE) != 0)
+		M0_LOG(M0_WARN, "madvise(%p, %"PRIu64", MADV_HUGEPAGE) "
+		       "errno=%d", g->sg_addr, g->sg_size, errno);
+	return M0_RC(0);
+}
+
+struct be_seg_read_job {
+	struct m0_stob *srj_stob;
+	void           *srj_addr;
+	m0_bindex_t     srj_offset;
+	m0_bcount_t     srj_size;
+};
+
+static int be_seg_read_job_process(void *data)
+{
+	struct be_seg_read_job *job = data;
+
+	return m0_be_io_single(job->srj_stob, SIO_READ, job->srj_addr,
+			       job->srj_offset, job->srj_size);
+}
+
+/**
+ * Reads the whole segment described by @g into its mapping.
+ *
+ * The first M0_BE_SEG_READ_SIZE_MAX bytes are read synchronously: they
+ * contain the structures needed right after the segment is opened
+ * (allocator header, segment dictionary). The rest is split into
+ * M0_BE_SEG_READ_SIZE_MAX chunks which are read in parallel.
+ */
+static int be_seg_read_all(struct m0_be_seg             *seg,
+			   const struct m0_be_seg_geom *g)
+{
+	struct m0_parallel_pool  pool = {};
+	struct be_seg_read_job  *jobs;
+	m0_bcount_t              head;
+	m0_bcount_t              pos;
+	m0_time_t                start = m0_time_now();
+	unsigned                 thread_nr;
+	int                      nr;
+	int                      i;
+	int                      rc;
+
+	head = min_check(g->sg_size, (m0_bcount_t)M0_BE_SEG_READ_SIZE_MAX);
+	rc = m0_be_io_single(seg->bs_stob, SIO_READ,
+			     g->sg_addr, g->sg_offset, head);
+	if (rc != 0 || head == g->sg_size)
+		return M0_RC(rc);
+
+	nr = (g->sg_size - head + M0_BE_SEG_READ_SIZE_MAX - 1) /
+		M0_BE_SEG_READ_SIZE_MAX;
+	thread_nr = seg->bs_open_cfg.soc_thread_nr ?:
+		    M0_BE_SEG_READ_THREAD_NR;
+	thread_nr = min_check(thread_nr, (unsigned)nr);
+	M0_ALLOC_ARR(jobs, nr);
+	if (jobs == NULL)
+		return M0_ERR(-ENOMEM);
+	rc = m0_parallel_pool_init(&pool, thread_nr, nr);
+	if (rc != 0) {
+		m0_free(jobs);
+		return M0_ERR(rc);
+	}
+	for (i = 0, pos = head; i < nr; ++i) {
+		jobs[i] = (struct be_seg_read_job) {
+			.srj_stob   = seg->bs_stob,
+			.srj_addr   = g->sg_addr + pos,
+			.srj_offset = g->sg_offset + pos,
+			.srj_size   = min_check(g->sg_size - pos,
+				      (m0_bcount_t)M0_BE_SEG_READ_SIZE_MAX),
+		};
+		pos += jobs[i].srj_size;
+		rc = m0_parallel_pool_job_add(&pool, &jobs[i]);
+		M0_ASSERT(rc == 0);
+	}
+	M0_ASSERT(pos == g->sg_size);
+	m0_parallel_pool_start(&pool, &be_seg_read_job_process);
+	rc = m0_parallel_pool_wait(&pool);
+	m0_parallel_pool_terminate_wait(&pool);
+	m0_parallel_pool_fini(&pool);
+	m0_free(jobs);
+	M0_LOG(M0_INFO, "seg=%p size=%"PRIu64" threads=%u rc=%d "
+	       "time=%"PRIu64" ms", seg, g->sg_size, thread_nr, rc,
+	       m0_time_sub(m0_time_now(), start) / M0_TIME_ONE_MSEC);
+	return M0_RC(rc);
+}
+
 M0_INTERNAL int m0_be_seg_open(struct m0_be_seg *seg)
 {
 	const struct m0_be_seg_geom *g;
 	struct m0_be_seg_hdr        *hdr;
 	const char                  *runtime_be_version;
-	void                        *p;
-	int                          fd;
 	int                          rc;
 
 	M0_ENTRY("seg=%p", seg);
@@ -361,19 +486,15 @@ M0_INTERNAL int m0_be_seg_open(struct m0_be_seg *seg)
 		return M0_ERR(-ENOENT);
 	}
 
-	fd = m0_stob_fd(seg->bs_stob);
-	p = mmap(g->sg_addr, g->sg_size, PROT_READ | PROT_WRITE,
-		 MAP_FIXED | MAP_PRIVATE | MAP_NORESERVE, fd, g->sg_offset);
-	if (p != g->sg_addr) {
-		rc = M0_ERR_INFO(-errno, "p=%p g->sg_addr=%p fd=%d",
-				 p, g->sg_addr, fd);
+	rc = be_seg_map(seg, g);
+	if (rc != 0) {
 		/* `g' is a part of `hdr'. Don't print it after free. */
 		m0_free(hdr);
 		return rc;
 	}
 
-	/* rc = be_seg_read_all(seg, &hdr); */
-	rc = 0;
+	if (be_seg_is_anon(seg))
+		rc = be_seg_read_all(seg, g);
 	if (rc == 0) {
 		seg->bs_reserved = be_seg_hdr_size();
 		seg->bs_size     = g->sg_size;
@@ -60,6 +60,65 @@ enum {
 	M0_BE_SEG_PAGE_SIZE = 1ULL << 12,
 };
 
+/** How m0_be_seg_open() brings segment contents into memory. */
+enum m0_be_seg_prefault {
+	/** Segment pages are faulted in from the stob on first access. */
+	M0_BE_SEG_PREFAULT_NONE,
+	/** The whole segment is faulted in by mmap(MAP_POPULATE). */
+	M0_BE_SEG_PREFAULT_POPULATE,
+	/**
+	 * The segment is mapped anonymously and read from the stob by
+	 * m0_be_seg_open_cfg::soc_thread_nr threads in chunks of
+	 * M0_BE_SEG_READ_SIZE_MAX bytes. The first chunk, which holds the
+	 * segment header, allocator header and segment dictionary root, is
+	 * read before the others.
+	 */
+	M0_BE_SEG_PREFAULT_READ,
+};
+
+/** Page size backing the segment mapping. */
+enum m0_be_seg_hugepage {
+	M0_BE_SEG_HUGEPAGE_NONE,
+	/** Transparent hugepages, requested with madvise(MADV_HUGEPAGE). */
+	M0_BE_SEG_HUGEPAGE_THP,
+	/**
+	 * Explicit hugepages from the hugetlb pool (MAP_HUGETLB). Segment
+	 * size and address have to be aligned to the default hugepage size.
+	 */
+	M0_BE_SEG_HUGEPAGE_HUGETLB,
+};
+
+enum {
+	/** Default number of threads for M0_BE_SEG_PREFAULT_READ. */
+	M0_BE_SEG_READ_THREAD_NR = 8,
+};
+
+/**
+ * Segment open parameters.
+ *
+ * Zeroed structure gives the default behaviour: file-backed mapping which is
+ * faulted in lazily.
+ *
+ * Hugepage backing requires anonymous mapping, so it implies
+ * M0_BE_SEG_PREFAULT_READ regardless of m0_be_seg_open_cfg::soc_prefault.
+ * It is safe, because the segment mapping is private and segment contents
+ * are never written back through it.
+ *
+ * Memory cost: anonymous mapping (M0_BE_SEG_PREFAULT_READ and both hugepage
+ * modes) keeps the whole segment resident for as long as it is open, since
+ * its pages can't be re-read from the stob. The full segment size is charged
+ * against the overcommit limit, hugetlb mode takes that many pages from the
+ * hugetlb pool on open, and hugepages are never swapped out. The default
+ * file-backed mapping only holds the pages which were accessed and lets the
+ * kernel drop the clean ones.
+ */
+struct m0_be_seg_open_cfg {
+	enum m0_be_seg_prefault soc_prefault;
+	enum m0_be_seg_hugepage soc_hugepage;
+	/** 0 means M0_BE_SEG_READ_THREAD_NR. */
+	unsigned                soc_thread_nr;
+};
+
 #define M0_BE_SEG_PG_PRESENT       0x8000000000000000ULL
 #define M0_BE_SEG_PG_PIN_CNT_MASK  (~M0_BE_SEG_PG_PRESENT)
 
@@ -80,6 +139,8 @@ struct m0_be_seg {
 	 */
 	struct m0_be_allocator bs_allocator;
 	struct m0_be_domain   *bs_domain;
+	/** Set by the user between m0_be_seg_init() and m0_be_seg_open(). */
+	struct m0_be_seg_open_cfg bs_open_cfg;
 	int                    bs_state;
 	uint64_t               bs_magic;
 	struct m0_tlink        bs_linkage;
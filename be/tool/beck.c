@@ -454,6 +454,17 @@ static struct rectype rt[] = {
 
 M0_BASSERT(ARRAY_SIZE(rt) == M0_FORMAT_TYPE_NR + 1);
 
+/**
+ * Tag of a bnode of format version 2. Such a node starts with struct
+ * m0_be_bnode, so it is processed by bnodeops like a node of version 1.
+ */
+static const struct m0_format_tag bnode_v2_tag = {
+	.ot_version       = M0_BE_BNODE_FORMAT_VERSION_2,
+	.ot_type          = M0_FORMAT_TYPE_BE_BNODE,
+	.ot_footer_offset = sizeof(struct m0_be_bnode) +
+			    offsetof(struct m0_be_bnode_pfx, bp_footer)
+};
+
 #define _B(t, proc) [t] = { .b_type = (t), .b_proc = (proc) }
 
 static struct btype bt[] = {
@@ -1162,7 +1173,8 @@ static int recdo(struct scanner *s, const struct m0_format_tag *tag,
 	buf = alloca(size);
 	result = get(s, buf, size);
 	if (result == 0) {
-		if (memcmp(tag, &r->r_tag, sizeof *tag) == 0) {
+		if (memcmp(tag, &r->r_tag, sizeof *tag) == 0 ||
+		    memcmp(tag, &bnode_v2_tag, sizeof *tag) == 0) {
 			/**
 			 * Check generation identifier before format footer
 			 * verification. Only process the records whose
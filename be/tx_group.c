@@ -28,6 +28,7 @@
 #include "lib/misc.h"        /* M0_SET0 */
 #include "lib/errno.h"       /* ENOSPC */
 #include "lib/memory.h"      /* M0_ALLOC_PTR */
+#include "lib/string.h"      /* memcpy */
 
 #include "be/tx_internal.h"  /* m0_be_tx__reg_area */
 #include "be/domain.h"       /* m0_be_domain_seg */
@@ -51,12 +52,45 @@ struct be_recovering_tx {
 	uint64_t        rtx_magic;
 };
 
+/** Part of group regions, re-applied by m0_be_tx_group::tg_reapply_pool. */
+struct be_tx_group_reapply_job {
+	struct m0_be_reg_area *rj_ra;
+	struct m0_be_reg_d    *rj_first;
+	size_t                 rj_nr;
+};
+
 /** A list of transactions that are currently being recovered. */
 M0_TL_DESCR_DEFINE(rtxs, "m0_be_tx_group::tg_txs_recovering", static,
 		   struct be_recovering_tx, rtx_link, rtx_magic,
 		   M0_BE_TX_MAGIC, M0_BE_TX_GROUP_MAGIC);
 M0_TL_DEFINE(rtxs, static, struct be_recovering_tx);
 
+static void be_tx_group_reapply_pool_init(struct m0_be_tx_group *gr)
+{
+	int rc;
+
+	M0_ALLOC_ARR(gr->tg_reapply_jobs, M0_BE_TX_GROUP_REAPPLY_JOB_NR);
+	if (gr->tg_reapply_jobs == NULL)
+		return;
+	rc = m0_parallel_pool_init(&gr->tg_reapply_pool,
+				   M0_BE_TX_GROUP_REAPPLY_THREAD_NR,
+				   M0_BE_TX_GROUP_REAPPLY_JOB_NR);
+	if (rc != 0) {
+		M0_LOG(M0_WARN, "groups are re-applied sequentially: rc=%d",
+		       rc);
+		m0_free0(&gr->tg_reapply_jobs);
+	}
+}
+
+static void be_tx_group_reapply_pool_fini(struct m0_be_tx_group *gr)
+{
+	if (gr->tg_reapply_jobs != NULL) {
+		m0_parallel_pool_terminate_wait(&gr->tg_reapply_pool);
+		m0_parallel_pool_fini(&gr->tg_reapply_pool);
+		m0_free0(&gr->tg_reapply_jobs);
+	}
+}
+
 M0_TL_DESCR_DEFINE(grp, "m0_be_tx_group::tg_txs", M0_INTERNAL,
 		   struct m0_be_tx, t_group_linkage, t_magic,
 		   M0_BE_TX_MAGIC, M0_BE_TX_GROUP_MAGIC);
@@ -225,6 +259,7 @@ M0_INTERNAL int m0_be_tx_group_init(struct m0_be_tx_group     *gr,
 	M0_ASSERT(rc == 0);	/* XXX */
 	rc = m0_be_reg_area_merger_init(&gr->tg_merger, gr_cfg->tgc_tx_nr_max);
 	M0_ASSERT(rc == 0);     /* XXX */
+	gr->tg_reapply_jobs = NULL;
 	M0_ALLOC_ARR(gr->tg_rtxs, gr->tg_cfg.tgc_tx_nr_max);
 	M0_ASSERT(gr->tg_rtxs != NULL); /* XXX */
 	for (i = 0; i < gr->tg_cfg.tgc_tx_nr_max; ++i) {
@@ -248,6 +283,7 @@ M0_INTERNAL void m0_be_tx_group_fini(struct m0_be_tx_group *gr)
 		m0_be_op_fini(&gr->tg_rtxs[i].rtx_op_open);
 	}
 	m0_free(gr->tg_rtxs);
+	be_tx_group_reapply_pool_fini(gr);
 	m0_be_reg_area_merger_fini(&gr->tg_merger);
 	m0_be_reg_area_fini(&gr->tg_reg_area);
 	m0_be_tx_group_fom_fini(&gr->tg_fom);
@@ -452,11 +488,18 @@ m0_be_tx_group__tx_state_post(struct m0_be_tx_group *gr,
 M0_INTERNAL void m0_be_tx_group_recovery_prepare(struct m0_be_tx_group *gr,
 						 struct m0_be_log      *log)
 {
+	if (gr->tg_reapply_jobs == NULL)
+		be_tx_group_reapply_pool_init(gr);
 	m0_be_group_format_recovery_prepare(&gr->tg_od, log);
 	m0_be_tx_group_fom_recovery_prepare(&gr->tg_fom);
 	gr->tg_recovering = true;
 }
 
+M0_INTERNAL void m0_be_tx_group_recovery_done(struct m0_be_tx_group *gr)
+{
+	be_tx_group_reapply_pool_fini(gr);
+}
+
 M0_INTERNAL void m0_be_tx_group_log_read(struct m0_be_tx_group *gr,
 					 struct m0_be_op       *op)
 {
@@ -603,6 +646,60 @@ m0_be_tx_group_reconstruct_tx_close(struct m0_be_tx_group *gr,
 	} m0_tl_endfor;
 }
 
+static int be_tx_group_reapply_job(void *data)
+{
+	struct be_tx_group_reapply_job *job = data;
+	struct m0_be_reg_d             *rd  = job->rj_first;
+	size_t                          i;
+
+	for (i = 0; i < job->rj_nr; ++i) {
+		memcpy(rd->rd_reg.br_addr, rd->rd_buf, rd->rd_reg.br_size);
+		rd = m0_be_reg_area_next(job->rj_ra, rd);
+	}
+	return 0;
+}
+
+/*
+ * Regions in the group reg_area don't overlap, so they are split to
+ * M0_BE_TX_GROUP_REAPPLY_JOB_NR parts of about the same size and the parts are
+ * copied by tg_reapply_pool threads.
+ */
+static int be_tx_group_reapply_parallel(struct m0_be_tx_group *gr,
+					m0_bcount_t            size)
+{
+	struct be_tx_group_reapply_job *job;
+	struct m0_be_reg_area          *ra   = &gr->tg_reg_area;
+	struct m0_be_reg_d             *rd;
+	m0_bcount_t                     part;
+	m0_bcount_t                     done = 0;
+	int                             nr   = 0;
+	int                             rc   = 0;
+
+	part = size / M0_BE_TX_GROUP_REAPPLY_JOB_NR + 1;
+	job  = &gr->tg_reapply_jobs[0];
+	*job = (struct be_tx_group_reapply_job){ .rj_ra = ra };
+	M0_BE_REG_AREA_FORALL(ra, rd) {
+		if (job->rj_nr == 0)
+			job->rj_first = rd;
+		++job->rj_nr;
+		done += rd->rd_reg.br_size;
+		if (done >= part * (nr + 1) &&
+		    nr + 1 < M0_BE_TX_GROUP_REAPPLY_JOB_NR) {
+			rc = m0_parallel_pool_job_add(&gr->tg_reapply_pool,
+						      job);
+			M0_ASSERT(rc == 0);
+			job = &gr->tg_reapply_jobs[++nr];
+			*job = (struct be_tx_group_reapply_job){ .rj_ra = ra };
+		}
+	}
+	if (job->rj_nr > 0) {
+		rc = m0_parallel_pool_job_add(&gr->tg_reapply_pool, job);
+		M0_ASSERT(rc == 0);
+	}
+	m0_parallel_pool_start(&gr->tg_reapply_pool, &be_tx_group_reapply_job);
+	return m0_parallel_pool_wait(&gr->tg_reapply_pool);
+}
+
 /*
  * It will perform actual I/O when paged implemented so op is added
  * to the function parameters list.
@@ -610,16 +707,25 @@ m0_be_tx_group_reconstruct_tx_close(struct m0_be_tx_group *gr,
 M0_INTERNAL int m0_be_tx_group_reapply(struct m0_be_tx_group *gr,
 				       struct m0_be_op       *op)
 {
-	struct m0_be_reg_d *rd;
+	struct m0_be_tx_credit  used;
+	struct m0_be_reg_d     *rd;
+	int                     rc = 0;
 
 	m0_be_op_active(op);
 
-	M0_BE_REG_AREA_FORALL(&gr->tg_reg_area, rd) {
-		memcpy(rd->rd_reg.br_addr, rd->rd_buf, rd->rd_reg.br_size);
-	};
+	m0_be_reg_area_used(&gr->tg_reg_area, &used);
+	if (gr->tg_reapply_jobs != NULL &&
+	    used.tc_reg_size >= M0_BE_TX_GROUP_REAPPLY_PAR_MIN) {
+		rc = be_tx_group_reapply_parallel(gr, used.tc_reg_size);
+	} else {
+		M0_BE_REG_AREA_FORALL(&gr->tg_reg_area, rd) {
+			memcpy(rd->rd_reg.br_addr, rd->rd_buf,
+			       rd->rd_reg.br_size);
+		};
+	}
 
 	m0_be_op_done(op);
-	return 0;
+	return M0_RC(rc);
 }
 
 M0_INTERNAL void m0_be_tx_group_discard(struct m0_be_log_discard      *ld,
@@ -25,6 +25,7 @@
 #define __MOTR_BE_TX_GROUP_H__
 
 #include "lib/tlist.h"          /* m0_tl */
+#include "lib/thread_pool.h"    /* m0_parallel_pool */
 
 #include "be/tx_credit.h"       /* m0_be_tx_credit */
 #include "be/tx_group_format.h" /* m0_be_group_format */
@@ -36,6 +37,7 @@ struct m0_be_engine;
 struct m0_be_domain;
 struct m0_be_tx;
 struct be_recovering_tx;
+struct be_tx_group_reapply_job;
 struct m0_be_op;
 
 /**
@@ -44,6 +46,15 @@ struct m0_be_op;
  * @{
  */
 
+enum {
+	/** Number of threads copying group regions to segments in recovery. */
+	M0_BE_TX_GROUP_REAPPLY_THREAD_NR = 4,
+	/** Number of parts group regions are split to for the threads. */
+	M0_BE_TX_GROUP_REAPPLY_JOB_NR    = M0_BE_TX_GROUP_REAPPLY_THREAD_NR * 4,
+	/** Groups with less data are re-applied by the group fom itself. */
+	M0_BE_TX_GROUP_REAPPLY_PAR_MIN   = 1 << 20,
+};
+
 enum m0_be_tx_group_state {
 	M0_BGS_READY,
 	M0_BGS_OPEN,
@@ -122,6 +133,14 @@ struct m0_be_tx_group {
 	struct m0_tl               tg_txs_recovering;
 	/** Preallocated array of recovering transactions. */
 	struct be_recovering_tx   *tg_rtxs;
+	/**
+	 * Threads for m0_be_tx_group_reapply(). Created by the first
+	 * m0_be_tx_group_recovery_prepare() and stopped by
+	 * m0_be_tx_group_recovery_done(), tg_reapply_jobs is NULL while
+	 * there are no threads.
+	 */
+	struct m0_parallel_pool    tg_reapply_pool;
+	struct be_tx_group_reapply_job *tg_reapply_jobs;
 	/* Linkage for engine lists (m0_be_engine::eng_txs). */
 	struct m0_tlink            tg_engine_linkage;
 	/* Magic for tg_engine_linkage. */
@@ -220,6 +239,8 @@ M0_INTERNAL void m0_be_tx_group_log_write(struct m0_be_tx_group *gr,
 
 M0_INTERNAL void m0_be_tx_group_recovery_prepare(struct m0_be_tx_group *gr,
 						 struct m0_be_log      *log);
+/** Stops re-apply threads of the group. Called when recovery is finished. */
+M0_INTERNAL void m0_be_tx_group_recovery_done(struct m0_be_tx_group *gr);
 M0_INTERNAL void m0_be_tx_group_log_read(struct m0_be_tx_group *gr,
 					 struct m0_be_op       *op);
 M0_INTERNAL int m0_be_tx_group_decode(struct m0_be_tx_group *gr);
@@ -196,19 +196,175 @@ static void be_reg_d_arr_first_subreg(struct m0_be_reg_d **rd_arr,
 	*size = arr[1] - arr[0];
 }
 
+static struct m0_be_reg_d_node *be_rdt_node(const struct m0_be_reg_d *rd)
+{
+	return container_of(rd, struct m0_be_reg_d_node, rdn_rd);
+}
+
 static bool be_rdt_contains(const struct m0_be_reg_d_tree *rdt,
 			    const struct m0_be_reg_d      *rd)
 {
-	return &rdt->brt_r[0] <= rd && rd < &rdt->brt_r[rdt->brt_size];
+	const struct m0_be_reg_d_node *node = be_rdt_node(rd);
+
+	return &rdt->brt_nodes[0] <= node &&
+	       node < &rdt->brt_nodes[rdt->brt_used];
+}
+
+static int be_rdt_height(const struct m0_be_reg_d_node *node)
+{
+	return node == NULL ? 0 : node->rdn_height;
+}
+
+static void be_rdt_height_update(struct m0_be_reg_d_node *node)
+{
+	node->rdn_height = max_check(be_rdt_height(node->rdn_child[0]),
+				     be_rdt_height(node->rdn_child[1])) + 1;
+}
+
+static int be_rdt_balance(const struct m0_be_reg_d_node *node)
+{
+	return be_rdt_height(node->rdn_child[0]) -
+	       be_rdt_height(node->rdn_child[1]);
+}
+
+static struct m0_be_reg_d_node *be_rdt_leftmost(struct m0_be_reg_d_node *node)
+{
+	while (node != NULL && node->rdn_child[0] != NULL)
+		node = node->rdn_child[0];
+	return node;
+}
+
+/** In-order successor. Time complexity is O(1) amortised. */
+static struct m0_be_reg_d_node *be_rdt_succ(struct m0_be_reg_d_node *node)
+{
+	if (node->rdn_child[1] != NULL)
+		return be_rdt_leftmost(node->rdn_child[1]);
+	for (; node->rdn_parent != NULL; node = node->rdn_parent) {
+		if (node->rdn_parent->rdn_child[1] != node)
+			break;
+	}
+	return node->rdn_parent;
+}
+
+/** Puts @new in place of @old in the link from the parent of @old. */
+static void be_rdt_replace(struct m0_be_reg_d_tree *rdt,
+			   struct m0_be_reg_d_node *old,
+			   struct m0_be_reg_d_node *new)
+{
+	struct m0_be_reg_d_node *parent = old->rdn_parent;
+
+	if (parent == NULL)
+		rdt->brt_root = new;
+	else
+		parent->rdn_child[parent->rdn_child[1] == old] = new;
+	if (new != NULL)
+		new->rdn_parent = parent;
+}
+
+/**
+ * Rotates subtree rooted at @node, so that node->rdn_child[!dir] becomes its
+ * root and @node becomes its rdn_child[dir]. Returns the new subtree root.
+ */
+static struct m0_be_reg_d_node *be_rdt_rotate(struct m0_be_reg_d_tree *rdt,
+					      struct m0_be_reg_d_node *node,
+					      int                      dir)
+{
+	struct m0_be_reg_d_node *up = node->rdn_child[!dir];
+
+	be_rdt_replace(rdt, node, up);
+	node->rdn_child[!dir] = up->rdn_child[dir];
+	if (node->rdn_child[!dir] != NULL)
+		node->rdn_child[!dir]->rdn_parent = node;
+	up->rdn_child[dir] = node;
+	node->rdn_parent = up;
+	be_rdt_height_update(node);
+	be_rdt_height_update(up);
+	return up;
+}
+
+/** Restores AVL balance on the path from @node to the root. */
+static void be_rdt_rebalance(struct m0_be_reg_d_tree *rdt,
+			     struct m0_be_reg_d_node *node)
+{
+	struct m0_be_reg_d_node *child;
+	int                      heavy;
+	int                      balance;
+
+	for (; node != NULL; node = node->rdn_parent) {
+		be_rdt_height_update(node);
+		balance = be_rdt_balance(node);
+		if (balance >= -1 && balance <= 1)
+			continue;
+		heavy = balance < 0;
+		child = node->rdn_child[heavy];
+		if (be_rdt_height(child->rdn_child[!heavy]) >
+		    be_rdt_height(child->rdn_child[heavy]))
+			be_rdt_rotate(rdt, child, heavy);
+		node = be_rdt_rotate(rdt, node, !heavy);
+	}
+}
+
+static struct m0_be_reg_d_node *be_rdt_node_get(struct m0_be_reg_d_tree *rdt)
+{
+	struct m0_be_reg_d_node *node = rdt->brt_free;
+
+	if (node != NULL) {
+		rdt->brt_free = node->rdn_parent;
+	} else {
+		M0_ASSERT(rdt->brt_used < rdt->brt_size_max);
+		node = &rdt->brt_nodes[rdt->brt_used++];
+	}
+	return node;
+}
+
+static void be_rdt_node_put(struct m0_be_reg_d_tree *rdt,
+			    struct m0_be_reg_d_node *node)
+{
+	node->rdn_parent = rdt->brt_free;
+	rdt->brt_free    = node;
+}
+
+static bool be_rdt_node__invariant(const struct m0_be_reg_d_node *node,
+				   const struct m0_be_reg_d_node *parent)
+{
+	return node == NULL ||
+	       (_0C(node->rdn_parent == parent) &&
+		_0C(m0_be_reg_d__invariant(&node->rdn_rd)) &&
+		_0C(node->rdn_height ==
+		    max_check(be_rdt_height(node->rdn_child[0]),
+			      be_rdt_height(node->rdn_child[1])) + 1) &&
+		_0C(M0_IN(be_rdt_balance(node), (-1, 0, 1))) &&
+		be_rdt_node__invariant(node->rdn_child[0], node) &&
+		be_rdt_node__invariant(node->rdn_child[1], node));
+}
+
+/** Checks that regions are ordered, don't overlap and are counted right. */
+static bool be_rdt_order__invariant(const struct m0_be_reg_d_tree *rdt)
+{
+	struct m0_be_reg_d_node *node;
+	struct m0_be_reg_d_node *next;
+	size_t                   nr = 0;
+
+	for (node = be_rdt_leftmost(rdt->brt_root); node != NULL; node = next) {
+		next = be_rdt_succ(node);
+		if (next != NULL &&
+		    (!_0C(node->rdn_rd.rd_reg.br_addr <
+			  next->rdn_rd.rd_reg.br_addr) ||
+		     !_0C(!be_reg_d_are_overlapping(&node->rdn_rd,
+						    &next->rdn_rd))))
+			return false;
+		++nr;
+	}
+	return _0C(nr == rdt->brt_size);
 }
 
 #define ARRAY_ALLOC_NZ(arr, nr) ((arr) = m0_alloc_nz((nr) * sizeof ((arr)[0])))
 
 M0_INTERNAL int m0_be_rdt_init(struct m0_be_reg_d_tree *rdt, size_t size_max)
 {
-	rdt->brt_size_max = size_max;
-	ARRAY_ALLOC_NZ(rdt->brt_r, rdt->brt_size_max);
-	if (rdt->brt_r == NULL)
+	*rdt = (struct m0_be_reg_d_tree){ .brt_size_max = size_max };
+	ARRAY_ALLOC_NZ(rdt->brt_nodes, rdt->brt_size_max);
+	if (rdt->brt_nodes == NULL)
 		return M0_ERR(-ENOMEM);
 
 	M0_POST(m0_be_rdt__invariant(rdt));
@@ -218,24 +374,19 @@ M0_INTERNAL int m0_be_rdt_init(struct m0_be_reg_d_tree *rdt, size_t size_max)
 M0_INTERNAL void m0_be_rdt_fini(struct m0_be_reg_d_tree *rdt)
 {
 	M0_PRE(m0_be_rdt__invariant(rdt));
-	m0_free(rdt->brt_r);
+	m0_free(rdt->brt_nodes);
 }
 
 M0_INTERNAL bool m0_be_rdt__invariant(const struct m0_be_reg_d_tree *rdt)
 {
 	return _0C(rdt != NULL) &&
-	       _0C(rdt->brt_r != NULL || rdt->brt_size == 0) &&
+	       _0C(rdt->brt_nodes != NULL || rdt->brt_size == 0) &&
 	       _0C(rdt->brt_size <= rdt->brt_size_max) &&
-	       M0_CHECK_EX(m0_forall(i, rdt->brt_size,
-				     m0_be_reg_d__invariant(&rdt->brt_r[i]))) &&
-	       M0_CHECK_EX(m0_forall(i,
-				     rdt->brt_size == 0 ? 0 : rdt->brt_size - 1,
-				     _0C(rdt->brt_r[i].rd_reg.br_addr <
-					 rdt->brt_r[i + 1].rd_reg.br_addr))) &&
-	       M0_CHECK_EX(m0_forall(i,
-				     rdt->brt_size == 0 ? 0 : rdt->brt_size - 1,
-		     _0C(!be_reg_d_are_overlapping(&rdt->brt_r[i],
-						   &rdt->brt_r[i + 1]))));
+	       _0C(rdt->brt_used <= rdt->brt_size_max) &&
+	       _0C(rdt->brt_size <= rdt->brt_used) &&
+	       _0C((rdt->brt_root == NULL) == (rdt->brt_size == 0)) &&
+	       M0_CHECK_EX(be_rdt_node__invariant(rdt->brt_root, NULL)) &&
+	       M0_CHECK_EX(be_rdt_order__invariant(rdt));
 }
 
 M0_INTERNAL size_t m0_be_rdt_size(const struct m0_be_reg_d_tree *rdt)
@@ -243,68 +394,39 @@ M0_INTERNAL size_t m0_be_rdt_size(const struct m0_be_reg_d_tree *rdt)
 	return rdt->brt_size;
 }
 
-/** Time complexity is O(1) */
-static bool be_rdt_check_i(const struct m0_be_reg_d_tree *rdt,
-			   void                          *addr,
-			   size_t                         index)
-{
-	struct m0_be_reg_d *r    = rdt->brt_r;
-	size_t              size = m0_be_rdt_size(rdt);
-
-	return  (size == 0 && index == 0) ||
-		(size != 0 &&
-		 ((index == size && !m0_be_reg_d_is_in(&r[size - 1], addr) &&
-		   addr > r[size - 1].rd_reg.br_addr) ||
-		  (index == 0 && (m0_be_reg_d_is_in(&r[0], addr) ||
-				  addr < r[0].rd_reg.br_addr)) ||
-		  (index < size && m0_be_reg_d_is_in(&r[index], addr)) ||
-		  (index < size && index > 0 &&
-		   !m0_be_reg_d_is_in(&r[index - 1], addr) &&
-		   addr < r[index].rd_reg.br_addr &&
-		   addr > r[index - 1].rd_reg.br_addr)));
-}
-
-/** Time complexity is O(log(m0_be_rdt_size(rdt) + 1)) */
-static size_t be_rdt_find_i(const struct m0_be_reg_d_tree *rdt, void *addr)
-{
-	size_t begin = 0;
-	size_t mid;
-	size_t end   = m0_be_rdt_size(rdt);
-	size_t res   = m0_be_rdt_size(rdt) + 1;
-	size_t size  = m0_be_rdt_size(rdt);
-
-	while (begin + 1 < end) {
-		mid = (begin + end) / 2;
-		M0_ASSERT_INFO(mid > begin && mid < end,
-			       "begin = %zu, mid = %zu, end = %zu",
-			       begin, mid, end);
-		if (rdt->brt_r[mid].rd_reg.br_addr < addr) {
-			begin = mid;
+/**
+ * Returns the first node which region ends after @addr. Regions in the tree
+ * don't overlap, so region ends are ordered the same way as region starts.
+ *
+ * Time complexity is O(log(m0_be_rdt_size(rdt) + 1))
+ */
+static struct m0_be_reg_d_node *
+be_rdt_find_node(const struct m0_be_reg_d_tree *rdt, void *addr)
+{
+	struct m0_be_reg_d_node *node = rdt->brt_root;
+	struct m0_be_reg_d_node *res  = NULL;
+
+	while (node != NULL) {
+		if (addr < be_reg_d_lb1(&node->rdn_rd)) {
+			res  = node;
+			node = node->rdn_child[0];
 		} else {
-			end   = mid;
+			node = node->rdn_child[1];
 		}
 	}
-	res = be_rdt_check_i(rdt, addr, begin) ? begin : res;
-	res = be_rdt_check_i(rdt, addr, end)   ? end   : res;
-
-	M0_ASSERT_INFO(size == 0 || res <= size, "size = %zu, res = %zu",
-		       size, res);
-	M0_POST(m0_be_rdt__invariant(rdt));
-	M0_POST(be_rdt_check_i(rdt, addr, res));
 	return res;
 }
 
-
 M0_INTERNAL struct m0_be_reg_d *
 m0_be_rdt_find(const struct m0_be_reg_d_tree *rdt, void *addr)
 {
-	struct m0_be_reg_d *rd;
-	size_t		    i;
+	struct m0_be_reg_d_node *node;
+	struct m0_be_reg_d      *rd;
 
 	M0_PRE(m0_be_rdt__invariant(rdt));
 
-	i = be_rdt_find_i(rdt, addr);
-	rd = i == rdt->brt_size ? NULL : &rdt->brt_r[i];
+	node = be_rdt_find_node(rdt, addr);
+	rd = node == NULL ? NULL : &node->rdn_rd;
 
 	M0_POST(ergo(rd != NULL, be_rdt_contains(rdt, rd)));
 	return rd;
@@ -313,13 +435,15 @@ m0_be_rdt_find(const struct m0_be_reg_d_tree *rdt, void *addr)
 M0_INTERNAL struct m0_be_reg_d *
 m0_be_rdt_next(const struct m0_be_reg_d_tree *rdt, struct m0_be_reg_d *prev)
 {
-	struct m0_be_reg_d *rd;
+	struct m0_be_reg_d_node *node;
+	struct m0_be_reg_d      *rd;
 
 	M0_PRE(m0_be_rdt__invariant(rdt));
 	M0_PRE(prev != NULL);
 	M0_PRE(be_rdt_contains(rdt, prev));
 
-	rd = prev == &rdt->brt_r[rdt->brt_size - 1] ? NULL : ++prev;
+	node = be_rdt_succ(be_rdt_node(prev));
+	rd = node == NULL ? NULL : &node->rdn_rd;
 
 	M0_POST(ergo(rd != NULL, be_rdt_contains(rdt, rd)));
 	return rd;
@@ -328,18 +452,29 @@ m0_be_rdt_next(const struct m0_be_reg_d_tree *rdt, struct m0_be_reg_d *prev)
 M0_INTERNAL void m0_be_rdt_ins(struct m0_be_reg_d_tree  *rdt,
 			       const struct m0_be_reg_d *rd)
 {
-	size_t index;
-	size_t i;
+	struct m0_be_reg_d_node **link;
+	struct m0_be_reg_d_node  *parent = NULL;
+	struct m0_be_reg_d_node  *node;
 
 	M0_PRE(m0_be_rdt__invariant(rdt));
 	M0_PRE(m0_be_rdt_size(rdt) < rdt->brt_size_max);
 	M0_PRE(rd->rd_reg.br_size > 0);
 
-	index = be_rdt_find_i(rdt, be_reg_d_fb(rd));
+	link = &rdt->brt_root;
+	while (*link != NULL) {
+		parent = *link;
+		link = &parent->rdn_child[be_reg_d_fb(rd) >
+					  be_reg_d_fb(&parent->rdn_rd)];
+	}
+	node = be_rdt_node_get(rdt);
+	*node = (struct m0_be_reg_d_node){
+		.rdn_rd     = *rd,
+		.rdn_parent = parent,
+		.rdn_height = 1,
+	};
+	*link = node;
+	be_rdt_rebalance(rdt, parent);
 	++rdt->brt_size;
-	for (i = rdt->brt_size - 1; i > index; --i)
-		rdt->brt_r[i] = rdt->brt_r[i - 1];
-	rdt->brt_r[index] = *rd;
 
 	M0_POST(m0_be_rdt__invariant(rdt));
 }
@@ -347,21 +482,47 @@ M0_INTERNAL void m0_be_rdt_ins(struct m0_be_reg_d_tree  *rdt,
 M0_INTERNAL struct m0_be_reg_d *m0_be_rdt_del(struct m0_be_reg_d_tree  *rdt,
 					      const struct m0_be_reg_d *rd)
 {
-	size_t index;
-	size_t i;
+	struct m0_be_reg_d_node *node;
+	struct m0_be_reg_d_node *next;
+	struct m0_be_reg_d_node *child;
+	struct m0_be_reg_d_node *start;
 
 	M0_PRE(m0_be_rdt__invariant(rdt));
 	M0_PRE(m0_be_rdt_size(rdt) > 0);
 
-	index = be_rdt_find_i(rdt, be_reg_d_fb(rd));
-	M0_ASSERT(m0_be_reg_eq(&rdt->brt_r[index].rd_reg, &rd->rd_reg));
+	node = be_rdt_find_node(rdt, be_reg_d_fb(rd));
+	M0_ASSERT(node != NULL);
+	M0_ASSERT(m0_be_reg_eq(&node->rdn_rd.rd_reg, &rd->rd_reg));
 
-	for (i = index; i + 1 < rdt->brt_size; ++i)
-		rdt->brt_r[i] = rdt->brt_r[i + 1];
+	next = be_rdt_succ(node);
+	if (node->rdn_child[0] == NULL || node->rdn_child[1] == NULL) {
+		child = node->rdn_child[node->rdn_child[0] == NULL];
+		start = node->rdn_parent;
+		be_rdt_replace(rdt, node, child);
+	} else {
+		/*
+		 * Successor is the leftmost node of the right subtree. It is
+		 * moved to the place of the deleted node, so pointers to the
+		 * regions remaining in the tree stay valid.
+		 */
+		if (next->rdn_parent == node) {
+			start = next;
+		} else {
+			start = next->rdn_parent;
+			be_rdt_replace(rdt, next, next->rdn_child[1]);
+			next->rdn_child[1] = node->rdn_child[1];
+			next->rdn_child[1]->rdn_parent = next;
+		}
+		be_rdt_replace(rdt, node, next);
+		next->rdn_child[0] = node->rdn_child[0];
+		next->rdn_child[0]->rdn_parent = next;
+	}
+	be_rdt_rebalance(rdt, start);
+	be_rdt_node_put(rdt, node);
 	--rdt->brt_size;
 
 	M0_POST(m0_be_rdt__invariant(rdt));
-	return index == m0_be_rdt_size(rdt) ? NULL : &rdt->brt_r[index];
+	return next == NULL ? NULL : &next->rdn_rd;
 }
 
 M0_INTERNAL void m0_be_rdt_reset(struct m0_be_reg_d_tree *rdt)
@@ -369,6 +530,9 @@ M0_INTERNAL void m0_be_rdt_reset(struct m0_be_reg_d_tree *rdt)
 	M0_PRE(m0_be_rdt__invariant(rdt));
 
 	rdt->brt_size = 0;
+	rdt->brt_root = NULL;
+	rdt->brt_free = NULL;
+	rdt->brt_used = 0;
 
 	M0_POST(m0_be_rdt_size(rdt) == 0);
 	M0_POST(m0_be_rdt__invariant(rdt));
@@ -68,11 +68,32 @@ struct m0_be_reg_d {
 		{ .rd_reg = (reg), .rd_buf = (buf) }
 #define M0_BE_REG_D_CREDIT(rd) M0_BE_TX_CREDIT(1, (rd)->rd_reg.br_size)
 
-/** Regions tree. */
+/** Node of m0_be_reg_d_tree. */
+struct m0_be_reg_d_node {
+	struct m0_be_reg_d       rdn_rd;
+	struct m0_be_reg_d_node *rdn_parent;
+	/** Left (0) and right (1) children. */
+	struct m0_be_reg_d_node *rdn_child[2];
+	/** Height of the subtree rooted at this node, leaf has height 1. */
+	int                      rdn_height;
+};
+
+/**
+ * Regions tree.
+ *
+ * AVL tree of m0_be_reg_d_node keyed by region start address. Nodes are
+ * taken from brt_nodes[] preallocated in m0_be_rdt_init(): first from
+ * brt_free list of deleted nodes and then from the never used tail of the
+ * array (brt_nodes[brt_used..brt_size_max - 1]).
+ */
 struct m0_be_reg_d_tree {
-	size_t              brt_size;
-	size_t              brt_size_max;
-	struct m0_be_reg_d *brt_r;
+	size_t                   brt_size;
+	size_t                   brt_size_max;
+	struct m0_be_reg_d_node *brt_nodes;
+	struct m0_be_reg_d_node *brt_root;
+	/** Deleted nodes, linked through m0_be_reg_d_node::rdn_parent. */
+	struct m0_be_reg_d_node *brt_free;
+	size_t                   brt_used;
 };
 
 struct m0_be_regmap_ops {
@@ -109,9 +130,12 @@ M0_INTERNAL bool m0_be_reg_d_is_in(const struct m0_be_reg_d *rd, void *ptr);
  *   functions;
  *
  * Region is from the tree iff it is returned by m0_be_rdt_find(),
- * m0_be_rdt_next(), m0_be_rdt_del().
- * @note Current implementation is based on array, so technically it is not
- * a tree. Optimizations should be made to make it a real tree.
+ * m0_be_rdt_next(), m0_be_rdt_del(). Such region stays at the same address
+ * until it is deleted from the tree or the tree is reset.
+ *
+ * m0_be_rdt_find(), m0_be_rdt_ins() and m0_be_rdt_del() take
+ * O(log(m0_be_rdt_size(rdt))) time, m0_be_rdt_next() takes O(1) amortised
+ * time.
  */
 M0_INTERNAL int m0_be_rdt_init(struct m0_be_reg_d_tree *rdt, size_t size_max);
 /** Finalize m0_be_reg_d tree. Free all memory allocated */
@@ -149,12 +149,15 @@ static void be_ut_alloc_thread(int index)
 	m0_be_ut_backend_thread_exit(&be_ut_alloc_backend);
 }
 
-static void be_ut_alloc_mt(int nr)
+static void be_ut_alloc_mt(int nr, bool arenas, bool slab)
 {
-	struct m0_be_ut_backend *ut_be  = &be_ut_alloc_backend;
-	struct m0_be_ut_seg     *ut_seg = &be_ut_alloc_seg;
-	int                      rc;
-	int                      i;
+	struct m0_be_ut_backend      *ut_be  = &be_ut_alloc_backend;
+	struct m0_be_ut_seg          *ut_seg = &be_ut_alloc_seg;
+	struct m0_be_allocator       *a;
+	struct m0_be_allocator_stats  before;
+	struct m0_be_allocator_stats  after;
+	int                           rc;
+	int                           i;
 
 	M0_SET_ARR0(be_ut_ts);
 	for (i = 0; i < nr; ++i) {
@@ -164,7 +167,20 @@ static void be_ut_alloc_mt(int nr)
 
 	m0_be_ut_backend_init(ut_be);
 	m0_be_ut_seg_init(ut_seg, ut_be, BE_UT_ALLOC_SEG_SIZE);
+	a = m0_be_seg_allocator(ut_seg->bus_seg);
+	if (arenas) {
+		a->ba_cfg.bac_arena_percent = M0_BE_ALLOC_ARENA_PERCENT;
+		m0_fi_enable_once("be_allocator_arenas_create",
+				  "any_zone_size");
+	}
+	if (slab) {
+		a->ba_cfg.bac_slab_percent = M0_BE_ALLOC_SLAB_PERCENT;
+		m0_fi_enable_once("be_allocator_slab_create", "any_zone_size");
+	}
 	m0_be_ut_seg_allocator_init(ut_seg, ut_be);
+	M0_UT_ASSERT(a->ba_arena_nr == (arenas ? M0_BE_ALLOC_ARENA_NR : 0));
+	M0_UT_ASSERT((a->ba_slab != NULL) == slab);
+	m0_be_alloc_stats(a, &before);
 	for (i = 0; i < nr; ++i) {
 		rc = M0_THREAD_INIT(&be_ut_ts[i].ats_thread, int, NULL,
 				    &be_ut_alloc_thread, i,
@@ -175,6 +191,20 @@ static void be_ut_alloc_mt(int nr)
 		m0_thread_join(&be_ut_ts[i].ats_thread);
 		m0_thread_fini(&be_ut_ts[i].ats_thread);
 	}
+	/* Everything is freed, including the memory allocated in arenas. */
+	m0_be_alloc_stats(a, &after);
+	if (slab) {
+		/* Slab pages stay initialised after their objects are freed */
+		M0_UT_ASSERT(a->ba_slab->bsl_page_used > 0);
+		M0_UT_ASSERT(after.bas_space_used >= before.bas_space_used);
+	} else {
+		M0_UT_ASSERT(after.bas_space_used == before.bas_space_used);
+		M0_UT_ASSERT(after.bas_space_free == before.bas_space_free);
+	}
+	M0_UT_ASSERT(after.bas_total.bacs_alloc_success.bcs_nr -
+		     before.bas_total.bacs_alloc_success.bcs_nr ==
+		     after.bas_total.bacs_free.bcs_nr -
+		     before.bas_total.bacs_free.bcs_nr);
 	m0_be_ut_seg_allocator_fini(ut_seg, ut_be);
 	m0_be_ut_seg_fini(ut_seg);
 	m0_be_ut_backend_fini(ut_be);
@@ -183,12 +213,252 @@ static void be_ut_alloc_mt(int nr)
 
 M0_INTERNAL void m0_be_ut_alloc_multiple(void)
 {
-	be_ut_alloc_mt(1);
+	be_ut_alloc_mt(1, false, false);
 }
 
 M0_INTERNAL void m0_be_ut_alloc_concurrent(void)
 {
-	be_ut_alloc_mt(BE_UT_ALLOC_THR_NR);
+	be_ut_alloc_mt(BE_UT_ALLOC_THR_NR, false, false);
+}
+
+M0_INTERNAL void m0_be_ut_alloc_arena_concurrent(void)
+{
+	be_ut_alloc_mt(BE_UT_ALLOC_THR_NR, true, false);
+}
+
+M0_INTERNAL void m0_be_ut_alloc_slab_concurrent(void)
+{
+	be_ut_alloc_mt(BE_UT_ALLOC_THR_NR, false, true);
+}
+
+M0_INTERNAL void m0_be_ut_alloc_arena(void)
+{
+	struct m0_be_ut_backend        *ut_be = &be_ut_alloc_backend;
+	struct m0_be_allocator         *a;
+	struct m0_be_allocator_header  *h0;
+	struct be_alloc_chunk          *c;
+	struct m0_be_ut_seg             ut_seg;
+	void                           *ptr;
+	int                             rc;
+
+	m0_be_ut_backend_init(ut_be);
+
+	/* Zero share gives no arenas. */
+	m0_be_ut_seg_init(&ut_seg, ut_be, BE_UT_ALLOC_SEG_SIZE);
+	m0_fi_enable_once("be_allocator_arenas_create", "any_zone_size");
+	m0_be_ut_seg_allocator_init(&ut_seg, ut_be);
+	a = m0_be_seg_allocator(ut_seg.bus_seg);
+	M0_UT_ASSERT(a->ba_arena_nr == 0);
+	m0_be_ut_seg_allocator_fini(&ut_seg, ut_be);
+	m0_be_ut_seg_fini(&ut_seg);
+
+	m0_be_ut_seg_init(&ut_seg, ut_be, BE_UT_ALLOC_SEG_SIZE);
+	a = m0_be_seg_allocator(ut_seg.bus_seg);
+	a->ba_cfg.bac_arena_percent = M0_BE_ALLOC_ARENA_PERCENT;
+	m0_fi_enable_once("be_allocator_arenas_create", "any_zone_size");
+	m0_be_ut_seg_allocator_init(&ut_seg, ut_be);
+	M0_UT_ASSERT(a->ba_arena_nr == M0_BE_ALLOC_ARENA_NR);
+	h0 = a->ba_h[M0_BAP_NR];
+
+	/* Arenas are found in the index when the allocator is re-initialised. */
+	m0_be_allocator_fini(a);
+	rc = m0_be_allocator_init(a, ut_seg.bus_seg);
+	M0_UT_ASSERT(rc == 0);
+	M0_UT_ASSERT(a->ba_arena_nr == M0_BE_ALLOC_ARENA_NR);
+	M0_UT_ASSERT(a->ba_h[M0_BAP_NR] == h0);
+
+	/* Small allocation goes to an arena. */
+	M0_BE_UT_TRANSACT(ut_be, tx, cred,
+		  m0_be_allocator_credit(a, M0_BAO_ALLOC, BE_UT_ALLOC_SIZE, 0,
+					 &cred),
+		  M0_BE_OP_SYNC(op, m0_be_alloc(a, tx, &op, &ptr,
+						BE_UT_ALLOC_SIZE)));
+	M0_UT_ASSERT(ptr != NULL);
+	c = container_of(ptr, struct be_alloc_chunk, bac_mem);
+	M0_UT_ASSERT(c->bac_zone >= M0_BAP_NR);
+	M0_BE_UT_TRANSACT(ut_be, tx, cred,
+		  m0_be_allocator_credit(a, M0_BAO_FREE, 0, 0, &cred),
+		  M0_BE_OP_SYNC(op, m0_be_free(a, tx, &op, ptr)));
+
+	/* Allocation which doesn't fit into an arena goes to the zone. */
+	M0_BE_UT_TRANSACT(ut_be, tx, cred,
+		  m0_be_allocator_credit(a, M0_BAO_ALLOC,
+					 BE_UT_ALLOC_SEG_SIZE / 4, 0, &cred),
+		  M0_BE_OP_SYNC(op, m0_be_alloc(a, tx, &op, &ptr,
+						BE_UT_ALLOC_SEG_SIZE / 4)));
+	M0_UT_ASSERT(ptr != NULL);
+	c = container_of(ptr, struct be_alloc_chunk, bac_mem);
+	M0_UT_ASSERT(c->bac_zone == M0_BAP_NORMAL);
+	M0_BE_UT_TRANSACT(ut_be, tx, cred,
+		  m0_be_allocator_credit(a, M0_BAO_FREE, 0, 0, &cred),
+		  M0_BE_OP_SYNC(op, m0_be_free(a, tx, &op, ptr)));
+
+	m0_be_ut_seg_allocator_fini(&ut_seg, ut_be);
+	m0_be_ut_seg_fini(&ut_seg);
+	m0_be_ut_backend_fini(ut_be);
+	M0_SET0(ut_be);
+}
+
+static bool be_ut_alloc_is_in_slab(struct m0_be_allocator *a, void *ptr)
+{
+	struct be_alloc_slab *s = a->ba_slab;
+
+	return ptr >= s->bsl_pages &&
+	       ptr < s->bsl_pages + s->bsl_page_nr * BE_ALLOC_SLAB_PAGE_SIZE;
+}
+
+static void *be_ut_alloc_slab_alloc(struct m0_be_allocator *a,
+				    m0_bcount_t             size)
+{
+	struct m0_be_ut_backend *ut_be = &be_ut_alloc_backend;
+	void                    *ptr;
+
+	M0_BE_UT_TRANSACT(ut_be, tx, cred,
+		  m0_be_allocator_credit(a, M0_BAO_ALLOC, size, 0, &cred),
+		  M0_BE_OP_SYNC(op, m0_be_alloc(a, tx, &op, &ptr, size)));
+	M0_UT_ASSERT(ptr != NULL);
+	return ptr;
+}
+
+static void be_ut_alloc_slab_free(struct m0_be_allocator *a, void *ptr)
+{
+	struct m0_be_ut_backend *ut_be = &be_ut_alloc_backend;
+
+	M0_BE_UT_TRANSACT(ut_be, tx, cred,
+		  m0_be_allocator_credit(a, M0_BAO_FREE, 0, 0, &cred),
+		  M0_BE_OP_SYNC(op, m0_be_free(a, tx, &op, ptr)));
+}
+
+M0_INTERNAL void m0_be_ut_alloc_slab(void)
+{
+	struct m0_be_ut_backend  *ut_be = &be_ut_alloc_backend;
+	struct m0_be_allocator   *a;
+	struct be_alloc_slab     *slab;
+	struct m0_be_ut_seg       ut_seg;
+	static const m0_bcount_t  sizes[] = { 1, 8, 16, 17, 100, 128 };
+	void                     *ptr[ARRAY_SIZE(sizes)];
+	void                    **full;
+	void                     *big;
+	uint64_t                  page_used;
+	int                       full_nr;
+	int                       rc;
+	int                       i;
+	int                       j;
+
+	m0_be_ut_backend_init(ut_be);
+	m0_be_ut_seg_init(&ut_seg, ut_be, BE_UT_ALLOC_SEG_SIZE);
+	a = m0_be_seg_allocator(ut_seg.bus_seg);
+	a->ba_cfg.bac_slab_percent = M0_BE_ALLOC_SLAB_PERCENT;
+	m0_fi_enable_once("be_allocator_slab_create", "any_zone_size");
+	m0_be_ut_seg_allocator_init(&ut_seg, ut_be);
+	slab = a->ba_slab;
+	M0_UT_ASSERT(slab != NULL);
+	M0_UT_ASSERT(slab->bsl_page_nr > 0);
+	M0_UT_ASSERT(m0_addr_is_aligned(slab->bsl_pages,
+					BE_ALLOC_SLAB_PAGE_SHIFT));
+
+	/* Slab is found again when the allocator is re-initialised. */
+	m0_be_allocator_fini(a);
+	rc = m0_be_allocator_init(a, ut_seg.bus_seg);
+	M0_UT_ASSERT(rc == 0);
+	M0_UT_ASSERT(a->ba_slab == slab);
+
+	/* Small objects go to slab, objects of different sizes don't mix. */
+	for (i = 0; i < ARRAY_SIZE(sizes); ++i) {
+		ptr[i] = be_ut_alloc_slab_alloc(a, sizes[i]);
+		M0_UT_ASSERT(be_ut_alloc_is_in_slab(a, ptr[i]));
+		M0_UT_ASSERT(m0_addr_is_aligned(ptr[i],
+						M0_BE_ALLOC_SLAB_CLASS_SHIFT));
+		for (j = 0; j < i; ++j)
+			M0_UT_ASSERT(ptr[i] != ptr[j]);
+	}
+	page_used = slab->bsl_page_used;
+	M0_UT_ASSERT(page_used == 4);
+	for (i = 0; i < ARRAY_SIZE(sizes); ++i)
+		be_ut_alloc_slab_free(a, ptr[i]);
+
+	/* Freed object is reused. */
+	ptr[0] = be_ut_alloc_slab_alloc(a, sizes[0]);
+	be_ut_alloc_slab_free(a, ptr[0]);
+	M0_UT_ASSERT(be_ut_alloc_slab_alloc(a, sizes[0]) == ptr[0]);
+	be_ut_alloc_slab_free(a, ptr[0]);
+	M0_UT_ASSERT(slab->bsl_page_used == page_used);
+
+	/* Larger objects are allocated as chunks. */
+	big = be_ut_alloc_slab_alloc(a, M0_BE_ALLOC_SLAB_OBJ_MAX + 1);
+	M0_UT_ASSERT(!be_ut_alloc_is_in_slab(a, big));
+	be_ut_alloc_slab_free(a, big);
+
+	/* Objects are allocated as chunks when slab is full. */
+	full_nr = slab->bsl_page_nr * BE_ALLOC_SLAB_PAGE_SIZE /
+		  M0_BE_ALLOC_SLAB_OBJ_MAX + 1;
+	M0_ALLOC_ARR(full, full_nr);
+	M0_UT_ASSERT(full != NULL);
+	for (i = 0; i < full_nr; ++i) {
+		full[i] = be_ut_alloc_slab_alloc(a, M0_BE_ALLOC_SLAB_OBJ_MAX);
+		if (!be_ut_alloc_is_in_slab(a, full[i]))
+			break;
+	}
+	M0_UT_ASSERT(i < full_nr);
+	M0_UT_ASSERT(slab->bsl_page_used == slab->bsl_page_nr);
+	for (j = 0; j <= i; ++j)
+		be_ut_alloc_slab_free(a, full[j]);
+	m0_free(full);
+
+	m0_be_ut_seg_allocator_fini(&ut_seg, ut_be);
+	m0_be_ut_seg_fini(&ut_seg);
+	m0_be_ut_backend_fini(ut_be);
+	M0_SET0(ut_be);
+}
+
+M0_INTERNAL void m0_be_ut_alloc_slab_cfg(void)
+{
+	struct m0_be_ut_backend *ut_be = &be_ut_alloc_backend;
+	struct m0_be_allocator  *a;
+	struct be_alloc_slab    *slab;
+	struct m0_be_ut_seg      ut_seg;
+	uint64_t                 page_nr;
+	void                    *ptr;
+	int                      percent;
+
+	m0_be_ut_backend_init(ut_be);
+
+	/* Zero share gives no slab. */
+	m0_be_ut_seg_init(&ut_seg, ut_be, BE_UT_ALLOC_SEG_SIZE);
+	m0_fi_enable_once("be_allocator_slab_create", "any_zone_size");
+	m0_be_ut_seg_allocator_init(&ut_seg, ut_be);
+	M0_UT_ASSERT(m0_be_seg_allocator(ut_seg.bus_seg)->ba_slab == NULL);
+	m0_be_ut_seg_allocator_fini(&ut_seg, ut_be);
+	m0_be_ut_seg_fini(&ut_seg);
+
+	page_nr = 0;
+	for (percent = 10; percent <= 20; percent += 10) {
+		m0_be_ut_seg_init(&ut_seg, ut_be, BE_UT_ALLOC_SEG_SIZE);
+		a = m0_be_seg_allocator(ut_seg.bus_seg);
+		a->ba_cfg = (struct m0_be_allocator_cfg){
+			.bac_slab_percent = percent,
+			.bac_slab_obj_max = 64,
+		};
+		m0_fi_enable_once("be_allocator_slab_create", "any_zone_size");
+		m0_be_ut_seg_allocator_init(&ut_seg, ut_be);
+		slab = a->ba_slab;
+		M0_UT_ASSERT(slab != NULL);
+		M0_UT_ASSERT(slab->bsl_obj_max == 64);
+		/* Larger slab share gives more pages. */
+		M0_UT_ASSERT(slab->bsl_page_nr > page_nr);
+		page_nr = slab->bsl_page_nr;
+
+		ptr = be_ut_alloc_slab_alloc(a, 64);
+		M0_UT_ASSERT(be_ut_alloc_is_in_slab(a, ptr));
+		be_ut_alloc_slab_free(a, ptr);
+		ptr = be_ut_alloc_slab_alloc(a, 65);
+		M0_UT_ASSERT(!be_ut_alloc_is_in_slab(a, ptr));
+		be_ut_alloc_slab_free(a, ptr);
+		m0_be_ut_seg_allocator_fini(&ut_seg, ut_be);
+		m0_be_ut_seg_fini(&ut_seg);
+	}
+	m0_be_ut_backend_fini(ut_be);
+	M0_SET0(ut_be);
 }
 
 static void be_ut_alloc_credit_log(struct m0_be_allocator  *a,
@@ -29,6 +29,8 @@
 #include "lib/misc.h"      /* M0_BITS, M0_IN */
 #include "lib/memory.h"    /* M0_ALLOC_PTR */
 #include "lib/errno.h"     /* ENOENT */
+#include "lib/thread.h"    /* M0_THREAD_INIT */
+#include "lib/time.h"      /* m0_time_now */
 #include "be/ut/helper.h"
 #include "ut/ut.h"
 #ifndef __KERNEL__
@@ -58,6 +60,29 @@ static const struct m0_be_btree_kv_ops kv_ops = {
 	.ko_compare = tree_cmp
 };
 
+/** First 8 characters of a string key, the rest is compared by tree_cmp(). */
+static uint64_t tree_key_prefix(const void *key)
+{
+	const unsigned char *k = key;
+	uint64_t             prefix = 0;
+	unsigned char        c = 1;
+	int                  i;
+
+	for (i = 0; i < sizeof prefix; ++i) {
+		c = c != 0 ? k[i] : 0;
+		prefix = prefix << 8 | c;
+	}
+	return prefix;
+}
+
+static const struct m0_be_btree_kv_ops pfx_kv_ops = {
+	.ko_type       = M0_BBT_UT_KV_OPS,
+	.ko_ksize      = tree_kv_size,
+	.ko_vsize      = tree_kv_size,
+	.ko_compare    = tree_cmp,
+	.ko_key_prefix = tree_key_prefix
+};
+
 enum {
 	INSERT_COUNT = BTREE_FAN_OUT * 20,
 	INSERT_KSIZE  = 7,
@@ -597,6 +622,7 @@ static struct m0_be_btree *create_tree(void)
 	m0_free(cred);
 
 	btree_dbg_print(tree);
+	m0_be_btree_fini(tree);
 
 	M0_LEAVE();
 	return tree;
@@ -881,6 +907,526 @@ static void check(struct m0_be_btree *tree)
 	m0_free(op);
 }
 
+enum {
+	MT_THREAD_NR = 64,
+	/** Number of even keys inserted before the threads are started. */
+	MT_PRE_NR    = BTREE_FAN_OUT * MT_THREAD_NR,
+	/** Number of keys inserted in one transaction while pre-populating. */
+	MT_BATCH_NR  = 64,
+	/** Total number of operations of a run, split among the threads. */
+	MT_OP_NR     = 2048,
+};
+
+struct btree_mt_thread {
+	struct m0_thread    bmt_thread;
+	struct m0_be_btree *bmt_tree;
+	int                 bmt_idx;
+	int                 bmt_nr;
+	bool                bmt_delete;
+};
+
+static void btree_mt_key(char *k, int i)
+{
+	sprintf(k, "%0*d", INSERT_KSIZE - 1, i);
+}
+
+static int btree_mt_op(struct m0_be_btree *tree, int i, bool delete)
+{
+	struct m0_be_tx_credit  cred = {};
+	struct m0_be_tx         tx = {};
+	struct m0_be_op         op = {};
+	struct m0_buf           key;
+	char                    k[INSERT_KSIZE];
+	int                     rc;
+
+	btree_mt_key(k, i);
+	m0_buf_init(&key, k, sizeof k);
+	if (delete)
+		m0_be_btree_delete_credit(tree, 1, INSERT_KSIZE, INSERT_KSIZE,
+					  &cred);
+	else
+		m0_be_btree_insert_credit(tree, 1, INSERT_KSIZE, INSERT_KSIZE,
+					  &cred);
+	m0_be_ut_tx_init(&tx, ut_be);
+	m0_be_tx_prep(&tx, &cred);
+	rc = m0_be_tx_open_sync(&tx);
+	M0_UT_ASSERT(rc == 0);
+	rc = delete ?
+		M0_BE_OP_SYNC_RET_WITH(&op, m0_be_btree_delete(tree, &tx, &op,
+							       &key),
+				       bo_u.u_btree.t_rc) :
+		M0_BE_OP_SYNC_RET_WITH(&op, m0_be_btree_insert(tree, &tx, &op,
+							       &key, &key),
+				       bo_u.u_btree.t_rc);
+	m0_be_tx_close_sync(&tx);
+	m0_be_tx_fini(&tx);
+	return rc;
+}
+
+/** Inserts or deletes even keys from [from, from + 2 * nr) in one tx. */
+static void btree_mt_batch(struct m0_be_btree *tree, int from, int nr,
+			   bool delete)
+{
+	struct m0_be_tx_credit  cred = {};
+	struct m0_be_tx         tx = {};
+	struct m0_be_op         op = {};
+	struct m0_buf           key;
+	char                    k[INSERT_KSIZE];
+	int                     rc;
+	int                     i;
+
+	m0_buf_init(&key, k, sizeof k);
+	if (delete)
+		m0_be_btree_delete_credit(tree, nr, INSERT_KSIZE, INSERT_KSIZE,
+					  &cred);
+	else
+		m0_be_btree_insert_credit(tree, nr, INSERT_KSIZE, INSERT_KSIZE,
+					  &cred);
+	m0_be_ut_tx_init(&tx, ut_be);
+	m0_be_tx_prep(&tx, &cred);
+	rc = m0_be_tx_open_sync(&tx);
+	M0_UT_ASSERT(rc == 0);
+	for (i = from; i < from + 2 * nr; i += 2) {
+		btree_mt_key(k, i);
+		M0_SET0(&op);
+		rc = delete ?
+			M0_BE_OP_SYNC_RET_WITH(&op,
+				m0_be_btree_delete(tree, &tx, &op, &key),
+				bo_u.u_btree.t_rc) :
+			M0_BE_OP_SYNC_RET_WITH(&op,
+				m0_be_btree_insert(tree, &tx, &op, &key, &key),
+				bo_u.u_btree.t_rc);
+		M0_UT_ASSERT(rc == 0);
+	}
+	m0_be_tx_close_sync(&tx);
+	m0_be_tx_fini(&tx);
+}
+
+static int btree_mt_lookup(struct m0_be_btree *tree, int i)
+{
+	struct m0_be_op op = {};
+	struct m0_buf   key;
+	struct m0_buf   val;
+	char            k[INSERT_KSIZE];
+	char            v[INSERT_KSIZE];
+	int             rc;
+
+	btree_mt_key(k, i);
+	m0_buf_init(&key, k, sizeof k);
+	m0_buf_init(&val, v, sizeof v);
+	rc = M0_BE_OP_SYNC_RET_WITH(&op, m0_be_btree_lookup(tree, &op,
+							    &key, &val),
+				    bo_u.u_btree.t_rc);
+	M0_UT_ASSERT(ergo(rc == 0, strcmp(k, v) == 0));
+	return rc;
+}
+
+/*
+ * Every thread works with odd keys from its own range, so threads mostly hit
+ * different subtrees of the root, which is populated with even keys. Ranges
+ * of the threads are spread over the whole tree.
+ */
+static void btree_mt_thread(struct btree_mt_thread *t)
+{
+	int base = 2 * t->bmt_idx * (MT_PRE_NR / t->bmt_nr);
+	int i;
+	int k;
+	int rc;
+
+	for (i = 0; i < MT_OP_NR / t->bmt_nr; ++i) {
+		k = base + 2 * i + 1;
+		rc = btree_mt_op(t->bmt_tree, k, t->bmt_delete);
+		M0_UT_ASSERT(rc == 0);
+		rc = btree_mt_lookup(t->bmt_tree, k);
+		M0_UT_ASSERT(rc == (t->bmt_delete ? -ENOENT : 0));
+		rc = btree_mt_lookup(t->bmt_tree, k - 1);
+		M0_UT_ASSERT(rc == 0);
+	}
+	m0_be_ut_backend_thread_exit(ut_be);
+}
+
+static void btree_mt_run(struct m0_be_btree *tree, int thread_nr, bool delete)
+{
+	static struct btree_mt_thread threads[MT_THREAD_NR];
+	m0_time_t                     start = m0_time_now();
+	m0_time_t                     elapsed;
+	int                           i;
+	int                           rc;
+
+	M0_PRE(thread_nr <= ARRAY_SIZE(threads));
+	M0_PRE(MT_OP_NR % thread_nr == 0);
+	for (i = 0; i < thread_nr; ++i) {
+		threads[i] = (struct btree_mt_thread) {
+			.bmt_tree   = tree,
+			.bmt_idx    = i,
+			.bmt_nr     = thread_nr,
+			.bmt_delete = delete,
+		};
+		rc = M0_THREAD_INIT(&threads[i].bmt_thread,
+				    struct btree_mt_thread *, NULL,
+				    &btree_mt_thread, &threads[i],
+				    "btree_mt%d", i);
+		M0_UT_ASSERT(rc == 0);
+	}
+	for (i = 0; i < thread_nr; ++i) {
+		m0_thread_join(&threads[i].bmt_thread);
+		m0_thread_fini(&threads[i].bmt_thread);
+	}
+	elapsed = m0_time_sub(m0_time_now(), start);
+	M0_LOG(M0_INFO, "%s: threads=%d ops=%d time=%"PRIu64" us",
+	       delete ? "delete" : "insert", thread_nr, MT_OP_NR,
+	       elapsed / 1000);
+}
+
+void m0_be_ut_btree_mt(void)
+{
+	struct m0_be_tx_credit  cred = {};
+	struct m0_be_btree     *tree;
+	struct m0_be_tx        *tx;
+	struct m0_be_op        *op;
+	static const int        nr[] = { 1, 8, 32, MT_THREAD_NR };
+	int                     i;
+	int                     rc;
+
+	M0_ALLOC_PTR(ut_be);
+	M0_UT_ASSERT(ut_be != NULL);
+	M0_ALLOC_PTR(ut_seg);
+	M0_UT_ASSERT(ut_seg != NULL);
+	M0_ALLOC_PTR(tx);
+	M0_UT_ASSERT(tx != NULL);
+	M0_ALLOC_PTR(op);
+	M0_UT_ASSERT(op != NULL);
+	m0_be_ut_backend_init(ut_be);
+	m0_be_ut_seg_init(ut_seg, ut_be, 1ULL << 24);
+	seg = ut_seg->bus_seg;
+
+	{
+		struct m0_be_btree t = { .bb_seg = seg };
+
+		m0_be_btree_create_credit(&t, 1, &cred);
+	}
+	M0_BE_ALLOC_CREDIT_PTR(tree, seg, &cred);
+	m0_be_ut_tx_init(tx, ut_be);
+	m0_be_tx_prep(tx, &cred);
+	rc = m0_be_tx_open_sync(tx);
+	M0_UT_ASSERT(rc == 0);
+	M0_BE_ALLOC_PTR_SYNC(tree, seg, tx);
+	m0_be_btree_init(tree, seg, &kv_ops);
+	M0_BE_OP_SYNC_WITH(op,
+		   m0_be_btree_create(tree, tx, op, &M0_FID_TINIT('b', 0, 2)));
+	m0_be_tx_close_sync(tx);
+	m0_be_tx_fini(tx);
+
+	for (i = 0; i < MT_PRE_NR * 2; i += MT_BATCH_NR * 2)
+		btree_mt_batch(tree, i, MT_BATCH_NR, false);
+	/* Check how operations scale with the number of threads. */
+	for (i = 0; i < ARRAY_SIZE(nr); ++i) {
+		btree_mt_run(tree, nr[i], false);
+		btree_mt_run(tree, nr[i], true);
+	}
+	for (i = 0; i < MT_PRE_NR * 2; ++i)
+		M0_UT_ASSERT(btree_mt_lookup(tree, i) ==
+			     (i % 2 == 0 ? 0 : -ENOENT));
+	for (i = 0; i < MT_PRE_NR * 2; i += MT_BATCH_NR * 2)
+		btree_mt_batch(tree, i, MT_BATCH_NR, true);
+	M0_UT_ASSERT(m0_be_btree_is_empty(tree));
+
+	cred = M0_BE_TX_CREDIT(0, 0);
+	m0_be_btree_destroy_credit(tree, &cred);
+	M0_BE_FREE_CREDIT_PTR(tree, seg, &cred);
+	m0_be_ut_tx_init(tx, ut_be);
+	m0_be_tx_prep(tx, &cred);
+	rc = m0_be_tx_open_sync(tx);
+	M0_UT_ASSERT(rc == 0);
+	M0_SET0(op);
+	M0_BE_OP_SYNC_WITH(op, m0_be_btree_destroy(tree, tx, op));
+	m0_be_btree_fini(tree);
+	M0_BE_FREE_PTR_SYNC(tree, seg, tx);
+	m0_be_tx_close_sync(tx);
+	m0_be_tx_fini(tx);
+
+	m0_be_ut_seg_fini(ut_seg);
+	m0_be_ut_backend_fini(ut_be);
+	m0_free(op);
+	m0_free(tx);
+	m0_free(ut_seg);
+	m0_free(ut_be);
+}
+
+static void btree_bulk_load_test(struct m0_be_btree *tree, int nr)
+{
+	static struct m0_be_btree_cursor  cursor;
+	struct m0_be_tx_credit            cred = {};
+	struct m0_be_tx                   tx = {};
+	struct m0_be_op                   op = {};
+	struct m0_buf                    *keys;
+	struct m0_buf                     key;
+	struct m0_buf                     val;
+	char                             *k;
+	char                              kbuf[INSERT_KSIZE];
+	int                               i;
+	int                               rc;
+
+	M0_ALLOC_ARR(keys, nr + 1);
+	M0_UT_ASSERT(keys != NULL);
+	M0_ALLOC_ARR(k, (nr + 1) * INSERT_KSIZE);
+	M0_UT_ASSERT(k != NULL);
+	/* Load even keys, so that odd ones can be inserted afterwards. */
+	for (i = 0; i < nr; ++i) {
+		btree_mt_key(k + i * INSERT_KSIZE, 2 * i);
+		keys[i] = M0_BUF_INIT(INSERT_KSIZE, k + i * INSERT_KSIZE);
+	}
+	m0_be_btree_bulk_load_credit(tree, nr, INSERT_KSIZE, INSERT_KSIZE,
+				     &cred);
+	m0_be_ut_tx_init(&tx, ut_be);
+	m0_be_tx_prep(&tx, &cred);
+	rc = m0_be_tx_open_sync(&tx);
+	M0_UT_ASSERT(rc == 0);
+	rc = M0_BE_OP_SYNC_RET_WITH(&op, m0_be_btree_bulk_load(tree, &tx, &op,
+							       keys, keys, nr),
+				    bo_u.u_btree.t_rc);
+	M0_UT_ASSERT(rc == 0);
+	m0_be_tx_close_sync(&tx);
+	m0_be_tx_fini(&tx);
+	M0_UT_ASSERT(m0_be_btree_is_empty(tree) == (nr == 0));
+
+	for (i = 0; i < 2 * nr; ++i)
+		M0_UT_ASSERT(btree_mt_lookup(tree, i) ==
+			     (i % 2 == 0 ? 0 : -ENOENT));
+	m0_be_btree_cursor_init(&cursor, tree);
+	rc = m0_be_btree_cursor_first_sync(&cursor);
+	for (i = 0; rc == 0; ++i) {
+		m0_be_btree_cursor_kv_get(&cursor, &key, &val);
+		btree_mt_key(kbuf, 2 * i);
+		M0_UT_ASSERT(strcmp(key.b_addr, kbuf) == 0);
+		M0_UT_ASSERT(strcmp(val.b_addr, kbuf) == 0);
+		rc = m0_be_btree_cursor_next_sync(&cursor);
+	}
+	M0_UT_ASSERT(rc == -ENOENT && i == nr);
+	m0_be_btree_cursor_fini(&cursor);
+
+	/* The loaded tree is a regular one: it can be updated. */
+	for (i = 1; i < 2 * nr; i += 2)
+		M0_UT_ASSERT(btree_mt_op(tree, i, false) == 0);
+	for (i = 0; i < 2 * nr; ++i)
+		M0_UT_ASSERT(btree_mt_op(tree, i, true) == 0);
+	M0_UT_ASSERT(m0_be_btree_is_empty(tree));
+	m0_free(k);
+	m0_free(keys);
+}
+
+/** Inserts keys @idx[0, nr) with m0_be_btree_insert_batch(). */
+static int btree_insert_batch(struct m0_be_btree *tree, const int *idx, int nr)
+{
+	struct m0_be_tx_credit cred = {};
+	struct m0_be_tx        tx = {};
+	struct m0_be_op        op = {};
+	struct m0_buf          keys[MT_BATCH_NR];
+	char                   k[MT_BATCH_NR][INSERT_KSIZE];
+	int                    i;
+	int                    rc;
+
+	M0_PRE(nr <= MT_BATCH_NR);
+	for (i = 0; i < nr; ++i) {
+		btree_mt_key(k[i], idx[i]);
+		keys[i] = M0_BUF_INIT(INSERT_KSIZE, k[i]);
+	}
+	m0_be_btree_insert_batch_credit(tree, nr, INSERT_KSIZE, INSERT_KSIZE,
+					&cred);
+	m0_be_ut_tx_init(&tx, ut_be);
+	m0_be_tx_prep(&tx, &cred);
+	rc = m0_be_tx_open_sync(&tx);
+	M0_UT_ASSERT(rc == 0);
+	rc = M0_BE_OP_SYNC_RET_WITH(&op,
+			m0_be_btree_insert_batch(tree, &tx, &op, keys, keys, nr),
+			bo_u.u_btree.t_rc);
+	m0_be_tx_close_sync(&tx);
+	m0_be_tx_fini(&tx);
+	return rc;
+}
+
+static void btree_insert_batch_test(struct m0_be_btree *tree, int nr)
+{
+	int idx[MT_BATCH_NR];
+	int off;
+	int n;
+	int i;
+	int j;
+
+	/*
+	 * Insert keys 3 * i into the empty tree, so that leaves are filled and
+	 * split, then keys 3 * i + 1 between them.
+	 */
+	for (off = 0; off < 2; ++off) {
+		for (i = 0; i < nr; i += n) {
+			n = min_check(nr - i, (int)MT_BATCH_NR);
+			for (j = 0; j < n; ++j)
+				idx[j] = 3 * (i + j) + off;
+			M0_UT_ASSERT(btree_insert_batch(tree, idx, n) == 0);
+		}
+	}
+	for (i = 0; i < 3 * nr; ++i)
+		M0_UT_ASSERT(btree_mt_lookup(tree, i) ==
+			     (i % 3 == 2 ? -ENOENT : 0));
+	if (nr > 1) {
+		/* Records preceding an existing key are inserted. */
+		idx[0] = 2;
+		idx[1] = 3;
+		idx[2] = 5;
+		M0_UT_ASSERT(btree_insert_batch(tree, idx, 3) == -EEXIST);
+		M0_UT_ASSERT(btree_mt_lookup(tree, 2) == 0);
+		M0_UT_ASSERT(btree_mt_lookup(tree, 5) == -ENOENT);
+		M0_UT_ASSERT(btree_mt_op(tree, 2, true) == 0);
+	}
+	for (i = 0; i < 3 * nr; ++i) {
+		if (i % 3 != 2)
+			M0_UT_ASSERT(btree_mt_op(tree, i, true) == 0);
+	}
+	M0_UT_ASSERT(m0_be_btree_is_empty(tree));
+}
+
+static int btree_convert(struct m0_be_btree *tree, m0_bcount_t limit)
+{
+	struct m0_be_tx_credit cred = {};
+	struct m0_be_tx        tx = {};
+	struct m0_be_op        op = {};
+	int                    rc;
+
+	m0_be_btree_convert_credit(tree, limit, &cred);
+	m0_be_ut_tx_init(&tx, ut_be);
+	m0_be_tx_prep(&tx, &cred);
+	rc = m0_be_tx_open_sync(&tx);
+	M0_UT_ASSERT(rc == 0);
+	rc = M0_BE_OP_SYNC_RET_WITH(&op,
+			m0_be_btree_convert(tree, &tx, &op, limit),
+			bo_u.u_btree.t_rc);
+	m0_be_tx_close_sync(&tx);
+	m0_be_tx_fini(&tx);
+	return rc;
+}
+
+static void btree_convert_test(struct m0_be_btree *tree, int nr)
+{
+	int idx[MT_BATCH_NR];
+	int n;
+	int i;
+	int j;
+	int rc;
+
+	/* Even keys go into the nodes of format version 1. */
+	for (i = 0; i < nr; i += n) {
+		n = min_check(nr - i, (int)MT_BATCH_NR);
+		for (j = 0; j < n; ++j)
+			idx[j] = 2 * (i + j);
+		M0_UT_ASSERT(btree_insert_batch(tree, idx, n) == 0);
+	}
+	/*
+	 * Once the tree type defines key prefixes, new nodes get format
+	 * version 2 and both formats are mixed in the tree.
+	 */
+	m0_be_btree_fini(tree);
+	m0_be_btree_init(tree, seg, &pfx_kv_ops);
+	for (i = 1; i < 2 * nr; i += 4)
+		M0_UT_ASSERT(btree_mt_op(tree, i, false) == 0);
+	/* A node per transaction, the tree is usable between them. */
+	while ((rc = btree_convert(tree, 1)) == -EAGAIN)
+		M0_UT_ASSERT(nr > 0 && btree_mt_lookup(tree, 0) == 0);
+	M0_UT_ASSERT(rc == 0);
+	M0_UT_ASSERT(btree_convert(tree, 0) == 0);
+
+	for (i = 0; i < 2 * nr; ++i)
+		M0_UT_ASSERT(btree_mt_lookup(tree, i) ==
+			     (i % 2 == 0 || i % 4 == 1 ? 0 : -ENOENT));
+	for (i = 3; i < 2 * nr; i += 4)
+		M0_UT_ASSERT(btree_mt_op(tree, i, false) == 0);
+	for (i = 0; i < 2 * nr; ++i)
+		M0_UT_ASSERT(btree_mt_op(tree, i, true) == 0);
+	M0_UT_ASSERT(m0_be_btree_is_empty(tree));
+}
+
+static void btree_bulk_ut(void (*test)(struct m0_be_btree *tree, int nr))
+{
+	static const int        nr[] = { 0, 1, 2 * BTREE_FAN_OUT - 1,
+					 2 * BTREE_FAN_OUT,
+					 BTREE_FAN_OUT * 20 };
+	struct m0_be_tx_credit  cred = {};
+	struct m0_be_btree     *tree;
+	struct m0_be_tx        *tx;
+	struct m0_be_op        *op;
+	int                     i;
+	int                     rc;
+
+	M0_ALLOC_PTR(ut_be);
+	M0_UT_ASSERT(ut_be != NULL);
+	M0_ALLOC_PTR(ut_seg);
+	M0_UT_ASSERT(ut_seg != NULL);
+	M0_ALLOC_PTR(tx);
+	M0_UT_ASSERT(tx != NULL);
+	M0_ALLOC_PTR(op);
+	M0_UT_ASSERT(op != NULL);
+	m0_be_ut_backend_init(ut_be);
+	m0_be_ut_seg_init(ut_seg, ut_be, 1ULL << 24);
+	seg = ut_seg->bus_seg;
+
+	/* Every test gets a new tree. */
+	for (i = 0; i < ARRAY_SIZE(nr); ++i) {
+		struct m0_be_btree t = { .bb_seg = seg };
+
+		cred = M0_BE_TX_CREDIT(0, 0);
+		m0_be_btree_create_credit(&t, 1, &cred);
+		M0_BE_ALLOC_CREDIT_PTR(tree, seg, &cred);
+		m0_be_ut_tx_init(tx, ut_be);
+		m0_be_tx_prep(tx, &cred);
+		rc = m0_be_tx_open_sync(tx);
+		M0_UT_ASSERT(rc == 0);
+		M0_BE_ALLOC_PTR_SYNC(tree, seg, tx);
+		m0_be_btree_init(tree, seg, &kv_ops);
+		M0_SET0(op);
+		M0_BE_OP_SYNC_WITH(op, m0_be_btree_create(tree, tx, op,
+						&M0_FID_TINIT('b', 0, 3)));
+		m0_be_tx_close_sync(tx);
+		m0_be_tx_fini(tx);
+
+		test(tree, nr[i]);
+
+		cred = M0_BE_TX_CREDIT(0, 0);
+		m0_be_btree_destroy_credit(tree, &cred);
+		M0_BE_FREE_CREDIT_PTR(tree, seg, &cred);
+		m0_be_ut_tx_init(tx, ut_be);
+		m0_be_tx_prep(tx, &cred);
+		rc = m0_be_tx_open_sync(tx);
+		M0_UT_ASSERT(rc == 0);
+		M0_SET0(op);
+		M0_BE_OP_SYNC_WITH(op, m0_be_btree_destroy(tree, tx, op));
+		m0_be_btree_fini(tree);
+		M0_BE_FREE_PTR_SYNC(tree, seg, tx);
+		m0_be_tx_close_sync(tx);
+		m0_be_tx_fini(tx);
+	}
+
+	m0_be_ut_seg_fini(ut_seg);
+	m0_be_ut_backend_fini(ut_be);
+	m0_free(op);
+	m0_free(tx);
+	m0_free(ut_seg);
+	m0_free(ut_be);
+}
+
+void m0_be_ut_btree_bulk_load(void)
+{
+	btree_bulk_ut(&btree_bulk_load_test);
+}
+
+void m0_be_ut_btree_insert_batch(void)
+{
+	btree_bulk_ut(&btree_insert_batch_test);
+}
+
+void m0_be_ut_btree_convert(void)
+{
+	btree_bulk_ut(&btree_convert_test);
+}
+
 #undef M0_TRACE_SUBSYSTEM
 
 /*
@@ -37,6 +37,7 @@ enum {
 	UT_DTM0_LOG_MAX_PA      =   3,
 	UT_DTM0_LOG_BUF_SIZE    = 256,
 	UT_DTM0_LOG_MAX_LOG_REC =  10,
+	UT_DTM0_LOG_INDEX_REC   = 1 << 14,
 };
 
 /* p - participant, state_set, init, check */
@@ -286,6 +287,69 @@ void test_volatile_dtm0_log(void)
 }
 
 
+/*
+ * Fills a volatile log with many records and checks lookup and ordered
+ * pruning through the index.
+ */
+static void test_volatile_dtm0_log_index(void)
+{
+	struct m0_dtm0_clk_src  cs;
+	struct m0_dtm0_tx_desc *txd;
+	struct m0_dtm0_tid      missing;
+	struct m0_buf           empty_buf = {};
+	struct m0_be_dtm0_log  *log;
+	int                     half = UT_DTM0_LOG_INDEX_REC / 2;
+	int                     i;
+	int                     j;
+	int                     rc;
+
+	m0_dtm0_clk_src_init(&cs, M0_DTM0_CS_PHYS);
+	M0_ALLOC_ARR(txd, UT_DTM0_LOG_INDEX_REC);
+	M0_UT_ASSERT(txd != NULL);
+	rc = m0_be_dtm0_log_alloc(&log);
+	M0_UT_ASSERT(rc == 0);
+	rc = m0_be_dtm0_log_init(log, &cs, false);
+	M0_UT_ASSERT(rc == 0);
+
+	m0_mutex_lock(&log->dl_lock);
+	for (i = 0; i < UT_DTM0_LOG_INDEX_REC; ++i) {
+		rc = txd_init(&txd[i], i);
+		M0_UT_ASSERT(rc == 0);
+		for (j = 0; j < txd[i].dtd_ps.dtp_nr; ++j)
+			p_state_set(&txd[i].dtd_ps.dtp_pa[j],
+				    M0_DTPS_PERSISTENT);
+		rc = m0_be_dtm0_log_update(log, NULL, &txd[i], &empty_buf);
+		M0_UT_ASSERT(rc == 0);
+	}
+	M0_UT_ASSERT(m0_forall(i, UT_DTM0_LOG_INDEX_REC,
+			       m0_be_dtm0_log_find(log,
+						   &txd[i].dtd_id) != NULL));
+	tid_init(&missing, UT_DTM0_LOG_INDEX_REC);
+	M0_UT_ASSERT(m0_be_dtm0_log_find(log, &missing) == NULL);
+	rc = m0_be_dtm0_log_prune(log, NULL, &missing);
+	M0_UT_ASSERT(rc == -ENOENT);
+
+	rc = m0_be_dtm0_log_prune(log, NULL, &txd[half].dtd_id);
+	M0_UT_ASSERT(rc == 0);
+	M0_UT_ASSERT(m0_forall(i, UT_DTM0_LOG_INDEX_REC,
+			       (m0_be_dtm0_log_find(log, &txd[i].dtd_id) ==
+				NULL) == (i <= half)));
+	rc = m0_be_dtm0_log_prune(log, NULL,
+				  &txd[UT_DTM0_LOG_INDEX_REC - 1].dtd_id);
+	M0_UT_ASSERT(rc == 0);
+	M0_UT_ASSERT(m0_forall(i, UT_DTM0_LOG_INDEX_REC,
+			       m0_be_dtm0_log_find(log,
+						   &txd[i].dtd_id) == NULL));
+	m0_mutex_unlock(&log->dl_lock);
+
+	for (i = 0; i < UT_DTM0_LOG_INDEX_REC; ++i)
+		txd_fini(&txd[i]);
+	m0_free(txd);
+	m0_be_dtm0_log_fini(log);
+	m0_be_dtm0_log_free(&log);
+	m0_dtm0_clk_src_fini(&cs);
+}
+
 static struct m0_be_ut_backend *ut_be;
 static struct m0_be_ut_seg     *ut_seg;
 static struct m0_be_seg        *seg;
@@ -585,15 +649,18 @@ static void m0_be_ut_dtm0_log_test(void)
 	log = persistent_log_create();
 	M0_UT_ASSERT(log != NULL);
 
+	m0_be_dtm0_log_fini(log);
 	m0_be_ut_seg_reload(ut_seg);
 	m0_be_dtm0_log_init(log, &cs, true);
 
 	persistent_log_operate(log);
+	m0_be_dtm0_log_fini(log);
 	m0_be_ut_seg_reload(ut_seg);
 	m0_be_dtm0_log_init(log, &cs, true);
 
 	dtm0_log_check(log);
 	persistent_log_destroy(log);
+	m0_be_dtm0_log_fini(log);
 
 	/* TODO: destroy_log(log); */
 
@@ -612,6 +679,7 @@ struct m0_ut_suite dtm0_log_ut = {
 	.ts_fini   = NULL,
 	.ts_tests  = {
 		{ "dtm0-log-list",       test_volatile_dtm0_log },
+		{ "dtm0-log-index",      test_volatile_dtm0_log_index },
 		{ "dtm0-log-persistent", m0_be_ut_dtm0_log_test },
 		{ NULL, NULL }
 	}
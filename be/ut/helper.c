@@ -344,7 +344,11 @@ void m0_be_ut_backend_cfg_default(struct m0_be_domain_cfg *cfg)
 			.ldsc_loc               = m0_locality0_get(),
 			.ldsc_sync_timeout      = M0_TIME_ONE_SECOND * 5ULL,
 		},
-		.bc_zone_pcnt = { [M0_BAP_NORMAL] = 100 }
+		.bc_zone_pcnt = { [M0_BAP_NORMAL] = 100 },
+		.bc_alloc_cfg = {
+			.bac_arena_percent = M0_BE_ALLOC_ARENA_PERCENT,
+			.bac_slab_percent  = M0_BE_ALLOC_SLAB_PERCENT,
+		},
 	};
 }
 
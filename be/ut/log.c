@@ -170,6 +170,63 @@ static void be_ut_log_multi_thread(struct be_ut_log_thread_ctx *ctx)
 
 M0_UT_THREADS_DEFINE(be_ut_log, be_ut_log_multi_thread);
 
+/*
+ * Scans the log with read-ahead forward and then backward and compares
+ * records with @iters.
+ */
+static void be_ut_log_ra_check(struct m0_be_log                   *log,
+			       const struct m0_be_log_record_iter *iters,
+			       int                                 nr)
+{
+	struct m0_be_log_record_iter ra_iters[2] = {};
+	struct m0_be_log_record_iter *curr;
+	uint64_t                      misses;
+	int                           rc;
+	int                           i;
+
+	rc = m0_be_log_ra_init(log, M0_BE_LOG_RA_SIZE);
+	M0_UT_ASSERT(rc == 0);
+	M0_UT_ASSERT(log->lg_ra.lra_size > 0);
+	for (i = 0; i < ARRAY_SIZE(ra_iters); ++i) {
+		rc = m0_be_log_record_iter_init(&ra_iters[i]);
+		M0_UT_ASSERT(rc == 0);
+	}
+	for (i = 0; i < nr; ++i) {
+		curr = &ra_iters[i % 2];
+		rc = i == 0 ? m0_be_log_record_initial(log, curr) :
+		     m0_be_log_record_next(log, &ra_iters[(i + 1) % 2], curr);
+		M0_UT_ASSERT(rc == 0);
+		M0_UT_ASSERT(curr->lri_header.lrh_pos ==
+			     iters[i].lri_header.lrh_pos);
+		M0_UT_ASSERT(curr->lri_header.lrh_size ==
+			     iters[i].lri_header.lrh_size);
+	}
+	rc = m0_be_log_record_next(log, &ra_iters[(nr + 1) % 2],
+				   &ra_iters[nr % 2]);
+	M0_UT_ASSERT(rc != 0);
+	/* only reads outside of the read-ahead windows miss */
+	M0_UT_ASSERT(log->lg_ra.lra_misses >= 1);
+	M0_UT_ASSERT(log->lg_ra.lra_hits > 0);
+	M0_UT_ASSERT(log->lg_ra.lra_backward == 0);
+
+	/* Backward scan doesn't use read-ahead windows beyond the current. */
+	misses = log->lg_ra.lra_misses;
+	for (i = nr - 2; i >= 0; --i) {
+		curr = &ra_iters[i % 2];
+		rc = m0_be_log_record_prev(log, &ra_iters[(i + 1) % 2], curr);
+		M0_UT_ASSERT(rc == 0);
+		M0_UT_ASSERT(curr->lri_header.lrh_pos ==
+			     iters[i].lri_header.lrh_pos);
+		M0_UT_ASSERT(curr->lri_header.lrh_size ==
+			     iters[i].lri_header.lrh_size);
+	}
+	M0_UT_ASSERT(log->lg_ra.lra_misses == misses);
+	for (i = 0; i < ARRAY_SIZE(ra_iters); ++i)
+		m0_be_log_record_iter_fini(&ra_iters[i]);
+	m0_be_log_ra_fini(log);
+	M0_UT_ASSERT(log->lg_ra.lra_size == 0);
+}
+
 static void be_ut_log_multi_ut(int thread_nr, bool discard,
 			       int lio_nr, m0_bcount_t lio_size)
 {
@@ -294,6 +351,7 @@ static void be_ut_log_multi_ut(int thread_nr, bool discard,
 	/* log must contain exactly thread_nr records */
 	rc = m0_be_log_record_next(&log, &iters[thread_nr-1], &iters[thread_nr]);
 	M0_UT_ASSERT(rc != 0);
+	be_ut_log_ra_check(&log, iters, thread_nr);
 
 	/* Finalisation */
 
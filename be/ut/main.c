@@ -57,6 +57,7 @@ extern void m0_be_ut_regmap_random(void);
 extern void m0_be_ut_reg_area_simple(void);
 extern void m0_be_ut_reg_area_random(void);
 extern void m0_be_ut_reg_area_merge(void);
+extern void m0_be_ut_reg_area_perf(void);
 
 extern void m0_be_ut_fmt_log_header(void);
 extern void m0_be_ut_fmt_cblock(void);
@@ -94,6 +95,7 @@ extern void m0_be_ut_seg_io(void);
 extern void m0_be_ut_seg_multiple(void);
 extern void m0_be_ut_seg_large(void);
 extern void m0_be_ut_seg_large_multiple(void);
+extern void m0_be_ut_seg_prefault(void);
 
 extern void m0_be_ut_group_format(void);
 
@@ -137,6 +139,11 @@ extern void m0_be_ut_alloc_init_fini(void);
 extern void m0_be_ut_alloc_create_destroy(void);
 extern void m0_be_ut_alloc_multiple(void);
 extern void m0_be_ut_alloc_concurrent(void);
+extern void m0_be_ut_alloc_arena(void);
+extern void m0_be_ut_alloc_arena_concurrent(void);
+extern void m0_be_ut_alloc_slab(void);
+extern void m0_be_ut_alloc_slab_cfg(void);
+extern void m0_be_ut_alloc_slab_concurrent(void);
 extern void m0_be_ut_alloc_oom(void);
 extern void m0_be_ut_alloc_info(void);
 extern void m0_be_ut_alloc_spare(void);
@@ -144,6 +151,10 @@ extern void m0_be_ut_alloc_spare(void);
 extern void m0_be_ut_list(void);
 extern void m0_be_ut_btree_create_destroy(void);
 extern void m0_be_ut_btree_create_truncate(void);
+extern void m0_be_ut_btree_mt(void);
+extern void m0_be_ut_btree_bulk_load(void);
+extern void m0_be_ut_btree_insert_batch(void);
+extern void m0_be_ut_btree_convert(void);
 extern void m0_be_ut_emap(void);
 extern void m0_be_ut_seg_dict(void);
 extern void m0_be_ut_seg0_test(void);
@@ -190,6 +201,7 @@ struct m0_ut_suite be_ut = {
 // XXX		{ "reg_area-simple",         m0_be_ut_reg_area_simple         },
 		{ "reg_area-random",         m0_be_ut_reg_area_random         },
 		{ "reg_area-merge",          m0_be_ut_reg_area_merge          },
+		{ "reg_area-perf",           m0_be_ut_reg_area_perf           },
 		{ "fmt-log_header",          m0_be_ut_fmt_log_header          },
 		{ "fmt-cblock",              m0_be_ut_fmt_cblock              },
 		{ "fmt-group",               m0_be_ut_fmt_group               },
@@ -220,6 +232,7 @@ struct m0_ut_suite be_ut = {
 		{ "seg-multiple",            m0_be_ut_seg_multiple            },
 		{ "seg-large",               m0_be_ut_seg_large               },
 		{ "seg-large-multiple",      m0_be_ut_seg_large_multiple      },
+		{ "seg-prefault",            m0_be_ut_seg_prefault            },
 		{ "group_format",            m0_be_ut_group_format            },
 		{ "mkfs",                    m0_be_ut_mkfs                    },
 		{ "mkfs-multiseg",           m0_be_ut_mkfs_multiseg           },
@@ -257,6 +270,11 @@ struct m0_ut_suite be_ut = {
 		{ "alloc-create",            m0_be_ut_alloc_create_destroy    },
 		{ "alloc-multiple",          m0_be_ut_alloc_multiple          },
 		{ "alloc-concurrent",        m0_be_ut_alloc_concurrent        },
+		{ "alloc-arena",             m0_be_ut_alloc_arena             },
+		{ "alloc-arena-concurrent",  m0_be_ut_alloc_arena_concurrent  },
+		{ "alloc-slab",              m0_be_ut_alloc_slab              },
+		{ "alloc-slab-cfg",          m0_be_ut_alloc_slab_cfg          },
+		{ "alloc-slab-concurrent",   m0_be_ut_alloc_slab_concurrent   },
 		{ "alloc-oom",               m0_be_ut_alloc_oom               },
 		{ "alloc-info",              m0_be_ut_alloc_info              },
 		{ "alloc-spare",             m0_be_ut_alloc_spare             },
@@ -266,6 +284,10 @@ struct m0_ut_suite be_ut = {
 		{ "list",                    m0_be_ut_list                    },
 		{ "btree-create_destroy",    m0_be_ut_btree_create_destroy    },
 		{ "btree-create_truncate",   m0_be_ut_btree_create_truncate   },
+		{ "btree-mt",                m0_be_ut_btree_mt                },
+		{ "btree-bulk_load",         m0_be_ut_btree_bulk_load         },
+		{ "btree-insert_batch",      m0_be_ut_btree_insert_batch      },
+		{ "btree-convert",           m0_be_ut_btree_convert           },
 		{ "seg_dict",                m0_be_ut_seg_dict                },
 #ifndef __KERNEL__
 		{ "seg0",                    m0_be_ut_seg0_test               },
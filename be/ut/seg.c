@@ -327,6 +327,57 @@ void m0_be_ut_seg_large(void)
 	m0_free(seg);
 }
 
+/*
+ * Checks that segment contents are the same after m0_be_seg_open() with
+ * every prefault mode. Segment size is not a multiple of
+ * M0_BE_SEG_READ_SIZE_MAX to test partial last chunk.
+ */
+void m0_be_ut_seg_prefault(void)
+{
+	static const struct m0_be_seg_open_cfg cfgs[] = {
+		{ .soc_prefault = M0_BE_SEG_PREFAULT_NONE },
+		{ .soc_prefault = M0_BE_SEG_PREFAULT_POPULATE },
+		{ .soc_prefault = M0_BE_SEG_PREFAULT_READ },
+		{ .soc_prefault = M0_BE_SEG_PREFAULT_READ,
+		  .soc_thread_nr = 1 },
+		{ .soc_hugepage = M0_BE_SEG_HUGEPAGE_THP },
+	};
+	struct m0_be_seg *seg;
+	struct m0_stob   *stob;
+	m0_bcount_t       size;
+	int               rc;
+	int               i;
+
+	M0_ALLOC_PTR(seg);
+	M0_UT_ASSERT(seg != NULL);
+	stob = m0_ut_stob_linux_get();
+	M0_UT_ASSERT(stob != NULL);
+
+	size = M0_BE_SEG_READ_SIZE_MAX * 2 + BE_UT_SEG_SIZE;
+	m0_be_seg_init(seg, stob, NULL, M0_BE_SEG_FAKE_ID);
+	rc = m0_be_seg_create(seg, size, m0_be_ut_seg_allocate_addr(size));
+	M0_UT_ASSERT(rc == 0);
+	rc = m0_be_seg_open(seg);
+	M0_UT_ASSERT(rc == 0);
+	be_ut_seg_large_stob(seg, 4, size, false);
+
+	for (i = 0; i < ARRAY_SIZE(cfgs); ++i) {
+		m0_be_seg_close(seg);
+		seg->bs_open_cfg = cfgs[i];
+		rc = m0_be_seg_open(seg);
+		M0_UT_ASSERT(rc == 0);
+		be_ut_seg_large_mem(seg, 4, size, true);
+	}
+
+	m0_be_seg_close(seg);
+	rc = m0_be_seg_destroy(seg);
+	M0_UT_ASSERT(rc == 0);
+	m0_be_seg_fini(seg);
+
+	m0_ut_stob_put(stob, true);
+	m0_free(seg);
+}
+
 void m0_be_ut_seg_large_multiple(void)
 {
 	struct m0_be_seg_geom geom[] = {
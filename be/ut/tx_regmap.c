@@ -20,6 +20,9 @@
  */
 
 
+#define M0_TRACE_SUBSYSTEM M0_TRACE_SUBSYS_UT
+#include "lib/trace.h"
+
 #include "be/tx_regmap.h"
 
 #include "ut/ut.h"		/* M0_UT_ASSERT */
@@ -28,6 +31,8 @@
 #include "lib/arith.h"          /* m0_rnd64 */
 #include "lib/misc.h"           /* M0_SET0 */
 #include "lib/string.h"         /* memcpy */
+#include "lib/memory.h"         /* m0_alloc */
+#include "lib/time.h"           /* m0_time_now */
 
 #include "be/ut/helper.h"	/* m0_be_ut_seg */
 
@@ -1039,6 +1044,126 @@ void m0_be_ut_reg_area_merge(void)
 	m0_be_ut_seg_fini(&ut_seg);
 }
 
+enum {
+	/*
+	 * m0_be_rdt__invariant() walks all regions on every insertion when
+	 * expensive checks are enabled, which makes the test quadratic.
+	 */
+	BE_UT_RA_PERF_NR     = M0_ASSERT_EX_ON ? 1000 : 100000,
+	BE_UT_RA_PERF_R_SIZE = 8,
+};
+
+static void be_ut_reg_area_perf_capture(struct m0_be_reg_area *ra,
+					char                  *buf,
+					const uint32_t        *order,
+					bool                   odd)
+{
+	struct m0_be_reg_d rd;
+	m0_bindex_t        offs;
+	m0_time_t          start;
+	int                i;
+
+	start = m0_time_now();
+	for (i = 0; i < BE_UT_RA_PERF_NR; ++i) {
+		offs = (order[i] * 2 + odd) * BE_UT_RA_PERF_R_SIZE;
+		rd = (struct m0_be_reg_d) {
+			.rd_reg = M0_BE_REG(NULL, BE_UT_RA_PERF_R_SIZE,
+					    buf + offs),
+		};
+		m0_be_reg_area_capture(ra, &rd);
+	}
+	M0_LOG(M0_INFO, "captured %d scattered regions in "TIME_F,
+	       BE_UT_RA_PERF_NR, TIME_P(m0_time_sub(m0_time_now(), start)));
+}
+
+static void be_ut_reg_area_perf_check(struct m0_be_reg_area *ra,
+				      char                  *buf,
+				      m0_bcount_t            nr,
+				      m0_bcount_t            step)
+{
+	struct m0_be_reg_d     *rd;
+	struct m0_be_tx_credit  used;
+	m0_bcount_t             i = 0;
+
+	m0_be_reg_area_used(ra, &used);
+	M0_UT_ASSERT(used.tc_reg_nr == nr);
+	M0_UT_ASSERT(used.tc_reg_size == nr * BE_UT_RA_PERF_R_SIZE);
+	M0_BE_REG_AREA_FORALL(ra, rd) {
+		M0_UT_ASSERT(rd->rd_reg.br_addr == buf + i * step);
+		M0_UT_ASSERT(rd->rd_reg.br_size == BE_UT_RA_PERF_R_SIZE);
+		M0_UT_ASSERT(memcmp(rd->rd_buf, rd->rd_reg.br_addr,
+				    BE_UT_RA_PERF_R_SIZE) == 0);
+		++i;
+	}
+	M0_UT_ASSERT(i == nr);
+}
+
+/*
+ * Captures BE_UT_RA_PERF_NR scattered regions in random order, then the gaps
+ * between them, and merges the result into another reg_area, like tx_group
+ * does. Each capture inserts into the middle of the regions tree.
+ */
+void m0_be_ut_reg_area_perf(void)
+{
+	struct m0_be_reg_area  ra;
+	struct m0_be_reg_area  group;
+	m0_bcount_t            size;
+	m0_time_t              start;
+	uint32_t              *order;
+	uint64_t               seed = 0;
+	char                  *buf;
+	uint32_t               tmp;
+	int                    rc;
+	int                    i;
+	int                    j;
+
+	size = 2 * BE_UT_RA_PERF_NR * BE_UT_RA_PERF_R_SIZE;
+	M0_ALLOC_ARR(order, BE_UT_RA_PERF_NR);
+	M0_UT_ASSERT(order != NULL);
+	buf = m0_alloc(size);
+	M0_UT_ASSERT(buf != NULL);
+	for (i = 0; i < size; ++i)
+		buf[i] = m0_rnd64(&seed) % 0xFF + 1;
+	for (i = 0; i < BE_UT_RA_PERF_NR; ++i)
+		order[i] = i;
+	for (i = BE_UT_RA_PERF_NR - 1; i > 0; --i) {
+		j = m0_rnd64(&seed) % (i + 1);
+		tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+
+	rc = m0_be_reg_area_init(&ra,
+				 &M0_BE_TX_CREDIT(2 * BE_UT_RA_PERF_NR, size),
+				 M0_BE_REG_AREA_DATA_COPY);
+	M0_UT_ASSERT(rc == 0);
+	rc = m0_be_reg_area_init(&group,
+				 &M0_BE_TX_CREDIT(2 * BE_UT_RA_PERF_NR, size),
+				 M0_BE_REG_AREA_DATA_NOCOPY);
+	M0_UT_ASSERT(rc == 0);
+
+	be_ut_reg_area_perf_capture(&ra, buf, order, false);
+	be_ut_reg_area_perf_check(&ra, buf, BE_UT_RA_PERF_NR,
+				  2 * BE_UT_RA_PERF_R_SIZE);
+	be_ut_reg_area_perf_capture(&ra, buf, order, true);
+	be_ut_reg_area_perf_check(&ra, buf, 2 * BE_UT_RA_PERF_NR,
+				  BE_UT_RA_PERF_R_SIZE);
+
+	start = m0_time_now();
+	m0_be_reg_area_merge_in(&group, &ra);
+	M0_LOG(M0_INFO, "merged %d regions in "TIME_F, 2 * BE_UT_RA_PERF_NR,
+	       TIME_P(m0_time_sub(m0_time_now(), start)));
+	be_ut_reg_area_perf_check(&group, buf, 2 * BE_UT_RA_PERF_NR,
+				  BE_UT_RA_PERF_R_SIZE);
+
+	m0_be_reg_area_fini(&group);
+	m0_be_reg_area_fini(&ra);
+	m0_free(buf);
+	m0_free(order);
+}
+
+#undef M0_TRACE_SUBSYSTEM
+
 /*
  *  Local variables:
  *  c-indentation-style: "K&R"
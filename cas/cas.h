@@ -360,6 +360,11 @@ M0_EXTERN struct m0_fop_type cas_rep_fopt;
 M0_EXTERN struct m0_fop_type cas_gc_fopt;
 extern    struct m0_fop_type m0_fop_fsync_cas_fopt;
 
+enum {
+	/** Maximum value for m0_cas_svc_key_shards_set(). */
+	M0_CAS_KEY_SHARD_BITS_MAX = 8,
+};
+
 /**
  * CAS server side is able to compile in user-space only. Use stubs in kernel
  * mode for service initialisation and deinitalisation. Also use NULLs for
@@ -375,6 +380,15 @@ M0_INTERNAL void m0_cas__ut_svc_be_set(struct m0_reqh_service *svc,
 				       struct m0_be_domain *dom);
 M0_INTERNAL struct m0_be_domain *
 m0_cas__ut_svc_be_get(struct m0_reqh_service *svc);
+
+/**
+ * Splits every catalogue of the service into 2^bits key ranges for home
+ * locality selection, the range is selected by the leading bits of the first
+ * key of a request. By default (bits == 0) all requests to a catalogue go to
+ * the same locality. m0d sets it from the "-P" option on service start.
+ */
+M0_INTERNAL void m0_cas_svc_key_shards_set(struct m0_reqh_service *svc,
+					   uint32_t bits);
 #else
 #define m0_cas_svc_init()
 #define m0_cas_svc_fini()
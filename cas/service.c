@@ -251,6 +251,14 @@
  * credits depends on the height of BE tree. Index is unlocked when all
  * necessary B-tree operations are done.
  *
+ * Home locality of a CAS FOM is selected by the hash of catalogue fid (see
+ * cas_fom_home_locality()), so requests to the same catalogue are executed by
+ * the same locality thread. They do not bounce m0_cas_ctg::cc_lock and btree
+ * nodes between cores and are processed one after another, instead of
+ * blocking on the catalogue long lock in several localities. A hot catalogue
+ * can be spread over several localities by key ranges, see
+ * m0_cas_svc_key_shards_set().
+ *
  * @subsection cas-lspec-layout
  *
  * Memory for all indices (including meta-index) is allocated in the first
@@ -311,6 +319,11 @@ enum {
 struct cas_service {
 	struct m0_reqh_service  c_service;
 	struct m0_be_domain    *c_be_domain;
+	/**
+	 * Log2 of the number of key ranges each catalogue is split into for
+	 * home locality selection. See m0_cas_svc_key_shards_set().
+	 */
+	uint32_t                c_key_shard_bits;
 };
 
 struct cas_kv {
@@ -549,6 +562,15 @@ M0_INTERNAL void m0_cas__ut_svc_be_set(struct m0_reqh_service *svc,
 	service->c_be_domain = dom;
 }
 
+M0_INTERNAL void m0_cas_svc_key_shards_set(struct m0_reqh_service *svc,
+					   uint32_t bits)
+{
+	struct cas_service *service = M0_AMB(service, svc, c_service);
+
+	M0_PRE(bits <= M0_CAS_KEY_SHARD_BITS_MAX);
+	service->c_key_shard_bits = bits;
+}
+
 M0_INTERNAL struct m0_be_domain *
 m0_cas__ut_svc_be_get(struct m0_reqh_service *svc)
 {
@@ -568,6 +590,9 @@ static int cas_service_start(struct m0_reqh_service *svc)
 	/* XXX It's a workaround. It's needed until we have a better way. */
 	service->c_be_domain = ut_dom != NULL ?
 			       ut_dom : svc->rs_reqh_ctx->rc_beseg->bs_domain;
+	if (ut_dom == NULL)
+		m0_cas_svc_key_shards_set(svc,
+				svc->rs_reqh_ctx->rc_cas_key_shard_bits);
 	rc = m0_ctg_store_init(service->c_be_domain);
 	if (rc == 0) {
 		/*
@@ -1738,11 +1763,31 @@ static const struct m0_fid *cas_fid(const struct m0_fom *fom)
 	return &cas_op(fom)->cg_id.ci_fid;
 }
 
+/**
+ * Selects home locality by catalogue fid, like
+ * m0_io_fom_cob_rw_locality_get() does for cobs.
+ *
+ * With key sharding enabled, the leading bits of the first key select one of
+ * the key ranges of the catalogue. Requests with keys from the same range
+ * still meet in one locality, adjacent keys stay together.
+ */
 static size_t cas_fom_home_locality(const struct m0_fom *fom)
 {
-	static uint64_t loc = 0;
-
-	return loc++;
+	struct cas_service         *service;
+	const struct m0_cas_op     *op   = cas_op(fom);
+	uint64_t                    hash = m0_fid_hash(cas_fid(fom));
+	const struct m0_rpc_at_buf *key;
+	uint32_t                    bits;
+
+	service = M0_AMB(service, fom->fo_service, c_service);
+	bits = service->c_key_shard_bits;
+	if (bits != 0 && op->cg_rec.cr_nr > 0) {
+		key = &op->cg_rec.cr_rec[0].cr_key;
+		if (key->ab_type == M0_RPC_AT_INLINE &&
+		    key->u.ab_buf.b_nob > 0)
+			hash += *(uint8_t *)key->u.ab_buf.b_addr >> (8 - bits);
+	}
+	return m0_rnd(1 << 30, &hash) >> 1;
 }
 
 static struct m0_cas_op *cas_op(const struct m0_fom *fom)
@@ -342,12 +342,16 @@ struct fopsem {
 	struct m0_fop       fs_fop;
 };
 
+/** Home locality of the last completed fom. */
+static int last_loc;
+
 static void cb_done(struct m0_fom *fom)
 {
 	struct m0_cas_rep *reply = m0_fop_data(fom->fo_rep_fop);
 	int                i;
 	struct fopsem     *fs = M0_AMB(fs, fom->fo_fop, fs_fop);
 
+	last_loc = fom->fo_loc->fl_idx;
 	M0_UT_ASSERT(reply != NULL);
 	M0_UT_ASSERT(reply->cgr_rep.cr_nr <= ARRAY_SIZE(repv));
 	rep.cgr_rc         = reply->cgr_rc;
@@ -979,6 +983,40 @@ static void insert(void)
 	fini();
 }
 
+/**
+ * Test that operations on a catalogue are executed in the same locality.
+ */
+static void locality(void)
+{
+	int loc;
+	int i;
+
+	init();
+	meta_fid_submit(&cas_put_fopt, &ifid);
+	index_op(&cas_put_fopt, &ifid, 1, 2);
+	M0_UT_ASSERT(rep.cgr_rc == 0);
+	loc = last_loc;
+	for (i = 2; i < 10; ++i) {
+		index_op(&cas_put_fopt, &ifid, i, i);
+		M0_UT_ASSERT(rep.cgr_rc == 0);
+		M0_UT_ASSERT(last_loc == loc);
+		index_op(&cas_get_fopt, &ifid, i, NOVAL);
+		M0_UT_ASSERT(rep.cgr_rc == 0);
+		M0_UT_ASSERT(last_loc == loc);
+	}
+	/* With key sharding the same key still goes to the same locality. */
+	m0_cas_svc_key_shards_set(cas, 8);
+	index_op(&cas_get_fopt, &ifid, 3, NOVAL);
+	loc = last_loc;
+	for (i = 0; i < 4; ++i) {
+		index_op(&cas_get_fopt, &ifid, 3, NOVAL);
+		M0_UT_ASSERT(rep.cgr_rc == 0);
+		M0_UT_ASSERT(last_loc == loc);
+	}
+	m0_cas_svc_key_shards_set(cas, 0);
+	fini();
+}
+
 /**
  * Test insert+lookup.
  */
@@ -1984,6 +2022,7 @@ struct m0_ut_suite cas_service_ut = {
 		{ "meta-invalid",            &meta_invalid,          "Nikita" },
 		{ "insert",                  &insert,                "Nikita" },
 		{ "insert-lookup",           &insert_lookup,         "Nikita" },
+		{ "locality",                &locality,              "Nikita" },
 		{ "insert-delete",           &insert_delete,         "Nikita" },
 		{ "lookup-none",             &lookup_none,           "Nikita" },
 		{ "empty-value",             &empty_value,           "Egor"   },
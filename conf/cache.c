@@ -30,12 +30,15 @@
 #include "conf/onwire.h"    /* m0_confx */
 #include "lib/errno.h"      /* EEXIST */
 #include "lib/memory.h"     /* M0_ALLOC_PTR, M0_ALLOC_ARR */
+#include "lib/hash.h"       /* M0_HT_DEFINE */
 
 /**
  * @defgroup conf_dlspec_cache Configuration Cache (lspec)
  *
  * The implementation of m0_conf_cache::ca_registry is based on linked
- * list data structure.
+ * list data structure. The registry is indexed by object fid with
+ * m0_conf_cache::ca_index hash table, so that m0_conf_cache_lookup() does
+ * not depend on the number of cached objects.
  *
  * @see @ref conf, @ref conf-lspec
  *
@@ -47,6 +50,24 @@ M0_TL_DESCR_DEFINE(m0_conf_cache, "registered m0_conf_obj-s", ,
 		   M0_CONF_OBJ_MAGIC, M0_CONF_CACHE_MAGIC);
 M0_TL_DEFINE(m0_conf_cache, M0_INTERNAL, struct m0_conf_obj);
 
+static uint64_t conf_cache_index_hash(const struct m0_htable *htable,
+				      const struct m0_fid    *fid)
+{
+	return m0_fid_hash(fid) % htable->h_bucket_nr;
+}
+
+static bool conf_cache_index_eq(const struct m0_fid *fid0,
+				const struct m0_fid *fid1)
+{
+	return m0_fid_eq(fid0, fid1);
+}
+
+M0_HT_DESCR_DEFINE(conf_cache_index, "conf cache index", static,
+		   struct m0_conf_obj, co_cache_hlink, co_gen_magic,
+		   M0_CONF_OBJ_MAGIC, M0_CONF_CACHE_INDEX_MAGIC,
+		   co_id, conf_cache_index_hash, conf_cache_index_eq);
+M0_HT_DEFINE(conf_cache_index, static, struct m0_conf_obj, struct m0_fid);
+
 M0_INTERNAL void m0_conf_cache_lock(struct m0_conf_cache *cache)
 {
 	m0_mutex_lock(cache->ca_lock);
@@ -62,7 +83,7 @@ M0_INTERNAL bool m0_conf_cache_is_locked(const struct m0_conf_cache *cache)
 	return m0_mutex_is_locked(cache->ca_lock);
 }
 
-M0_INTERNAL void
+M0_INTERNAL int
 m0_conf_cache_init(struct m0_conf_cache *cache, struct m0_mutex *lock)
 {
 	M0_ENTRY();
@@ -72,7 +93,8 @@ m0_conf_cache_init(struct m0_conf_cache *cache, struct m0_mutex *lock)
 	cache->ca_ver  = 0;
 	cache->ca_fid_counter = 0;
 
-	M0_LEAVE();
+	return M0_RC(conf_cache_index_htable_init(&cache->ca_index,
+						  M0_CONF_CACHE_BUCKET_NR));
 }
 
 M0_INTERNAL int
@@ -83,11 +105,14 @@ m0_conf_cache_add(struct m0_conf_cache *cache, struct m0_conf_obj *obj)
 	M0_ENTRY();
 	M0_PRE(m0_conf_cache_is_locked(cache));
 	M0_PRE(!m0_conf_cache_tlink_is_in(obj));
+	M0_PRE(obj->co_cache == cache);
 
 	x = m0_conf_cache_lookup(cache, &obj->co_id);
 	if (x != NULL)
 		return M0_ERR(-EEXIST);
 	m0_conf_cache_tlist_add(&cache->ca_registry, obj);
+	conf_cache_index_tlink_init(obj);
+	conf_cache_index_htable_add(&cache->ca_index, obj);
 	return M0_RC(0);
 }
 
@@ -106,14 +131,15 @@ M0_INTERNAL struct m0_conf_obj *
 m0_conf_cache_lookup(const struct m0_conf_cache *cache,
 		     const struct m0_fid *id)
 {
-	return m0_tl_find(m0_conf_cache, obj, &cache->ca_registry,
-			  m0_fid_eq(&obj->co_id, id));
+	return conf_cache_index_htable_lookup(&cache->ca_index, id);
 }
 
 static void _obj_del(struct m0_conf_obj *obj)
 {
 	M0_ENTRY("obj="FID_F, FID_P(&obj->co_id));
 
+	conf_cache_index_htable_del(&obj->co_cache->ca_index, obj);
+	conf_cache_index_tlink_fini(obj);
 	m0_conf_cache_tlist_del(obj);
 	m0_conf_obj_delete(obj);
 
@@ -187,6 +213,8 @@ M0_INTERNAL void m0_conf_cache_fini(struct m0_conf_cache *cache)
 	m0_conf_cache_lock(cache);
 	m0_conf_cache_clean(cache, NULL);
 	m0_conf_cache_tlist_fini(&cache->ca_registry);
+	if (m0_htable_is_init(&cache->ca_index))
+		conf_cache_index_htable_fini(&cache->ca_index);
 	m0_conf_cache_unlock(cache);
 
 	M0_LEAVE();
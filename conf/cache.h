@@ -98,6 +98,12 @@ struct m0_conf_cache {
 	 */
 	struct m0_tl     ca_registry;
 
+	/**
+	 * Index of the registry by m0_conf_obj::co_id, used by
+	 * m0_conf_cache_lookup(). Contains the same objects as ca_registry.
+	 */
+	struct m0_htable ca_index;
+
 	/** Cache lock. */
 	struct m0_mutex *ca_lock;
 
@@ -111,9 +117,19 @@ struct m0_conf_cache {
 	uint64_t         ca_fid_counter;
 };
 
-/** Initialises configuration cache. */
-M0_INTERNAL void m0_conf_cache_init(struct m0_conf_cache *cache,
-				    struct m0_mutex *lock);
+enum {
+	/** Number of buckets in m0_conf_cache::ca_index. */
+	M0_CONF_CACHE_BUCKET_NR = 1024
+};
+
+/**
+ * Initialises configuration cache.
+ *
+ * If initialisation fails, the cache can still be finalised with
+ * m0_conf_cache_fini().
+ */
+M0_INTERNAL int m0_conf_cache_init(struct m0_conf_cache *cache,
+				   struct m0_mutex *lock);
 
 /**
  * Finalises configuration cache.
@@ -152,6 +168,7 @@ M0_INTERNAL void m0_conf_cache_gc(struct m0_conf_cache *cache);
  *
  * @pre  m0_conf_cache_is_locked(cache)
  * @pre  !m0_conf_cache_tlink_is_in(obj)
+ * @pre  obj->co_cache == cache
  */
 M0_INTERNAL int m0_conf_cache_add(struct m0_conf_cache *cache,
 				  struct m0_conf_obj *obj);
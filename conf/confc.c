@@ -468,7 +468,9 @@ static int confc_cache_create(struct m0_confc *confc,
 	M0_ENTRY("confc=%p", confc);
 	M0_PRE(confc_is_locked(confc));
 
-	m0_conf_cache_init(&confc->cc_cache, &confc->cc_lock);
+	rc = m0_conf_cache_init(&confc->cc_cache, &confc->cc_lock);
+	if (rc != 0)
+		return M0_ERR(rc);
 
 	/* Create stub for root object */
 	rc = m0_conf_obj_find(&confc->cc_cache, &M0_CONF_ROOT_FID,
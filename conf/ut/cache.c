@@ -30,6 +30,7 @@
 #include "lib/errno.h"     /* ENOENT */
 #include "lib/fs.h"        /* m0_file_read */
 #include "lib/memory.h"    /* m0_free0 */
+#include "lib/ub.h"        /* m0_ub_set */
 #include "ut/misc.h"       /* M0_UT_PATH */
 #include "ut/ut.h"
 
@@ -183,6 +184,106 @@ static void test_obj_fill(void)
 	m0_confx_free(enc);
 }
 
+enum {
+	/** Number of objects in a "large cluster" configuration. */
+	CONF_CACHE_LARGE_NR = 10000
+};
+
+static struct m0_fid conf_cache_large_fid(int i)
+{
+	return M0_FID_TINIT(M0_CONF_SDEV_TYPE.cot_ftype.ft_id, 2, i);
+}
+
+static void conf_cache_large_add(struct m0_conf_cache *cache, int i)
+{
+	struct m0_fid       fid = conf_cache_large_fid(i);
+	struct m0_conf_obj *obj;
+	int                 rc;
+
+	m0_conf_cache_lock(cache);
+	rc = m0_conf_obj_find(cache, &fid, &obj);
+	m0_conf_cache_unlock(cache);
+	M0_ASSERT(rc == 0);
+}
+
+static void conf_cache_large_lookup(struct m0_conf_cache *cache, int i)
+{
+	struct m0_fid       fid = conf_cache_large_fid(i);
+	struct m0_conf_obj *obj;
+
+	m0_conf_cache_lock(cache);
+	obj = m0_conf_cache_lookup(cache, &fid);
+	m0_conf_cache_unlock(cache);
+	M0_ASSERT(obj != NULL && m0_fid_eq(&obj->co_id, &fid));
+}
+
+static struct m0_mutex      conf_ub_lock;
+static struct m0_conf_cache conf_ub_cache;
+
+static int conf_ub_init(const char *opts M0_UNUSED)
+{
+	m0_mutex_init(&conf_ub_lock);
+	return m0_conf_cache_init(&conf_ub_cache, &conf_ub_lock);
+}
+
+static void conf_ub_fini(void)
+{
+	m0_conf_cache_fini(&conf_ub_cache);
+	m0_mutex_fini(&conf_ub_lock);
+}
+
+static void conf_ub_add(int i)
+{
+	conf_cache_large_add(&conf_ub_cache, i);
+}
+
+static void conf_ub_lookup(int i)
+{
+	conf_cache_large_lookup(&conf_ub_cache, i);
+}
+
+static void test_cache_large(void)
+{
+	struct m0_fid fid = conf_cache_large_fid(CONF_CACHE_LARGE_NR);
+	int           rc;
+	int           i;
+
+	rc = conf_ub_init(NULL);
+	M0_UT_ASSERT(rc == 0);
+	for (i = 0; i < CONF_CACHE_LARGE_NR; ++i)
+		conf_ub_add(i);
+	for (i = 0; i < CONF_CACHE_LARGE_NR; ++i)
+		conf_ub_lookup(i);
+	M0_UT_ASSERT(m0_conf_cache_lookup(&conf_ub_cache, &fid) == NULL);
+
+	m0_conf_cache_lock(&conf_ub_cache);
+	m0_conf_cache_clean(&conf_ub_cache, NULL);
+	m0_conf_cache_unlock(&conf_ub_cache);
+	for (i = 0; i < CONF_CACHE_LARGE_NR; i += CONF_CACHE_LARGE_NR / 10) {
+		fid = conf_cache_large_fid(i);
+		M0_UT_ASSERT(m0_conf_cache_lookup(&conf_ub_cache, &fid) ==
+			     NULL);
+	}
+	conf_ub_fini();
+}
+
+struct m0_ub_set m0_conf_ub = {
+	.us_name = "conf-ub",
+	.us_init = conf_ub_init,
+	.us_fini = conf_ub_fini,
+	.us_run  = {
+		{ .ub_name  = "load",
+		  .ub_iter  = CONF_CACHE_LARGE_NR,
+		  .ub_round = conf_ub_add },
+
+		{ .ub_name  = "lookup",
+		  .ub_iter  = CONF_CACHE_LARGE_NR,
+		  .ub_round = conf_ub_lookup },
+
+		{ .ub_name = NULL }
+	}
+};
+
 struct m0_ut_suite conf_ut = {
 	.ts_name  = "conf-ut",
 	.ts_init  = m0_conf_ut_cache_init,
@@ -193,6 +294,7 @@ struct m0_ut_suite conf_ut = {
 		{ "obj-find",    test_obj_find  },
 		{ "obj-fill",    test_obj_fill  },
 		{ "dir-add-del", test_dir_add_del },
+		{ "cache-large", test_cache_large },
 		{ NULL, NULL }
 	}
 };
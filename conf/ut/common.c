@@ -107,8 +107,7 @@ static struct m0_mutex conf_ut_lock;
 M0_INTERNAL int m0_conf_ut_cache_init(void)
 {
 	m0_mutex_init(&conf_ut_lock);
-	m0_conf_cache_init(&m0_conf_ut_cache, &conf_ut_lock);
-	return 0;
+	return m0_conf_cache_init(&m0_conf_ut_cache, &conf_ut_lock);
 }
 
 M0_INTERNAL int m0_conf_ut_cache_fini(void)
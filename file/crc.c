@@ -35,15 +35,33 @@ static uint64_t md_crc32_cksum(void *data, uint64_t len, uint64_t *cksum);
  * CRC table is generated during first crc operation which contains the all
  * possible crc values for the byte of data. These values are used to
  * compute CRC for the all the bytes of data in the block of given length.
+ *
+ * The register update is linear, so 8 bytes can be folded in per step with
+ * 8 tables (slicing-by-8): crc_table[k] gives the effect of a byte that is
+ * k + 1 updates away from leaving the register.
  */
 
 #define CRC_POLY	0x04C11DB7
 #define CRC_WIDTH	32
 #define CRC_SLICE_SIZE	8
 #define CRC_TABLE_SIZE	256
+#define CRC_SLICES	8
+
+/** Castagnoli polynomial, bit-reflected. */
+#define CRC32C_POLY	0x82F63B78
 
-uint32_t crc_table[CRC_TABLE_SIZE];
+/** crc_table[k][i] is the register after k + 1 updates starting at i << 24. */
+static uint32_t crc_table[CRC_SLICES][CRC_TABLE_SIZE];
+/** Same for crc32c, in the bit-reflected domain. */
+static uint32_t crc32c_table[CRC_SLICES][CRC_TABLE_SIZE];
+/** crc32c_x2n[k] is x^(2^k) modulo CRC32C_POLY, for m0_crc32c_combine(). */
+static uint32_t crc32c_x2n[32];
 static bool is_table = false;
+#if defined(__x86_64__) && !defined(__KERNEL__)
+static bool crc32c_has_sse42 = false;
+#endif
+
+static uint32_t crc32c_multmodp(uint32_t a, uint32_t b);
 
 static void crc_mktable(void)
 {
@@ -59,27 +77,207 @@ static void crc_mktable(void)
 			if (crc &  hibit)
 				crc ^= CRC_POLY;
 		}
-		crc_table[i] = crc;
+		crc_table[0][i] = crc;
+		crc = i;
+		for (j = 0; j < CRC_SLICE_SIZE; j++)
+			crc = crc & 1 ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+		crc32c_table[0][i] = crc;
+	}
+	for (i = 0; i < CRC_TABLE_SIZE; i++) {
+		for (j = 1; j < CRC_SLICES; j++) {
+			crc = crc_table[j - 1][i];
+			crc_table[j][i] = (crc << CRC_SLICE_SIZE) ^
+				crc_table[0][crc >> 24];
+			crc = crc32c_table[j - 1][i];
+			crc32c_table[j][i] = (crc >> CRC_SLICE_SIZE) ^
+				crc32c_table[0][crc & 0xFF];
+		}
 	}
+	/* x^1 in the reflected domain. */
+	crc32c_x2n[0] = M0_BITS(CRC_WIDTH - 2);
+	for (i = 1; i < ARRAY_SIZE(crc32c_x2n); i++)
+		crc32c_x2n[i] = crc32c_multmodp(crc32c_x2n[i - 1],
+						crc32c_x2n[i - 1]);
+#if defined(__x86_64__) && !defined(__KERNEL__)
+	crc32c_has_sse42 = __builtin_cpu_supports("sse4.2");
+#endif
 }
 
-static uint32_t crc32(uint32_t crc, unsigned char const *data, m0_bcount_t len)
+static void crc_init(void)
 {
-	M0_PRE(data != NULL);
-	M0_PRE(len > 0);
-
 	if (!is_table) {
 		crc_mktable();
 		is_table = true;
 	}
+}
 
+static uint32_t crc32_bytes(uint32_t crc, unsigned char const *data,
+			    m0_bcount_t len)
+{
 	while (len--)
 		crc = ((crc << CRC_SLICE_SIZE) | *data++) ^
-			crc_table[crc >> (CRC_WIDTH - CRC_SLICE_SIZE) & 0xFF];
+			crc_table[0][crc >> (CRC_WIDTH - CRC_SLICE_SIZE) &
+				     0xFF];
+	return crc;
+}
+
+static uint32_t crc32_be32(unsigned char const *p)
+{
+	return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 |
+	       (uint32_t)p[2] << 8  | (uint32_t)p[3];
+}
+
+static uint32_t crc32(uint32_t crc, unsigned char const *data, m0_bcount_t len)
+{
+	M0_PRE(data != NULL);
+	M0_PRE(len > 0);
+
+	crc_init();
+	for (; len >= CRC_SLICES; len -= CRC_SLICES, data += CRC_SLICES)
+		crc = crc_table[7][crc >> 24] ^
+		      crc_table[6][(crc >> 16) & 0xFF] ^
+		      crc_table[5][(crc >> 8) & 0xFF] ^
+		      crc_table[4][crc & 0xFF] ^
+		      crc_table[3][data[0]] ^ crc_table[2][data[1]] ^
+		      crc_table[1][data[2]] ^ crc_table[0][data[3]] ^
+		      crc32_be32(data + 4);
+	return crc32_bytes(crc, data, len);
+}
 
+/** Software crc32c (reflected, no pre- and post-conditioning). */
+static uint32_t crc32c_soft(uint32_t crc, unsigned char const *data,
+			    m0_bcount_t len)
+{
+	uint32_t w;
+
+	for (; len >= CRC_SLICES; len -= CRC_SLICES, data += CRC_SLICES) {
+		w = crc ^ ((uint32_t)data[0] | (uint32_t)data[1] << 8 |
+			   (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24);
+		crc = crc32c_table[7][w & 0xFF] ^
+		      crc32c_table[6][(w >> 8) & 0xFF] ^
+		      crc32c_table[5][(w >> 16) & 0xFF] ^
+		      crc32c_table[4][w >> 24] ^
+		      crc32c_table[3][data[4]] ^ crc32c_table[2][data[5]] ^
+		      crc32c_table[1][data[6]] ^ crc32c_table[0][data[7]];
+	}
+	while (len--)
+		crc = (crc >> CRC_SLICE_SIZE) ^
+		      crc32c_table[0][(crc ^ *data++) & 0xFF];
 	return crc;
 }
 
+#if defined(__x86_64__) && !defined(__KERNEL__)
+/** crc32c with the SSE4.2 crc32 instruction. */
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, unsigned char const *data,
+			     m0_bcount_t len)
+{
+	uint64_t c = crc;
+	uint64_t w;
+
+	for (; len > 0 && ((uint64_t)data & 7) != 0; --len)
+		c = __builtin_ia32_crc32qi(c, *data++);
+	for (; len >= 8; len -= 8, data += 8) {
+		memcpy(&w, data, sizeof w);
+		c = __builtin_ia32_crc32di(c, w);
+	}
+	while (len--)
+		c = __builtin_ia32_crc32qi(c, *data++);
+	return c;
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_copy_sse42(uint32_t crc, void *dst, const void *src,
+				  m0_bcount_t len)
+{
+	unsigned char       *d = dst;
+	unsigned char const *s = src;
+	uint64_t             c = crc;
+	uint64_t             w;
+
+	for (; len >= 8; len -= 8, s += 8, d += 8) {
+		memcpy(&w, s, sizeof w);
+		memcpy(d, &w, sizeof w);
+		c = __builtin_ia32_crc32di(c, w);
+	}
+	for (; len > 0; --len) {
+		*d++ = *s;
+		c = __builtin_ia32_crc32qi(c, *s++);
+	}
+	return c;
+}
+#endif
+
+static uint32_t crc32c_update(uint32_t crc, const void *data, m0_bcount_t len)
+{
+	crc_init();
+#if defined(__x86_64__) && !defined(__KERNEL__)
+	if (crc32c_has_sse42)
+		return crc32c_sse42(crc, data, len);
+#endif
+	return crc32c_soft(crc, data, len);
+}
+
+/** Returns a * b modulo CRC32C_POLY, both in the reflected domain. */
+static uint32_t crc32c_multmodp(uint32_t a, uint32_t b)
+{
+	uint32_t m = M0_BITS(CRC_WIDTH - 1);
+	uint32_t p = 0;
+
+	for (; m != 0; m >>= 1) {
+		if (a & m)
+			p ^= b;
+		b = b & 1 ? (b >> 1) ^ CRC32C_POLY : b >> 1;
+	}
+	return p;
+}
+
+M0_INTERNAL uint32_t m0_crc32c(uint32_t crc, const void *data, uint64_t len)
+{
+	M0_PRE(data != NULL || len == 0);
+
+	return ~crc32c_update(~crc, data, len);
+}
+
+M0_INTERNAL uint32_t m0_crc32c_copy(uint32_t crc, void *dst, const void *src,
+				    uint64_t len)
+{
+	enum { CRC_COPY_CHUNK = 4096 };
+	m0_bcount_t chunk;
+
+	M0_PRE(ergo(len > 0, dst != NULL && src != NULL));
+
+	crc = ~crc;
+#if defined(__x86_64__) && !defined(__KERNEL__)
+	crc_init();
+	if (crc32c_has_sse42)
+		return ~crc32c_copy_sse42(crc, dst, src, len);
+#endif
+	/* Checksum each chunk right after copying, while it is in cache. */
+	for (; len > 0; len -= chunk) {
+		chunk = min_check(len, (uint64_t)CRC_COPY_CHUNK);
+		memcpy(dst, src, chunk);
+		crc = crc32c_update(crc, dst, chunk);
+		dst = (char *)dst + chunk;
+		src = (const char *)src + chunk;
+	}
+	return ~crc;
+}
+
+M0_INTERNAL uint32_t m0_crc32c_combine(uint32_t crc1, uint32_t crc2,
+				       uint64_t len2)
+{
+	uint32_t p = M0_BITS(CRC_WIDTH - 1); /* x^0 */
+	unsigned k = 3;                      /* len2 is in bytes: 2^3 bits */
+
+	crc_init();
+	for (; len2 != 0; len2 >>= 1, ++k) {
+		if (len2 & 1)
+			p = crc32c_multmodp(crc32c_x2n[k & 31], p);
+	}
+	return crc32c_multmodp(p, crc1) ^ crc2;
+}
+
 M0_INTERNAL void m0_crc32(const void *data, uint64_t len,
 			  uint64_t *cksum)
 {
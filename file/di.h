@@ -188,6 +188,29 @@ M0_INTERNAL void m0_crc32(const void *data, uint64_t len,
 M0_INTERNAL bool m0_crc32_chk(const void *data, uint64_t len,
 			      const uint64_t *cksum);
 
+/**
+ * Updates crc32c (Castagnoli) checksum "crc" with data of length "len".
+ *
+ * Start with crc == 0. Uses the SSE4.2 crc32 instruction when the CPU has it,
+ * slicing-by-8 tables otherwise.
+ */
+M0_INTERNAL uint32_t m0_crc32c(uint32_t crc, const void *data, uint64_t len);
+
+/**
+ * Copies "len" bytes from "src" to "dst" and updates crc32c checksum "crc"
+ * with them in the same pass.
+ */
+M0_INTERNAL uint32_t m0_crc32c_copy(uint32_t crc, void *dst, const void *src,
+				    uint64_t len);
+
+/**
+ * Returns crc32c of the concatenation of two blocks, given crc32c of each of
+ * them and the length of the second one. This allows to checksum pages
+ * independently and to derive the checksum of a larger unit from them.
+ */
+M0_INTERNAL uint32_t m0_crc32c_combine(uint32_t crc1, uint32_t crc2,
+				       uint64_t len2);
+
 M0_INTERNAL m0_bcount_t m0_di_size_get(const struct m0_file *file,
 				       const m0_bcount_t size);
 
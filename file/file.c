@@ -149,6 +149,7 @@
 /* Forward Declarations */
 static bool file_lock_equal(const struct m0_rm_resource *resource0,
 			    const struct m0_rm_resource *resource1);
+static uint64_t file_lock_hash(const struct m0_rm_resource *resource);
 static m0_bcount_t file_lock_len(const struct m0_rm_resource *resource);
 static int file_lock_encode(struct m0_bufvec_cursor     *cur,
 			    const struct m0_rm_resource *resource);
@@ -187,6 +188,7 @@ static void file_lock_cr_initial_capital(struct m0_rm_credit *self);
 
 const struct m0_rm_resource_type_ops file_lock_type_ops = {
 	.rto_eq     = file_lock_equal,
+	.rto_hash   = file_lock_hash,
 	.rto_len    = file_lock_len,
 	.rto_decode = file_lock_decode,
 	.rto_encode = file_lock_encode,
@@ -234,6 +236,11 @@ static bool file_lock_equal(const struct m0_rm_resource *resource0,
 	return m0_fid_eq(file0->fi_fid, file1->fi_fid);
 }
 
+static uint64_t file_lock_hash(const struct m0_rm_resource *resource)
+{
+	return m0_fid_hash(R_F(resource)->fi_fid);
+}
+
 static m0_bcount_t file_lock_len(const struct m0_rm_resource *resource)
 {
 	struct m0_file      *fl;
@@ -122,6 +122,51 @@ void file_di_none_test(void)
 		     &cksum_data));
 }
 
+void file_crc_test(void)
+{
+	enum { CRC_BUF_SIZE = 1000 };
+	unsigned char *src;
+	unsigned char *dst;
+	uint32_t       crc;
+	uint32_t       crc1;
+	int            len;
+	int            off;
+	int            i;
+
+	src = m0_alloc(CRC_BUF_SIZE);
+	dst = m0_alloc(CRC_BUF_SIZE);
+	M0_UT_ASSERT(src != NULL && dst != NULL);
+	for (i = 0; i < CRC_BUF_SIZE; ++i)
+		src[i] = i * 7 + (i >> 3);
+
+	/* Sliced crc32 gives the same checksums as byte-at-a-time one. */
+	crc_init();
+	for (len = 1; len < 100; ++len) {
+		for (off = 0; off < 8; ++off)
+			M0_UT_ASSERT(crc32(~0, src + off, len) ==
+				     crc32_bytes(~0, src + off, len));
+	}
+
+	/* crc32c check value. */
+	M0_UT_ASSERT(m0_crc32c(0, "123456789", 9) == 0xE3069283);
+	M0_UT_ASSERT(crc32c_soft(~0, (unsigned char *)"123456789", 9) ==
+		     ~0xE3069283);
+
+	crc = m0_crc32c(0, src, CRC_BUF_SIZE);
+	M0_UT_ASSERT(m0_crc32c_copy(0, dst, src, CRC_BUF_SIZE) == crc);
+	M0_UT_ASSERT(memcmp(src, dst, CRC_BUF_SIZE) == 0);
+	for (i = 0; i < CRC_BUF_SIZE; i += 111) {
+		crc1 = m0_crc32c(0, src, i);
+		M0_UT_ASSERT(m0_crc32c(crc1, src + i, CRC_BUF_SIZE - i) ==
+			     crc);
+		M0_UT_ASSERT(m0_crc32c_combine(crc1,
+				m0_crc32c(0, src + i, CRC_BUF_SIZE - i),
+				CRC_BUF_SIZE - i) == crc);
+	}
+	m0_free(dst);
+	m0_free(src);
+}
+
 void file_di_fini(void)
 {
 	m0_file_fini(&file);
@@ -139,6 +184,7 @@ struct m0_ut_suite di_ut = {
 		{ "di-ref-tag-test", file_ref_tag_test},
 		{ "di-test", file_di_test},
 		{ "di-none-test", file_di_none_test},
+		{ "di-crc-test", file_crc_test},
 		{ "di-fini", file_di_fini},
 		{ NULL, NULL },
 	},
@@ -130,6 +130,25 @@
  * Thread state transitions, associated lists and counters are protected by
  * the group mutex.
  *
+ * <b>Work stealing</b>
+ *
+ * Foms of types with m0_fom_type::ft_migratable set can be moved from a busy
+ * locality to an idle one. Because the handler thread keeps the group lock,
+ * an idle locality cannot take a fom from another run-queue itself. Instead,
+ * the idle handler sets m0_fom_locality::fl_hungry before going to sleep
+ * (fom_steal_want()) and a handler with at least FOM_STEAL_RUNQ_MIN foms in
+ * its run-queue, on each iteration of its loop, detaches a migratable fom
+ * from the tail of the run-queue and posts it to a hungry locality, which
+ * adds it to its own run-queue in AST context (fom_steal_offer(), stolen()).
+ * Hungry localities of the same NUMA node are preferred.
+ *
+ * While the fom travels it is counted in m0_fom_domain::fd_migrating, so that
+ * m0_fom_domain_is_idle_for() does not report a service idle in between.
+ *
+ * Most fom types are not migratable, so fom_steal_offer() first checks
+ * m0_fom_domain::fd_migratable and returns at once while the domain has no
+ * foms of migratable types.
+ *
  * @{
  */
 
@@ -138,6 +157,13 @@ enum {
 	HUNG_FOP_SEC_PERIOD   = 5,
 	HUNG_FOP_TIME_SEC_MAX = 2*60,
 	HUNG_FOP_TIME_SEC_IEM = 5*60,
+	/**
+	 * A locality gives foms away only while its run-queue is at least this
+	 * long, so that it keeps work for itself.
+	 */
+	FOM_STEAL_RUNQ_MIN    = 2,
+	/** How many foms at the run-queue tail are checked for migratability. */
+	FOM_STEAL_SCAN_MAX    = 8,
 };
 
 /**
@@ -195,6 +221,60 @@ static bool fom_wait_time_is_out(const struct m0_fom_domain *dom,
 				 const struct m0_fom *fom);
 static int loc_thr_create(struct m0_fom_locality *loc);
 
+/**
+ * Groups localities of the domain by NUMA node, see m0_fom_domain::fd_nodes.
+ */
+static int fom_domain_nodes_init(struct m0_fom_domain *dom)
+{
+	struct m0_processor_descr pd;
+	struct m0_fom_numa_node  *node;
+	uint32_t                  nr = 0;
+	size_t                    i;
+
+	dom->fd_proc_nr = m0_processor_nr_max();
+	M0_ALLOC_ARR(dom->fd_proc_node, dom->fd_proc_nr);
+	if (dom->fd_proc_node == NULL)
+		return M0_ERR(-ENOMEM);
+	for (i = 0; i < dom->fd_proc_nr; ++i)
+		dom->fd_proc_node[i] = m0_processor_describe(i, &pd) == 0 ?
+			pd.pd_numa_node : M0_PROCESSORS_INVALID_ID;
+
+	for (i = 0; i < dom->fd_localities_nr; ++i)
+		nr = max_check(nr, dom->fd_localities[i]->fl_numa_node + 1);
+	M0_ALLOC_ARR(dom->fd_nodes, nr);
+	if (dom->fd_nodes == NULL)
+		return M0_ERR(-ENOMEM);
+	dom->fd_nodes_nr = nr;
+	for (i = 0; i < dom->fd_localities_nr; ++i)
+		++dom->fd_nodes[dom->fd_localities[i]->fl_numa_node].fnn_locs_nr;
+	for (i = 0; i < nr; ++i) {
+		node = &dom->fd_nodes[i];
+		if (node->fnn_locs_nr == 0)
+			continue;
+		M0_ALLOC_ARR(node->fnn_locs, node->fnn_locs_nr);
+		if (node->fnn_locs == NULL)
+			return M0_ERR(-ENOMEM);
+		node->fnn_locs_nr = 0;
+	}
+	for (i = 0; i < dom->fd_localities_nr; ++i) {
+		node = &dom->fd_nodes[dom->fd_localities[i]->fl_numa_node];
+		node->fnn_locs[node->fnn_locs_nr++] = i;
+	}
+	return 0;
+}
+
+static void fom_domain_nodes_fini(struct m0_fom_domain *dom)
+{
+	uint32_t i;
+
+	for (i = 0; i < dom->fd_nodes_nr; ++i)
+		m0_free(dom->fd_nodes[i].fnn_locs);
+	m0_free0(&dom->fd_nodes);
+	dom->fd_nodes_nr = 0;
+	m0_free0(&dom->fd_proc_node);
+	dom->fd_proc_nr = 0;
+}
+
 static void hung_foms_notify(struct m0_locality_chore *chore,
 			     struct m0_locality *loc, void *place);
 
@@ -403,20 +483,13 @@ static bool fom_wait_time_is_out(const struct m0_fom_domain *dom,
 }
 
 /**
- * Enqueues fom into locality runq list and increments
- * number of items in runq, m0_fom_locality::fl_runq_nr.
- * This function is invoked when a new fom is submitted for
- * execution or a waiting fom is re-scheduled for processing.
- *
- * @post m0_fom_invariant(fom)
+ * Adds a ready fom to the runq of its locality.
  */
-static void fom_ready(struct m0_fom *fom)
+static void fom_runq_add(struct m0_fom *fom)
 {
-	struct m0_fom_locality *loc;
+	struct m0_fom_locality *loc = fom->fo_loc;
 	bool                    empty;
 
-	fom_state_set(fom, M0_FOS_READY);
-	loc = fom->fo_loc;
 	empty = runq_tlist_is_empty(&loc->fl_runq);
 	runq_tlist_add_tail(&loc->fl_runq, fom);
 	M0_CNT_INC(loc->fl_runq_nr);
@@ -426,6 +499,20 @@ static void fom_ready(struct m0_fom *fom)
 	M0_POST(m0_fom_invariant(fom));
 }
 
+/**
+ * Enqueues fom into locality runq list and increments
+ * number of items in runq, m0_fom_locality::fl_runq_nr.
+ * This function is invoked when a new fom is submitted for
+ * execution or a waiting fom is re-scheduled for processing.
+ *
+ * @post m0_fom_invariant(fom)
+ */
+static void fom_ready(struct m0_fom *fom)
+{
+	fom_state_set(fom, M0_FOS_READY);
+	fom_runq_add(fom);
+}
+
 M0_INTERNAL void m0_fom_ready(struct m0_fom *fom)
 {
 	struct m0_fom_locality *loc = fom->fo_loc;
@@ -451,24 +538,33 @@ static void fom_addb2_push(struct m0_fom *fom)
 		      fom->fo_transitions, fom->fo_sm_phase.sm_state);
 }
 
-static void addb2_introduce(struct m0_fom *fom)
+/**
+ * Points addb2 statistics of fom state machines to the data of the current
+ * locality.
+ */
+static void fom_addb2_stats_set(struct m0_fom *fom)
 {
-	struct m0_rpc_item             *req;
 	static struct m0_sm_addb2_stats phase_stats = {
 		.as_id = M0_AVI_PHASE,
 		.as_nr = 0
 	};
-	uint64_t sender_id = 0;
-	uint64_t item_sm_id = 0;
-	uint64_t phase_sm_id = 0;
-	uint64_t state_sm_id = 0;
 
 	if (!m0_sm_addb2_counter_init(&fom->fo_sm_phase))
 		fom->fo_sm_phase.sm_addb2_stats = &phase_stats;
 	if (!m0_sm_addb2_counter_init(&fom->fo_sm_state))
 		fom->fo_sm_state.sm_addb2_stats =
 			m0_locality_data(fom_states_conf.scf_addb2_key - 1);
+}
+
+static void addb2_introduce(struct m0_fom *fom)
+{
+	struct m0_rpc_item             *req;
+	uint64_t sender_id = 0;
+	uint64_t item_sm_id = 0;
+	uint64_t phase_sm_id = 0;
+	uint64_t state_sm_id = 0;
 
+	fom_addb2_stats_set(fom);
 	req = fom->fo_fop != NULL ? &fom->fo_fop->f_item : NULL;
 
 	fom_addb2_push(fom);
@@ -621,6 +717,48 @@ M0_INTERNAL void m0_fom_block_leave(struct m0_fom *fom)
 	M0_ASSERT(m0_locality_invariant(loc));
 }
 
+/**
+ * Returns the NUMA node to queue @fom to: the node of the processor the
+ * current thread runs on, if the fom was created for a request received by an
+ * rpc machine with m0_rpc_machine::rm_numa_steer and its type allows to steer
+ * its foms by node.
+ *
+ * Such foms are queued by m0_reqh_fop_handle() in the rpc thread which has
+ * just received the fop and created the fom, so this is the node where their
+ * memory was first touched. No node-specific allocator is used: the memory is
+ * node-local only as far as the allocator hands out pages first touched by
+ * this thread.
+ *
+ * @see m0_rpc_machine::rm_numa_steer, m0_fom_type::ft_numa_steered
+ */
+static uint32_t fom_numa_node(const struct m0_fom_domain *dom,
+			      const struct m0_fom        *fom)
+{
+	const struct m0_rpc_machine *mach;
+	m0_processor_nr_t            id;
+
+	mach = fom->fo_fop == NULL || !fom->fo_type->ft_numa_steered ?
+		NULL : fom->fo_fop->f_item.ri_rmachine;
+	if (mach == NULL || !mach->rm_numa_steer)
+		return M0_PROCESSORS_INVALID_ID;
+	id = m0_processor_id_get();
+	return id < dom->fd_proc_nr ? dom->fd_proc_node[id] :
+		M0_PROCESSORS_INVALID_ID;
+}
+
+M0_INTERNAL size_t m0_fom_domain_node_locality(const struct m0_fom_domain *dom,
+					       uint32_t node, size_t home)
+{
+	const struct m0_fom_numa_node *n;
+
+	if (node < dom->fd_nodes_nr) {
+		n = &dom->fd_nodes[node];
+		if (n->fnn_locs_nr > 0)
+			return n->fnn_locs[home % n->fnn_locs_nr];
+	}
+	return home % dom->fd_localities_nr;
+}
+
 M0_INTERNAL void m0_fom_queue(struct m0_fom *fom)
 {
 	struct m0_fom_domain *dom;
@@ -629,7 +767,8 @@ M0_INTERNAL void m0_fom_queue(struct m0_fom *fom)
 	M0_PRE(fom != NULL);
 
 	dom = m0_fom_dom();
-	loc_idx = fom->fo_ops->fo_home_locality(fom) % dom->fd_localities_nr;
+	loc_idx = m0_fom_domain_node_locality(dom, fom_numa_node(dom, fom),
+					fom->fo_ops->fo_home_locality(fom));
 	M0_ASSERT(loc_idx < dom->fd_localities_nr);
 	fom->fo_loc = dom->fd_localities[loc_idx];
 	fom->fo_loc_idx = loc_idx;
@@ -861,6 +1000,137 @@ static struct m0_fom *fom_dequeue(struct m0_fom_locality *loc)
 	return fom;
 }
 
+/**
+ * Clears m0_fom_locality::fl_hungry. Returns true iff this call cleared it.
+ */
+static bool fom_steal_hungry_clear(struct m0_fom_locality *loc)
+{
+	if (m0_atomic64_get(&loc->fl_hungry) != 0 &&
+	    m0_atomic64_cas(&loc->fl_hungry.a_value, 1, 0)) {
+		m0_atomic64_dec(&loc->fl_dom->fd_hungry);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Called by an idle handler: asks busy localities to hand a fom over.
+ */
+static void fom_steal_want(struct m0_fom_locality *loc)
+{
+	if (m0_atomic64_get(&loc->fl_hungry) == 0 &&
+	    m0_atomic64_cas(&loc->fl_hungry.a_value, 0, 1))
+		m0_atomic64_inc(&loc->fl_dom->fd_hungry);
+}
+
+/**
+ * Finds a hungry locality and claims it, preferring localities on the NUMA
+ * node of "loc".
+ */
+static struct m0_fom_locality *fom_steal_thief(struct m0_fom_locality *loc)
+{
+	struct m0_fom_domain    *dom  = loc->fl_dom;
+	struct m0_fom_numa_node *node = &dom->fd_nodes[loc->fl_numa_node];
+	struct m0_fom_locality  *thief;
+	size_t                   i;
+
+	for (i = 0; i < node->fnn_locs_nr; ++i) {
+		thief = dom->fd_localities[node->fnn_locs[(loc->fl_idx + i) %
+							  node->fnn_locs_nr]];
+		if (thief != loc && fom_steal_hungry_clear(thief))
+			return thief;
+	}
+	for (i = 0; i < dom->fd_localities_nr; ++i) {
+		thief = dom->fd_localities[i];
+		if (thief->fl_numa_node != loc->fl_numa_node &&
+		    fom_steal_hungry_clear(thief))
+			return thief;
+	}
+	return NULL;
+}
+
+static bool fom_is_migratable(struct m0_fom *fom)
+{
+	return fom->fo_type->ft_migratable &&
+		fom->fo_pending == NULL &&
+		fom->fo_tx.tx_state == M0_DTX_INVALID &&
+		!m0_chan_has_waiters(&fom->fo_sm_phase.sm_chan) &&
+		!m0_chan_has_waiters(&fom->fo_sm_state.sm_chan);
+}
+
+/**
+ * Re-attaches a state machine of a migrating fom to the group of its new
+ * locality.
+ */
+static void fom_sm_move(struct m0_sm *sm, struct m0_sm_group *grp)
+{
+	m0_chan_fini(&sm->sm_chan);
+	sm->sm_grp = grp;
+	m0_chan_init(&sm->sm_chan, &grp->s_lock);
+}
+
+/**
+ * AST call-back delivering a stolen fom to its new locality.
+ */
+static void stolen(struct m0_sm_group *grp, struct m0_sm_ast *ast)
+{
+	struct m0_fom *fom = container_of(ast, struct m0_fom, fo_cb.fc_ast);
+
+	M0_PRE(&fom->fo_loc->fl_group == grp);
+	M0_PRE(fom_state(fom) == M0_FOS_READY);
+
+	fom_addb2_stats_set(fom);
+	m0_fom_locality_inc(fom);
+	m0_atomic64_dec(&fom->fo_loc->fl_dom->fd_migrating);
+	fom_runq_add(fom);
+}
+
+/**
+ * Hands a migratable fom from the runq of a busy locality over to a hungry
+ * locality. See the "Work stealing" section.
+ */
+static void fom_steal_offer(struct m0_fom_locality *loc)
+{
+	struct m0_fom_domain   *dom = loc->fl_dom;
+	struct m0_fom_locality *thief;
+	struct m0_fom          *fom;
+	int                     scanned = 0;
+
+	if (m0_atomic64_get(&dom->fd_migratable) == 0 ||
+	    loc->fl_runq_nr < FOM_STEAL_RUNQ_MIN ||
+	    m0_atomic64_get(&dom->fd_hungry) == 0)
+		return;
+	/* The head of the runq is about to be executed here anyway. */
+	for (fom = runq_tlist_tail(&loc->fl_runq);
+	     fom != NULL && !fom_is_migratable(fom);
+	     fom = runq_tlist_prev(&loc->fl_runq, fom)) {
+		if (++scanned == FOM_STEAL_SCAN_MAX)
+			return;
+	}
+	if (fom == NULL)
+		return;
+	thief = fom_steal_thief(loc);
+	if (thief == NULL)
+		return;
+	m0_addb2_hist_mod(&loc->fl_steal_counter, loc->fl_runq_nr);
+	runq_tlist_del(fom);
+	M0_CNT_DEC(loc->fl_runq_nr);
+	m0_addb2_hist_mod(&loc->fl_runq_counter, loc->fl_runq_nr);
+	/*
+	 * Account the fom as migrating before it leaves the locality counters,
+	 * see m0_fom_domain_is_idle_for().
+	 */
+	m0_atomic64_inc(&dom->fd_steals);
+	m0_atomic64_inc(&dom->fd_migrating);
+	(void)m0_fom_locality_dec(fom);
+	fom_sm_move(&fom->fo_sm_phase, &thief->fl_group);
+	fom_sm_move(&fom->fo_sm_state, &thief->fl_group);
+	fom->fo_loc     = thief;
+	fom->fo_loc_idx = thief->fl_idx;
+	fom->fo_cb.fc_ast.sa_cb = &stolen;
+	m0_sm_ast_post(&thief->fl_group, &fom->fo_cb.fc_ast);
+}
+
 /**
  * Locality handler thread. See the "Locality internals" section.
  */
@@ -925,20 +1195,24 @@ static void loc_handler_thread(struct m0_loc_thread *th)
 			M0_ADDB2_IN(M0_AVI_AST, m0_sm_asts_run(&loc->fl_group));
 			M0_ADDB2_IN(M0_AVI_CHORE,
 				    m0_locality_chores_run(&loc->fl_locality));
+			fom_steal_offer(loc);
 			fom = fom_dequeue(loc);
 			if (fom != NULL) {
+				(void)fom_steal_hungry_clear(loc);
 				fom_addb2_push(fom);
 				fom_exec(fom);
 				m0_addb2_pop(M0_AVI_FOM);
 			} else if (loc->fl_shutdown)
 				break;
-			else
+			else {
+				fom_steal_want(loc);
 				/*
 				 * Yes, sleep with the lock held. Knock on
 				 * &loc->fl_runrun or &loc->fl_group.s_clink to
 				 * wake.
 				 */
 				m0_chan_wait(clink);
+			}
 		}
 		loc->fl_handler = NULL;
 		th->lt_state = IDLE;
@@ -1065,8 +1339,9 @@ static void loc_fini(struct m0_fom_locality *loc)
 static int loc_init(struct m0_fom_locality *loc, struct m0_fom_domain *dom,
 		    size_t idx)
 {
-	int                   res;
-	struct m0_addb2_mach *orig = m0_thread_tls()->tls_addb2_mach;
+	int                       res;
+	struct m0_addb2_mach     *orig = m0_thread_tls()->tls_addb2_mach;
+	struct m0_processor_descr pd;
 
 	M0_PRE(loc != NULL);
 
@@ -1084,6 +1359,11 @@ static int loc_init(struct m0_fom_locality *loc, struct m0_fom_domain *dom,
 	wail_tlist_init(&loc->fl_wail);
 	loc->fl_wail_nr = 0;
 	loc->fl_idx = idx;
+	m0_atomic64_set(&loc->fl_hungry, 0);
+	res = m0_processor_describe(idx, &pd);
+	loc->fl_numa_node = res == 0 &&
+		pd.pd_numa_node != M0_PROCESSORS_INVALID_ID ?
+		pd.pd_numa_node : 0;
 	m0_thread_tls()->tls_addb2_mach = loc->fl_addb2_mach;
 	m0_addb2_push(M0_AVI_NODE, M0_ADDB2_OBJ(&m0_node_uuid));
 	M0_ADDB2_PUSH(M0_AVI_PID, m0_pid());
@@ -1092,6 +1372,8 @@ static int loc_init(struct m0_fom_locality *loc, struct m0_fom_domain *dom,
 	m0_addb2_hist_add(&loc->fl_fom_active,   1, 30, M0_AVI_FOM_ACTIVE, -1);
 	m0_addb2_hist_add(&loc->fl_runq_counter, 1, 30, M0_AVI_RUNQ, -1);
 	m0_addb2_hist_add(&loc->fl_wail_counter, 1, 30, M0_AVI_WAIL, -1);
+	m0_addb2_hist_add(&loc->fl_steal_counter, 1, 30, M0_AVI_LOCALITY_STEAL,
+			  -1);
 	m0_addb2_hist_add_auto(&loc->fl_grp_addb2.ga_forq_hist, 1000,
 			       M0_AVI_LOCALITY_FORQ, -1);
 	m0_addb2_hist_add_auto(&loc->fl_chan_addb2.ca_wait_hist, 1000,
@@ -1197,6 +1479,10 @@ M0_INTERNAL int m0_fom_domain_init(struct m0_fom_domain **out)
 		return M0_ERR(-ENOMEM);
 	}
 	dom->fd_ops = &m0_fom_dom_ops;
+	m0_atomic64_set(&dom->fd_hungry, 0);
+	m0_atomic64_set(&dom->fd_migratable, 0);
+	m0_atomic64_set(&dom->fd_steals, 0);
+	m0_atomic64_set(&dom->fd_migrating, 0);
 
 	result = m0_addb2_sys_init(&dom->fd_addb2_sys,
 				   &(struct m0_addb2_config) {
@@ -1224,6 +1510,8 @@ M0_INTERNAL int m0_fom_domain_init(struct m0_fom_domain **out)
 				if (result != 0)
 					break;
 			}
+			if (result == 0)
+				result = fom_domain_nodes_init(dom);
 			if (result == 0) {
 				m0_locality_dom_set(dom);
 				/* Wake up handler threads. */
@@ -1257,7 +1545,10 @@ M0_INTERNAL void m0_fom_domain_fini(struct m0_fom_domain *dom)
 {
 	int i;
 
+	M0_PRE(m0_atomic64_get(&dom->fd_migrating) == 0);
+
 	m0_locality_chore_fini(&dom->fd_hung_foms_chore);
+	fom_domain_nodes_fini(dom);
 	if (dom->fd_localities != NULL) {
 		for (i = dom->fd_localities_nr - 1; i >= 0; --i) {
 			if (dom->fd_localities[i] != NULL)
@@ -1278,18 +1569,38 @@ static bool is_loc_locker_empty(struct m0_fom_locality *loc, uint32_t key)
 	return m0_locality_lockers_is_empty(&loc->fl_locality, key);
 }
 
+/**
+ * A stolen fom leaves the counters of its old locality before it enters the
+ * counters of the new one. The scan of locality counters is valid only if no
+ * fom was in flight when it started and no fom was stolen while it ran.
+ */
+static bool fom_domain_no_steals(const struct m0_fom_domain *dom,
+				 int64_t steals)
+{
+	return m0_atomic64_get(&dom->fd_migrating) == 0 &&
+		m0_atomic64_get(&dom->fd_steals) == steals;
+}
+
 M0_INTERNAL bool m0_fom_domain_is_idle_for(const struct m0_reqh_service *svc)
 {
-	struct m0_fom_domain *dom = m0_fom_dom();
-	return m0_forall(i, dom->fd_localities_nr,
-			 is_loc_locker_empty(dom->fd_localities[i],
-					     svc->rs_fom_key));
+	struct m0_fom_domain *dom    = m0_fom_dom();
+	int64_t               steals = m0_atomic64_get(&dom->fd_steals);
+
+	return fom_domain_no_steals(dom, steals) &&
+		m0_forall(i, dom->fd_localities_nr,
+			  is_loc_locker_empty(dom->fd_localities[i],
+					      svc->rs_fom_key)) &&
+		fom_domain_no_steals(dom, steals);
 }
 
 M0_INTERNAL bool m0_fom_domain_is_idle(const struct m0_fom_domain *dom)
 {
-	return m0_forall(i, dom->fd_localities_nr,
-			 dom->fd_localities[i]->fl_foms == 0);
+	int64_t steals = m0_atomic64_get(&dom->fd_steals);
+
+	return fom_domain_no_steals(dom, steals) &&
+		m0_forall(i, dom->fd_localities_nr,
+			  dom->fd_localities[i]->fl_foms == 0) &&
+		fom_domain_no_steals(dom, steals);
 }
 
 M0_INTERNAL void m0_fom_locality_inc(struct m0_fom *fom)
@@ -1304,6 +1615,8 @@ M0_INTERNAL void m0_fom_locality_inc(struct m0_fom *fom)
 	M0_CNT_INC(loc->fl_foms);
 	m0_addb2_hist_mod(&loc->fl_fom_active, loc->fl_foms);
 	m0_locality_lockers_set(&loc->fl_locality, key, (void *)cnt);
+	if (fom->fo_type->ft_migratable)
+		m0_atomic64_inc(&loc->fl_dom->fd_migratable);
 }
 
 M0_INTERNAL bool m0_fom_locality_dec(struct m0_fom *fom)
@@ -1318,6 +1631,8 @@ M0_INTERNAL bool m0_fom_locality_dec(struct m0_fom *fom)
 	M0_CNT_DEC(loc->fl_foms);
 	m0_locality_lockers_set(&loc->fl_locality, key, (void *)cnt);
 	m0_addb2_hist_mod(&loc->fl_fom_active, loc->fl_foms);
+	if (fom->fo_type->ft_migratable)
+		m0_atomic64_dec(&loc->fl_dom->fd_migratable);
 	return cnt == 0;
 }
 
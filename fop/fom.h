@@ -302,7 +302,24 @@ struct m0_fom_locality {
 	struct m0_locality             fl_locality;
 	struct m0_sm_group_addb2       fl_grp_addb2;
 	struct m0_chan_addb2           fl_chan_addb2;
-	/** Something for memory, see set_mempolicy(2). */
+	/**
+	 * NUMA node of the processor of this locality.
+	 *
+	 * Locality threads are confined to fl_processors, so with the default
+	 * memory policy (see set_mempolicy(2)) memory they allocate comes from
+	 * this node.
+	 */
+	uint32_t                       fl_numa_node;
+	/**
+	 * Set to 1 by an idle handler that wants to steal a fom from a busy
+	 * locality, cleared by the locality that hands a fom over or by the
+	 * handler itself when it finds work. Updated with m0_atomic64_cas().
+	 *
+	 * @see fom_steal_offer()
+	 */
+	struct m0_atomic64             fl_hungry;
+	/** Run-queue length of this locality when a fom is stolen from it. */
+	struct m0_addb2_hist           fl_steal_counter;
 };
 
 /**
@@ -318,6 +335,16 @@ M0_INTERNAL bool m0_locality_invariant(const struct m0_fom_locality *loc);
  */
 M0_INTERNAL void m0_fom_locality_post_stats(struct m0_fom_locality *loc);
 
+/**
+ * Localities of a fom domain that run on the same NUMA node.
+ */
+struct m0_fom_numa_node {
+	/** Indices of the localities in m0_fom_domain::fd_localities. */
+	size_t *fnn_locs;
+	/** Number of elements in fnn_locs. */
+	size_t  fnn_locs_nr;
+};
+
 /**
  * Domain is a collection of localities that compete for the resources.
  *
@@ -336,6 +363,32 @@ struct m0_fom_domain {
 	/** Long living foms detecting chore. */
 	struct m0_locality_chore        fd_hung_foms_chore;
 	struct m0_addb2_sys            *fd_addb2_sys;
+	/**
+	 * Localities grouped by NUMA node, indexed by node id. Nodes without
+	 * localities have m0_fom_numa_node::fnn_locs_nr == 0.
+	 */
+	struct m0_fom_numa_node        *fd_nodes;
+	/** Number of elements in fd_nodes, the largest node id plus one. */
+	uint32_t                        fd_nodes_nr;
+	/**
+	 * NUMA node of each processor, indexed by processor id, or
+	 * M0_PROCESSORS_INVALID_ID. Used by m0_fom_queue() to find the node
+	 * of the current thread without a m0_processor_describe() call.
+	 */
+	uint32_t                       *fd_proc_node;
+	/** Number of elements in fd_proc_node, m0_processor_nr_max(). */
+	uint32_t                        fd_proc_nr;
+	/** Number of localities with m0_fom_locality::fl_hungry set. */
+	struct m0_atomic64              fd_hungry;
+	/**
+	 * Number of foms of m0_fom_type::ft_migratable types counted in the
+	 * localities of the domain. Work stealing is skipped while it is 0.
+	 */
+	struct m0_atomic64              fd_migratable;
+	/** Number of foms ever stolen between localities of the domain. */
+	struct m0_atomic64              fd_steals;
+	/** Number of stolen foms that did not reach their new locality yet. */
+	struct m0_atomic64              fd_migrating;
 };
 
 /** Operations vector attached to a domain. */
@@ -406,6 +459,17 @@ M0_INTERNAL void m0_fom_domain_fini(struct m0_fom_domain *dom);
 M0_INTERNAL bool m0_fom_domain_is_idle(const struct m0_fom_domain *dom);
 M0_INTERNAL bool m0_fom_domain_is_idle_for(const struct m0_reqh_service *svc);
 
+/**
+ * Maps a fom home locality value (m0_fom_ops::fo_home_locality()) to the
+ * index of a locality on the given NUMA node.
+ *
+ * If the node is M0_PROCESSORS_INVALID_ID or has no localities, the value is
+ * mapped over all localities of the domain, as m0_fom_queue() does for foms
+ * of types without m0_fom_type::ft_numa_steered.
+ */
+M0_INTERNAL size_t m0_fom_domain_node_locality(const struct m0_fom_domain *dom,
+					       uint32_t node, size_t home);
+
 /**
  * This function iterates over m0_fom_domain members and checks
  * if they are intialised.
@@ -615,6 +679,30 @@ struct m0_fom_type {
 	      struct m0_sm_conf            ft_conf;
 	      struct m0_sm_conf            ft_state_conf;
 	const struct m0_reqh_service_type *ft_rstype;
+	/**
+	 * True iff foms of this type can be stolen by an idle locality from
+	 * the run-queue of a busy one. Off by default, set it after
+	 * m0_fom_type_init().
+	 *
+	 * A fom is only moved when it is in the run-queue, has no pending
+	 * call-backs, no open transaction and nobody waits on its state
+	 * machine channels. Beyond that, the fom type guarantees that its
+	 * foms do not keep locality bound state between phase transitions:
+	 * m0_locality_data(), ASTs, timeouts or call-backs other than
+	 * m0_fom::fo_cb that refer to m0_fom::fo_loc.
+	 */
+	bool                               ft_migratable;
+	/**
+	 * True iff foms of this type, created for requests received by an rpc
+	 * machine with m0_rpc_machine::rm_numa_steer, are queued to a locality
+	 * on the NUMA node of the rpc thread which created them. Off by
+	 * default, set it after m0_fom_type_init().
+	 *
+	 * The same m0_fom_ops::fo_home_locality() value then gives the same
+	 * locality only for foms received on the same node, so the fom type
+	 * must not use the home locality to serialise its foms.
+	 */
+	bool                               ft_numa_steered;
 };
 
 /**
@@ -387,13 +387,11 @@ M0_INTERNAL int m0_fop_encdec(struct m0_fop           *fop,
 
 M0_INTERNAL struct m0_fop_type *m0_fop_type_find(uint32_t opcode)
 {
-	struct m0_fop_type *ftype = NULL;
+	struct m0_rpc_item_type *item_type;
 
-	while ((ftype = m0_fop_type_next(ftype)) != NULL) {
-		if(ftype->ft_rpc_item_type.rit_opcode == opcode)
-			break;
-	}
-	return ftype;
+	/* Every rpc item type is a part of fop type, see m0_fop_type_init(). */
+	item_type = m0_rpc_item_type_lookup(opcode);
+	return item_type == NULL ? NULL : m0_item_type_to_fop_type(item_type);
 }
 
 static int fop_xc_type(uint32_t opcode, const struct m0_xcode_type **out)
@@ -0,0 +1,250 @@
+/* -*- C -*- */
+/*
+ * Copyright (c) 2021 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+
+#include "lib/memory.h"
+#include "lib/semaphore.h"
+#include "lib/atomic.h"
+#include "lib/time.h"
+#include "rpc/rpc_opcodes.h"
+#include "fop/fom.h"
+#include "reqh/reqh.h"
+#include "reqh/reqh_service.h"
+#include "ut/ut.h"
+
+enum {
+	/** Number of foms queued to the same locality. */
+	ST_FOM_NR  = 64,
+	/** Time a fom keeps its handler busy. */
+	ST_SPIN_NS = 500000
+};
+
+struct st_fom {
+	struct m0_fom st_fom;
+};
+
+static struct m0_sm_state_descr st_fom_phases[] = {
+	[M0_FOM_PHASE_INIT] = {
+		.sd_flags   = M0_SDF_INITIAL,
+		.sd_name    = "init",
+		.sd_allowed = M0_BITS(M0_FOM_PHASE_FINISH)
+	},
+	[M0_FOM_PHASE_FINISH] = {
+		.sd_name    = "finish",
+		.sd_flags   = M0_SDF_TERMINAL,
+	}
+};
+
+static struct m0_sm_conf st_sm_conf = {
+	.scf_name      = "st_fom",
+	.scf_nr_states = ARRAY_SIZE(st_fom_phases),
+	.scf_state     = st_fom_phases,
+};
+
+static struct m0_fom_type      st_fomt;
+static struct m0_reqh          streqh;
+static struct m0_reqh_service *stsvc;
+static struct m0_semaphore     st_done;
+/** Number of foms executed outside of their home locality. */
+static struct m0_atomic64      st_elsewhere;
+
+static void   st_fom_fini(struct m0_fom *fom);
+static int    st_fom_tick(struct m0_fom *fom);
+static size_t st_fom_home_locality(const struct m0_fom *fom);
+
+static const struct m0_fom_ops st_fom_ops = {
+	.fo_fini          = st_fom_fini,
+	.fo_tick          = st_fom_tick,
+	.fo_home_locality = st_fom_home_locality
+};
+
+static const struct m0_fom_type_ops st_fom_type_ops = {
+	.fto_create = NULL
+};
+
+static int stsvc_start(struct m0_reqh_service *svc)
+{
+	return 0;
+}
+
+static void stsvc_stop(struct m0_reqh_service *svc)
+{
+}
+
+static void stsvc_fini(struct m0_reqh_service *svc)
+{
+	m0_free(svc);
+}
+
+static const struct m0_reqh_service_ops stsvc_ops = {
+	.rso_start_async = &m0_reqh_service_async_start_simple,
+	.rso_start       = &stsvc_start,
+	.rso_stop        = &stsvc_stop,
+	.rso_fini        = &stsvc_fini
+};
+
+static int stsvc_type_allocate(struct m0_reqh_service            **svc,
+			       const struct m0_reqh_service_type  *stype)
+{
+	M0_ALLOC_PTR(*svc);
+	M0_UT_ASSERT(*svc != NULL);
+	(*svc)->rs_type = stype;
+	(*svc)->rs_ops = &stsvc_ops;
+	return 0;
+}
+
+static const struct m0_reqh_service_type_ops stsvc_type_ops = {
+	.rsto_service_allocate = &stsvc_type_allocate
+};
+
+static struct m0_reqh_service_type ut_st_service_type = {
+	.rst_name     = "st_ut",
+	.rst_ops      = &stsvc_type_ops,
+	.rst_level    = M0_RS_LEVEL_NORMAL,
+	.rst_typecode = M0_CST_DS1
+};
+
+static size_t st_fom_home_locality(const struct m0_fom *fom)
+{
+	return 0;
+}
+
+static int st_fom_tick(struct m0_fom *fom)
+{
+	m0_time_t end = m0_time_from_now(0, ST_SPIN_NS);
+
+	/* Keep the handler busy, so that the home runq grows. */
+	while (!m0_time_is_in_past(end))
+		;
+	if (fom->fo_loc_idx != st_fom_home_locality(fom))
+		m0_atomic64_inc(&st_elsewhere);
+	m0_fom_phase_set(fom, M0_FOM_PHASE_FINISH);
+	return M0_FSO_WAIT;
+}
+
+static void st_fom_fini(struct m0_fom *fom)
+{
+	struct st_fom *st = M0_AMB(st, fom, st_fom);
+
+	m0_fom_fini(fom);
+	m0_free(st);
+	m0_semaphore_up(&st_done);
+}
+
+static void st_run(bool migratable)
+{
+	struct st_fom *st;
+	int            rc;
+	int            i;
+
+	st_fomt.ft_migratable = migratable;
+	m0_atomic64_set(&st_elsewhere, 0);
+	rc = M0_REQH_INIT(&streqh,
+			  .rhia_dtm     = (void *)1,
+			  .rhia_mdstore = (void *)1,
+			  .rhia_fid     = &g_process_fid);
+	M0_UT_ASSERT(rc == 0);
+	rc = m0_reqh_service_allocate(&stsvc, &ut_st_service_type, NULL);
+	M0_UT_ASSERT(rc == 0);
+	m0_reqh_service_init(stsvc, &streqh, NULL);
+	m0_reqh_service_start(stsvc);
+	m0_reqh_start(&streqh);
+
+	for (i = 0; i < ST_FOM_NR; ++i) {
+		M0_ALLOC_PTR(st);
+		M0_UT_ASSERT(st != NULL);
+		m0_fom_init(&st->st_fom, &st_fomt, &st_fom_ops, NULL, NULL,
+			    &streqh);
+		m0_fom_queue(&st->st_fom);
+	}
+	for (i = 0; i < ST_FOM_NR; ++i)
+		m0_semaphore_down(&st_done);
+
+	m0_reqh_service_prepare_to_stop(stsvc);
+	m0_reqh_idle_wait_for(&streqh, stsvc);
+	m0_reqh_service_stop(stsvc);
+	m0_reqh_service_fini(stsvc);
+	m0_reqh_services_terminate(&streqh);
+	m0_reqh_fini(&streqh);
+}
+
+static void steal_off(void)
+{
+	struct m0_fom_domain *dom    = m0_fom_dom();
+	int64_t               steals = m0_atomic64_get(&dom->fd_steals);
+
+	st_run(false);
+	M0_UT_ASSERT(m0_atomic64_get(&st_elsewhere) == 0);
+	/* No migratable foms: stealing is not even attempted. */
+	M0_UT_ASSERT(m0_atomic64_get(&dom->fd_steals) == steals);
+}
+
+static void steal_on(void)
+{
+	struct m0_fom_domain *dom    = m0_fom_dom();
+	int64_t               steals = m0_atomic64_get(&dom->fd_steals);
+
+	st_run(true);
+	M0_UT_ASSERT(m0_atomic64_get(&dom->fd_migrating) == 0);
+	M0_UT_ASSERT(m0_atomic64_get(&dom->fd_migratable) == 0);
+	if (dom->fd_localities_nr > 1) {
+		M0_UT_ASSERT(m0_atomic64_get(&dom->fd_steals) > steals);
+		M0_UT_ASSERT(m0_atomic64_get(&st_elsewhere) > 0);
+	}
+}
+
+static int st_init(void)
+{
+	m0_fom_type_init(&st_fomt, M0_UT_STEAL_FOM_OPCODE,
+			 &st_fom_type_ops, &ut_st_service_type, &st_sm_conf);
+	return m0_semaphore_init(&st_done, 0);
+}
+
+static int st_fini(void)
+{
+	m0_semaphore_fini(&st_done);
+	return 0;
+}
+
+struct m0_ut_suite fom_steal_ut = {
+	.ts_name = "fom-steal-ut",
+	.ts_init = st_init,
+	.ts_fini = st_fini,
+	.ts_tests = {
+		{ "steal-off", steal_off },
+		{ "steal-on",  steal_on  },
+		{ NULL, NULL }
+	}
+};
+M0_EXPORTED(fom_steal_ut);
+
+/*
+ *  Local variables:
+ *  c-indentation-style: "K&R"
+ *  c-basic-offset: 8
+ *  tab-width: 8
+ *  fill-column: 80
+ *  scroll-step: 1
+ *  End:
+ */
+/*
+ * vim: tabstop=8 shiftwidth=8 noexpandtab textwidth=80 nowrap
+ */
@@ -50,6 +50,8 @@ M0_INTERNAL int m0_iscservice_fop_init(void)
 			 .fom_ops   = &m0_fom_isc_type_ops,
 			 .svc_type  = &m0_iscs_type,
 			 .sm        = &isc_sm_conf);
+	/* ISC foms are spread over localities round-robin. */
+	m0_fop_isc_fopt.ft_fom_type.ft_numa_steered = true;
 
 	M0_FOP_TYPE_INIT(&m0_fop_isc_rep_fopt,
 			 .name      = "isc-fop-reply",
@@ -171,6 +171,13 @@ M0_INTERNAL struct m0_locality *m0_locality0_get(void)
 	return &loc_glob()->lg_fallback;
 }
 
+M0_INTERNAL uint32_t m0_localities_nr(void)
+{
+	struct locality_global *glob = loc_glob();
+
+	return glob == NULL || glob->lg_dom == NULL ? 1 : loc_nr();
+}
+
 M0_INTERNAL void m0_locality_dom_set(struct m0_fom_domain *dom)
 {
 	struct locality_global *glob = loc_glob();
@@ -94,6 +94,12 @@ M0_INTERNAL struct m0_locality *m0_locality_get(uint64_t value);
 
 M0_INTERNAL struct m0_locality *m0_locality0_get(void);
 
+/**
+ * Returns the number of localities, m0_locality_here()->lo_idx is less than
+ * it. Returns 1 if the localities are not initialised.
+ */
+M0_INTERNAL uint32_t m0_localities_nr(void);
+
 /**
  * Starts using localities from the specified domain.
  */
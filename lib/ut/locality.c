@@ -26,6 +26,7 @@
 #include "lib/assert.h"
 #include "lib/locality.h"
 #include "lib/finject.h"
+#include "lib/processor.h"      /* M0_PROCESSORS_INVALID_ID */
 #include "fop/fom.h"
 #include "fop/fom_simple.h"
 #include "reqh/reqh.h"
@@ -417,6 +418,46 @@ void test_locality_chore(void)
 }
 M0_EXPORTED(test_locality_chore);
 
+void test_locality_numa(void)
+{
+	struct m0_fom_domain          *dom = m0_fom_dom();
+	const struct m0_fom_numa_node *node;
+	size_t                         total = 0;
+	size_t                         idx;
+	uint32_t                       i;
+	size_t                         j;
+
+	M0_UT_ASSERT(dom->fd_nodes_nr > 0);
+	for (i = 0; i < dom->fd_nodes_nr; ++i) {
+		node = &dom->fd_nodes[i];
+		total += node->fnn_locs_nr;
+		for (j = 0; j < node->fnn_locs_nr; ++j) {
+			idx = node->fnn_locs[j];
+			M0_UT_ASSERT(idx < dom->fd_localities_nr);
+			M0_UT_ASSERT(dom->fd_localities[idx]->fl_numa_node ==
+				     i);
+		}
+		for (j = 0; j < 2 * dom->fd_localities_nr; ++j) {
+			idx = m0_fom_domain_node_locality(dom, i, j);
+			M0_UT_ASSERT(idx < dom->fd_localities_nr);
+			M0_UT_ASSERT(node->fnn_locs_nr == 0 ||
+				     dom->fd_localities[idx]->fl_numa_node ==
+				     i);
+		}
+	}
+	M0_UT_ASSERT(total == dom->fd_localities_nr);
+	for (j = 0; j < dom->fd_localities_nr; ++j)
+		M0_UT_ASSERT(j >= dom->fd_proc_nr ||
+			     dom->fd_proc_node[j] == M0_PROCESSORS_INVALID_ID ||
+			     dom->fd_proc_node[j] ==
+			     dom->fd_localities[j]->fl_numa_node);
+	for (j = 0; j < 2 * dom->fd_localities_nr; ++j)
+		M0_UT_ASSERT(m0_fom_domain_node_locality(dom,
+						M0_PROCESSORS_INVALID_ID, j) ==
+			     j % dom->fd_localities_nr);
+}
+M0_EXPORTED(test_locality_numa);
+
 /*
  *  Local variables:
  *  c-indentation-style: "K&R"
@@ -53,6 +53,7 @@ extern void test_vec(void);
 extern void test_zerovec(void);
 extern void test_locality(void);
 extern void test_locality_chore(void);
+extern void test_locality_numa(void);
 extern void test_hashtable(void);
 extern void test_fold(void);
 extern void m0_ut_lib_thread_pool_test(void);
@@ -79,6 +80,7 @@ struct m0_ut_suite libm0_ut = {
 		{ "list",             test_list          },
 		{ "locality",         test_locality,     "Nikita" },
 		{ "locality-chore",   test_locality_chore, "Nikita" },
+		{ "locality-numa",    test_locality_numa },
 		{ "lockers",          test_lockers       },
 		{ "memory",           test_memory        },
 		{ "misc",             m0_test_misc       },
@@ -579,7 +579,12 @@ enum m0_op_obj_flags {
 	 * Write, alloc and free operations wait for the transaction to become
 	 * persistent before returning.
 	 */
-	M0_OOF_SYNC   = 1 << 1
+	M0_OOF_SYNC   = 1 << 1,
+	/**
+	 * Read operation bypasses the client read cache and refreshes it
+	 * with the data read. See m0_config::mc_read_cache_size.
+	 */
+	M0_OOF_NOCACHE = 1 << 2
 } M0_XCA_ENUM;
 
 /**
@@ -953,6 +958,33 @@ struct m0_config {
  	 * ADDB size
  	 */
 	m0_bcount_t mc_addb_size;
+
+	/**
+	 * Size in bytes of the client read cache, which keeps the data of
+	 * whole parity groups read from the servers. 0 disables the cache.
+	 */
+	m0_bcount_t mc_read_cache_size;
+	/**
+	 * Maximum number of parity groups the read cache reads ahead of a
+	 * sequential reader. 0 disables readahead.
+	 */
+	uint32_t    mc_readahead_max;
+};
+
+/** Statistics of the client read cache, see m0_client_read_cache_stats(). */
+struct m0_read_cache_stats {
+	/** Reads served from the cache. */
+	uint64_t rcs_hits;
+	/** Reads which had to go to the servers. */
+	uint64_t rcs_misses;
+	/** Parity groups requested by readahead. */
+	uint64_t rcs_ra_groups;
+	/** Parity groups brought in by readahead and then read. */
+	uint64_t rcs_ra_hits;
+	/** Parity groups dropped to keep the cache within its size. */
+	uint64_t rcs_evictions;
+	/** Parity groups dropped because they were or could be stale. */
+	uint64_t rcs_invalidations;
 };
 
 /** The identifier of the root of realm hierarchy. */
@@ -1439,7 +1471,8 @@ void m0_obj_idx_init(struct m0_idx       *idx,
  *                       (m0_vec_count(&ext->iv_vec) >> obj->ob_attr.oa_bshift)
  * @pre ergo(M0_IN(opcode, (M0_OC_ALLOC, M0_OC_FREE)),
  *           data == NULL && attr == NULL && mask == 0)
- * @pre ergo(opcode == M0_OC_READ, M0_IN(flags, (0, M0_OOF_NOHOLE)))
+ * @pre ergo(opcode == M0_OC_READ,
+ *           (flags & ~(M0_OOF_NOHOLE | M0_OOF_NOCACHE)) == 0)
  * @pre ergo(opcode != M0_OC_READ, M0_IN(flags, (0, M0_OOF_SYNC)))
  *
  * @post ergo(*op != NULL, *op->op_code == opcode &&
@@ -1660,6 +1693,15 @@ void m0_client_fini(struct m0_client *m0c, bool fini_m0);
 void m0_process_fid(const struct m0_client *m0c,
 		    struct m0_fid *proc_fid);
 
+/**
+ * Returns statistics of the client read cache.
+ *
+ * @param m0c The client instance being queried.
+ * @param stats Where the statistics are stored.
+ */
+void m0_client_read_cache_stats(struct m0_client           *m0c,
+				struct m0_read_cache_stats *stats);
+
 /**
  * Allocates and initialises an SYNC operation.
  *
@@ -1439,6 +1439,7 @@ M0_INTERNAL void m0_client_global_fini(void)
 	m0_sm_conf_fini(&m0_op_conf);
 	m0_sm_conf_fini(&entity_conf);
 	m0_semaphore_fini(&cpus_sem);
+	m0__page_cache_fini();
 
 	M0_LEAVE();
 }
@@ -1484,6 +1485,7 @@ M0_INTERNAL int m0_client_global_init(void)
 	cpus = get_online_cpus();
 	M0_LOG(M0_INFO, "motr: max CPUs for parity calcs: %d\n", cpus);
 	m0_semaphore_init(&cpus_sem, cpus);
+	m0__page_cache_init();
 
 	m0_idx_services_register();
 
@@ -1539,6 +1541,12 @@ int m0_client_init(struct m0_client **m0c_p,
 	/* Set configuration parameters */
 	m0c->m0c_config = conf;
 
+	rc = m0__rcache_init(m0c);
+	if (rc != 0) {
+		m0_free(m0c);
+		return M0_ERR(rc);
+	}
+
 	/* Parse some parameters in m0_config for future uses. */
 	rc = client_fid_sscanf(conf->mc_process_fid, &m0c->m0c_process_fid,
 	                       "process fid");
@@ -1673,6 +1681,7 @@ int m0_client_init(struct m0_client **m0c_p,
 	return M0_RC(rc);
 
 err_exit:
+	m0__rcache_fini(m0c);
 	m0_free(m0c);
 #ifndef __KERNEL__
 	if (init_m0)
@@ -1692,6 +1701,11 @@ void m0_client_fini(struct m0_client *m0c, bool fini_m0)
 	M0_PRE(m0c != NULL);
 	M0_PRE(ergo(ENABLE_DTM0, m0c->m0c_dtms != NULL));
 
+	/* Readahead ops in flight need the client up and running. */
+	m0__rcache_fini(m0c);
+	/* Don't pin io pages of a client which is gone. */
+	m0__page_cache_drain();
+
 	if (m0c->m0c_dtms != NULL)
 		m0_dtm_client_service_stop(&m0c->m0c_dtms->dos_generic);
 
@@ -62,6 +62,7 @@
 #include "motr/idx.h"  /* m0_idx_* */
 #include "motr/pg.h"          /* nwxfer and friends */
 #include "motr/sync.h"        /* sync_request */
+#include "motr/read_cache.h"  /* m0_read_cache */
 #include "fop/fop.h"
 
 struct m0_idx_service_ctx;
@@ -373,6 +374,14 @@ struct m0_op_io {
 	 * Relying on this to remove duplicate mapping for the same nxfer_req
 	 */
 	int                              ioo_addb2_mapped;
+
+	/**
+	 * Generation of the read cache when this read was launched. The read
+	 * does not populate the cache if it changed in between.
+	 */
+	uint64_t                         ioo_rcache_gen;
+	/** Whether this read was issued by the read cache as readahead. */
+	bool                             ioo_readahead;
 };
 
 struct m0_io_args {
@@ -597,6 +606,9 @@ struct m0_client {
 	struct m0_htable                        m0c_rm_ctxs;
 
 	struct m0_dtm0_service                 *m0c_dtms;
+
+	/** Read cache of parity group data, see motr/read_cache.h. */
+	struct m0_read_cache                    m0c_rcache;
 };
 
 /** CPUs semaphore - to control CPUs usage by parity calcs. */
@@ -647,6 +659,12 @@ struct m0_rm_lock_req {
 	struct m0_mutex       rlr_mutex;
 	int32_t               rlr_rc;
 	struct m0_chan        rlr_chan;
+	/**
+	 * Client and id of the locked object, its cached data are dropped
+	 * when the lock is granted.
+	 */
+	struct m0_client     *rlr_m0c;
+	struct m0_uint128     rlr_obj_id;
 };
 
 /**
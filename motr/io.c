@@ -222,6 +222,38 @@ static void addb2_add_ioo_attrs(const struct m0_op_io *ioo, int rmw)
 	M0_ADDB2_ADD(M0_AVI_ATTR, ioid, M0_AVI_IOO_ATTR_RMW, rmw);
 }
 
+/**
+ * AST completing a read served from the read cache, see m0__rcache_read().
+ *
+ * @param grp The (locked) state machine group for this ast.
+ * @param ast The ast descriptor, embedded in an m0_op_io.
+ */
+static void obj_io_ast_cached(struct m0_sm_group *grp, struct m0_sm_ast *ast)
+{
+	struct m0_op_io *ioo;
+	struct m0_op    *op;
+
+	M0_ENTRY();
+
+	M0_PRE(m0_sm_group_is_locked(grp));
+	ioo = bob_of(ast, struct m0_op_io, ioo_ast, &ioo_bobtype);
+	M0_PRE_EX(m0_op_io_invariant(ioo));
+	op = &ioo->ioo_oo.oo_oc.oc_op;
+
+	ioreq_sm_state_set_locked(ioo, IRS_REQ_COMPLETE);
+
+	m0_sm_group_lock(&op->op_sm_group);
+	m0_sm_move(&op->op_sm, 0, M0_OS_LAUNCHED);
+	m0_sm_move(&op->op_sm, 0, M0_OS_EXECUTED);
+	m0_op_executed(op);
+	m0_sm_move(&op->op_sm, 0, M0_OS_STABLE);
+	m0_op_stable(op);
+	m0_sm_group_unlock(&op->op_sm_group);
+
+	m0__obj_op_done(op);
+	M0_LEAVE();
+}
+
 /**
  * Callback for an IO operation being launched.
  * Prepares io maps and distributes the operations in the network transfer.
@@ -250,6 +282,17 @@ static void obj_io_cb_launch(struct m0_op_common *oc)
 	ioo = bob_of(oo, struct m0_op_io, ioo_oo, &ioo_bobtype);
 	M0_PRE_EX(m0_op_io_invariant(ioo));
 
+	if (oc->oc_op.op_code == M0_OC_READ && m0__rcache_read(ioo)) {
+		ioo->ioo_ast.sa_cb = obj_io_ast_cached;
+		m0_sm_ast_post(ioo->ioo_oo.oo_sm_grp, &ioo->ioo_ast);
+		goto end;
+	}
+	if (oc->oc_op.op_code != M0_OC_READ)
+		m0__rcache_invalidate(m0__op_instance(&oc->oc_op),
+				      &oc->oc_op.op_entity->en_id,
+				      &ioo->ioo_ext,
+				      data_size(pdlayout_get(ioo)));
+
 	rc = ioo->ioo_ops->iro_iomaps_prepare(ioo);
 	if (rc != 0)
 		goto end;
@@ -692,7 +735,8 @@ int m0_obj_op(struct m0_obj       *obj,
 	M0_ENTRY();
 	M0_PRE(obj != NULL);
 	M0_PRE(op != NULL);
-	M0_PRE(ergo(opcode == M0_OC_READ, M0_IN(flags, (0, M0_OOF_NOHOLE))));
+	M0_PRE(ergo(opcode == M0_OC_READ,
+		    (flags & ~(M0_OOF_NOHOLE | M0_OOF_NOCACHE)) == 0));
 	M0_PRE(ergo(opcode != M0_OC_READ, M0_IN(flags, (0, M0_OOF_SYNC))));
 
 	if (M0_FI_ENABLED("fail_op"))
@@ -550,6 +550,15 @@ M0_INTERNAL void pargrp_iomap_fini(struct pargrp_iomap *map,
 
 M0_INTERNAL struct m0_obj_attr *
 m0_io_attr(struct m0_op_io *ioo);
+
+/**
+ * Initialises and finalises the per-processor cache of io pages, which
+ * data_buf allocations are served from.
+ */
+M0_INTERNAL void m0__page_cache_init(void);
+M0_INTERNAL void m0__page_cache_fini(void);
+/** Frees the pages held by the cache. */
+M0_INTERNAL void m0__page_cache_drain(void);
 #endif /* __MOTR_IO_H__ */
 
 /*
@@ -28,6 +28,10 @@
 #include "lib/buf.h"             /* M0_BUF_INIT_PTR */
 #include "lib/memory.h"          /* m0_alloc, m0_free */
 #include "lib/errno.h"           /* ENOMEM */
+#include "lib/arith.h"           /* m0_is_po2, m0_log2 */
+#include "lib/mutex.h"           /* m0_mutex */
+#include "lib/atomic.h"          /* m0_atomic64 */
+#include "lib/processor.h"       /* m0_processor_id_get */
 #include "fid/fid.h"             /* m0_fid */
 #include "rm/rm.h"               /* stuct m0_rm_owner */
 #include "sns/parity_repair.h"   /* m0_sns_repair_spare_map*/
@@ -73,6 +77,144 @@ const struct m0_bob_type dtbuf_bobtype = {
 	.bt_check        = NULL,
 };
 
+/**
+ * Page cache.
+ *
+ * Every io request allocates a page per touched block (and per parity and
+ * auxiliary block) and frees them again when it completes. To keep this off
+ * the allocator, freed pages are kept on small free lists, sharded by the
+ * processor the caller runs on, so that threads on different cores do not
+ * contend. Each shard caches pages of every size between
+ * M0_MIN_BUF_SHIFT and M0_MIN_BUF_SHIFT + PC_SHIFT_NR - 1. Pages of other
+ * sizes bypass the cache. All shards together hold at most PC_BYTES_MAX, the
+ * cache is drained when a client instance is finalised.
+ *
+ * Pages are zeroed when they are taken from the cache, as m0_alloc_aligned()
+ * does, so that no data of an earlier request leak through a page which is
+ * not fully overwritten.
+ *
+ * A cached page is linked through its first word.
+ */
+enum {
+	PC_SHARD_NR  = 16,
+	PC_SHIFT_NR  = 12,
+	PC_BYTES_MAX = 64 << 20
+};
+
+struct page_cache_shard {
+	struct m0_mutex pcs_lock;
+	void           *pcs_free[PC_SHIFT_NR];
+};
+
+static struct page_cache_shard page_cache[PC_SHARD_NR];
+/** Bytes held by all shards. */
+static struct m0_atomic64      page_cache_bytes;
+
+static int page_cache_class(uint64_t size)
+{
+	int shift;
+
+	if (!m0_is_po2(size))
+		return -1;
+	shift = (int)m0_log2(size) - M0_MIN_BUF_SHIFT;
+	return shift >= 0 && shift < PC_SHIFT_NR ? shift : -1;
+}
+
+static struct page_cache_shard *page_cache_here(void)
+{
+	return &page_cache[m0_processor_id_get() % PC_SHARD_NR];
+}
+
+/**
+ * Returns a network aligned page of the given size, either from the cache
+ * or from the allocator.
+ */
+static void *page_get(uint64_t size)
+{
+	struct page_cache_shard *pcs;
+	int                      cls = page_cache_class(size);
+	void                    *page = NULL;
+
+	if (cls >= 0) {
+		pcs = page_cache_here();
+		m0_mutex_lock(&pcs->pcs_lock);
+		page = pcs->pcs_free[cls];
+		if (page != NULL)
+			pcs->pcs_free[cls] = *(void **)page;
+		m0_mutex_unlock(&pcs->pcs_lock);
+	}
+	if (page == NULL)
+		return m0_alloc_aligned(size, M0_NETBUF_SHIFT);
+	m0_atomic64_sub(&page_cache_bytes, size);
+	memset(page, 0, size);
+	return page;
+}
+
+/** Returns a page obtained from page_get() to the cache. */
+static void page_put(void *page, uint64_t size)
+{
+	struct page_cache_shard *pcs;
+	int                      cls = page_cache_class(size);
+
+	if (page == NULL)
+		return;
+	if (cls >= 0 &&
+	    m0_atomic64_add_return(&page_cache_bytes, size) <= PC_BYTES_MAX) {
+		pcs = page_cache_here();
+		m0_mutex_lock(&pcs->pcs_lock);
+		*(void **)page = pcs->pcs_free[cls];
+		pcs->pcs_free[cls] = page;
+		m0_mutex_unlock(&pcs->pcs_lock);
+		return;
+	}
+	if (cls >= 0)
+		m0_atomic64_sub(&page_cache_bytes, size);
+	m0_free_aligned(page, size, M0_NETBUF_SHIFT);
+}
+
+M0_INTERNAL void m0__page_cache_init(void)
+{
+	int i;
+
+	M0_SET_ARR0(page_cache);
+	m0_atomic64_set(&page_cache_bytes, 0);
+	for (i = 0; i < PC_SHARD_NR; ++i)
+		m0_mutex_init(&page_cache[i].pcs_lock);
+}
+
+M0_INTERNAL void m0__page_cache_drain(void)
+{
+	struct page_cache_shard *pcs;
+	void                    *page;
+	uint64_t                 size;
+	int                      i;
+	int                      cls;
+
+	for (i = 0; i < PC_SHARD_NR; ++i) {
+		pcs = &page_cache[i];
+		m0_mutex_lock(&pcs->pcs_lock);
+		for (cls = 0; cls < PC_SHIFT_NR; ++cls) {
+			size = 1ULL << (cls + M0_MIN_BUF_SHIFT);
+			while ((page = pcs->pcs_free[cls]) != NULL) {
+				pcs->pcs_free[cls] = *(void **)page;
+				m0_atomic64_sub(&page_cache_bytes, size);
+				m0_free_aligned(page, size, M0_NETBUF_SHIFT);
+			}
+		}
+		m0_mutex_unlock(&pcs->pcs_lock);
+	}
+}
+
+M0_INTERNAL void m0__page_cache_fini(void)
+{
+	int i;
+
+	m0__page_cache_drain();
+	M0_ASSERT(m0_atomic64_get(&page_cache_bytes) == 0);
+	for (i = 0; i < PC_SHARD_NR; ++i)
+		m0_mutex_fini(&page_cache[i].pcs_lock);
+}
+
 /**
  * Finds the parity group associated with a given target offset.
  *
@@ -293,15 +435,10 @@ static void data_buf_dealloc_fini(struct data_buf *buf)
 
 	M0_PRE(data_buf_invariant(buf));
 
-	if ((buf->db_flags & PA_APP_MEMORY) == 0) {
-		m0_free_aligned(buf->db_buf.b_addr,
-				buf->db_buf.b_nob,
-				M0_NETBUF_SHIFT);
-
-		m0_free_aligned(buf->db_auxbuf.b_addr,
-				buf->db_auxbuf.b_nob,
-				M0_NETBUF_SHIFT);
-	}
+	if ((buf->db_flags & PA_APP_MEMORY) == 0)
+		page_put(buf->db_buf.b_addr, buf->db_buf.b_nob);
+	/* The auxiliary buffer is always owned by the client. */
+	page_put(buf->db_auxbuf.b_addr, buf->db_auxbuf.b_nob);
 
 	data_buf_fini(buf);
 	m0_free(buf);
@@ -331,7 +468,7 @@ static struct data_buf *data_buf_alloc_init(struct m0_obj *obj,
 	instance = m0__obj_instance(obj);
 	M0_PRE(instance != NULL);
 
-	addr = m0_alloc_aligned(obj_buffer_size(obj), M0_NETBUF_SHIFT);
+	addr = page_get(obj_buffer_size(obj));
 	if (addr == NULL) {
 		M0_LOG(M0_ERROR, "Failed to get free page");
 		return NULL;
@@ -339,8 +476,7 @@ static struct data_buf *data_buf_alloc_init(struct m0_obj *obj,
 
 	M0_ALLOC_PTR(buf);
 	if (buf == NULL) {
-		m0_free_aligned(addr, obj_buffer_size(obj),
-				M0_NETBUF_SHIFT);
+		page_put(addr, obj_buffer_size(obj));
 		M0_LOG(M0_ERROR, "Failed to allocate data_buf");
 		return NULL;
 	}
@@ -830,8 +966,17 @@ static int pargrp_iomap_seg_process(struct pargrp_iomap *map,
 			 */
 			if (buf_cursor && m0_bufvec_cursor_move(buf_cursor, 0))
 				buf_cursor = NULL;
+			/*
+			 * Application memory is handed to the network layer
+			 * as a whole page. Only do this for pages which are
+			 * fully covered by the request and by a single
+			 * application segment, partial pages get a private
+			 * copy, which can be read into or padded safely.
+			 */
 			rc = map->pi_ops->pi_databuf_alloc(map, row, col,
-							   buf_cursor);
+				buf_cursor != NULL && count == pagesize &&
+				m0_bufvec_cursor_step(buf_cursor) >= pagesize ?
+				buf_cursor : NULL);
 			if (rc == 0 && buf_cursor)
 				m0_bufvec_cursor_move(buf_cursor, count);
 		}
@@ -903,10 +1048,13 @@ static int pargrp_iomap_databuf_alloc(struct pargrp_iomap     *map,
 	flags = PA_NONE | PA_APP_MEMORY;
 	/* Fall back to allocate-copy route */
 	if (!addr_is_network_aligned(addr) || addr == NULL) {
-		addr = m0_alloc_aligned(obj_buffer_size(obj),
-				        M0_NETBUF_SHIFT);
+		addr = page_get(obj_buffer_size(obj));
 		flags = PA_NONE;
 	}
+	if (addr == NULL) {
+		m0_free(buf);
+		return M0_ERR(-ENOMEM);
+	}
 
 	data_buf_init(buf, addr, obj_buffer_size(obj), flags);
 	M0_POST_EX(data_buf_invariant(buf));
@@ -937,8 +1085,7 @@ static uint64_t pargrp_iomap_auxbuf_alloc(struct pargrp_iomap *map,
 	M0_PRE(map->pi_rtype == PIR_READOLD);
 
 	pagesize = m0__page_size(map->pi_ioo);
-	map->pi_databufs[row][col]->db_auxbuf.b_addr = (void *)
-		m0_alloc_aligned(pagesize, M0_NETBUF_SHIFT);
+	map->pi_databufs[row][col]->db_auxbuf.b_addr = page_get(pagesize);
 
 	if (map->pi_databufs[row][col]->db_auxbuf.b_addr == NULL)
 		return M0_ERR(-ENOMEM);
@@ -525,6 +525,7 @@ static void ioreq_iosm_handle_executed(struct m0_sm_group *grp,
 						 "failed (to APP): rc=%d", rc);
 				goto fail_locked;
 			}
+			m0__rcache_fill(ioo);
 		} else {
 			M0_ASSERT(state == IRS_WRITE_COMPLETE);
 
@@ -673,6 +674,10 @@ static void ioreq_iosm_handle_executed(struct m0_sm_group *grp,
 	}
 done:
 	ioo->ioo_nwxfer.nxr_ops->nxo_complete(&ioo->ioo_nwxfer, rmw);
+	/* Groups cached while the update was in flight may be stale. */
+	if (op->op_code != M0_OC_READ)
+		m0__rcache_invalidate(instance, &ioo->ioo_obj->ob_entity.en_id,
+				      &ioo->ioo_ext, data_size(play));
 
 #ifdef CLIENT_FOR_M0T1FS
 	/* XXX: TODO: update the inode size on the mds */
@@ -721,6 +726,9 @@ fail_locked:
 #else
 	ioo->ioo_nwxfer.nxr_state = NXS_COMPLETE;
 #endif
+	if (op->op_code != M0_OC_READ)
+		m0__rcache_invalidate(instance, &ioo->ioo_obj->ob_entity.en_id,
+				      &ioo->ioo_ext, data_size(play));
 
 	/* As per bug MOTR-2575, rc will be reported in op->op_rc and the
 	 * op will be completed with status M0_OS_STABLE */
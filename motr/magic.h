@@ -101,6 +101,24 @@ enum m0_magic_satchel {
 	/* be_alloc_chunk::bac_magic_free (edifice faded) */
 	M0_BE_ALLOC_FREE_LINK_MAGIC = 0xed1f1cefaded,
 
+	/* be_alloc_arena::baa_magic (cable ace feed) */
+	M0_BE_ALLOC_ARENA_MAGIC = 0xcab1eacefeed,
+
+	/* be_alloc_index::bai_magic (decoded fable) */
+	M0_BE_ALLOC_INDEX_MAGIC = 0xdec0dedfab1e,
+
+	/* be_alloc_slab::bsl_magic (decibel bassoc) */
+	M0_BE_ALLOC_SLAB_MAGIC = 0xdec1be1ba55c,
+
+	/* be_alloc_slab_page::bsp_magic (addable seed) */
+	M0_BE_ALLOC_SLAB_PAGE_MAGIC = 0xaddab1e5eed0,
+
+	/* be_alloc_slab::bsl_free and bsl_class[] (baffled cobb) */
+	M0_BE_ALLOC_SLAB_LIST_MAGIC = 0xbaff1edc0bb0,
+
+	/* be_alloc_slab_page::bsp_link_magic (fiddle coded) */
+	M0_BE_ALLOC_SLAB_LINK_MAGIC = 0xf1dd1ec0ded0,
+
 	/* m0_be_0type::b0_magic (bee fires stig) */
 	M0_BE_0TYPE_MAGIC = 0x33beef17e5519177,
 
@@ -155,6 +173,12 @@ enum m0_magic_satchel {
 	/* m0_be_io::bio_sched_magic (bad be io base) */
 	M0_BE_IO_SCHED_MAGIC = 0x33badbe10ba5e77,
 
+	/* m0_be_btree_sublocks::bsl_magic (be btree stubborn lock) */
+	M0_BE_BTREE_SUBLOCKS_MAGIC = 0x33beb7eeb0b10c77,
+
+	/* be/btree.c::btree_sublocks_registry (be btree lock head) */
+	M0_BE_BTREE_SUBLOCKS_HEAD_MAGIC = 0x33beb7ee10c4ea77,
+
 	/* m0_be_io_sched::bis_ios (bad be io head) */
 	M0_BE_IO_SCHED_HEAD_MAGIC = 0x33badbe104ead77,
 
@@ -245,6 +269,9 @@ enum m0_magic_satchel {
 	/* m0_conf_cache::ca_registry::t_magic (fabled feodal) */
 	M0_CONF_CACHE_MAGIC = 0x33fab1edfe0da177,
 
+	/* conf_cache_index_tl::td_head_magic (decoded seabed) */
+	M0_CONF_CACHE_INDEX_MAGIC = 0x33dec0ded5eabed7,
+
 	/* m0_conf_obj::co_gen_magic (selfless cell) */
 	M0_CONF_OBJ_MAGIC = 0x335e1f1e55ce1177,
 
@@ -789,6 +816,9 @@ enum m0_magic_satchel {
 	/* res_tl::td_head_magic (feeble eagles) */
 	M0_RM_RESOURCE_HEAD_MAGIC = 0x33feeb1eea91e577,
 
+	/* res_hash_tl::td_head_magic (boiled bees) */
+	M0_RM_RESOURCE_BUCKET_MAGIC = 0x33b0113dbee5e577,
+
 	/* m0_rm_right::ri_magix (fizzle fields) */
 	M0_RM_CREDIT_MAGIC = 0x33f1221ef1e1d577,
 
@@ -928,6 +958,12 @@ enum m0_magic_satchel {
 	/* stob/cache.c:stob_cache_tl::td_head_magic (cache billed) */
 	M0_STOB_CACHE_HEAD_MAGIC    = 0x33cac4eb111ed77,
 
+	/* m0_stob::so_cache_hmagic (cache hashed) */
+	M0_STOB_CACHE_HASH_MAGIC    = 0x33cac4e4a54ed77,
+
+	/* stob/cache.c:stob_cache_hash_tl::td_head_magic (cache bucket) */
+	M0_STOB_CACHE_HASH_HEAD_MAGIC = 0x33cac4eb0c4e7577,
+
 	/* m0_stob_type::st_magic (disc class) */
 	M0_STOB_TYPES_MAGIC         = 0x33d15cc1a5577,
 
@@ -1073,6 +1109,16 @@ enum m0_magic_satchel {
 	M0_CEXT_TL_MAGIC      = 0x3326816123512277,
 	/* composite_sub_io_ext:ce_tlink_magic */
 	M0_CIO_EXT_MAGIC      = 0x3327816123512277,
+	/* rc_group::rg_magic */
+	M0_RCACHE_GROUP_MAGIC = 0x3328816123512277,
+	/* m0_read_cache::rc_groups head magic */
+	M0_RCACHE_GROUP_HEAD_MAGIC = 0x3329816123512277,
+	/* rc_group::rg_lru_magic */
+	M0_RCACHE_LRU_MAGIC   = 0x332a816123512277,
+	/* rc_stream::rs_magic */
+	M0_RCACHE_STREAM_MAGIC = 0x332b816123512277,
+	/* rc_ra::ra_magic */
+	M0_RCACHE_RA_MAGIC    = 0x332c816123512277,
 	/* m0_rm_lock_ctx::rmc_magic (ice ice ice) */
 	M0_RM_MAGIC           = 0x331CE1CE1C0E2277,
 	/* rm_ctx_tl::td_head_magic (coca cola sea) */
@@ -1165,6 +1211,10 @@ enum m0_magic_satchel {
 	M0_BE_DTM0_LOG_MAGIX = 0x33d73010600077,
 	/* be/dtm0_log.c::dlr_link (dtm0 log rec) */
 	M0_BE_DTM0_LOG_REC_MAGIX = 0x33d73010673c77,
+	/* be/dtm0_log.c::dlr_hlink (dtm0 log index) */
+	M0_BE_DTM0_LOG_INDEX_MAGIX = 0x33d730106d6e77,
+	/* be/dtm0_log.c::dl_index (dtm0 log index head) */
+	M0_BE_DTM0_LOG_INDEX_HEAD_MAGIX = 0x33d73010eadd77,
 };
 
 #endif /* __MOTR_MAGIC_H__ */
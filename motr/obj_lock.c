@@ -204,7 +204,9 @@ M0_INTERNAL int m0_obj_lock_get(struct m0_obj *obj,
 	ctx = m0_cookie_of(&obj->ob_cookie, struct m0_rm_lock_ctx,
 			   rmc_gen);
 	M0_ASSERT(ctx != NULL);
-	req->rlr_rc = 0;
+	req->rlr_rc     = 0;
+	req->rlr_m0c    = m0__obj_instance(obj);
+	req->rlr_obj_id = obj->ob_entity.en_id;
 	rm_lock_req_init(clink, &ctx->rmc_owner, req, rw_type);
 	m0_rm_credit_get(&req->rlr_in);
 
@@ -311,6 +313,12 @@ static void obj_lock_incoming_complete(struct m0_rm_incoming *in, int32_t rc)
 	M0_ENTRY();
 
 	req = M0_AMB(req, in, rlr_in);
+	/*
+	 * Other clients may have changed the object until now. Data cached
+	 * or being read before the lock was granted are dropped.
+	 */
+	if (rc == 0)
+		m0__rcache_invalidate(req->rlr_m0c, &req->rlr_obj_id, NULL, 0);
 	req->rlr_rc = rc;
 	/* Signals the thread waiting for the lock to be granted */
 	m0_chan_broadcast_lock(&req->rlr_chan);
@@ -0,0 +1,733 @@
+/* -*- C -*- */
+/*
+ * Copyright (c) 2021 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+
+#include "motr/client.h"
+#include "motr/client_internal.h"
+#include "motr/io.h"
+#include "motr/layout.h"
+#include "motr/magic.h"
+#include "motr/read_cache.h"
+
+#include "lib/arith.h"                /* min3 */
+#include "lib/atomic.h"
+#include "lib/errno.h"
+#include "lib/memory.h"
+#include "lib/vec.h"
+#include "net/net.h"                  /* M0_NETBUF_SHIFT */
+
+#define M0_TRACE_SUBSYSTEM M0_TRACE_SUBSYS_CLIENT
+#include "lib/trace.h"
+
+/**
+ * @addtogroup client_read_cache
+ * @{
+ */
+
+enum {
+	RC_HASH_BUCKETS    = 1024,
+	/** Number of objects whose sequential streams are tracked. */
+	RC_STREAM_MAX      = 64,
+	/** Maximal number of readahead ops in flight. */
+	RC_RA_INFLIGHT_MAX = 8,
+};
+
+struct rc_key {
+	struct m0_uint128 rk_id;
+	uint64_t          rk_grp;
+};
+
+/** Cached data of a parity group. */
+struct rc_group {
+	uint64_t          rg_magic;
+	struct m0_hlink   rg_hlink;
+	uint64_t          rg_lru_magic;
+	struct m0_tlink   rg_lru;
+	struct rc_key     rg_key;
+	m0_bcount_t       rg_size;
+	/** The group was read ahead and was not used yet. */
+	bool              rg_ra;
+	void             *rg_data;
+};
+
+/** Sequential read stream of an object. */
+struct rc_stream {
+	uint64_t          rs_magic;
+	struct m0_tlink   rs_link;
+	struct m0_uint128 rs_id;
+	/** Offset where the next sequential read starts. */
+	m0_bindex_t       rs_next;
+	/** Offset up to which the data was read ahead. */
+	m0_bindex_t       rs_ra_end;
+	/** Current readahead window, in parity groups. */
+	uint32_t          rs_window;
+};
+
+/** Readahead op and everything it owns. */
+struct rc_ra {
+	uint64_t          ra_magic;
+	struct m0_tlink   ra_link;
+	struct m0_obj     ra_obj;
+	struct m0_op     *ra_op;
+	struct m0_indexvec ra_ext;
+	struct m0_bufvec  ra_data;
+	struct m0_bufvec  ra_attr;
+	/** Set once the op is stable or failed. */
+	struct m0_atomic64 ra_done;
+};
+
+static uint64_t rcache_hash(const struct m0_htable *htable, const void *k)
+{
+	const struct rc_key *key = k;
+
+	return m0_hash(key->rk_id.u_hi ^ key->rk_id.u_lo ^
+		       m0_hash(key->rk_grp)) % htable->h_bucket_nr;
+}
+
+static bool rcache_key_eq(const void *key1, const void *key2)
+{
+	const struct rc_key *k1 = key1;
+	const struct rc_key *k2 = key2;
+
+	return m0_uint128_eq(&k1->rk_id, &k2->rk_id) &&
+		k1->rk_grp == k2->rk_grp;
+}
+
+M0_HT_DESCR_DEFINE(rcg, "read cache groups", static, struct rc_group,
+		   rg_hlink, rg_magic, M0_RCACHE_GROUP_MAGIC,
+		   M0_RCACHE_GROUP_HEAD_MAGIC, rg_key, rcache_hash,
+		   rcache_key_eq);
+M0_HT_DEFINE(rcg, static, struct rc_group, struct rc_key);
+
+M0_TL_DESCR_DEFINE(rcl, "read cache lru", static, struct rc_group, rg_lru,
+		   rg_lru_magic, M0_RCACHE_LRU_MAGIC,
+		   M0_RCACHE_GROUP_HEAD_MAGIC);
+M0_TL_DEFINE(rcl, static, struct rc_group);
+
+M0_TL_DESCR_DEFINE(rcs, "read cache streams", static, struct rc_stream,
+		   rs_link, rs_magic, M0_RCACHE_STREAM_MAGIC,
+		   M0_RCACHE_GROUP_HEAD_MAGIC);
+M0_TL_DEFINE(rcs, static, struct rc_stream);
+
+M0_TL_DESCR_DEFINE(rcra, "read cache readahead", static, struct rc_ra,
+		   ra_link, ra_magic, M0_RCACHE_RA_MAGIC,
+		   M0_RCACHE_GROUP_HEAD_MAGIC);
+M0_TL_DEFINE(rcra, static, struct rc_ra);
+
+static bool rcache_is_enabled(const struct m0_read_cache *rc)
+{
+	return rc->rc_size_max > 0;
+}
+
+static bool rcache_obj_is_cacheable(const struct m0_obj *obj)
+{
+	return M0_OBJ_LAYOUT_TYPE(obj->ob_attr.oa_layout_id) == M0_LT_PDCLUST;
+}
+
+static struct m0_read_cache *rcache_of(struct m0_op_io *ioo)
+{
+	return &m0__obj_instance(ioo->ioo_obj)->m0c_rcache;
+}
+
+static int rcache_init(struct m0_read_cache *rc, m0_bcount_t size_max,
+		       uint32_t ra_max)
+{
+	int result;
+
+	M0_SET0(rc);
+	result = rcg_htable_init(&rc->rc_groups, RC_HASH_BUCKETS);
+	if (result != 0)
+		return M0_ERR(result);
+	m0_mutex_init(&rc->rc_lock);
+	rcl_tlist_init(&rc->rc_lru);
+	rcs_tlist_init(&rc->rc_streams);
+	rcra_tlist_init(&rc->rc_ra);
+	rc->rc_size_max = size_max;
+	rc->rc_ra_max   = ra_max;
+	return 0;
+}
+
+static struct rc_group *rcache_group_alloc(const struct m0_uint128 *id,
+					   uint64_t grp, m0_bcount_t size)
+{
+	struct rc_group *rg;
+
+	M0_ALLOC_PTR(rg);
+	if (rg == NULL)
+		return NULL;
+	rg->rg_data = m0_alloc(size);
+	if (rg->rg_data == NULL) {
+		m0_free(rg);
+		return NULL;
+	}
+	rcg_tlink_init(rg);
+	rcl_tlink_init(rg);
+	rg->rg_key.rk_id  = *id;
+	rg->rg_key.rk_grp = grp;
+	rg->rg_size       = size;
+	return rg;
+}
+
+static void rcache_group_free(struct rc_group *rg)
+{
+	rcl_tlink_fini(rg);
+	rcg_tlink_fini(rg);
+	m0_free(rg->rg_data);
+	m0_free(rg);
+}
+
+static struct rc_group *rcache_lookup(struct m0_read_cache *rc,
+				      const struct m0_uint128 *id, uint64_t grp)
+{
+	struct rc_key key = { .rk_id = *id, .rk_grp = grp };
+
+	M0_PRE(m0_mutex_is_locked(&rc->rc_lock));
+	return rcg_htable_lookup(&rc->rc_groups, &key);
+}
+
+static void rcache_group_del(struct m0_read_cache *rc, struct rc_group *rg)
+{
+	M0_PRE(m0_mutex_is_locked(&rc->rc_lock));
+	rcg_htable_del(&rc->rc_groups, rg);
+	rcl_tlist_del(rg);
+	M0_ASSERT(rc->rc_size >= rg->rg_size);
+	rc->rc_size -= rg->rg_size;
+	rcache_group_free(rg);
+}
+
+/**
+ * Inserts the group, replacing its older copy if any, and evicts the least
+ * recently used groups to stay within the size limit.
+ */
+static void rcache_group_add(struct m0_read_cache *rc, struct rc_group *rg)
+{
+	struct rc_group *old;
+
+	M0_PRE(m0_mutex_is_locked(&rc->rc_lock));
+	M0_PRE(rg->rg_size <= rc->rc_size_max);
+
+	old = rcg_htable_lookup(&rc->rc_groups, &rg->rg_key);
+	if (old != NULL)
+		rcache_group_del(rc, old);
+	while (rc->rc_size + rg->rg_size > rc->rc_size_max) {
+		rcache_group_del(rc, rcl_tlist_tail(&rc->rc_lru));
+		++rc->rc_stats.rcs_evictions;
+	}
+	rcg_htable_add(&rc->rc_groups, rg);
+	rcl_tlist_add(&rc->rc_lru, rg);
+	rc->rc_size += rg->rg_size;
+}
+
+static bool rcache_ext_touches(const struct m0_indexvec *ext, uint64_t grp,
+			       m0_bcount_t grpsize)
+{
+	uint32_t i;
+
+	for (i = 0; i < ext->iv_vec.v_nr; ++i) {
+		if (INDEX(ext, i) < (grp + 1) * grpsize &&
+		    seg_endpos(ext, i) > grp * grpsize)
+			return true;
+	}
+	return false;
+}
+
+static uint64_t rcache_ext_groups_nr(const struct m0_indexvec *ext,
+				     m0_bcount_t grpsize)
+{
+	uint64_t nr = 0;
+	uint32_t i;
+
+	for (i = 0; i < ext->iv_vec.v_nr; ++i)
+		nr += (seg_endpos(ext, i) - 1) / grpsize -
+			INDEX(ext, i) / grpsize + 1;
+	return nr;
+}
+
+/** Returns true iff every group touched by the extents is cached. */
+static bool rcache_covers(struct m0_read_cache *rc,
+			  const struct m0_uint128 *id,
+			  const struct m0_indexvec *ext, m0_bcount_t grpsize)
+{
+	uint64_t grp;
+	uint32_t i;
+
+	for (i = 0; i < ext->iv_vec.v_nr; ++i) {
+		for (grp = INDEX(ext, i) / grpsize;
+		     grp <= (seg_endpos(ext, i) - 1) / grpsize; ++grp) {
+			if (rcache_lookup(rc, id, grp) == NULL)
+				return false;
+		}
+	}
+	return true;
+}
+
+/** Copies cached data to the buffers, rcache_covers() must hold. */
+static void rcache_copy_out(struct m0_read_cache *rc,
+			    const struct m0_uint128 *id,
+			    struct m0_indexvec *ext, struct m0_bufvec *data,
+			    m0_bcount_t grpsize)
+{
+	struct m0_ivec_cursor   ic;
+	struct m0_bufvec_cursor bc;
+	struct rc_group        *rg = NULL;
+	m0_bindex_t             off;
+	m0_bcount_t             n = 0;
+
+	m0_ivec_cursor_init(&ic, ext);
+	m0_bufvec_cursor_init(&bc, data);
+	while (!m0_ivec_cursor_move(&ic, n)) {
+		off = m0_ivec_cursor_index(&ic);
+		if (rg == NULL || rg->rg_key.rk_grp != off / grpsize) {
+			rg = rcache_lookup(rc, id, off / grpsize);
+			M0_ASSERT(rg != NULL);
+			rcl_tlist_move(&rc->rc_lru, rg);
+			if (rg->rg_ra) {
+				rg->rg_ra = false;
+				++rc->rc_stats.rcs_ra_hits;
+			}
+		}
+		off -= rg->rg_key.rk_grp * grpsize;
+		n = min3(m0_ivec_cursor_step(&ic), grpsize - off,
+			 m0_bufvec_cursor_step(&bc));
+		memcpy(m0_bufvec_cursor_addr(&bc),
+		       (char *)rg->rg_data + off, n);
+		m0_bufvec_cursor_move(&bc, n);
+	}
+}
+
+static void rcache_drop(struct m0_read_cache *rc, const struct m0_uint128 *id,
+			const struct m0_indexvec *ext, m0_bcount_t grpsize)
+{
+	struct rc_group  *rg;
+	struct rc_stream *rs;
+	uint64_t          grp;
+	uint32_t          i;
+
+	M0_PRE(m0_mutex_is_locked(&rc->rc_lock));
+
+	++rc->rc_gen;
+	/* Look the groups up, unless there are more of them than cached. */
+	if (ext != NULL &&
+	    rcache_ext_groups_nr(ext, grpsize) * grpsize < rc->rc_size) {
+		for (i = 0; i < ext->iv_vec.v_nr; ++i) {
+			for (grp = INDEX(ext, i) / grpsize;
+			     grp <= (seg_endpos(ext, i) - 1) / grpsize; ++grp) {
+				rg = rcache_lookup(rc, id, grp);
+				if (rg != NULL) {
+					rcache_group_del(rc, rg);
+					++rc->rc_stats.rcs_invalidations;
+				}
+			}
+		}
+		return;
+	}
+	m0_tl_for(rcl, &rc->rc_lru, rg) {
+		if (m0_uint128_eq(&rg->rg_key.rk_id, id) &&
+		    (ext == NULL ||
+		     rcache_ext_touches(ext, rg->rg_key.rk_grp, grpsize))) {
+			rcache_group_del(rc, rg);
+			++rc->rc_stats.rcs_invalidations;
+		}
+	} m0_tl_endfor;
+	if (ext == NULL) {
+		rs = m0_tl_find(rcs, rs, &rc->rc_streams,
+				m0_uint128_eq(&rs->rs_id, id));
+		if (rs != NULL)
+			rs->rs_ra_end = 0;
+	}
+}
+
+/**
+ * Updates the sequential stream of the object with a read of [start, end).
+ * Returns the number of groups to read ahead, starting from *first.
+ */
+static uint32_t rcache_stream_update(struct m0_read_cache *rc,
+				     const struct m0_uint128 *id,
+				     m0_bindex_t start, m0_bindex_t end,
+				     m0_bcount_t grpsize, uint64_t *first)
+{
+	struct rc_stream *rs;
+	uint64_t          grp;
+	uint64_t          last;
+	uint32_t          window_max;
+
+	M0_PRE(m0_mutex_is_locked(&rc->rc_lock));
+
+	if (rc->rc_ra_max == 0)
+		return 0;
+	rs = m0_tl_find(rcs, rs, &rc->rc_streams,
+			m0_uint128_eq(&rs->rs_id, id));
+	if (rs == NULL) {
+		if (rc->rc_streams_nr < RC_STREAM_MAX) {
+			M0_ALLOC_PTR(rs);
+			if (rs == NULL)
+				return 0;
+			rcs_tlink_init(rs);
+			++rc->rc_streams_nr;
+		} else {
+			rs = rcs_tlist_tail(&rc->rc_streams);
+			rcs_tlist_del(rs);
+		}
+		rs->rs_id     = *id;
+		rs->rs_next   = end;
+		rs->rs_ra_end = 0;
+		rs->rs_window = 0;
+		rcs_tlist_add(&rc->rc_streams, rs);
+		return 0;
+	}
+	rcs_tlist_move(&rc->rc_streams, rs);
+	if (start != rs->rs_next) {
+		rs->rs_next   = end;
+		rs->rs_ra_end = 0;
+		rs->rs_window = 0;
+		return 0;
+	}
+	rs->rs_next = end;
+	/* Keep readahead within a half of the cache. */
+	window_max = min_check((uint64_t)rc->rc_ra_max,
+			       rc->rc_size_max / 2 / grpsize);
+	rs->rs_window = min_check(rs->rs_window == 0 ? 1 : rs->rs_window * 2,
+				  window_max);
+	if (rs->rs_window == 0 || rc->rc_ra_nr >= RC_RA_INFLIGHT_MAX)
+		return 0;
+	grp  = max_check(end / grpsize, rs->rs_ra_end / grpsize);
+	last = (end + grpsize - 1) / grpsize + rs->rs_window;
+	while (grp < last && rcache_lookup(rc, id, grp) != NULL)
+		++grp;
+	if (grp >= last)
+		return 0;
+	rs->rs_ra_end = last * grpsize;
+	rc->rc_stats.rcs_ra_groups += last - grp;
+	*first = grp;
+	return last - grp;
+}
+
+static void rcache_ra_free(struct rc_ra *ra)
+{
+	if (ra->ra_op != NULL) {
+		m0_op_fini(ra->ra_op);
+		m0_op_free(ra->ra_op);
+	}
+	m0_obj_fini(&ra->ra_obj);
+	m0_bufvec_free_aligned(&ra->ra_data, M0_NETBUF_SHIFT);
+	m0_indexvec_free(&ra->ra_ext);
+	rcra_tlink_fini(ra);
+	m0_free(ra);
+}
+
+/**
+ * Finalises completed readahead ops, or waits for all of them when wait is
+ * true. Ops are finalised without rc_lock held.
+ */
+static void rcache_ra_reap(struct m0_read_cache *rc, bool wait)
+{
+	struct rc_ra *ra;
+	struct m0_tl  done;
+
+	rcra_tlist_init(&done);
+	m0_mutex_lock(&rc->rc_lock);
+	m0_tl_for(rcra, &rc->rc_ra, ra) {
+		if (wait || m0_atomic64_get(&ra->ra_done) != 0) {
+			rcra_tlist_move(&done, ra);
+			--rc->rc_ra_nr;
+		}
+	} m0_tl_endfor;
+	m0_mutex_unlock(&rc->rc_lock);
+	m0_tl_teardown(rcra, &done, ra) {
+		if (wait)
+			m0_op_wait(ra->ra_op, M0_BITS(M0_OS_STABLE,
+						      M0_OS_FAILED),
+				   M0_TIME_NEVER);
+		rcache_ra_free(ra);
+	}
+	rcra_tlist_fini(&done);
+}
+
+static void rcache_ra_done(struct m0_op *op)
+{
+	struct rc_ra *ra = op->op_datum;
+
+	m0_atomic64_set(&ra->ra_done, 1);
+}
+
+static const struct m0_op_ops rcache_ra_ops = {
+	.oop_executed = NULL,
+	.oop_failed   = rcache_ra_done,
+	.oop_stable   = rcache_ra_done
+};
+
+/** Launches a read of groups [first, first + nr) of the object. */
+static void rcache_ra_launch(struct m0_read_cache *rc, struct m0_obj *obj,
+			     uint64_t first, uint32_t nr, m0_bcount_t grpsize)
+{
+	struct m0_op_common *oc;
+	struct m0_op_obj    *oo;
+	struct m0_op_io     *ioo;
+	struct rc_ra        *ra;
+	uint32_t             i;
+	int                  result;
+
+	M0_ALLOC_PTR(ra);
+	if (ra == NULL)
+		return;
+	rcra_tlink_init(ra);
+	m0_obj_init(&ra->ra_obj, obj->ob_entity.en_realm,
+		    &obj->ob_entity.en_id, obj->ob_attr.oa_layout_id);
+	ra->ra_obj.ob_attr = obj->ob_attr;
+	result = m0_indexvec_alloc(&ra->ra_ext, nr) ?:
+		 m0_bufvec_alloc_aligned(&ra->ra_data, nr, grpsize,
+					 M0_NETBUF_SHIFT);
+	if (result == 0) {
+		for (i = 0; i < nr; ++i) {
+			INDEX(&ra->ra_ext, i) = (first + i) * grpsize;
+			COUNT(&ra->ra_ext, i) = grpsize;
+		}
+		result = m0_obj_op(&ra->ra_obj, M0_OC_READ, &ra->ra_ext,
+				   &ra->ra_data, &ra->ra_attr, 0, 0,
+				   &ra->ra_op);
+	}
+	if (result != 0) {
+		M0_LOG(M0_DEBUG, "readahead of "U128X_F" failed: %d",
+		       U128_P(&obj->ob_entity.en_id), result);
+		rcache_ra_free(ra);
+		return;
+	}
+	oc  = bob_of(ra->ra_op, struct m0_op_common, oc_op, &oc_bobtype);
+	oo  = bob_of(oc, struct m0_op_obj, oo_oc, &oo_bobtype);
+	ioo = bob_of(oo, struct m0_op_io, ioo_oo, &ioo_bobtype);
+	ioo->ioo_readahead = true;
+	ra->ra_op->op_datum = ra;
+	m0_op_setup(ra->ra_op, &rcache_ra_ops, 0);
+	m0_op_launch(&ra->ra_op, 1);
+	/* A launch failure moves the op to FAILED without call-backs. */
+	if (m0_op_wait(ra->ra_op, M0_BITS(M0_OS_FAILED),
+		       M0_TIME_IMMEDIATELY) == 0)
+		m0_atomic64_set(&ra->ra_done, 1);
+	/* Published only now, so that nobody reaps it under our feet. */
+	m0_mutex_lock(&rc->rc_lock);
+	rcra_tlist_add_tail(&rc->rc_ra, ra);
+	++rc->rc_ra_nr;
+	m0_mutex_unlock(&rc->rc_lock);
+}
+
+static void rcache_fini(struct m0_read_cache *rc)
+{
+	struct rc_group  *rg;
+	struct rc_stream *rs;
+
+	rcache_ra_reap(rc, true);
+	M0_LOG(M0_INFO, "read cache: hits=%"PRIu64" misses=%"PRIu64
+	       " ra_groups=%"PRIu64" ra_hits=%"PRIu64" evictions=%"PRIu64
+	       " invalidations=%"PRIu64, rc->rc_stats.rcs_hits,
+	       rc->rc_stats.rcs_misses, rc->rc_stats.rcs_ra_groups,
+	       rc->rc_stats.rcs_ra_hits, rc->rc_stats.rcs_evictions,
+	       rc->rc_stats.rcs_invalidations);
+	m0_tl_teardown(rcl, &rc->rc_lru, rg) {
+		rcg_htable_del(&rc->rc_groups, rg);
+		rcache_group_free(rg);
+	}
+	m0_tl_teardown(rcs, &rc->rc_streams, rs) {
+		rcs_tlink_fini(rs);
+		m0_free(rs);
+	}
+	rcra_tlist_fini(&rc->rc_ra);
+	rcs_tlist_fini(&rc->rc_streams);
+	rcl_tlist_fini(&rc->rc_lru);
+	rcg_htable_fini(&rc->rc_groups);
+	m0_mutex_fini(&rc->rc_lock);
+}
+
+M0_INTERNAL int m0__rcache_init(struct m0_client *m0c)
+{
+	return rcache_init(&m0c->m0c_rcache,
+			   m0c->m0c_config->mc_read_cache_size,
+			   m0c->m0c_config->mc_readahead_max);
+}
+
+M0_INTERNAL void m0__rcache_fini(struct m0_client *m0c)
+{
+	rcache_fini(&m0c->m0c_rcache);
+}
+
+M0_INTERNAL bool m0__rcache_read(struct m0_op_io *ioo)
+{
+	struct m0_read_cache *rc  = rcache_of(ioo);
+	struct m0_obj        *obj = ioo->ioo_obj;
+	struct m0_indexvec   *ext = &ioo->ioo_ext;
+	m0_bcount_t           grpsize;
+	uint64_t              first = 0;
+	uint32_t              nr;
+	bool                  hit;
+
+	M0_PRE(ioo->ioo_oo.oo_oc.oc_op.op_code == M0_OC_READ);
+
+	if (!rcache_is_enabled(rc) || !rcache_obj_is_cacheable(obj) ||
+	    ext->iv_vec.v_nr == 0)
+		return false;
+	grpsize = data_size(pdlayout_get(ioo));
+	if (!ioo->ioo_readahead)
+		rcache_ra_reap(rc, false);
+
+	m0_mutex_lock(&rc->rc_lock);
+	if (ioo->ioo_flags & M0_OOF_NOCACHE)
+		rcache_drop(rc, &obj->ob_entity.en_id, ext, grpsize);
+	ioo->ioo_rcache_gen = rc->rc_gen;
+	if (ioo->ioo_readahead) {
+		m0_mutex_unlock(&rc->rc_lock);
+		return false;
+	}
+	hit = !(ioo->ioo_flags & M0_OOF_NOCACHE) &&
+	      ioo->ioo_attr.ov_vec.v_nr == 0 &&
+	      rcache_covers(rc, &obj->ob_entity.en_id, ext, grpsize);
+	if (hit) {
+		rcache_copy_out(rc, &obj->ob_entity.en_id, ext,
+				&ioo->ioo_data, grpsize);
+		++rc->rc_stats.rcs_hits;
+	} else
+		++rc->rc_stats.rcs_misses;
+	nr = rcache_stream_update(rc, &obj->ob_entity.en_id, INDEX(ext, 0),
+				  seg_endpos(ext, ext->iv_vec.v_nr - 1),
+				  grpsize, &first);
+	m0_mutex_unlock(&rc->rc_lock);
+
+	if (nr > 0)
+		rcache_ra_launch(rc, obj, first, nr, grpsize);
+	return hit;
+}
+
+/** Returns true iff every data page of the group was read. */
+static bool rcache_map_is_full(struct pargrp_iomap *map)
+{
+	struct m0_op_io          *ioo  = map->pi_ioo;
+	struct m0_pdclust_layout *play = pdlayout_get(ioo);
+	struct data_buf          *buf;
+	uint32_t                  row;
+	uint32_t                  col;
+
+	for (row = 0; row < rows_nr(play, ioo->ioo_obj); ++row) {
+		for (col = 0; col < layout_n(play); ++col) {
+			buf = map->pi_databufs[row][col];
+			if (buf == NULL || buf->db_buf.b_addr == NULL ||
+			    buf->db_flags & PA_READ_FAILED)
+				return false;
+		}
+	}
+	return true;
+}
+
+M0_INTERNAL void m0__rcache_fill(struct m0_op_io *ioo)
+{
+	struct m0_read_cache     *rc  = rcache_of(ioo);
+	struct m0_obj            *obj = ioo->ioo_obj;
+	struct m0_pdclust_layout *play;
+	struct pargrp_iomap      *map;
+	struct data_buf          *buf;
+	struct rc_group          *rg;
+	m0_bcount_t               grpsize;
+	m0_bcount_t               pgsize;
+	m0_bindex_t               off;
+	uint64_t                  i;
+	uint32_t                  row;
+	uint32_t                  col;
+
+	if (!rcache_is_enabled(rc) || !rcache_obj_is_cacheable(obj))
+		return;
+	play    = pdlayout_get(ioo);
+	grpsize = data_size(play);
+	pgsize  = m0__page_size(ioo);
+	if (grpsize > rc->rc_size_max)
+		return;
+
+	for (i = 0; i < ioo->ioo_iomap_nr; ++i) {
+		map = ioo->ioo_iomaps[i];
+		if (!rcache_map_is_full(map))
+			continue;
+		rg = rcache_group_alloc(&obj->ob_entity.en_id, map->pi_grpid,
+					grpsize);
+		if (rg == NULL)
+			break;
+		rg->rg_ra = ioo->ioo_readahead;
+		for (row = 0; row < rows_nr(play, obj); ++row) {
+			for (col = 0; col < layout_n(play); ++col) {
+				off = data_page_offset_get(map, row, col) -
+				      map->pi_grpid * grpsize;
+				buf = map->pi_databufs[row][col];
+				memcpy((char *)rg->rg_data + off,
+				       buf->db_buf.b_addr, pgsize);
+			}
+		}
+		m0_mutex_lock(&rc->rc_lock);
+		if (ioo->ioo_rcache_gen != rc->rc_gen) {
+			/* Invalidated while the read was in flight. */
+			m0_mutex_unlock(&rc->rc_lock);
+			rcache_group_free(rg);
+			break;
+		}
+		rcache_group_add(rc, rg);
+		m0_mutex_unlock(&rc->rc_lock);
+	}
+}
+
+M0_INTERNAL void m0__rcache_invalidate(struct m0_client         *m0c,
+				       const struct m0_uint128  *id,
+				       const struct m0_indexvec *ext,
+				       m0_bcount_t               grpsize)
+{
+	struct m0_read_cache *rc = &m0c->m0c_rcache;
+
+	M0_PRE(ergo(ext != NULL, grpsize > 0));
+
+	if (!rcache_is_enabled(rc))
+		return;
+	m0_mutex_lock(&rc->rc_lock);
+	rcache_drop(rc, id, ext, grpsize);
+	m0_mutex_unlock(&rc->rc_lock);
+}
+
+void m0_client_read_cache_stats(struct m0_client           *m0c,
+				struct m0_read_cache_stats *stats)
+{
+	struct m0_read_cache *rc = &m0c->m0c_rcache;
+
+	M0_PRE(stats != NULL);
+
+	m0_mutex_lock(&rc->rc_lock);
+	*stats = rc->rc_stats;
+	m0_mutex_unlock(&rc->rc_lock);
+}
+M0_EXPORTED(m0_client_read_cache_stats);
+
+#undef M0_TRACE_SUBSYSTEM
+
+/** @} end of client_read_cache group */
+
+/*
+ *  Local variables:
+ *  c-indentation-style: "K&R"
+ *  c-basic-offset: 8
+ *  tab-width: 8
+ *  fill-column: 80
+ *  scroll-step: 1
+ *  End:
+ */
+/*
+ * vim: tabstop=8 shiftwidth=8 noexpandtab textwidth=80 nowrap
+ */
@@ -0,0 +1,128 @@
+/* -*- C -*- */
+/*
+ * Copyright (c) 2021 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+
+#pragma once
+
+#ifndef __MOTR_READ_CACHE_H__
+#define __MOTR_READ_CACHE_H__
+
+#include "lib/types.h"
+#include "lib/mutex.h"
+#include "lib/tlist.h"
+#include "lib/hash.h"
+#include "motr/client.h"      /* m0_read_cache_stats */
+
+/**
+ * @defgroup client_read_cache Client read cache
+ *
+ * The read cache keeps the data of whole parity groups read from the
+ * servers, keyed by (object id, parity group index). It is enabled by
+ * m0_config::mc_read_cache_size, and holds at most that many bytes, evicting
+ * the least recently used groups.
+ *
+ * - A read whose every extent falls into cached groups is served from the
+ *   cache at launch, without any network round trip.
+ *
+ * - A successful read populates the cache with the groups it read in full.
+ *
+ * - Sequential readers are detected per object. Once a read starts where the
+ *   previous one ended, the cache reads the following groups ahead with an
+ *   internal read op. The window doubles with every further sequential read,
+ *   up to m0_config::mc_readahead_max groups.
+ *
+ * - Writes and frees drop the groups they touch, when they are launched and
+ *   when they complete. When an object lock (m0_obj_lock_get()) is granted,
+ *   the whole object is dropped, as other clients may have changed it.
+ *   M0_OOF_NOCACHE makes a read bypass the cache and refresh it.
+ *
+ * Every invalidation bumps m0_read_cache::rc_gen. A read only populates the
+ * cache if the generation did not change since it was launched, so it never
+ * brings back data written over in the meantime.
+ *
+ * @{
+ */
+
+struct m0_client;
+struct m0_op_io;
+
+struct m0_read_cache {
+	/** Protects everything below. */
+	struct m0_mutex            rc_lock;
+	/** Maximal number of bytes of cached data, 0 when disabled. */
+	m0_bcount_t                rc_size_max;
+	/** Number of bytes of cached data. */
+	m0_bcount_t                rc_size;
+	/** Maximal readahead window in parity groups. */
+	uint32_t                   rc_ra_max;
+	/** Incremented on every invalidation. */
+	uint64_t                   rc_gen;
+	/** Cached groups, by (object id, group index). */
+	struct m0_htable           rc_groups;
+	/** Cached groups, the most recently used first. */
+	struct m0_tl               rc_lru;
+	/** Sequential stream state, the most recently used first. */
+	struct m0_tl               rc_streams;
+	uint32_t                   rc_streams_nr;
+	/** Readahead ops in flight or waiting to be finalised. */
+	struct m0_tl               rc_ra;
+	uint32_t                   rc_ra_nr;
+	struct m0_read_cache_stats rc_stats;
+};
+
+M0_INTERNAL int  m0__rcache_init(struct m0_client *m0c);
+/** Waits for readahead in flight and drops the cached data. */
+M0_INTERNAL void m0__rcache_fini(struct m0_client *m0c);
+
+/**
+ * Called when a read op is launched. Serves the read from the cache and
+ * returns true if every group it touches is cached, returns false if the
+ * read has to go to the servers. In both cases may start readahead.
+ */
+M0_INTERNAL bool m0__rcache_read(struct m0_op_io *ioo);
+
+/** Called when a read op has copied its data to the application. */
+M0_INTERNAL void m0__rcache_fill(struct m0_op_io *ioo);
+
+/**
+ * Drops the cached groups of an object which intersect with the extents,
+ * or all of them if ext is NULL.
+ */
+M0_INTERNAL void m0__rcache_invalidate(struct m0_client         *m0c,
+				       const struct m0_uint128  *id,
+				       const struct m0_indexvec *ext,
+				       m0_bcount_t               grpsize);
+
+/** @} end of client_read_cache group */
+#endif /* __MOTR_READ_CACHE_H__ */
+
+/*
+ *  Local variables:
+ *  c-indentation-style: "K&R"
+ *  c-basic-offset: 8
+ *  tab-width: 8
+ *  fill-column: 80
+ *  scroll-step: 1
+ *  End:
+ */
+/*
+ * vim: tabstop=8 shiftwidth=8 noexpandtab textwidth=80 nowrap
+ */
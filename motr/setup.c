@@ -64,6 +64,7 @@
 #include "ioservice/fid_convert.h" /* M0_AD_STOB_LINUX_DOM_KEY */
 #include "ioservice/storage_dev.h"
 #include "ioservice/io_service.h"  /* m0_ios_net_buffer_pool_size_set */
+#include "cas/cas.h"            /* M0_CAS_KEY_SHARD_BITS_MAX */
 #include "stob/linux.h"
 #include "conf/ha.h"            /* m0_conf_ha_process_event_post */
 #include "dtm0/helper.h"        /* m0_dtm0_log_create */
@@ -528,6 +529,8 @@ static int cs_rpc_machine_init(struct m0_motr *cctx, const char *xprt_name,
 				 recv_queue_min_length);
 	if (rc != 0)
 		m0_free(rpcmach);
+	else
+		rpcmach->rm_numa_steer = cctx->cc_reqh_ctx.rc_numa_steer;
 	return M0_RC(rc);
 }
 
@@ -1517,6 +1520,7 @@ static int cs_be_init(struct m0_reqh_context *rctx,
 		be->but_dom_cfg.bc_engine.bec_group_freeze_timeout_max =
 			rctx->rc_be_tx_group_freeze_timeout_max;
 	}
+	be->but_dom_cfg.bc_seg_open_cfg = rctx->rc_be_seg_open_cfg;
 	rc = cs_be_dom_cfg_zone_pcnt_fill(&rctx->rc_reqh, &be->but_dom_cfg);
 	if (rc != 0)
 		goto err;
@@ -2231,6 +2235,28 @@ static int _args_parse(struct m0_motr *cctx, int argc, char **argv)
 				{
 					rctx->rc_be_seg_preallocate = true;
 				})),
+			M0_STRINGARG('O', "BE segment open mode, repeatable:"
+				     " populate, read, thp or hugetlb",
+				LAMBDA(void, (const char *s)
+				{
+					struct m0_be_seg_open_cfg *oc =
+						&rctx->rc_be_seg_open_cfg;
+
+					if (m0_streq(s, "populate"))
+						oc->soc_prefault =
+						  M0_BE_SEG_PREFAULT_POPULATE;
+					else if (m0_streq(s, "read"))
+						oc->soc_prefault =
+						  M0_BE_SEG_PREFAULT_READ;
+					else if (m0_streq(s, "thp"))
+						oc->soc_hugepage =
+						  M0_BE_SEG_HUGEPAGE_THP;
+					else if (m0_streq(s, "hugetlb"))
+						oc->soc_hugepage =
+						  M0_BE_SEG_HUGEPAGE_HUGETLB;
+					else
+						rc = M0_ERR(-EINVAL);
+				})),
 			M0_STRINGARG('c', "Path to the configuration database",
 				LAMBDA(void, (const char *s)
 				{
@@ -2300,6 +2326,24 @@ static int _args_parse(struct m0_motr *cctx, int argc, char **argv)
 				{
 					rctx->rc_fis_enabled = true;
 				})),
+			M0_VOIDARG('W', "Run steered FOMs on localities of"
+				   " the NUMA node which received their"
+				   " request",
+				LAMBDA(void, (void)
+				{
+					rctx->rc_numa_steer = true;
+				})),
+			M0_NUMBERARG('P', "Split CAS catalogues into 2^bits"
+				     " key ranges over localities",
+				LAMBDA(void, (int64_t bits)
+				{
+					if (bits < 0 ||
+					    bits > M0_CAS_KEY_SHARD_BITS_MAX)
+						rc = M0_ERR(-EINVAL);
+					else
+						rctx->rc_cas_key_shard_bits =
+							bits;
+				})),
 			M0_NUMBERARG('r', "ADDB Record storage size",
 				LAMBDA(void, (int64_t size)
 				{
@@ -285,6 +285,8 @@ struct m0_reqh_context {
 	m0_bcount_t                  rc_be_tx_payload_size_max;
 	m0_time_t                    rc_be_tx_group_freeze_timeout_min;
 	m0_time_t                    rc_be_tx_group_freeze_timeout_max;
+	/** How BE segments are brought into memory on m0d start. */
+	struct m0_be_seg_open_cfg    rc_be_seg_open_cfg;
 
 	/**
 	 * Default path to the configuration database.
@@ -337,6 +339,18 @@ struct m0_reqh_context {
 	/** Disable direct I/O for data from clients */
 	bool                         rc_disable_direct_io;
 
+	/**
+	 * Steer foms to the NUMA node of the rpc thread which received their
+	 * request, see m0_rpc_machine::rm_numa_steer.
+	 */
+	bool                         rc_numa_steer;
+
+	/**
+	 * Log2 of the number of key ranges CAS catalogues are split into for
+	 * FOM home locality selection, see m0_cas_svc_key_shards_set().
+	 */
+	uint32_t                     rc_cas_key_shard_bits;
+
 	/** Enable Fault Injection Service */
 	bool                         rc_fis_enabled;
 
@@ -449,6 +449,8 @@ static void ut_test_pargrp_iomap_seg_process(void)
 	struct m0_op_io *ioo;
 	struct m0_client       *instance = NULL;
 	struct m0_realm  realm;
+	struct m0_bufvec        appbuf;
+	struct m0_bufvec_cursor appcur;
 
 	blk_size = 1UL << UT_DEFAULT_BLOCK_SHIFT;
 
@@ -519,6 +521,31 @@ static void ut_test_pargrp_iomap_seg_process(void)
 	M0_UT_ASSERT(map->pi_databufs[0][0] != NULL);
 	M0_UT_ASSERT(map->pi_databufs[0][0]->db_flags != 0);
 
+	/*
+	 * Test 4. Aligned application memory is used directly for the
+	 * full page only, the partial page gets a private copy.
+	 */
+	ut_pargrp_iomap_free_data_buf(map, 0, 0);
+	ut_pargrp_iomap_free_data_buf(map, 0, 1);
+	rc = m0_bufvec_alloc_aligned(&appbuf, 1, 2 * blk_size,
+				     M0_NETBUF_SHIFT);
+	M0_UT_ASSERT(rc == 0);
+	m0_bufvec_cursor_init(&appcur, &appbuf);
+	map->pi_ivec.iv_index[0] = 0;
+	map->pi_ivec.iv_vec.v_count[0] = blk_size + blk_size / 2;
+
+	rc = pargrp_iomap_seg_process(map, 0, 0, 0, &appcur);
+	M0_UT_ASSERT(rc == 0);
+	M0_UT_ASSERT(map->pi_databufs[0][0]->db_flags & PA_APP_MEMORY);
+	M0_UT_ASSERT(map->pi_databufs[0][0]->db_buf.b_addr ==
+		     appbuf.ov_buf[0]);
+	M0_UT_ASSERT(!(map->pi_databufs[0][1]->db_flags & PA_APP_MEMORY));
+	data_buf_dealloc_fini(map->pi_databufs[0][0]);
+	data_buf_dealloc_fini(map->pi_databufs[0][1]);
+	m0_bufvec_free_aligned(&appbuf, M0_NETBUF_SHIFT);
+	map->pi_databufs[0][0] = ut_dummy_data_buf_create();
+	map->pi_databufs[0][1] = ut_dummy_data_buf_create();
+
 	/* Clean up */
 	ut_dummy_ioo_delete(ioo, instance);
 }
@@ -1223,6 +1250,29 @@ static void ut_test_pargrp_iomap_dgmode_recover(void)
 	ut_dummy_pargrp_iomap_delete(map, instance);
 }
 
+/**
+ * Tests that pages from the io page cache come back zeroed.
+ */
+static void ut_test_page_cache(void)
+{
+	char     *page;
+	uint64_t  i;
+
+	page = page_get(UT_DEFAULT_BLOCK_SIZE);
+	M0_UT_ASSERT(page != NULL);
+	memset(page, 0xff, UT_DEFAULT_BLOCK_SIZE);
+	page_put(page, UT_DEFAULT_BLOCK_SIZE);
+
+	page = page_get(UT_DEFAULT_BLOCK_SIZE);
+	M0_UT_ASSERT(page != NULL);
+	for (i = 0; i < UT_DEFAULT_BLOCK_SIZE; ++i)
+		M0_UT_ASSERT(page[i] == 0);
+	page_put(page, UT_DEFAULT_BLOCK_SIZE);
+
+	m0__page_cache_drain();
+	M0_UT_ASSERT(m0_atomic64_get(&page_cache_bytes) == 0);
+}
+
 M0_INTERNAL int ut_io_pargrp_init(void)
 {
 	int                       rc;
@@ -1261,6 +1311,8 @@ struct m0_ut_suite ut_suite_io_pargrp = {
 	.ts_init = ut_io_pargrp_init,
 	.ts_fini = ut_io_pargrp_fini,
 	.ts_tests = {
+		{ "page_cache",
+				    &ut_test_page_cache},
 		{ "data_buf_invariant",
 				    &ut_test_data_buf_invariant},
 		{ "data_buf_invariant_nr",
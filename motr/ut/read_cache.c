@@ -0,0 +1,278 @@
+/* -*- C -*- */
+/*
+ * Copyright (c) 2021 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+
+#include "ut/ut.h"            /* M0_UT_ASSERT */
+
+/*
+ * Including the c file, so that the cache can be tested without a client
+ * instance.
+ */
+#include "motr/read_cache.c"
+
+enum {
+	UT_GRP_SIZE = 4096,
+};
+
+static const struct m0_uint128 ut_id0 = M0_UINT128(0x100, 0x1);
+static const struct m0_uint128 ut_id1 = M0_UINT128(0x100, 0x2);
+
+static void ut_group_add(struct m0_read_cache *rc,
+			 const struct m0_uint128 *id, uint64_t grp)
+{
+	struct rc_group *rg;
+
+	rg = rcache_group_alloc(id, grp, UT_GRP_SIZE);
+	M0_UT_ASSERT(rg != NULL);
+	memset(rg->rg_data, (int)grp + 1, UT_GRP_SIZE);
+	m0_mutex_lock(&rc->rc_lock);
+	rcache_group_add(rc, rg);
+	m0_mutex_unlock(&rc->rc_lock);
+}
+
+static bool ut_is_cached(struct m0_read_cache *rc,
+			 const struct m0_uint128 *id, uint64_t grp)
+{
+	bool cached;
+
+	m0_mutex_lock(&rc->rc_lock);
+	cached = rcache_lookup(rc, id, grp) != NULL;
+	m0_mutex_unlock(&rc->rc_lock);
+	return cached;
+}
+
+static void ut_test_rcache_lru(void)
+{
+	struct m0_read_cache rc;
+	int                  rc_init;
+
+	rc_init = rcache_init(&rc, 3 * UT_GRP_SIZE, 0);
+	M0_UT_ASSERT(rc_init == 0);
+
+	ut_group_add(&rc, &ut_id0, 0);
+	ut_group_add(&rc, &ut_id0, 1);
+	ut_group_add(&rc, &ut_id0, 2);
+	M0_UT_ASSERT(rc.rc_size == 3 * UT_GRP_SIZE);
+
+	/* Re-adding a group replaces it and makes it the most recent. */
+	ut_group_add(&rc, &ut_id0, 0);
+	M0_UT_ASSERT(rc.rc_size == 3 * UT_GRP_SIZE);
+	M0_UT_ASSERT(rc.rc_stats.rcs_evictions == 0);
+
+	/* The least recently used group goes first. */
+	ut_group_add(&rc, &ut_id0, 3);
+	M0_UT_ASSERT(rc.rc_size == 3 * UT_GRP_SIZE);
+	M0_UT_ASSERT(rc.rc_stats.rcs_evictions == 1);
+	M0_UT_ASSERT(!ut_is_cached(&rc, &ut_id0, 1));
+	M0_UT_ASSERT(ut_is_cached(&rc, &ut_id0, 0));
+	M0_UT_ASSERT(ut_is_cached(&rc, &ut_id0, 2));
+	M0_UT_ASSERT(ut_is_cached(&rc, &ut_id0, 3));
+	M0_UT_ASSERT(!ut_is_cached(&rc, &ut_id1, 0));
+
+	rcache_fini(&rc);
+}
+
+static void ut_test_rcache_copy_out(void)
+{
+	struct m0_read_cache rc;
+	struct m0_indexvec   ext;
+	struct m0_bufvec     data;
+	char                *buf;
+	int                  rc_init;
+	int                  i;
+
+	rc_init = rcache_init(&rc, 4 * UT_GRP_SIZE, 0);
+	M0_UT_ASSERT(rc_init == 0);
+	ut_group_add(&rc, &ut_id0, 1);
+	ut_group_add(&rc, &ut_id0, 2);
+	ut_group_add(&rc, &ut_id0, 3);
+
+	/* One extent across groups 1 and 2, another one in group 3. */
+	M0_UT_ASSERT(m0_indexvec_alloc(&ext, 2) == 0);
+	INDEX(&ext, 0) = 2 * UT_GRP_SIZE - 512;
+	COUNT(&ext, 0) = 1024;
+	INDEX(&ext, 1) = 3 * UT_GRP_SIZE;
+	COUNT(&ext, 1) = 512;
+	M0_UT_ASSERT(m0_bufvec_alloc(&data, 3, 512) == 0);
+
+	m0_mutex_lock(&rc.rc_lock);
+	M0_UT_ASSERT(rcache_covers(&rc, &ut_id0, &ext, UT_GRP_SIZE));
+	rcache_copy_out(&rc, &ut_id0, &ext, &data, UT_GRP_SIZE);
+	/* Group 3 was used last. */
+	M0_UT_ASSERT(rcl_tlist_head(&rc.rc_lru)->rg_key.rk_grp == 3);
+	M0_UT_ASSERT(rcl_tlist_tail(&rc.rc_lru)->rg_key.rk_grp == 1);
+	m0_mutex_unlock(&rc.rc_lock);
+	for (i = 0; i < 512; ++i) {
+		buf = data.ov_buf[0];
+		M0_UT_ASSERT(buf[i] == 2);
+		buf = data.ov_buf[1];
+		M0_UT_ASSERT(buf[i] == 3);
+		buf = data.ov_buf[2];
+		M0_UT_ASSERT(buf[i] == 4);
+	}
+
+	/* Group 0 is missing. */
+	INDEX(&ext, 0) = UT_GRP_SIZE - 1;
+	m0_mutex_lock(&rc.rc_lock);
+	M0_UT_ASSERT(!rcache_covers(&rc, &ut_id0, &ext, UT_GRP_SIZE));
+	M0_UT_ASSERT(!rcache_covers(&rc, &ut_id1, &ext, UT_GRP_SIZE));
+	m0_mutex_unlock(&rc.rc_lock);
+
+	m0_bufvec_free(&data);
+	m0_indexvec_free(&ext);
+	rcache_fini(&rc);
+}
+
+static void ut_test_rcache_invalidate(void)
+{
+	struct m0_read_cache rc;
+	struct m0_indexvec   ext;
+	uint64_t             gen;
+	int                  rc_init;
+	int                  i;
+
+	rc_init = rcache_init(&rc, 8 * UT_GRP_SIZE, 0);
+	M0_UT_ASSERT(rc_init == 0);
+	for (i = 0; i < 4; ++i) {
+		ut_group_add(&rc, &ut_id0, i);
+		ut_group_add(&rc, &ut_id1, i);
+	}
+	M0_UT_ASSERT(m0_indexvec_alloc(&ext, 1) == 0);
+
+	/* A small extent is dropped through hash lookups. */
+	INDEX(&ext, 0) = UT_GRP_SIZE + 1;
+	COUNT(&ext, 0) = 1;
+	gen = rc.rc_gen;
+	m0_mutex_lock(&rc.rc_lock);
+	rcache_drop(&rc, &ut_id0, &ext, UT_GRP_SIZE);
+	m0_mutex_unlock(&rc.rc_lock);
+	M0_UT_ASSERT(rc.rc_gen == gen + 1);
+	M0_UT_ASSERT(rc.rc_stats.rcs_invalidations == 1);
+	M0_UT_ASSERT(!ut_is_cached(&rc, &ut_id0, 1));
+	M0_UT_ASSERT(ut_is_cached(&rc, &ut_id0, 0));
+	M0_UT_ASSERT(ut_is_cached(&rc, &ut_id1, 1));
+
+	/* A large one by walking the cache. */
+	INDEX(&ext, 0) = UT_GRP_SIZE;
+	COUNT(&ext, 0) = 1000 * UT_GRP_SIZE;
+	m0_mutex_lock(&rc.rc_lock);
+	rcache_drop(&rc, &ut_id1, &ext, UT_GRP_SIZE);
+	m0_mutex_unlock(&rc.rc_lock);
+	M0_UT_ASSERT(rc.rc_stats.rcs_invalidations == 4);
+	M0_UT_ASSERT(ut_is_cached(&rc, &ut_id1, 0));
+	M0_UT_ASSERT(!ut_is_cached(&rc, &ut_id1, 3));
+
+	/* The whole object. */
+	m0_mutex_lock(&rc.rc_lock);
+	rcache_drop(&rc, &ut_id0, NULL, 0);
+	m0_mutex_unlock(&rc.rc_lock);
+	M0_UT_ASSERT(rc.rc_gen == gen + 3);
+	for (i = 0; i < 4; ++i)
+		M0_UT_ASSERT(!ut_is_cached(&rc, &ut_id0, i));
+	M0_UT_ASSERT(ut_is_cached(&rc, &ut_id1, 0));
+	M0_UT_ASSERT(rc.rc_size == UT_GRP_SIZE);
+
+	m0_indexvec_free(&ext);
+	rcache_fini(&rc);
+}
+
+static uint32_t ut_stream(struct m0_read_cache *rc, m0_bindex_t start,
+			  m0_bindex_t end, uint64_t *first)
+{
+	uint32_t nr;
+
+	m0_mutex_lock(&rc->rc_lock);
+	nr = rcache_stream_update(rc, &ut_id0, start, end, UT_GRP_SIZE,
+				  first);
+	m0_mutex_unlock(&rc->rc_lock);
+	return nr;
+}
+
+static void ut_test_rcache_readahead(void)
+{
+	struct m0_read_cache rc;
+	uint64_t             first;
+	int                  rc_init;
+
+	rc_init = rcache_init(&rc, 64 * UT_GRP_SIZE, 4);
+	M0_UT_ASSERT(rc_init == 0);
+
+	/* The first read only starts a stream. */
+	M0_UT_ASSERT(ut_stream(&rc, 0, UT_GRP_SIZE, &first) == 0);
+	/* Sequential reads open the window: 1, 2, 4, 4. */
+	M0_UT_ASSERT(ut_stream(&rc, UT_GRP_SIZE, 2 * UT_GRP_SIZE,
+			       &first) == 1);
+	M0_UT_ASSERT(first == 2);
+	M0_UT_ASSERT(ut_stream(&rc, 2 * UT_GRP_SIZE, 3 * UT_GRP_SIZE,
+			       &first) == 2);
+	M0_UT_ASSERT(first == 3);
+	/* Groups up to 5 were already requested. */
+	M0_UT_ASSERT(ut_stream(&rc, 3 * UT_GRP_SIZE, 4 * UT_GRP_SIZE,
+			       &first) == 3);
+	M0_UT_ASSERT(first == 5);
+	/* Cached groups are not read again. */
+	ut_group_add(&rc, &ut_id0, 8);
+	M0_UT_ASSERT(ut_stream(&rc, 4 * UT_GRP_SIZE, 5 * UT_GRP_SIZE,
+			       &first) == 0);
+	M0_UT_ASSERT(rc.rc_stats.rcs_ra_groups == 6);
+
+	/* A random read closes the window. */
+	M0_UT_ASSERT(ut_stream(&rc, 0, UT_GRP_SIZE, &first) == 0);
+	M0_UT_ASSERT(ut_stream(&rc, UT_GRP_SIZE, 2 * UT_GRP_SIZE,
+			       &first) == 1);
+	M0_UT_ASSERT(first == 2);
+
+	rcache_fini(&rc);
+
+	/* Readahead is disabled. */
+	rc_init = rcache_init(&rc, 64 * UT_GRP_SIZE, 0);
+	M0_UT_ASSERT(rc_init == 0);
+	M0_UT_ASSERT(ut_stream(&rc, 0, UT_GRP_SIZE, &first) == 0);
+	M0_UT_ASSERT(ut_stream(&rc, UT_GRP_SIZE, 2 * UT_GRP_SIZE,
+			       &first) == 0);
+	rcache_fini(&rc);
+}
+
+struct m0_ut_suite ut_suite_read_cache = {
+	.ts_name  = "client-read-cache-ut",
+	.ts_init  = NULL,
+	.ts_fini  = NULL,
+	.ts_tests = {
+		{ "lru",        ut_test_rcache_lru        },
+		{ "copy-out",   ut_test_rcache_copy_out   },
+		{ "invalidate", ut_test_rcache_invalidate },
+		{ "readahead",  ut_test_rcache_readahead  },
+		{ NULL, NULL }
+	}
+};
+
+/*
+ *  Local variables:
+ *  c-indentation-style: "K&R"
+ *  c-basic-offset: 8
+ *  tab-width: 8
+ *  fill-column: 80
+ *  scroll-step: 1
+ *  End:
+ */
+/*
+ * vim: tabstop=8 shiftwidth=8 noexpandtab textwidth=80 nowrap
+ */
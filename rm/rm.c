@@ -32,6 +32,7 @@
 #include "lib/trace.h"
 #include "lib/bob.h"
 #include "lib/finject.h" /* M0_FI_ENABLED */
+#include "lib/hash.h"    /* m0_hash */
 #include "fid/fid.h"
 #include "addb2/addb2.h"
 #include "motr/magic.h"
@@ -130,6 +131,11 @@ M0_TL_DESCR_DEFINE(res, "resources", , struct m0_rm_resource,
 		   M0_RM_RESOURCE_MAGIC, M0_RM_RESOURCE_HEAD_MAGIC);
 M0_TL_DEFINE(res, M0_INTERNAL, struct m0_rm_resource);
 
+M0_TL_DESCR_DEFINE(res_hash, "resource bucket", static, struct m0_rm_resource,
+		   r_hlinkage, r_magix,
+		   M0_RM_RESOURCE_MAGIC, M0_RM_RESOURCE_BUCKET_MAGIC);
+M0_TL_DEFINE(res_hash, static, struct m0_rm_resource);
+
 static struct m0_bob_type resource_bob;
 M0_BOB_DEFINE(M0_INTERNAL, &resource_bob, m0_rm_resource);
 
@@ -239,26 +245,53 @@ static const struct m0_rm_incoming_ops windup_incoming_ops = {
 	.rio_conflict = windup_incoming_conflict,
 };
 
+/**
+ * Returns the bucket of m0_rm_resource_type::rt_buckets the resource hashes to.
+ */
+static struct m0_tl *resource_bucket(const struct m0_rm_resource_type *rt,
+				     const struct m0_rm_resource      *res)
+{
+	uint64_t hash = rt->rt_ops->rto_hash == NULL ? 0 :
+			rt->rt_ops->rto_hash(res);
+
+	return &rt->rt_buckets[m0_hash(hash) % M0_RM_RESOURCE_BUCKET_NR];
+}
+
 M0_INTERNAL struct m0_rm_resource *
 m0_rm_resource_find(const struct m0_rm_resource_type *rt,
 		    const struct m0_rm_resource      *res)
 {
 	M0_PRE(rt->rt_ops->rto_eq != NULL);
 
-	return m0_tl_find(res, scan, &rt->rt_resources,
+	return m0_tl_find(res_hash, scan, resource_bucket(rt, res),
 			  rt->rt_ops->rto_eq(res, scan));
 }
 
+static void resource_buckets_fini(struct m0_rm_resource_type *rt)
+{
+	int i;
+
+	for (i = 0; i < M0_RM_RESOURCE_BUCKET_NR; ++i)
+		res_hash_tlist_fini(&rt->rt_buckets[i]);
+	m0_free0(&rt->rt_buckets);
+}
+
 M0_INTERNAL int m0_rm_type_register(struct m0_rm_domain        *dom,
 				    struct m0_rm_resource_type *rt)
 {
 	int rc;
+	int i;
 
 	M0_ENTRY("resource type: %s", rt->rt_name);
 	M0_PRE(rt->rt_dom == NULL);
 	M0_PRE(IS_IN_ARRAY(rt->rt_id, dom->rd_types));
 	M0_PRE(dom->rd_types[rt->rt_id] == NULL);
 
+	M0_ALLOC_ARR(rt->rt_buckets, M0_RM_RESOURCE_BUCKET_NR);
+	if (rt->rt_buckets == NULL)
+		return M0_ERR(-ENOMEM);
+	for (i = 0; i < M0_RM_RESOURCE_BUCKET_NR; ++i)
+		res_hash_tlist_init(&rt->rt_buckets[i]);
 	m0_mutex_init(&rt->rt_lock);
 	res_tlist_init(&rt->rt_resources);
 	rt->rt_nr_resources = 0;
@@ -269,8 +302,10 @@ M0_INTERNAL int m0_rm_type_register(struct m0_rm_domain        *dom,
 	rt->rt_stop_worker = false;
 	rc = M0_THREAD_INIT(&rt->rt_worker, struct m0_rm_resource_type *, NULL,
 			    &credit_processor, rt, "m0_rm_rt_agent");
-	if (rc != 0)
+	if (rc != 0) {
+		resource_buckets_fini(rt);
 		return M0_RC(rc);
+	}
 
 	m0_mutex_lock(&dom->rd_lock);
 	dom->rd_types[rt->rt_id] = rt;
@@ -316,6 +351,7 @@ M0_INTERNAL void m0_rm_type_deregister(struct m0_rm_resource_type *rt)
 
 	rt->rt_dom = NULL;
 	res_tlist_fini(&rt->rt_resources);
+	resource_buckets_fini(rt);
 	m0_mutex_fini(&rt->rt_lock);
 
 	M0_POST(rt->rt_dom == NULL);
@@ -345,12 +381,13 @@ M0_INTERNAL void m0_rm_resource_add(struct m0_rm_resource_type *rtype,
 	M0_PRE_EX(m0_rm_resource_find(rtype, res) == NULL);
 	res->r_type = rtype;
 	res_tlink_init_at(res, &rtype->rt_resources);
+	res_hash_tlink_init_at(res, resource_bucket(rtype, res));
 	m0_remotes_tlist_init(&res->r_remotes);
 	m0_mutex_init(&res->r_mutex);
 	m0_owners_tlist_init(&res->r_local);
 	m0_rm_resource_bob_init(res);
 	M0_CNT_INC(rtype->rt_nr_resources);
-	M0_POST(res_tlist_contains(&rtype->rt_resources, res));
+	M0_POST(res_hash_tlist_contains(resource_bucket(rtype, res), res));
 	M0_POST_EX(resource_type_invariant(rtype));
 	m0_mutex_unlock(&rtype->rt_lock);
 	M0_POST(res->r_type == rtype);
@@ -370,6 +407,7 @@ M0_INTERNAL void m0_rm_resource_del(struct m0_rm_resource *res)
 	M0_PRE(m0_owners_tlist_is_empty(&res->r_local));
 	M0_PRE_EX(resource_type_invariant(rtype));
 
+	res_hash_tlink_del_fini(res);
 	res_tlink_del_fini(res);
 	M0_CNT_DEC(rtype->rt_nr_resources);
 
@@ -2878,6 +2916,7 @@ static bool resource_type_invariant(const struct m0_rm_resource_type *rt)
 	const struct m0_tl  *rlist = &rt->rt_resources;
 
 	return
+		rt->rt_buckets != NULL &&
 		res_tlist_invariant_ext(rlist, resource_list_check,
 					(void *)rt) &&
 		rt->rt_nr_resources == res_tlist_length(rlist) &&
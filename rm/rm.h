@@ -232,6 +232,10 @@ struct m0_rm_lease;
 
 enum {
 	M0_RM_RESOURCE_TYPE_ID_MAX = 64,
+	/**
+	 * Number of hash buckets in m0_rm_resource_type::rt_buckets.
+	 */
+	M0_RM_RESOURCE_BUCKET_NR   = 1024,
 };
 
 /**
@@ -308,6 +312,10 @@ struct m0_rm_resource {
 	 * m0_rm_resource_type::rt_resources.
 	 */
 	struct m0_tlink                  r_linkage;
+	/**
+	 * Linkage to a hash bucket of m0_rm_resource_type::rt_buckets.
+	 */
+	struct m0_tlink                  r_hlinkage;
 	/**
 	 * List of remote owners (linked through m0_rm_remote::rem_res_linkage)
 	 * with which local owners of credits to this resource communicates.
@@ -407,6 +415,13 @@ struct m0_rm_resource_type {
 	 * m0_rm_resource_type::rt_lock.
 	 */
 	struct m0_tl			      rt_resources;
+	/**
+	 * The same resources hashed by m0_rm_resource_type_ops::rto_hash()
+	 * into M0_RM_RESOURCE_BUCKET_NR buckets, so that
+	 * m0_rm_resource_find() does not scan the whole rt_resources list.
+	 * Protected by m0_rm_resource_type::rt_lock.
+	 */
+	struct m0_tl			     *rt_buckets;
 	/**
 	 * Active references to this resource type from resource instances
 	 * (m0_rm_owner::ro_resource). Protected by
@@ -458,6 +473,14 @@ struct m0_rm_resource_type_ops {
 	 */
 	bool (*rto_is)(const struct m0_rm_resource *resource,
 		       uint64_t id);
+	/**
+	 * Returns a hash of the resource identifier. Resources equal according
+	 * to rto_eq() must have equal hashes.
+	 *
+	 * Optional. If NULL, all resources of the type land in the same bucket
+	 * and m0_rm_resource_find() degrades to a list scan.
+	 */
+	uint64_t (*rto_hash)(const struct m0_rm_resource *resource);
 	/**
 	 * Return the size of the resource data
 	 */
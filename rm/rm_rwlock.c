@@ -188,6 +188,7 @@
 /* Forward Declarations */
 static bool rwlockable_equal(const struct m0_rm_resource *resource0,
 			     const struct m0_rm_resource *resource1);
+static uint64_t rwlockable_hash(const struct m0_rm_resource *resource);
 static m0_bcount_t rwlockable_len(const struct m0_rm_resource *resource);
 static int rwlockable_encode(struct m0_bufvec_cursor     *cur,
 			     const struct m0_rm_resource *resource);
@@ -223,6 +224,7 @@ static void rwlock_cr_initial_capital(struct m0_rm_credit *self);
 
 const struct m0_rm_resource_type_ops rwlockable_type_ops = {
 	.rto_eq     = rwlockable_equal,
+	.rto_hash   = rwlockable_hash,
 	.rto_len    = rwlockable_len,
 	.rto_decode = rwlockable_decode,
 	.rto_encode = rwlockable_encode,
@@ -286,6 +288,11 @@ static bool rwlockable_equal(const struct m0_rm_resource *resource0,
 	return m0_fid_eq(lockable0->rwl_fid, lockable1->rwl_fid);
 }
 
+static uint64_t rwlockable_hash(const struct m0_rm_resource *resource)
+{
+	return m0_fid_hash(R_RW(resource)->rwl_fid);
+}
+
 static m0_bcount_t rwlockable_len(const struct m0_rm_resource *resource)
 {
 	struct m0_rw_lockable *lockable;
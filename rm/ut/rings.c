@@ -97,6 +97,11 @@ static bool rings_resources_are_equal(const struct m0_rm_resource *c0,
 	return c0 == c1;
 }
 
+static uint64_t rings_resource_hash(const struct m0_rm_resource *res)
+{
+	return container_of(res, struct m0_rings, rs_resource)->rs_id;
+}
+
 static bool rings_resource_is(const struct m0_rm_resource *res, uint64_t res_id)
 {
 	struct m0_rings *ring;
@@ -149,6 +154,7 @@ static int rings_resource_decode(struct m0_bufvec_cursor  *cur,
 const struct m0_rm_resource_type_ops rings_rtype_ops = {
 	.rto_eq     = rings_resources_are_equal,
 	.rto_is     = rings_resource_is,
+	.rto_hash   = rings_resource_hash,
 	.rto_len    = rings_resource_len,
 	.rto_encode = rings_resource_encode,
 	.rto_decode = rings_resource_decode
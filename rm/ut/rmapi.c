@@ -216,6 +216,124 @@ static void dom_api_test(void)
 	m0_rm_domain_fini(&rm_test_data.rd_dom);
 }
 
+enum {
+	RES_HASH_UT_NR = 1 << 12,
+	RES_HASH_UB_NR = 100000,
+};
+
+static struct m0_rm_domain        res_hash_dom;
+static struct m0_rm_resource_type res_hash_rt = {
+	.rt_name = "hashed rings",
+	.rt_id   = RINGS_RESOURCE_TYPE_ID,
+	.rt_ops  = &rings_rtype_ops,
+};
+static struct m0_rings           *res_hash_rings;
+
+static int res_hash_init(int nr)
+{
+	int i;
+	int rc;
+
+	M0_ALLOC_ARR(res_hash_rings, nr);
+	if (res_hash_rings == NULL)
+		return -ENOMEM;
+	for (i = 0; i < nr; ++i) {
+		res_hash_rings[i].rs_id = i;
+		res_hash_rings[i].rs_resource.r_ops = &rings_ops;
+	}
+	m0_rm_domain_init(&res_hash_dom);
+	rc = m0_rm_type_register(&res_hash_dom, &res_hash_rt);
+	if (rc != 0) {
+		m0_rm_domain_fini(&res_hash_dom);
+		m0_free0(&res_hash_rings);
+	}
+	return rc;
+}
+
+static void res_hash_fini(void)
+{
+	m0_rm_type_deregister(&res_hash_rt);
+	m0_rm_domain_fini(&res_hash_dom);
+	m0_free0(&res_hash_rings);
+}
+
+static void res_hash_add(int i)
+{
+	m0_rm_resource_add(&res_hash_rt, &res_hash_rings[i].rs_resource);
+}
+
+static void res_hash_find(int i)
+{
+	struct m0_rm_resource *res = &res_hash_rings[i].rs_resource;
+
+	m0_mutex_lock(&res_hash_rt.rt_lock);
+	M0_ASSERT(m0_rm_resource_find(&res_hash_rt, res) == res);
+	m0_mutex_unlock(&res_hash_rt.rt_lock);
+}
+
+static void res_hash_del(int i)
+{
+	m0_rm_resource_del(&res_hash_rings[i].rs_resource);
+}
+
+void rm_res_hash_test(void)
+{
+	struct m0_rings probe = { .rs_id = 1 };
+	int             rc;
+	int             i;
+
+	rc = res_hash_init(RES_HASH_UT_NR);
+	M0_UT_ASSERT(rc == 0);
+	for (i = 0; i < RES_HASH_UT_NR; ++i)
+		res_hash_add(i);
+	M0_UT_ASSERT(res_hash_rt.rt_nr_resources == RES_HASH_UT_NR);
+	for (i = 0; i < RES_HASH_UT_NR; ++i)
+		res_hash_find(i);
+	/*
+	 * Rings are equal only to themselves: a probe hashing to the bucket of
+	 * an existing resource must not be found.
+	 */
+	m0_mutex_lock(&res_hash_rt.rt_lock);
+	M0_UT_ASSERT(m0_rm_resource_find(&res_hash_rt,
+					 &probe.rs_resource) == NULL);
+	m0_mutex_unlock(&res_hash_rt.rt_lock);
+	/* Delete every other resource and check the rest are still found. */
+	for (i = 0; i < RES_HASH_UT_NR; i += 2)
+		res_hash_del(i);
+	for (i = 1; i < RES_HASH_UT_NR; i += 2)
+		res_hash_find(i);
+	for (i = 1; i < RES_HASH_UT_NR; i += 2)
+		res_hash_del(i);
+	M0_UT_ASSERT(res_hash_rt.rt_nr_resources == 0);
+	res_hash_fini();
+}
+
+static int res_hash_ub_init(const char *opts M0_UNUSED)
+{
+	return res_hash_init(RES_HASH_UB_NR);
+}
+
+struct m0_ub_set m0_rm_ub = {
+	.us_name = "rm-ub",
+	.us_init = res_hash_ub_init,
+	.us_fini = res_hash_fini,
+	.us_run  = {
+		{ .ub_name  = "res-add",
+		  .ub_iter  = RES_HASH_UB_NR,
+		  .ub_round = res_hash_add },
+
+		{ .ub_name  = "res-find",
+		  .ub_iter  = RES_HASH_UB_NR,
+		  .ub_round = res_hash_find },
+
+		{ .ub_name  = "res-del",
+		  .ub_iter  = RES_HASH_UB_NR,
+		  .ub_round = res_hash_del },
+
+		{ .ub_name = NULL }
+	}
+};
+
 void rm_api_test(void)
 {
 	/* Test domain APIs */
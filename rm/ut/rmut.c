@@ -56,6 +56,7 @@ struct m0_chan    rm_ut_tests_chan;
 struct m0_mutex   rm_ut_tests_chan_mutex;
 
 extern void rm_api_test(void);
+extern void rm_res_hash_test(void);
 extern void local_credits_test(void);
 extern void rm_fom_funcs_test(void);
 extern void rm_fop_funcs_test(void);
@@ -459,6 +460,7 @@ struct m0_ut_suite rm_ut = {
 	.ts_name = "rm-ut",
 	.ts_tests = {
 		{ "api", rm_api_test },
+		{ "res-hash", rm_res_hash_test },
 		{ "lcredits", local_credits_test },
 		{ "fop-funcs", rm_fop_funcs_test },
 #ifndef __KERNEL__
@@ -36,6 +36,7 @@
 #include "addb2/addb2.h"
 #include "rpc/addb2.h"
 #include "rpc/rpc_internal.h"
+#include "rpc/rpc_opcodes.h"    /* M0_OPCODES_NR */
 #include "rpc/rpc_opcodes_xc.h" /* m0_xc_M0_RPC_OPCODES_enum */
 #include "motr/iem.h"
 
@@ -87,6 +88,17 @@ M0_TL_DEFINE(xidl, M0_INTERNAL, struct m0_rpc_item);
 /** Global rpc item types list. */
 static struct m0_tl        rpc_item_types_list;
 static struct m0_rwlock    rpc_item_types_lock;
+/**
+ * Item types indexed by opcode.
+ *
+ * Used by m0_rpc_item_type_lookup() on the receive path without taking
+ * rpc_item_types_lock. The table is only modified under the write lock by
+ * m0_rpc_item_type_{,de}register(), which are called while modules are
+ * initialised or finalised, i.e. when the table is not being read by
+ * rpc machines. An entry is published after the item type is fully set up,
+ * so a reader dereferencing it sees the initialised structure.
+ */
+static struct m0_rpc_item_type *rpc_item_types_tab[M0_OPCODES_NR];
 
 /**
   Checks if the supplied opcode has already been registered.
@@ -142,6 +154,7 @@ M0_INTERNAL void m0_rpc_item_module_fini(void)
 
 	m0_rwlock_write_lock(&rpc_item_types_lock);
 	m0_tl_for(rit, &rpc_item_types_list, item_type) {
+		rpc_item_types_tab[item_type->rit_opcode] = NULL;
 		rit_tlink_del_fini(item_type);
 	} m0_tl_endfor;
 	rit_tlist_fini(&rpc_item_types_list);
@@ -159,6 +172,7 @@ M0_INTERNAL void m0_rpc_item_type_register(struct m0_rpc_item_type *item_type)
 	M0_PRE(item_type != NULL);
 	dir_flag = item_type->rit_flags & (M0_RPC_ITEM_TYPE_REQUEST |
 		   M0_RPC_ITEM_TYPE_REPLY | M0_RPC_ITEM_TYPE_ONEWAY);
+	M0_PRE(item_type->rit_opcode < M0_OPCODES_NR);
 	M0_PRE(!opcode_is_dup(item_type->rit_opcode));
 	M0_PRE(m0_is_po2(dir_flag));
 	M0_PRE(ergo(item_type->rit_flags & M0_RPC_ITEM_TYPE_MUTABO,
@@ -168,6 +182,7 @@ M0_INTERNAL void m0_rpc_item_type_register(struct m0_rpc_item_type *item_type)
 	item_type->rit_incoming_conf = incoming_item_sm_conf;
 	m0_rwlock_write_lock(&rpc_item_types_lock);
 	rit_tlink_init_at(item_type, &rpc_item_types_list);
+	rpc_item_types_tab[item_type->rit_opcode] = item_type;
 	m0_rwlock_write_unlock(&rpc_item_types_lock);
 
 	M0_LEAVE();
@@ -179,6 +194,8 @@ M0_INTERNAL void m0_rpc_item_type_deregister(struct m0_rpc_item_type *item_type)
 	M0_PRE(item_type != NULL);
 
 	m0_rwlock_write_lock(&rpc_item_types_lock);
+	M0_ASSERT(rpc_item_types_tab[item_type->rit_opcode] == item_type);
+	rpc_item_types_tab[item_type->rit_opcode] = NULL;
 	rit_tlink_del_fini(item_type);
 	item_type->rit_magic = 0;
 	m0_rwlock_write_unlock(&rpc_item_types_lock);
@@ -190,15 +207,10 @@ M0_INTERNAL struct m0_rpc_item_type *m0_rpc_item_type_lookup(uint32_t opcode)
 {
 	struct m0_rpc_item_type *item_type;
 
-	M0_ENTRY("opcode: %u", opcode);
-
-	m0_rwlock_read_lock(&rpc_item_types_lock);
-	item_type = m0_tl_find(rit, item_type, &rpc_item_types_list,
-			       item_type->rit_opcode == opcode);
-	m0_rwlock_read_unlock(&rpc_item_types_lock);
-
+	/* opcode comes from the wire, check it before indexing. */
+	item_type = opcode < ARRAY_SIZE(rpc_item_types_tab) ?
+		    rpc_item_types_tab[opcode] : NULL;
 	M0_POST(ergo(item_type != NULL, item_type->rit_opcode == opcode));
-	M0_LEAVE("item_type: %p", item_type);
 	return item_type;
 }
 
@@ -503,6 +503,8 @@ M0_INTERNAL void m0_rpc_item_type_deregister(struct m0_rpc_item_type
 
 /** Returns a pointer to rpc item type registered for an opcode
 
+  Constant time and lock-free, safe to call on the receive path.
+
   @param opcode Unique operation code for the rpc item type to be looked up.
   @retval Pointer to the rpc item type for that opcode.
   @retval NULL if the item type is not registered.
@@ -155,6 +155,15 @@ struct m0_rpc_machine {
 	 * @see m0_rpc_at_buf
 	 */
 	m0_bcount_t                       rm_bulk_cutoff;
+
+	/**
+	 * True iff foms of types with m0_fom_type::ft_numa_steered for requests
+	 * received by this machine are queued to localities of the NUMA node
+	 * of the receiving rpc thread. False by default.
+	 *
+	 * @see m0_fom_domain_node_locality()
+	 */
+	bool                              rm_numa_steer;
 };
 
 /**
@@ -1289,6 +1289,18 @@ static void test_ha_notify()
 	m0_rconfc_fini(cl_rconfc);
 }
 
+static void test_item_type_lookup(void)
+{
+	struct m0_rpc_item_type *itype = &m0_rpc_arrow_fopt.ft_rpc_item_type;
+
+	M0_UT_ASSERT(m0_rpc_item_type_lookup(itype->rit_opcode) == itype);
+	M0_UT_ASSERT(m0_fop_type_find(itype->rit_opcode) ==
+		     &m0_rpc_arrow_fopt);
+	M0_UT_ASSERT(m0_rpc_item_type_lookup(M0_OPCODES_NR) == NULL);
+	M0_UT_ASSERT(m0_rpc_item_type_lookup(UINT32_MAX) == NULL);
+	M0_UT_ASSERT(m0_fop_type_find(UINT32_MAX) == NULL);
+}
+
 struct m0_ut_suite item_ut = {
 	.ts_name = "rpc-item-ut",
 	.ts_init = ts_item_init,
@@ -1305,6 +1317,7 @@ struct m0_ut_suite item_ut = {
 		{ "ha-cancel",              test_ha_cancel              },
 		{ "cancel-session",         test_cancel_session         },
 		{ "ha-notify",              test_ha_notify              },
+		{ "type-lookup",            test_item_type_lookup       },
 		{ NULL, NULL },
 	}
 };
@@ -198,11 +198,6 @@ enum {
 };
 
 /* m0_parity_* are to much eclectic. just more simple names. */
-static int gadd(int x, int y)
-{
-	return m0_parity_add(x, y);
-}
-
 static int gsub(int x, int y)
 {
 	return m0_parity_sub(x, y);
@@ -395,9 +390,7 @@ static void reed_solomon_diff(struct m0_parity_math *math,
 			      uint32_t               index)
 {
 	struct m0_matrix *mat;
-	uint32_t          ei;
 	uint32_t          ui;
-	uint8_t		  diff_data;
 	m0_parity_elem_t  mat_elem;
 
 	M0_PRE(math   != NULL);
@@ -411,13 +404,10 @@ static void reed_solomon_diff(struct m0_parity_math *math,
 
 	mat = &math->pmi_vandmat_parity_slice;
 	for (ui = 0; ui < math->pmi_parity_count; ++ui) {
-		for (ei = 0; ei < new[index].b_nob; ++ei) {
-			mat_elem = *m0_matrix_elem_get(mat, index, ui);
-			diff_data = ((uint8_t *)old[index].b_addr)[ei] ^
-				    ((uint8_t *)new[index].b_addr)[ei];
-			((uint8_t*)parity[ui].b_addr)[ei] ^=
-				gmul(diff_data, mat_elem);
-		}
+		mat_elem = *m0_matrix_elem_get(mat, index, ui);
+		m0_parity_region_mac2(parity[ui].b_addr, old[index].b_addr,
+				      new[index].b_addr, new[index].b_nob,
+				      mat_elem);
 	}
 }
 
@@ -448,11 +438,6 @@ static void reed_solomon_encode(struct m0_parity_math *math,
 				const struct m0_buf *data,
 				struct m0_buf *parity)
 {
-#define PARITY_MATH_REGION_ENABLE 0
-
-#if !PARITY_MATH_REGION_ENABLE
-	uint32_t	  ei; /* block element index. */
-#endif
 	uint32_t	  pi; /* parity unit index. */
 	uint32_t	  di; /* data unit index. */
 	m0_parity_elem_t  mat_elem;
@@ -466,39 +451,16 @@ static void reed_solomon_encode(struct m0_parity_math *math,
 		M0_ASSERT(block_size == parity[pi].b_nob);
 
 	for (pi = 0; pi < math->pmi_parity_count; ++pi) {
+		memset(parity[pi].b_addr, M0_PARITY_ZERO, block_size);
 		for (di = 0; di < math->pmi_data_count; ++di) {
 			mat_elem =
 			*m0_matrix_elem_get(&math->pmi_vandmat_parity_slice,
 					    di, pi);
-			if (mat_elem == 0)
-				continue;
-#if !PARITY_MATH_REGION_ENABLE
-			for (ei = 0; ei < block_size; ++ei) {
-				if (di == 0)
-					((uint8_t*)parity[pi].b_addr)[ei] =
-						M0_PARITY_ZERO;
-
-				((uint8_t*)parity[pi].b_addr)[ei] =
-					gadd(((uint8_t*)parity[pi].b_addr)[ei],
-					     gmul(mat_elem,
-						  ((uint8_t*)data[di].b_addr)
-						  [ei]));
-			}
-#else
-			if (di == 0)
-				memset((uint8_t*)parity[pi].b_addr,
-				       M0_PARITY_ZERO, block_size);
-
-			m0_parity_region_mac(
-				(m0_parity_elem_t*) parity[pi].b_addr,
-				(const m0_parity_elem_t*) data[di].b_addr,
-				block_size,
-				mat_elem);
-#endif
+			m0_parity_region_mac(parity[pi].b_addr,
+					     data[di].b_addr, block_size,
+					     mat_elem);
 		}
 	}
-
-#undef PARITY_MATH_REGION_ENABLE
 }
 
 M0_INTERNAL void m0_parity_math_calculate(struct m0_parity_math *math,
@@ -670,6 +632,43 @@ static void xor_recover(struct m0_parity_math *math,
         }
 }
 
+/**
+ * Recovers lost data units a whole unit at a time, using the inverse matrix
+ * prepared by m0_parity_recov_mat_gen(): a lost unit is the linear
+ * combination of the alive units selected by recovery_mat_fill(), with the
+ * coefficients taken from its row of the inverse.
+ */
+static void reed_solomon_recover_inverse(struct m0_parity_math *math,
+					 struct m0_buf *data,
+					 struct m0_buf *parity,
+					 uint8_t *fail)
+{
+	const struct m0_matrix *mat = &math->pmi_recov_mat;
+	uint32_t                unit_count;
+	uint32_t                block_size = data[0].b_nob;
+	uint32_t                ui; /* unit index. */
+	uint32_t                f;  /* alive unit index. */
+	uint32_t                x;  /* column of the inverse matrix. */
+	const struct m0_buf    *alive;
+
+	unit_count = math->pmi_data_count + math->pmi_parity_count;
+	for (ui = 0; ui < math->pmi_data_count; ++ui) {
+		if (fail[ui] == 0)
+			continue;
+		memset(data[ui].b_addr, M0_PARITY_ZERO, block_size);
+		for (f = 0, x = 0; f < unit_count && x < mat->m_width; ++f) {
+			if (fail[f])
+				continue;
+			alive = f < math->pmi_data_count ? &data[f] :
+				&parity[f - math->pmi_data_count];
+			m0_parity_region_mac(data[ui].b_addr, alive->b_addr,
+					     block_size,
+					     *m0_matrix_elem_get(mat, x, ui));
+			++x;
+		}
+	}
+}
+
 static void reed_solomon_recover(struct m0_parity_math *math,
 				 struct m0_buf *data,
 				 struct m0_buf *parity,
@@ -695,6 +694,11 @@ static void reed_solomon_recover(struct m0_parity_math *math,
 	for (ui = 0; ui < math->pmi_parity_count; ++ui)
 		M0_ASSERT(block_size == parity[ui].b_nob);
 
+	if (algo == M0_LA_INVERSE) {
+		reed_solomon_recover_inverse(math, data, parity, fail);
+		return;
+	}
+
 	for (ei = 0; ei < block_size; ++ei) {
 		struct m0_matvec *recovered = &math->pmi_sys_res;
 
@@ -1090,7 +1094,6 @@ static void incr_recover(struct m0_sns_ir_block *failed_block,
 static void gfaxpy(struct m0_bufvec *y, struct m0_bufvec *x,
 		   m0_parity_elem_t alpha)
 {
-	uint32_t		i;
 	uint32_t		seg_size;
 	uint8_t		       *y_addr;
 	uint8_t		       *x_addr;
@@ -1111,23 +1114,7 @@ static void gfaxpy(struct m0_bufvec *y, struct m0_bufvec *x,
 	do {
 		x_addr  = m0_bufvec_cursor_addr(&x_cursor);
 		y_addr  = m0_bufvec_cursor_addr(&y_cursor);
-
-		switch (alpha) {
-		/* This is a special case of the 'default' case that follows.
-		 * Here we avoid unnecessary call to gmul.*/
-		case 1:
-			for (i = 0; i <seg_size; ++i) {
-				y_addr[i] = gadd(y_addr[i],
-						 x_addr[i]);
-			}
-			break;
-		default:
-			for (i = 0; i < seg_size; ++i) {
-				y_addr[i] = gadd(y_addr[i], gmul(x_addr[i],
-							         alpha));
-			}
-			break;
-		}
+		m0_parity_region_mac(y_addr, x_addr, seg_size, alpha);
 		step = m0_bufvec_cursor_step(&y_cursor);
 	} while (!m0_bufvec_cursor_move(&x_cursor, step) &&
 		 !m0_bufvec_cursor_move(&y_cursor, step));
@@ -25,8 +25,219 @@
 #include "lib/misc.h"
 #include "lib/memory.h"
 #include "lib/assert.h"
+#include "lib/errno.h"
 #include "sns/parity_ops.h"
 
+#if !defined(__KERNEL__) && defined(__GNUC__) && \
+	(defined(__x86_64__) || defined(__i386__))
+#define PARITY_SIMD_X86 (1)
+#include <immintrin.h>
+#endif
+
+/**
+ * @defgroup parity_simd GF(2^8) region kernels
+ *
+ * The product c * x of a constant c and a byte x is split by the nibbles of
+ * x: c * x = c * (x & 0xf) ^ c * (x & 0xf0). For every c both halves take
+ * only 16 values, so they are precomputed (parity_tab[c]) and looked up with
+ * a byte shuffle (pshufb and its AVX2 and AVX-512 counterparts), processing
+ * 16, 32 or 64 bytes per instruction.
+ *
+ * The kernel is selected at run time by m0_parity_init(), depending on the
+ * instruction sets supported by the CPU. The kernels are compiled with
+ * per-function target attributes, so the rest of motr does not have to be
+ * built for the newest CPU. Kernel builds use the portable loop, because
+ * vector registers are not available there without kernel_fpu_begin().
+ *
+ * @{
+ */
+
+enum {
+	/** Low and high nibble tables of a constant. */
+	PARITY_TAB_SIZE = 32
+};
+
+/**
+ * Processes a prefix of the region using vector instructions and returns
+ * its length. src1 is optional.
+ */
+typedef m0_bcount_t (*parity_kernel_t)(uint8_t *dst, const uint8_t *src0,
+				       const uint8_t *src1, m0_bcount_t nob,
+				       const uint8_t *tab);
+
+static uint8_t             parity_tab[1 << M0_PARITY_GALOIS_W]
+				     [PARITY_TAB_SIZE];
+static enum m0_parity_simd parity_simd = M0_PARITY_SIMD_NONE;
+static parity_kernel_t     parity_kernel = NULL;
+
+#ifdef PARITY_SIMD_X86
+
+__attribute__((target("ssse3")))
+static m0_bcount_t parity_kernel_ssse3(uint8_t *dst, const uint8_t *src0,
+				       const uint8_t *src1, m0_bcount_t nob,
+				       const uint8_t *tab)
+{
+	__m128i     lo   = _mm_loadu_si128((const __m128i *)tab);
+	__m128i     hi   = _mm_loadu_si128((const __m128i *)(tab + 16));
+	__m128i     mask = _mm_set1_epi8(0x0f);
+	__m128i     x;
+	__m128i     p;
+	m0_bcount_t i;
+
+	for (i = 0; i + sizeof x <= nob; i += sizeof x) {
+		x = _mm_loadu_si128((const __m128i *)(src0 + i));
+		if (src1 != NULL)
+			x = _mm_xor_si128(x, _mm_loadu_si128(
+						  (const __m128i *)(src1 + i)));
+		p = _mm_xor_si128(
+			_mm_shuffle_epi8(lo, _mm_and_si128(x, mask)),
+			_mm_shuffle_epi8(hi, _mm_and_si128(
+						 _mm_srli_epi64(x, 4), mask)));
+		p = _mm_xor_si128(p, _mm_loadu_si128((__m128i *)(dst + i)));
+		_mm_storeu_si128((__m128i *)(dst + i), p);
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+static m0_bcount_t parity_kernel_avx2(uint8_t *dst, const uint8_t *src0,
+				      const uint8_t *src1, m0_bcount_t nob,
+				      const uint8_t *tab)
+{
+	__m256i     lo   = _mm256_broadcastsi128_si256(
+				_mm_loadu_si128((const __m128i *)tab));
+	__m256i     hi   = _mm256_broadcastsi128_si256(
+				_mm_loadu_si128((const __m128i *)(tab + 16)));
+	__m256i     mask = _mm256_set1_epi8(0x0f);
+	__m256i     x;
+	__m256i     p;
+	m0_bcount_t i;
+
+	for (i = 0; i + sizeof x <= nob; i += sizeof x) {
+		x = _mm256_loadu_si256((const __m256i *)(src0 + i));
+		if (src1 != NULL)
+			x = _mm256_xor_si256(x, _mm256_loadu_si256(
+						  (const __m256i *)(src1 + i)));
+		p = _mm256_xor_si256(
+			_mm256_shuffle_epi8(lo, _mm256_and_si256(x, mask)),
+			_mm256_shuffle_epi8(hi, _mm256_and_si256(
+					     _mm256_srli_epi64(x, 4), mask)));
+		p = _mm256_xor_si256(p, _mm256_loadu_si256(
+					     (__m256i *)(dst + i)));
+		_mm256_storeu_si256((__m256i *)(dst + i), p);
+	}
+	return i;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static m0_bcount_t parity_kernel_avx512(uint8_t *dst, const uint8_t *src0,
+					const uint8_t *src1, m0_bcount_t nob,
+					const uint8_t *tab)
+{
+	__m512i     lo   = _mm512_broadcast_i32x4(
+				_mm_loadu_si128((const __m128i *)tab));
+	__m512i     hi   = _mm512_broadcast_i32x4(
+				_mm_loadu_si128((const __m128i *)(tab + 16)));
+	__m512i     mask = _mm512_set1_epi8(0x0f);
+	__m512i     x;
+	__m512i     p;
+	m0_bcount_t i;
+
+	for (i = 0; i + sizeof x <= nob; i += sizeof x) {
+		x = _mm512_loadu_si512(src0 + i);
+		if (src1 != NULL)
+			x = _mm512_xor_si512(x, _mm512_loadu_si512(src1 + i));
+		p = _mm512_xor_si512(
+			_mm512_shuffle_epi8(lo, _mm512_and_si512(x, mask)),
+			_mm512_shuffle_epi8(hi, _mm512_and_si512(
+					     _mm512_srli_epi64(x, 4), mask)));
+		p = _mm512_xor_si512(p, _mm512_loadu_si512(dst + i));
+		_mm512_storeu_si512(dst + i, p);
+	}
+	return i;
+}
+
+#endif /* PARITY_SIMD_X86 */
+
+static bool parity_simd_supported(enum m0_parity_simd simd)
+{
+#ifdef PARITY_SIMD_X86
+	__builtin_cpu_init();
+#endif
+	switch (simd) {
+	case M0_PARITY_SIMD_NONE:
+		return true;
+#ifdef PARITY_SIMD_X86
+	case M0_PARITY_SIMD_SSSE3:
+		return __builtin_cpu_supports("ssse3");
+	case M0_PARITY_SIMD_AVX2:
+		return __builtin_cpu_supports("avx2");
+	case M0_PARITY_SIMD_AVX512:
+		return __builtin_cpu_supports("avx512f") &&
+		       __builtin_cpu_supports("avx512bw");
+#endif
+	default:
+		return false;
+	}
+}
+
+M0_INTERNAL int m0_parity_simd_set(enum m0_parity_simd simd)
+{
+	static const parity_kernel_t kernels[M0_PARITY_SIMD_NR] = {
+#ifdef PARITY_SIMD_X86
+		[M0_PARITY_SIMD_SSSE3]  = &parity_kernel_ssse3,
+		[M0_PARITY_SIMD_AVX2]   = &parity_kernel_avx2,
+		[M0_PARITY_SIMD_AVX512] = &parity_kernel_avx512,
+#endif
+	};
+
+	M0_PRE(simd < M0_PARITY_SIMD_NR);
+	if (!parity_simd_supported(simd))
+		return M0_ERR(-ENOTSUP);
+	parity_simd   = simd;
+	parity_kernel = kernels[simd];
+	return 0;
+}
+
+M0_INTERNAL enum m0_parity_simd m0_parity_simd_get(void)
+{
+	return parity_simd;
+}
+
+static void parity_region(uint8_t *dst, const uint8_t *src0,
+			  const uint8_t *src1, m0_bcount_t nob,
+			  m0_parity_elem_t c)
+{
+	const uint8_t *tab = parity_tab[c];
+	m0_bcount_t    i   = 0;
+	uint8_t        x;
+
+	M0_PRE(c >= 0 && c < ARRAY_SIZE(parity_tab));
+	if (c == 0)
+		return;
+	if (parity_kernel != NULL)
+		i = parity_kernel(dst, src0, src1, nob, tab);
+	for (; i < nob; ++i) {
+		x = src0[i] ^ (src1 != NULL ? src1[i] : 0);
+		dst[i] ^= tab[x & 0x0f] ^ tab[16 + (x >> 4)];
+	}
+}
+
+M0_INTERNAL void m0_parity_region_mac(uint8_t *dst, const uint8_t *src,
+				      m0_bcount_t nob, m0_parity_elem_t c)
+{
+	parity_region(dst, src, NULL, nob, c);
+}
+
+M0_INTERNAL void m0_parity_region_mac2(uint8_t *dst, const uint8_t *src0,
+				       const uint8_t *src1, m0_bcount_t nob,
+				       m0_parity_elem_t c)
+{
+	parity_region(dst, src0, src1, nob, c);
+}
+
+/** @} end of parity_simd group */
+
 M0_INTERNAL void m0_parity_fini(void)
 {
 #if defined(__KERNEL__)  || !defined(HAVE_ISAL)
@@ -36,10 +247,26 @@ M0_INTERNAL void m0_parity_fini(void)
 
 M0_INTERNAL int m0_parity_init(void)
 {
+	int c;
+	int x;
+	int simd;
+
 #if defined(__KERNEL__)  || !defined(HAVE_ISAL)
 	int ret = galois_create_mult_tables(M0_PARITY_GALOIS_W);
 	M0_ASSERT(ret == 0);
 #endif /* __KERNEL__ || !HAVE_ISAL */
+	for (c = 0; c < ARRAY_SIZE(parity_tab); ++c) {
+		for (x = 0; x < 16; ++x) {
+			parity_tab[c][x]      = m0_parity_mul(c, x);
+			parity_tab[c][16 + x] = m0_parity_mul(c, x << 4);
+		}
+	}
+	for (simd = M0_PARITY_SIMD_NR - 1; simd > M0_PARITY_SIMD_NONE; --simd) {
+		if (parity_simd_supported(simd))
+			break;
+	}
+	m0_parity_simd_set(simd);
+	M0_LOG(M0_DEBUG, "parity simd: %i", simd);
 	return 0;
 }
 
@@ -31,15 +31,60 @@
 #include "galois/galois.h"
 #endif /* !__KERNEL__ && HAVE_ISAL */
 #include "lib/assert.h"
+#include "lib/types.h"
 
 #define M0_PARITY_ZERO (0)
 #define M0_PARITY_GALOIS_W (8)
 
 typedef int m0_parity_elem_t;
 
+/**
+ * Vector instruction sets used by the region kernels below, in order of
+ * preference. All of them implement GF(2^8) multiplication as two 16-entry
+ * table lookups (low and high nibble of the source byte) done by a byte
+ * shuffle instruction.
+ */
+enum m0_parity_simd {
+	/** Portable nibble-table loop, always available. */
+	M0_PARITY_SIMD_NONE,
+	M0_PARITY_SIMD_SSSE3,
+	M0_PARITY_SIMD_AVX2,
+	M0_PARITY_SIMD_AVX512,
+	M0_PARITY_SIMD_NR
+};
+
 M0_INTERNAL int m0_parity_init(void);
 M0_INTERNAL void m0_parity_fini(void);
 
+/**
+ * Region multiply-accumulate: dst[i] ^= c * src[i] for 0 <= i < nob.
+ *
+ * This is the building block of Reed-Solomon encode, recovery and
+ * incremental recovery.
+ */
+M0_INTERNAL void m0_parity_region_mac(uint8_t *dst, const uint8_t *src,
+				      m0_bcount_t nob, m0_parity_elem_t c);
+
+/**
+ * Same as m0_parity_region_mac(), for the difference of two regions:
+ * dst[i] ^= c * (src0[i] ^ src1[i]). Used to update parity on overwrite.
+ */
+M0_INTERNAL void m0_parity_region_mac2(uint8_t *dst, const uint8_t *src0,
+				       const uint8_t *src1, m0_bcount_t nob,
+				       m0_parity_elem_t c);
+
+/** Returns the instruction set used by the region kernels. */
+M0_INTERNAL enum m0_parity_simd m0_parity_simd_get(void);
+
+/**
+ * Forces the region kernels to use the given instruction set.
+ *
+ * m0_parity_init() selects the best one supported by the CPU, this is for
+ * testing and benchmarking. Returns -ENOTSUP if the CPU (or the build) does
+ * not support @simd.
+ */
+M0_INTERNAL int m0_parity_simd_set(enum m0_parity_simd simd);
+
 M0_INTERNAL m0_parity_elem_t m0_parity_pow(m0_parity_elem_t x,
 					   m0_parity_elem_t p);
 
@@ -28,6 +28,7 @@
 #include "lib/ub.h"
 #include "ut/ut.h"
 #include "sns/parity_math.h"
+#include "sns/parity_ops.h"
 
 enum {
 	MAX_NUM_ROWS = 20,
@@ -447,6 +448,91 @@ static void test_parity_math_diff_rs(void)
 	}
 }
 
+static void test_region_mac(void)
+{
+	enum m0_parity_simd saved = m0_parity_simd_get();
+	int                 simd;
+	uint32_t            c;
+	uint32_t            nob;
+	uint32_t            i;
+	uint8_t            *src0 = data[0] + 1;
+	uint8_t            *src1 = data[1] + 3;
+	uint8_t            *dst  = parity[0] + 5;
+	uint8_t            *ref  = expected[0] + 5;
+
+	for (simd = 0; simd < M0_PARITY_SIMD_NR; ++simd) {
+		if (m0_parity_simd_set(simd) != 0)
+			continue;
+		for (c = 0; c < 256; c += 17) {
+			/* Cover full vectors and all tail lengths. */
+			for (nob = 0; nob < 300; nob += 7) {
+				for (i = 0; i < nob; ++i) {
+					src0[i] = m0_rnd64(&seed);
+					src1[i] = m0_rnd64(&seed);
+					dst[i]  = ref[i] = m0_rnd64(&seed);
+				}
+				m0_parity_region_mac(dst, src0, nob, c);
+				for (i = 0; i < nob; ++i)
+					ref[i] ^= m0_parity_mul(c, src0[i]);
+				M0_UT_ASSERT(memcmp(dst, ref, nob) == 0);
+				m0_parity_region_mac2(dst, src0, src1, nob, c);
+				for (i = 0; i < nob; ++i)
+					ref[i] ^= m0_parity_mul(c, src0[i] ^
+								src1[i]);
+				M0_UT_ASSERT(memcmp(dst, ref, nob) == 0);
+			}
+		}
+	}
+	M0_UT_ASSERT(m0_parity_simd_set(saved) == 0);
+}
+
+static void test_rs_inverse_recover(void)
+{
+	enum m0_parity_simd   saved = m0_parity_simd_get();
+	int                   simd;
+	uint32_t              i;
+	uint32_t              j;
+	uint32_t              buff_size = 4096 + 13;
+	struct m0_buf         data_buf[DATA_UNIT_COUNT];
+	struct m0_buf         parity_buf[RS_MAX_PARITY_UNIT_COUNT];
+	struct m0_buf         fail_buf;
+	struct m0_parity_math math;
+	int                   rc;
+
+	M0_CASSERT(4 <= RS_MAX_PARITY_UNIT_COUNT);
+	for (simd = 0; simd < M0_PARITY_SIMD_NR; ++simd) {
+		if (m0_parity_simd_set(simd) != 0)
+			continue;
+		rc = m0_parity_math_init(&math, DATA_UNIT_COUNT, 4);
+		M0_UT_ASSERT(rc == 0);
+		for (i = 0; i < DATA_UNIT_COUNT; ++i) {
+			m0_buf_init(&data_buf[i], data[i], buff_size);
+			for (j = 0; j < buff_size; ++j)
+				data[i][j] = m0_rnd64(&seed);
+			memcpy(expected[i], data[i], buff_size);
+		}
+		for (i = 0; i < 4; ++i)
+			m0_buf_init(&parity_buf[i], parity[i], buff_size);
+		m0_parity_math_calculate(&math, data_buf, parity_buf);
+
+		/* Lose three data units and one parity unit. */
+		memset(fail, 0, DATA_UNIT_COUNT + 4);
+		fail[0] = fail[7] = fail[DATA_UNIT_COUNT - 1] = 1;
+		fail[DATA_UNIT_COUNT + 1] = 1;
+		m0_buf_init(&fail_buf, fail, DATA_UNIT_COUNT + 4);
+		unit_spoil(buff_size, DATA_UNIT_COUNT + 4, DATA_UNIT_COUNT);
+
+		rc = m0_parity_recov_mat_gen(&math, fail);
+		M0_UT_ASSERT(rc == 0);
+		m0_parity_math_recover(&math, data_buf, parity_buf, &fail_buf,
+				       M0_LA_INVERSE);
+		m0_parity_recov_mat_destroy(&math);
+		m0_parity_math_fini(&math);
+		M0_UT_ASSERT(expected_eq(DATA_UNIT_COUNT, buff_size));
+	}
+	M0_UT_ASSERT(m0_parity_simd_set(saved) == 0);
+}
+
 static void test_incr_recov_rs(void)
 {
 	test_matrix_inverse();
@@ -1291,6 +1377,8 @@ static inline uint32_t block_nr(const struct m0_sns_ir *ir)
 
 #define _TESTS								\
 	{ "reed_solomon_recover_with_fail_vec", test_rs_fv_recover },	\
+	{ "reed_solomon_recover_inverse", test_rs_inverse_recover },	\
+	{ "parity_region_mac", test_region_mac },			\
 	{ "xor_recover_with_fail_vec", test_xor_fv_recover },		\
 	{ "xor_recover_with_fail_index", test_xor_fail_idx_recover },	\
 	{ "buffer_xor", test_buffer_xor },				\
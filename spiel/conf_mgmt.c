@@ -102,7 +102,7 @@ static int spiel_root_ver_update(struct m0_spiel_tx *tx, uint64_t verno)
 	return M0_RC(rc);
 }
 
-void m0_spiel_tx_open(struct m0_spiel *spiel, struct m0_spiel_tx *tx)
+int m0_spiel_tx_open(struct m0_spiel *spiel, struct m0_spiel_tx *tx)
 {
 	struct m0_mutex    *lock = &tx->spt_lock;
 	struct m0_conf_obj *obj;
@@ -115,16 +115,23 @@ void m0_spiel_tx_open(struct m0_spiel *spiel, struct m0_spiel_tx *tx)
 	tx->spt_buffer = NULL;
 
 	m0_mutex_init(lock);
-	m0_conf_cache_init(&tx->spt_cache, lock);
+	rc = m0_conf_cache_init(&tx->spt_cache, lock);
+	if (rc != 0) {
+		m0_mutex_fini(lock);
+		return M0_ERR(rc);
+	}
 
 	/* Create root object. */
 	m0_mutex_lock(lock);
 	rc = m0_conf_obj_find(&tx->spt_cache, &M0_CONF_ROOT_FID, &obj);
 	m0_mutex_unlock(lock);
-	M0_ASSERT(rc == 0); /* XXX Error handling is for cowards. */
+	if (rc != 0) {
+		m0_spiel_tx_close(tx);
+		return M0_ERR(rc);
+	}
 
 	M0_POST(obj->co_status == M0_CS_MISSING);
-	M0_LEAVE();
+	return M0_RC(0);
 }
 M0_EXPORTED(m0_spiel_tx_open);
 
@@ -246,7 +246,9 @@ void m0_spiel_fini(struct m0_spiel *spiel);
  *     struct m0_spiel    *spiel;
  *     int                 rc;
  *
- *     m0_spiel_tx_open(spiel, tx);
+ *     rc = m0_spiel_tx_open(spiel, tx);
+ *     if (rc != 0)
+ *             return rc;
  *     rc = m0_spiel_root_add(tx, ...) ?:
  *          ... add other conf objects ... ?:
  *          m0_spiel_tx_commit(tx);
@@ -285,6 +287,8 @@ struct m0_spiel_tx {
  *	int                 rc;
  *
  *	rc = m0_spiel_tx_open(NULL, &tx);
+ *	if (rc != 0)
+ *		return rc;
  *
  *	. . . add configuration items to tx . . .
  *
@@ -299,10 +303,13 @@ struct m0_spiel_tx {
  *
  * In case (spiel == NULL), the transaction must not be m0_spiel_tx_commit()ted.
  *
+ * If the transaction cannot be opened, nothing has to be released and
+ * m0_spiel_tx_close() must not be called.
+ *
  * @pre tx != NULL
  */
-void m0_spiel_tx_open(struct m0_spiel    *spiel,
-		      struct m0_spiel_tx *tx);
+int m0_spiel_tx_open(struct m0_spiel    *spiel,
+		     struct m0_spiel_tx *tx);
 
 /**
  * Closes spiel transaction.
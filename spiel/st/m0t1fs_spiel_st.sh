@@ -326,7 +326,10 @@ if spiel.cmd_profile_set(str(fids['profile'])) != 0:
     sys.exit('cannot set profile {0}'.format(fids['profile']))
 
 tx = SpielTx(spiel.spiel)
-spiel.tx_open(tx)
+try:
+    spiel.tx_open(tx)
+except RuntimeError as e:
+    sys.exit('cannot open spiel transaction: {0}'.format(e))
 
 commands = [
     ('root_add', tx, Fid(11, 12), fids['mdpool'],
@@ -252,7 +252,8 @@ static void spiel_conf_create_conf_with_opt(struct m0_spiel    *spiel,
 	m0_bitmap_set(&bitmap, 0, true);
 	m0_bitmap_set(&bitmap, 1, true);
 
-	m0_spiel_tx_open(spiel, tx);
+	rc = m0_spiel_tx_open(spiel, tx);
+	M0_UT_ASSERT(rc == 0);
 
 	rc = m0_spiel_root_add(tx,
 			       &M0_FID0,
@@ -636,7 +637,8 @@ static void spiel_conf_create_invalid_configuration(struct m0_spiel    *spiel,
 	m0_bitmap_set(&bitmap, 0, true);
 	m0_bitmap_set(&bitmap, 1, true);
 
-	m0_spiel_tx_open(spiel, tx);
+	rc = m0_spiel_tx_open(spiel, tx);
+	M0_UT_ASSERT(rc == 0);
 	rc = m0_spiel_root_add(tx,
 			       &spiel_obj_fid[SPIEL_UT_OBJ_PROFILE],
 			       &spiel_obj_fid[SPIEL_UT_OBJ_POOL],
@@ -1053,7 +1055,8 @@ static void spiel_conf_create_fail(void)
 	m0_bitmap_set(&bitmap, 0, true);
 	m0_bitmap_set(&bitmap, 1, true);
 
-	m0_spiel_tx_open(&spiel, &tx);
+	rc = m0_spiel_tx_open(&spiel, &tx);
+	M0_UT_ASSERT(rc == 0);
 	/**
 	 * alloc fail for rt_params.
 	 * Note: 'm0_fi_enable_once' is not used here as some other
@@ -1656,7 +1659,8 @@ static void spiel_conf_file(void)
 
 	spiel_conf_ut_init();
 
-	m0_spiel_tx_open(&spiel, &tx);
+	rc = m0_spiel_tx_open(&spiel, &tx);
+	M0_UT_ASSERT(rc == 0);
 	spiel_conf_file_create_tree(&tx);
 
 	/* Convert to file */
@@ -1672,7 +1676,8 @@ static void spiel_conf_file(void)
 	M0_UT_ASSERT(rc == 0);
 
 	m0_mutex_init(&lock);
-	m0_conf_cache_init(&cache, &lock);
+	rc = m0_conf_cache_init(&cache, &lock);
+	M0_UT_ASSERT(rc == 0);
 
 	m0_mutex_lock(&lock);
 
@@ -31,6 +31,7 @@
 
 #include "lib/finject.h"
 #include "lib/errno.h"
+#include "lib/hash.h"		/* m0_hash */
 #include "lib/locality.h"	/* m0_locality0_get */
 #include "lib/memory.h"
 #include "lib/string.h"
@@ -1010,13 +1011,38 @@ static void *stob_ad_addr_open(const void *buf, uint32_t shift)
 	return (void *)(addr << shift);
 }
 
+/**
+   Returns the allocation goal for the next extent of the object, in balloc
+   blocks.
+
+   This is the block right after the previous extent of the object. An object
+   that has not allocated yet starts at a group picked by its fid, so that
+   objects written concurrently grow in different groups instead of
+   interleaving their extents.
+ */
+static m0_bindex_t stob_ad_goal(struct m0_stob_ad_domain *adom,
+				struct m0_stob *obj)
+{
+	const struct m0_fid *fid = m0_stob_fid_get(obj);
+	m0_bcount_t          groups;
+
+	if (stob_ad_stob2ad(obj)->ad_goal != 0)
+		return stob_ad_stob2ad(obj)->ad_goal;
+	if (adom->sad_blocks_per_group == 0)
+		return 0;
+	groups = (adom->sad_container_size >> adom->sad_bshift) /
+		 adom->sad_blocks_per_group;
+	return groups <= 1 ? 0 : m0_hash(fid->f_container ^ fid->f_key) %
+				 groups * adom->sad_blocks_per_group;
+}
+
 /**
    Helper function to allocate a given number of blocks in the underlying
    storage object.
  */
-static int stob_ad_balloc(struct m0_stob_ad_domain *adom, struct m0_dtx *tx,
-			  m0_bcount_t count, struct m0_ext *out,
-			  uint64_t alloc_type)
+static int stob_ad_balloc(struct m0_stob_ad_domain *adom, struct m0_stob *obj,
+			  struct m0_dtx *tx, m0_bcount_t count,
+			  struct m0_ext *out, uint64_t alloc_type)
 {
 	struct m0_ad_balloc *ballroom = adom->sad_ballroom;
 	int                  rc;
@@ -1024,7 +1050,11 @@ static int stob_ad_balloc(struct m0_stob_ad_domain *adom, struct m0_dtx *tx,
 	count >>= adom->sad_babshift;
 	M0_LOG(M0_DEBUG, "count=%lu", (unsigned long)count);
 	M0_ASSERT(count > 0);
+	out->e_start = stob_ad_goal(adom, obj);
+	out->e_end   = out->e_start;
 	rc = ballroom->ab_ops->bo_alloc(ballroom, tx, count, out, alloc_type);
+	if (rc == 0)
+		stob_ad_stob2ad(obj)->ad_goal = out->e_end;
 	out->e_start <<= adom->sad_babshift;
 	out->e_end   <<= adom->sad_babshift;
 	m0_ext_init(out);
@@ -1816,8 +1846,8 @@ static int stob_ad_write_prepare(struct m0_stob_io        *io,
 
 		M0_ADDB2_ADD(M0_AVI_STOB_IO_REQ, io->si_id,
 			     M0_AVI_AD_BALLOC_START);
-		rc = stob_ad_balloc(adom, io->si_tx, todo, &wext->we_ext,
-				    aio->ai_balloc_flags);
+		rc = stob_ad_balloc(adom, io->si_obj, io->si_tx, todo,
+				    &wext->we_ext, aio->ai_balloc_flags);
 		M0_ADDB2_ADD(M0_AVI_STOB_IO_REQ, io->si_id,
 			     M0_AVI_AD_BALLOC_END);
 		if (rc != 0)
@@ -81,7 +81,9 @@ struct m0_ad_balloc_ops {
 	/** Finalises and destroys struct m0_balloc instance. */
 	void (*bo_fini)(struct m0_ad_balloc *ballroom);
 	/** Allocates count of blocks. On success, allocated extent, also
-	    measured in blocks, is returned in out parameter. */
+	    measured in blocks, is returned in out parameter. Non-zero
+	    out->e_start on entry is the goal: the block the allocation should
+	    preferably start at. */
 	int  (*bo_alloc)(struct m0_ad_balloc *ballroom, struct m0_dtx *dtx,
 			 m0_bcount_t count, struct m0_ext *out,
 			 uint64_t alloc_zone);
@@ -192,6 +194,12 @@ enum stob_ad_allocation_extent_type {
 
 struct m0_stob_ad {
 	struct m0_stob          ad_stob;
+	/**
+	 * Goal of the next allocation for this stob, in balloc blocks: the
+	 * block right after the previously allocated extent, 0 if none yet.
+	 * Only a hint, updated without locking.
+	 */
+	m0_bindex_t             ad_goal;
 };
 
 struct m0_stob_ad_io {
@@ -25,8 +25,12 @@
 #include "stob/cache.h"
 
 #include "motr/magic.h"
+#include "lib/locality.h"       /* m0_locality_data_free */
+#include "lib/arith.h"          /* max64u */
+#include "addb2/counter.h"      /* m0_addb2_local_counter */
 
 #include "stob/stob.h"	/* m0_stob */
+#include "stob/addb2.h" /* M0_AVI_STOB_CACHE_HIT */
 
 /**
  * @addtogroup stobcache
@@ -34,209 +38,314 @@
  * @{
  */
 
+static uint64_t stob_cache_hash_func(const struct m0_htable *htable,
+				     const void *key)
+{
+	/* Low bits of the hash select the shard, see stob_cache_shard(). */
+	return m0_fid_hash(key) / M0_STOB_CACHE_SHARD_NR % htable->h_bucket_nr;
+}
+
+static bool stob_cache_hash_key_eq(const void *key1, const void *key2)
+{
+	return m0_fid_eq(key1, key2);
+}
+
 M0_TL_DESCR_DEFINE(stob_cache, "cached stobs", static, struct m0_stob,
 		   so_cache_linkage, so_cache_magic,
 		   M0_STOB_CACHE_MAGIC, M0_STOB_CACHE_HEAD_MAGIC);
 M0_TL_DEFINE(stob_cache, static, struct m0_stob);
 
+M0_HT_DESCR_DEFINE(stob_cache_hash, "stob cache hash", static, struct m0_stob,
+		   so_cache_hlink, so_cache_hmagic, M0_STOB_CACHE_HASH_MAGIC,
+		   M0_STOB_CACHE_HASH_HEAD_MAGIC, so_id.si_fid,
+		   stob_cache_hash_func, stob_cache_hash_key_eq);
+M0_HT_DEFINE(stob_cache_hash, static, struct m0_stob, struct m0_fid);
+
+static struct m0_addb2_local_counter stob_cache_hit;
+static struct m0_addb2_local_counter stob_cache_miss;
+
+M0_INTERNAL int m0_stob_cache_mod_init(void)
+{
+	return m0_addb2_local_counter_init(&stob_cache_hit,
+					   M0_AVI_STOB_CACHE_HIT,
+					   M0_AVI_STOB_CACHE_HIT) ?:
+	       m0_addb2_local_counter_init(&stob_cache_miss,
+					   M0_AVI_STOB_CACHE_MISS,
+					   M0_AVI_STOB_CACHE_MISS);
+}
+
+M0_INTERNAL void m0_stob_cache_mod_fini(void)
+{
+	m0_locality_data_free(stob_cache_miss.lc_key);
+	m0_locality_data_free(stob_cache_hit.lc_key);
+}
+
+static struct m0_stob_cache_shard *
+stob_cache_shard(const struct m0_stob_cache *cache,
+		 const struct m0_fid *stob_fid)
+{
+	return (struct m0_stob_cache_shard *)
+		&cache->sc_shard[m0_fid_hash(stob_fid) %
+				 M0_STOB_CACHE_SHARD_NR];
+}
+
 M0_INTERNAL int m0_stob_cache_init(struct m0_stob_cache *cache,
 				   uint64_t idle_size,
 				   m0_stob_cache_eviction_cb_t eviction_cb)
 {
+	struct m0_stob_cache_shard *shard;
+	uint64_t                    shard_idle;
+	int                         rc = 0;
+	int                         i;
+
+	/*
+	 * idle_size is split between the shards. A shard keeps at least one
+	 * idle stob unless idle stobs are not cached at all, so the total may
+	 * exceed idle_size when it is less than the number of shards.
+	 */
+	shard_idle = idle_size == 0 ? 0 :
+		max64u(idle_size / M0_STOB_CACHE_SHARD_NR, 1);
 	*cache = (struct m0_stob_cache){
-		.sc_idle_size	= idle_size,
-		.sc_idle_used	= 0,
+		.sc_idle_size	= shard_idle * M0_STOB_CACHE_SHARD_NR,
 		.sc_eviction_cb = eviction_cb,
-		.sc_busy_hits	= 0,
-		.sc_idle_hits	= 0,
-		.sc_misses	= 0,
-		.sc_evictions	= 0,
 	};
-	m0_mutex_init(&cache->sc_lock);
-	stob_cache_tlist_init(&cache->sc_busy);
-	stob_cache_tlist_init(&cache->sc_idle);
-	return 0;
+	for (i = 0; i < ARRAY_SIZE(cache->sc_shard); ++i) {
+		shard = &cache->sc_shard[i];
+		shard->scs_idle_size = shard_idle;
+		rc = stob_cache_hash_htable_init(&shard->scs_hash,
+						 M0_STOB_CACHE_BUCKET_NR);
+		if (rc != 0)
+			break;
+		m0_mutex_init(&shard->scs_lock);
+		stob_cache_tlist_init(&shard->scs_idle);
+	}
+	if (rc != 0) {
+		while (--i >= 0) {
+			shard = &cache->sc_shard[i];
+			stob_cache_tlist_fini(&shard->scs_idle);
+			m0_mutex_fini(&shard->scs_lock);
+			stob_cache_hash_htable_fini(&shard->scs_hash);
+		}
+	}
+	return M0_RC(rc);
 }
 
 M0_INTERNAL void m0_stob_cache_fini(struct m0_stob_cache *cache)
 {
-	struct m0_stob *zombie;
+	struct m0_stob_cache_shard *shard;
+	struct m0_stob             *zombie;
+	int                         i;
 
 	m0_stob_cache_purge(cache, cache->sc_idle_size);
 	m0_stob_cache__print(cache);
-	m0_tl_for(stob_cache, &cache->sc_busy, zombie) {
-		M0_LOG(M0_FATAL, "Still busy "FID_F,
-		       FID_P(m0_stob_fid_get(zombie)));
-	} m0_tl_endfor;
-	m0_tl_for(stob_cache, &cache->sc_idle, zombie) {
-		M0_LOG(M0_FATAL, "Still idle "FID_F,
-		       FID_P(m0_stob_fid_get(zombie)));
-	} m0_tl_endfor;
-	stob_cache_tlist_fini(&cache->sc_idle);
-	stob_cache_tlist_fini(&cache->sc_busy);
-	m0_mutex_fini(&cache->sc_lock);
+	for (i = 0; i < ARRAY_SIZE(cache->sc_shard); ++i) {
+		shard = &cache->sc_shard[i];
+		m0_htable_for(stob_cache_hash, zombie, &shard->scs_hash) {
+			M0_LOG(M0_FATAL, "Still %s "FID_F,
+			       stob_cache_tlink_is_in(zombie) ? "idle" : "busy",
+			       FID_P(m0_stob_fid_get(zombie)));
+		} m0_htable_endfor;
+		stob_cache_tlist_fini(&shard->scs_idle);
+		m0_mutex_fini(&shard->scs_lock);
+		stob_cache_hash_htable_fini(&shard->scs_hash);
+	}
 }
 
-
-M0_INTERNAL bool m0_stob_cache__invariant(const struct m0_stob_cache *cache)
+static bool stob_cache_shard_invariant(const struct m0_stob_cache_shard *shard)
 {
-	return _0C(m0_stob_cache_is_locked(cache)) &&
-	       _0C(cache->sc_idle_size >= cache->sc_idle_used) &&
-	       M0_CHECK_EX(_0C(stob_cache_tlist_length(&cache->sc_idle) ==
-			       cache->sc_idle_used));
+	return _0C(m0_mutex_is_locked(&shard->scs_lock)) &&
+	       _0C(shard->scs_idle_size >= shard->scs_idle_used) &&
+	       M0_CHECK_EX(_0C(stob_cache_tlist_length(&shard->scs_idle) ==
+			       shard->scs_idle_used)) &&
+	       M0_CHECK_EX(_0C(stob_cache_hash_htable_size(&shard->scs_hash) >=
+			       shard->scs_idle_used));
+}
 
+M0_INTERNAL bool m0_stob_cache__invariant(const struct m0_stob_cache *cache,
+					  const struct m0_fid *stob_fid)
+{
+	return stob_cache_shard_invariant(stob_cache_shard(cache, stob_fid));
 }
 
-static void stob_cache_evict(struct m0_stob_cache *cache,
-			     struct m0_stob *stob)
+static void stob_cache_evict(struct m0_stob_cache       *cache,
+			     struct m0_stob_cache_shard *shard,
+			     struct m0_stob             *stob)
 {
+	stob_cache_hash_htable_del(&shard->scs_hash, stob);
+	stob_cache_hash_tlink_fini(stob);
 	cache->sc_eviction_cb(cache, stob);
-	++cache->sc_evictions;
+	++shard->scs_evictions;
 }
 
-static void stob_cache_idle_del(struct m0_stob_cache *cache,
-				struct m0_stob *stob)
+static void stob_cache_idle_del(struct m0_stob_cache_shard *shard,
+				struct m0_stob             *stob)
 {
 	M0_ENTRY("stob %p, stob_fid "FID_F, stob,
 	       FID_P(m0_stob_fid_get(stob)));
 	stob_cache_tlink_del_fini(stob);
-	--cache->sc_idle_used;
+	--shard->scs_idle_used;
 }
 
-static void stob_cache_idle_moveto(struct m0_stob_cache *cache,
-				   struct m0_stob *stob)
+static void stob_cache_idle_moveto(struct m0_stob_cache       *cache,
+				   struct m0_stob_cache_shard *shard,
+				   struct m0_stob             *stob)
 {
 	struct m0_stob *evicted;
 
-	stob_cache_tlist_move(&cache->sc_idle, stob);
-	++cache->sc_idle_used;
-	if (cache->sc_idle_used > cache->sc_idle_size) {
-		evicted = stob_cache_tlist_tail(&cache->sc_idle);
-		stob_cache_idle_del(cache, evicted);
-		stob_cache_evict(cache, evicted);
+	stob_cache_tlink_init_at(stob, &shard->scs_idle);
+	++shard->scs_idle_used;
+	if (shard->scs_idle_used > shard->scs_idle_size) {
+		evicted = stob_cache_tlist_tail(&shard->scs_idle);
+		stob_cache_idle_del(shard, evicted);
+		stob_cache_evict(cache, shard, evicted);
 	}
 }
 
 M0_INTERNAL void m0_stob_cache_add(struct m0_stob_cache *cache,
 				   struct m0_stob *stob)
 {
-	M0_PRE(m0_stob_cache__invariant(cache));
-	M0_PRE_EX(m0_stob_cache_lookup(cache, m0_stob_fid_get(stob)) == NULL);
+	struct m0_stob_cache_shard *shard;
 
-	stob_cache_tlink_init_at(stob, &cache->sc_busy);
+	shard = stob_cache_shard(cache, m0_stob_fid_get(stob));
+	M0_PRE(stob_cache_shard_invariant(shard));
+	M0_PRE(stob_cache_hash_htable_lookup(&shard->scs_hash,
+					     m0_stob_fid_get(stob)) == NULL);
+
+	stob_cache_tlink_init(stob);
+	stob_cache_hash_tlink_init(stob);
+	stob_cache_hash_htable_add(&shard->scs_hash, stob);
 }
 
 M0_INTERNAL void m0_stob_cache_idle(struct m0_stob_cache *cache,
 				   struct m0_stob *stob)
 {
-	M0_PRE(m0_stob_cache__invariant(cache));
+	struct m0_stob_cache_shard *shard;
+
+	shard = stob_cache_shard(cache, m0_stob_fid_get(stob));
+	M0_PRE(stob_cache_shard_invariant(shard));
+	M0_PRE(!stob_cache_tlink_is_in(stob));
 
-	stob_cache_idle_moveto(cache, stob);
+	stob_cache_idle_moveto(cache, shard, stob);
 }
 
 M0_INTERNAL struct m0_stob *m0_stob_cache_lookup(struct m0_stob_cache *cache,
 						 const struct m0_fid *stob_fid)
 {
-	struct m0_stob *stob;
-
-	M0_PRE(m0_stob_cache__invariant(cache));
-
-	m0_tl_for(stob_cache, &cache->sc_busy, stob) {
-		if (m0_fid_cmp(stob_fid, m0_stob_fid_get(stob)) == 0) {
-			++cache->sc_busy_hits;
-			return stob;
-		}
-	} m0_tl_endfor;
-
-	m0_tl_for(stob_cache, &cache->sc_idle, stob) {
-		if (m0_fid_cmp(stob_fid, m0_stob_fid_get(stob)) == 0) {
-			++cache->sc_idle_hits;
-			stob_cache_idle_del(cache, stob);
-			stob_cache_tlink_init_at(stob, &cache->sc_busy);
-			return stob;
-		}
-	} m0_tl_endfor;
-
-	++cache->sc_misses;
-	return NULL;
+	struct m0_stob_cache_shard *shard = stob_cache_shard(cache, stob_fid);
+	struct m0_stob             *stob;
+
+	M0_PRE(stob_cache_shard_invariant(shard));
+
+	stob = stob_cache_hash_htable_lookup(&shard->scs_hash, stob_fid);
+	if (stob == NULL) {
+		++shard->scs_misses;
+		m0_addb2_local_counter_mod(&stob_cache_miss, 1, 0);
+	} else if (stob_cache_tlink_is_in(stob)) {
+		++shard->scs_idle_hits;
+		stob_cache_idle_del(shard, stob);
+		m0_addb2_local_counter_mod(&stob_cache_hit, 1, 1);
+	} else {
+		++shard->scs_busy_hits;
+		m0_addb2_local_counter_mod(&stob_cache_hit, 1, 0);
+	}
+	return stob;
 }
 
-
 M0_INTERNAL void m0_stob_cache_purge(struct m0_stob_cache *cache, int nr)
 {
-	struct m0_stob *stob;
-	struct m0_stob *prev;
-
-	m0_stob_cache_lock(cache);
-	M0_PRE(m0_stob_cache__invariant(cache));
-
-	stob = stob_cache_tlist_tail(&cache->sc_idle);
-	for (; stob != NULL && nr > 0; --nr) {
-		prev = stob_cache_tlist_prev(&cache->sc_idle, stob);
-		stob_cache_idle_del(cache, stob);
-		stob_cache_evict(cache, stob);
-		stob = prev;
-	}
-
-	M0_POST(m0_stob_cache__invariant(cache));
-	m0_stob_cache_unlock(cache);
+	struct m0_stob_cache_shard *shard;
+	struct m0_stob             *stob;
+	bool                        purged;
+	int                         i;
+
+	/* Take one idle stob from every shard in turn. */
+	do {
+		purged = false;
+		for (i = 0; i < ARRAY_SIZE(cache->sc_shard) && nr > 0; ++i) {
+			shard = &cache->sc_shard[i];
+			m0_mutex_lock(&shard->scs_lock);
+			M0_PRE(stob_cache_shard_invariant(shard));
+			stob = stob_cache_tlist_tail(&shard->scs_idle);
+			if (stob != NULL) {
+				stob_cache_idle_del(shard, stob);
+				stob_cache_evict(cache, shard, stob);
+				purged = true;
+				--nr;
+			}
+			M0_POST(stob_cache_shard_invariant(shard));
+			m0_mutex_unlock(&shard->scs_lock);
+		}
+	} while (purged && nr > 0);
 }
 
-M0_INTERNAL void m0_stob_cache_lock(struct m0_stob_cache *cache)
+M0_INTERNAL void m0_stob_cache_lock(struct m0_stob_cache *cache,
+				    const struct m0_fid *stob_fid)
 {
-	m0_mutex_lock(&cache->sc_lock);
+	m0_mutex_lock(&stob_cache_shard(cache, stob_fid)->scs_lock);
 }
 
-M0_INTERNAL void m0_stob_cache_unlock(struct m0_stob_cache *cache)
+M0_INTERNAL void m0_stob_cache_unlock(struct m0_stob_cache *cache,
+				      const struct m0_fid *stob_fid)
 {
-	m0_mutex_unlock(&cache->sc_lock);
+	m0_mutex_unlock(&stob_cache_shard(cache, stob_fid)->scs_lock);
 }
 
-M0_INTERNAL bool m0_stob_cache_is_locked(const struct m0_stob_cache *cache)
+M0_INTERNAL bool m0_stob_cache_is_locked(const struct m0_stob_cache *cache,
+					 const struct m0_fid *stob_fid)
 {
-	return m0_mutex_is_locked(&cache->sc_lock);
+	return m0_mutex_is_locked(&stob_cache_shard(cache, stob_fid)->scs_lock);
 }
 
-M0_INTERNAL bool m0_stob_cache_is_not_locked(const struct m0_stob_cache *cache)
+M0_INTERNAL bool m0_stob_cache_is_not_locked(const struct m0_stob_cache *cache,
+					     const struct m0_fid *stob_fid)
 {
-	return m0_mutex_is_not_locked(&cache->sc_lock);
+	return m0_mutex_is_not_locked(
+			&stob_cache_shard(cache, stob_fid)->scs_lock);
 }
 
 M0_INTERNAL void m0_stob_cache__print(struct m0_stob_cache *cache)
 {
 #define LEVEL M0_DEBUG
-	struct m0_stob *stob;
-	int		i;
-
-	M0_LOG(LEVEL, "m0_stob_cache %p: "
-	       "sc_busy_hits = %"PRIu64", sc_idle_hits = %"PRIu64", "
-	       "sc_misses = %"PRIu64", sc_evictions = %"PRIu64, cache,
-	       cache->sc_busy_hits, cache->sc_idle_hits,
-	       cache->sc_misses, cache->sc_evictions);
+	struct m0_stob_cache_shard *shard;
+	struct m0_stob             *stob;
+	uint64_t                    busy_hits = 0;
+	uint64_t                    idle_hits = 0;
+	uint64_t                    misses    = 0;
+	uint64_t                    evictions = 0;
+	uint64_t                    idle_used = 0;
+	uint64_t                    size      = 0;
+	int                         i;
+
+	for (i = 0; i < ARRAY_SIZE(cache->sc_shard); ++i) {
+		shard = &cache->sc_shard[i];
+		m0_mutex_lock(&shard->scs_lock);
+		busy_hits += shard->scs_busy_hits;
+		idle_hits += shard->scs_idle_hits;
+		misses    += shard->scs_misses;
+		evictions += shard->scs_evictions;
+		idle_used += shard->scs_idle_used;
+		size      += stob_cache_hash_htable_size(&shard->scs_hash);
+		m0_mutex_unlock(&shard->scs_lock);
+	}
 	M0_LOG(LEVEL, "m0_stob_cache %p: "
-	       "sc_idle_size = %"PRIu64", sc_idle_used = %"PRIu64", ",
-	       cache, cache->sc_idle_size, cache->sc_idle_used);
+	       "busy_hits = %"PRIu64", idle_hits = %"PRIu64", "
+	       "misses = %"PRIu64", evictions = %"PRIu64, cache,
+	       busy_hits, idle_hits, misses, evictions);
 	M0_LOG(LEVEL, "m0_stob_cache %p: "
-	       "sc_busy length = %zu, sc_idle length = %zu", cache,
-	       stob_cache_tlist_length(&cache->sc_busy),
-	       stob_cache_tlist_length(&cache->sc_idle));
-
-
-	M0_LOG(LEVEL, "m0_stob_cache %p: sc_busy list", cache);
-	i = 0;
-	m0_tl_for(stob_cache, &cache->sc_busy, stob) {
-		M0_LOG(LEVEL, "%d: %p, stob_fid =" FID_F,
-		       i, stob, FID_P(m0_stob_fid_get(stob)));
-		++i;
-	} m0_tl_endfor;
-
-	M0_LOG(LEVEL, "m0_stob_cache %p: sc_idle list", cache);
-	i = 0;
-	m0_tl_for(stob_cache, &cache->sc_idle, stob) {
-		M0_LOG(LEVEL, "%d: %p, stob_key =" FID_F,
-		       i, stob, FID_P(m0_stob_fid_get(stob)));
-		++i;
-	} m0_tl_endfor;
+	       "sc_idle_size = %"PRIu64", idle_used = %"PRIu64", "
+	       "busy = %"PRIu64, cache, cache->sc_idle_size, idle_used,
+	       size - idle_used);
+
+	for (i = 0; i < ARRAY_SIZE(cache->sc_shard); ++i) {
+		shard = &cache->sc_shard[i];
+		m0_mutex_lock(&shard->scs_lock);
+		m0_htable_for(stob_cache_hash, stob, &shard->scs_hash) {
+			M0_LOG(LEVEL, "%d: %p, %s, stob_fid =" FID_F, i, stob,
+			       stob_cache_tlink_is_in(stob) ? "idle" : "busy",
+			       FID_P(m0_stob_fid_get(stob)));
+		} m0_htable_endfor;
+		m0_mutex_unlock(&shard->scs_lock);
+	}
 	M0_LOG(LEVEL, "m0_stob_cache %p: end.", cache);
 #undef LEVEL
 }
@@ -27,13 +27,28 @@
 
 #include "lib/mutex.h"	/* m0_mutex */
 #include "lib/tlist.h"	/* m0_tl */
+#include "lib/hash.h"	/* m0_htable */
 #include "lib/types.h"	/* uint64_t */
 #include "fid/fid.h"    /* m0_fid */
 
 /**
  * @defgroup stob Storage object
  *
- * @todo more scalable object index instead of a list.
+ * Stob cache keeps the stobs of a domain indexed by stob fid. It is split
+ * into M0_STOB_CACHE_SHARD_NR shards, the shard of a stob is selected by the
+ * hash of its fid. Each shard has its own lock, fid hash table, idle LRU list
+ * and statistics, so lookups of different stobs rarely contend.
+ *
+ * A stob is "busy" while it is referenced and "idle" otherwise. Both busy and
+ * idle stobs are in the hash table, idle stobs are also on the LRU list of the
+ * shard, most recently used first. The idle_size limit is split evenly between
+ * the shards, each shard keeping at least one idle stob. LRU order is kept
+ * within a shard only: when a shard has more idle stobs than its part of the
+ * limit, its least recently used stob is evicted, even if other shards hold
+ * older ones.
+ *
+ * Lookup hits and misses are counted per locality by the addb2 counters
+ * M0_AVI_STOB_CACHE_HIT and M0_AVI_STOB_CACHE_MISS.
  *
  * @{
  */
@@ -41,30 +56,49 @@
 struct m0_stob;
 struct m0_stob_cache;
 
+enum {
+	/** Number of independently locked cache shards. */
+	M0_STOB_CACHE_SHARD_NR  = 16,
+	/** Number of hash buckets in each shard. */
+	M0_STOB_CACHE_BUCKET_NR = 256,
+};
+
 typedef void (*m0_stob_cache_eviction_cb_t)(struct m0_stob_cache *cache,
 					    struct m0_stob *stob);
-/**
- * @todo document
- */
+
+/** A part of the stob cache protected by a single lock. */
+struct m0_stob_cache_shard {
+	struct m0_mutex             scs_lock;
+	/** All stobs of the shard, busy and idle, hashed by fid. */
+	struct m0_htable            scs_hash;
+	/** Idle stobs, most recently used first. */
+	struct m0_tl                scs_idle;
+	uint64_t                    scs_idle_size;
+	uint64_t                    scs_idle_used;
+
+	uint64_t                    scs_busy_hits;
+	uint64_t                    scs_idle_hits;
+	uint64_t                    scs_misses;
+	uint64_t                    scs_evictions;
+};
+
 struct m0_stob_cache {
-	struct m0_mutex             sc_lock;
-	struct m0_tl		    sc_busy;
-	struct m0_tl		    sc_idle;
-	uint64_t		    sc_idle_size;
-	uint64_t		    sc_idle_used;
+	struct m0_stob_cache_shard  sc_shard[M0_STOB_CACHE_SHARD_NR];
+	/** Maximum number of idle stobs in all shards together. */
+	uint64_t                    sc_idle_size;
 	m0_stob_cache_eviction_cb_t sc_eviction_cb;
-
-	uint64_t		    sc_busy_hits;
-	uint64_t		    sc_idle_hits;
-	uint64_t		    sc_misses;
-	uint64_t		    sc_evictions;
 };
 
+/** Initialises addb2 counters of stob caches. */
+M0_INTERNAL int m0_stob_cache_mod_init(void);
+M0_INTERNAL void m0_stob_cache_mod_fini(void);
+
 /**
  * Initialises stob cache.
  *
  * @param cache stob cache
- * @param idle_size idle list maximum size
+ * @param idle_size maximum number of idle stobs in all shards together, 0
+ *        disables caching of idle stobs
  */
 M0_INTERNAL int m0_stob_cache_init(struct m0_stob_cache *cache,
 				   uint64_t idle_size,
@@ -72,19 +106,20 @@ M0_INTERNAL int m0_stob_cache_init(struct m0_stob_cache *cache,
 M0_INTERNAL void m0_stob_cache_fini(struct m0_stob_cache *cache);
 
 /**
- * Stob cache invariant.
+ * Invariant of the stob cache shard @stob_fid belongs to.
  *
- * @pre m0_stob_cache_is_locked(cache)
- * @post m0_stob_cache_is_locked(cache)
+ * @pre m0_stob_cache_is_locked(cache, stob_fid)
+ * @post m0_stob_cache_is_locked(cache, stob_fid)
  */
-M0_INTERNAL bool m0_stob_cache__invariant(const struct m0_stob_cache *cache);
+M0_INTERNAL bool m0_stob_cache__invariant(const struct m0_stob_cache *cache,
+					  const struct m0_fid *stob_fid);
 
 /**
  * Adds stob to the stob cache. Stob should be deleted from the stob cache using
  * m0_stob_cache_idle().
  *
- * @pre m0_stob_cache_is_locked(cache)
- * @post m0_stob_cache_is_locked(cache)
+ * @pre m0_stob_cache_is_locked(cache, m0_stob_fid_get(stob))
+ * @post m0_stob_cache_is_locked(cache, m0_stob_fid_get(stob))
  */
 M0_INTERNAL void m0_stob_cache_add(struct m0_stob_cache *cache,
 				   struct m0_stob *stob);
@@ -92,8 +127,8 @@ M0_INTERNAL void m0_stob_cache_add(struct m0_stob_cache *cache,
 /**
  * Deletes item from the stob cache.
  *
- * @pre m0_stob_cache_is_locked(cache)
- * @post m0_stob_cache_is_locked(cache)
+ * @pre m0_stob_cache_is_locked(cache, m0_stob_fid_get(stob))
+ * @post m0_stob_cache_is_locked(cache, m0_stob_fid_get(stob))
  */
 M0_INTERNAL void m0_stob_cache_idle(struct m0_stob_cache *cache,
 				   struct m0_stob *stob);
@@ -102,8 +137,8 @@ M0_INTERNAL void m0_stob_cache_idle(struct m0_stob_cache *cache,
  * Finds item in the stob cache. Stob found should be deleted from the stob
  * cache using m0_stob_cache_idle().
  *
- * @pre m0_stob_cache_is_locked(cache)
- * @post m0_stob_cache_is_locked(cache)
+ * @pre m0_stob_cache_is_locked(cache, stob_fid)
+ * @post m0_stob_cache_is_locked(cache, stob_fid)
  */
 M0_INTERNAL struct m0_stob *m0_stob_cache_lookup(struct m0_stob_cache *cache,
 						 const struct m0_fid *stob_fid);
@@ -111,15 +146,22 @@ M0_INTERNAL struct m0_stob *m0_stob_cache_lookup(struct m0_stob_cache *cache,
 /**
  * Purges at most nr items from the idle stob cache.
  *
- * @pre m0_stob_cache_is_not_locked(cache)
- * @post m0_stob_cache_is_not_locked(cache)
+ * Idle stobs are purged from all shards in turn, least recently used first in
+ * each shard.
+ *
+ * @pre none of the shard locks is held by the caller
  */
 M0_INTERNAL void m0_stob_cache_purge(struct m0_stob_cache *cache, int nr);
 
-M0_INTERNAL void m0_stob_cache_lock(struct m0_stob_cache *cache);
-M0_INTERNAL void m0_stob_cache_unlock(struct m0_stob_cache *cache);
-M0_INTERNAL bool m0_stob_cache_is_locked(const struct m0_stob_cache *cache);
-M0_INTERNAL bool m0_stob_cache_is_not_locked(const struct m0_stob_cache *cache);
+/** Locks the shard @stob_fid belongs to. */
+M0_INTERNAL void m0_stob_cache_lock(struct m0_stob_cache *cache,
+				    const struct m0_fid *stob_fid);
+M0_INTERNAL void m0_stob_cache_unlock(struct m0_stob_cache *cache,
+				      const struct m0_fid *stob_fid);
+M0_INTERNAL bool m0_stob_cache_is_locked(const struct m0_stob_cache *cache,
+					 const struct m0_fid *stob_fid);
+M0_INTERNAL bool m0_stob_cache_is_not_locked(const struct m0_stob_cache *cache,
+					     const struct m0_fid *stob_fid);
 
 M0_INTERNAL void m0_stob_cache__print(struct m0_stob_cache *cache);
 
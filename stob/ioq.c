@@ -27,15 +27,23 @@
 #include <limits.h>			/* IOV_MAX */
 #include <sys/uio.h>			/* iovec */
 #include <libaio.h>                     /* io_getevents */
+#ifdef HAVE_IO_URING
+#include <unistd.h>                     /* syscall */
+#include <sys/mman.h>                   /* mmap */
+#include <sys/syscall.h>                /* __NR_io_uring_setup */
+#include <linux/io_uring.h>             /* io_uring_sqe */
+#endif
 
 #include "ha/ha.h"                      /* m0_ha_send */
 #include "ha/msg.h"                     /* m0_ha_msg */
 
 #include "lib/misc.h"			/* M0_SET0 */
+#include "lib/bitmap.h"			/* m0_bitmap */
 #include "lib/errno.h"			/* ENOMEM */
 #include "lib/finject.h"		/* M0_FI_ENABLED */
 #include "lib/locality.h"
 #include "lib/memory.h"			/* M0_ALLOC_PTR */
+#include "lib/processor.h"		/* m0_processor_describe */
 
 #include "module/instance.h"            /* m0_get() */
 #include "reqh/reqh.h"                  /* m0_reqh */
@@ -59,16 +67,28 @@
    storage object domain level, that is, each domain has its own set of queues,
    threads and thresholds.
 
+   The queues of a domain are split into independent shards
+   (m0_stob_ioq_shard), one per locality. Each shard has its own admission
+   queue, ring buffer, lock and worker thread. A request is executed by the
+   shard of the locality where it is launched (ioq_shard_pick()), so requests
+   launched in different localities don't share locks or ring buffers.
+
+   The ring buffers divide M0_STOB_IOQ_RING_SIZE between the shards. When the
+   ring buffer of the local shard is full, a request is executed by the next
+   shard with free slots. Hence a single busy locality is not limited to its
+   own share of the ring and to a single completion thread: it can keep up to
+   the whole M0_STOB_IOQ_RING_SIZE in flight while other localities are idle.
+
    On a high level, adieu IO request is first split into fragments. A fragment
-   is initially placed into a per-domain queue (admission queue,
-   linux_domain::ioq_queue) where it is held until there is enough space in the
-   AIO ring buffer (linux_domain::ioq_ctx). Placing a fragment into the ring
-   buffer (ioq_queue_submit()) means that kernel AIO is launched for it. When IO
-   completes, the kernel delivers an IO completion event via the ring buffer.
+   is initially placed into a per-shard queue (admission queue,
+   m0_stob_ioq_shard::ios_queue) where it is held until there is enough space
+   in the AIO ring buffer (m0_stob_ioq_shard::ios_ctx). Placing a fragment into
+   the ring buffer (ioq_queue_submit()) means that kernel AIO is launched for
+   it. When IO completes, the kernel delivers an IO completion event via the
+   ring buffer.
 
-   A number (M0_STOB_IOQ_NR_THREADS by default) of worker adieu threads is
-   created for each storage object domain. These threads are implementing
-   admission control and completion notification, they
+   A worker adieu thread is created for each shard. These threads are
+   implementing admission control and completion notification, they
 
        - listen for the AIO completion events in the ring buffer. When an AIO is
          completed, worker thread signals completion event to AIO users;
@@ -86,8 +106,8 @@
 
    <b>Concurrency control</b>
 
-   Per-domain data structures (queue, thresholds, etc.) are protected by
-   linux_domain::ioq_mutex.
+   Per-shard data structures (queue, thresholds, etc.) are protected by
+   m0_stob_ioq_shard::ios_lock.
 
    Concurrency control for an individual adieu fragment is very simple: user is
    not allowed to touch it in SIS_BUSY state and io_getevents() exactly-once
@@ -96,6 +116,29 @@
    implemented, because it requires synchronization between user actions
    (cancellation) and ongoing IO in SIS_BUSY state.
 
+   <b>io_uring</b>
+
+   Alternatively (M0_STOB_IOQ_URING, see m0_stob_ioq_init()) fragments are
+   executed with io_uring. The admission queue and the worker threads are the
+   same, but
+
+       - ioq_queue_submit() moves all fragments which fit into the submission
+         ring at once and submits them with a single io_uring_enter(2) call (or
+         none in SQPOLL mode);
+
+       - worker threads wait for completions in io_uring_enter(2) and reap
+         completion ring under ioq_uring::iu_cq_lock, which only serialises
+         reaping, not waiting. The same call submits entries which
+         ioq_queue_submit() failed to submit;
+
+       - files of the domain are registered with the rings of all shards (see
+         m0_stob_ioq_fd_register()), so that the kernel doesn't look them up
+         for every fragment.
+
+   io_uring is used through raw system calls, no user space library is needed.
+   Timed wait (IORING_FEAT_EXT_ARG, Linux 5.11) is required, without it the
+   queue falls back to AIO.
+
    @todo use explicit state machine instead of ioq threads
 
    @see http://www.kernel.org/doc/man-pages/online/pages/man2/io_setup.2.html
@@ -115,8 +158,8 @@ struct ioq_qev {
 	struct iocb           iq_iocb;
 	m0_bcount_t           iq_nbytes;
 	m0_bindex_t           iq_offset;
-	/** Linkage to a per-domain admission queue
-	    (linux_domain::ioq_queue). */
+	/** Linkage to a per-shard admission queue
+	    (m0_stob_ioq_shard::ios_queue). */
 	struct m0_queue_link  iq_linkage;
 	struct m0_stob_io    *iq_io;
 };
@@ -137,12 +180,27 @@ struct stob_linux_io {
 	struct m0_stob_ioq *si_ioq;
 };
 
-static struct ioq_qev *ioq_queue_get   (struct m0_stob_ioq *ioq);
-static void            ioq_queue_put   (struct m0_stob_ioq *ioq,
+/** Completion event of a fragment. */
+struct ioq_event {
+	struct ioq_qev *ie_qev;
+	long            ie_res;
+};
+
+static struct ioq_qev *ioq_queue_get   (struct m0_stob_ioq_shard *ios);
+static void            ioq_queue_put   (struct m0_stob_ioq_shard *ios,
 					struct ioq_qev *qev);
-static void            ioq_queue_submit(struct m0_stob_ioq *ioq);
-static void            ioq_queue_lock  (struct m0_stob_ioq *ioq);
-static void            ioq_queue_unlock(struct m0_stob_ioq *ioq);
+static void            ioq_queue_submit(struct m0_stob_ioq_shard *ios);
+static void            ioq_queue_lock  (struct m0_stob_ioq_shard *ios);
+static void            ioq_queue_unlock(struct m0_stob_ioq_shard *ios);
+
+static int  ioq_uring_init       (struct m0_stob_ioq_shard *ios, bool sqpoll);
+static void ioq_uring_fini       (struct m0_stob_ioq_shard *ios);
+static void ioq_uring_submit     (struct m0_stob_ioq_shard *ios);
+static int  ioq_uring_getevents  (struct m0_stob_ioq_shard *ios,
+				  struct ioq_event *ev, int nr,
+				  const struct timespec *timeout);
+static int  ioq_uring_fd_register(struct m0_stob_ioq *ioq, int fd);
+static void ioq_uring_fd_unregister(struct m0_stob_ioq *ioq, int idx);
 
 static const struct m0_stob_io_op stob_linux_io_op;
 
@@ -193,6 +251,36 @@ static void stob_linux_io_fini(struct m0_stob_io *io)
 	m0_free(lio);
 }
 
+/** Returns the number of free ring buffer slots not claimed by the queue. */
+static int64_t ioq_shard_room(const struct m0_stob_ioq_shard *ios)
+{
+	/* ios_queued is read without the lock, it is only a hint. */
+	return m0_atomic64_get(&ios->ios_avail) -
+		*(const volatile int *)&ios->ios_queued;
+}
+
+/**
+   Returns the shard to execute a request of @nr fragments: the shard of the
+   current locality or, if its ring buffer has no room for the request, the
+   first following shard that has. If all rings are full, the request waits in
+   the admission queue of the local shard.
+ */
+static struct m0_stob_ioq_shard *ioq_shard_pick(struct m0_stob_ioq *ioq,
+						uint32_t            nr)
+{
+	uint32_t here = m0_locality_here()->lo_idx % ioq->ioq_shard_nr;
+	uint32_t i;
+
+	for (i = 0; i < ioq->ioq_shard_nr; ++i) {
+		struct m0_stob_ioq_shard *ios;
+
+		ios = &ioq->ioq_shard[(here + i) % ioq->ioq_shard_nr];
+		if (ioq_shard_room(ios) >= nr)
+			return ios;
+	}
+	return &ioq->ioq_shard[here];
+}
+
 /**
    Launch asynchronous IO.
 
@@ -204,21 +292,22 @@ static void stob_linux_io_fini(struct m0_stob_io *io)
  */
 static int stob_linux_io_launch(struct m0_stob_io *io)
 {
-	struct m0_stob_linux *lstob = m0_stob_linux_container(io->si_obj);
-	struct stob_linux_io *lio   = io->si_stob_private;
-	struct m0_stob_ioq   *ioq   = lio->si_ioq;
-	struct ioq_qev       *qev;
-	struct iovec         *iov;
-	struct m0_vec_cursor  src;
-	struct m0_vec_cursor  dst;
-	uint32_t              frags = 0;
-	uint32_t              chunks; /* contiguous stob chunks */
-	m0_bcount_t           frag_size;
-	int                   result = 0;
-	int                   i;
-	bool                  eosrc;
-	bool                  eodst;
-	int                   opcode;
+	struct m0_stob_linux     *lstob = m0_stob_linux_container(io->si_obj);
+	struct stob_linux_io     *lio   = io->si_stob_private;
+	struct m0_stob_ioq       *ioq   = lio->si_ioq;
+	struct m0_stob_ioq_shard *ios;
+	struct ioq_qev           *qev;
+	struct iovec             *iov;
+	struct m0_vec_cursor      src;
+	struct m0_vec_cursor      dst;
+	uint32_t                  frags = 0;
+	uint32_t                  chunks; /* contiguous stob chunks */
+	m0_bcount_t               frag_size;
+	int                       result = 0;
+	int                       i;
+	bool                      eosrc;
+	bool                      eodst;
+	int                       opcode;
 
 	M0_PRE(M0_IN(io->si_opcode, (SIO_READ, SIO_WRITE)));
 	/* prefix fragments execution mode is not yet supported */
@@ -259,7 +348,8 @@ static int stob_linux_io_launch(struct m0_stob_io *io)
 	}
 	opcode = io->si_opcode == SIO_READ ? IO_CMD_PREADV : IO_CMD_PWRITEV;
 
-	ioq_queue_lock(ioq);
+	ios = ioq_shard_pick(ioq, lio->si_nr);
+	ioq_queue_lock(ios);
 	while (result == 0) {
 		struct iocb *iocb = &qev->iq_iocb;
 		m0_bindex_t  off = io->si_stob.iv_index[dst.vc_seg] +
@@ -313,7 +403,7 @@ static int stob_linux_io_launch(struct m0_stob_io *io)
 			qev->iq_nbytes = chunk_size << m0_stob_ioq_bshift(ioq);
 			qev->iq_offset = off << m0_stob_ioq_bshift(ioq);
 
-			ioq_queue_put(ioq, qev);
+			ioq_queue_put(ios, qev);
 
 			frags -= i;
 			if (frags == 0)
@@ -328,14 +418,14 @@ static int stob_linux_io_launch(struct m0_stob_io *io)
 	 * the lio->si_nr is correctly updated. When this lock is released,
 	 * these 'qev's may be submitted.
 	 */
-	ioq_queue_unlock(ioq);
+	ioq_queue_unlock(ios);
 out:
 	if (result != 0) {
 		M0_LOG(M0_ERROR, "Launch op=%d io=%p failed: rc=%d",
 				 io->si_opcode, io, result);
 		stob_linux_io_release(lio);
 	} else
-		ioq_queue_submit(ioq);
+		ioq_queue_submit(ios);
 
 	return result;
 }
@@ -348,49 +438,49 @@ static const struct m0_stob_io_op stob_linux_io_op = {
 /**
    Removes an element from the (non-empty) admission queue and returns it.
  */
-static struct ioq_qev *ioq_queue_get(struct m0_stob_ioq *ioq)
+static struct ioq_qev *ioq_queue_get(struct m0_stob_ioq_shard *ios)
 {
 	struct m0_queue_link *head;
 
-	M0_ASSERT(!m0_queue_is_empty(&ioq->ioq_queue));
-	M0_ASSERT(m0_mutex_is_locked(&ioq->ioq_lock));
+	M0_ASSERT(!m0_queue_is_empty(&ios->ios_queue));
+	M0_ASSERT(m0_mutex_is_locked(&ios->ios_lock));
 
-	head = m0_queue_get(&ioq->ioq_queue);
-	ioq->ioq_queued--;
-	M0_ASSERT_EX(ioq->ioq_queued == m0_queue_length(&ioq->ioq_queue));
+	head = m0_queue_get(&ios->ios_queue);
+	ios->ios_queued--;
+	M0_ASSERT_EX(ios->ios_queued == m0_queue_length(&ios->ios_queue));
 	return container_of(head, struct ioq_qev, iq_linkage);
 }
 
 /**
    Adds an element to the admission queue.
  */
-static void ioq_queue_put(struct m0_stob_ioq *ioq,
+static void ioq_queue_put(struct m0_stob_ioq_shard *ios,
 			  struct ioq_qev *qev)
 {
 	M0_ASSERT(!m0_queue_link_is_in(&qev->iq_linkage));
-	M0_ASSERT(m0_mutex_is_locked(&ioq->ioq_lock));
+	M0_ASSERT(m0_mutex_is_locked(&ios->ios_lock));
 	// M0_ASSERT(qev->iq_io->si_obj->so_domain == &ioq->sdl_base);
 
-	m0_queue_put(&ioq->ioq_queue, &qev->iq_linkage);
-	ioq->ioq_queued++;
-	M0_ASSERT_EX(ioq->ioq_queued == m0_queue_length(&ioq->ioq_queue));
+	m0_queue_put(&ios->ios_queue, &qev->iq_linkage);
+	ios->ios_queued++;
+	M0_ASSERT_EX(ios->ios_queued == m0_queue_length(&ios->ios_queue));
 }
 
-static void ioq_queue_lock(struct m0_stob_ioq *ioq)
+static void ioq_queue_lock(struct m0_stob_ioq_shard *ios)
 {
-	m0_mutex_lock(&ioq->ioq_lock);
+	m0_mutex_lock(&ios->ios_lock);
 }
 
-static void ioq_queue_unlock(struct m0_stob_ioq *ioq)
+static void ioq_queue_unlock(struct m0_stob_ioq_shard *ios)
 {
-	m0_mutex_unlock(&ioq->ioq_lock);
+	m0_mutex_unlock(&ios->ios_lock);
 }
 
 /**
    Transfers fragments from the admission queue to the ring buffer in batches
    until the ring buffer is full.
  */
-static void ioq_queue_submit(struct m0_stob_ioq *ioq)
+static void ioq_queue_submit(struct m0_stob_ioq_shard *ios)
 {
 	int got;
 	int put;
@@ -400,30 +490,34 @@ static void ioq_queue_submit(struct m0_stob_ioq *ioq)
 	struct ioq_qev  *qev[M0_STOB_IOQ_BATCH_IN_SIZE];
 	struct iocb    *evin[M0_STOB_IOQ_BATCH_IN_SIZE];
 
+	if (ios->ios_ioq->ioq_engine == M0_STOB_IOQ_URING) {
+		ioq_uring_submit(ios);
+		return;
+	}
 	do {
-		ioq_queue_lock(ioq);
-		avail = m0_atomic64_get(&ioq->ioq_avail);
-		got = min32(ioq->ioq_queued, min32(avail, ARRAY_SIZE(evin)));
-		m0_atomic64_sub(&ioq->ioq_avail, got);
+		ioq_queue_lock(ios);
+		avail = m0_atomic64_get(&ios->ios_avail);
+		got = min32(ios->ios_queued, min32(avail, ARRAY_SIZE(evin)));
+		m0_atomic64_sub(&ios->ios_avail, got);
 		for (i = 0; i < got; ++i) {
-			qev[i] = ioq_queue_get(ioq);
+			qev[i] = ioq_queue_get(ios);
 			evin[i] = &qev[i]->iq_iocb;
 		}
-		ioq_queue_unlock(ioq);
+		ioq_queue_unlock(ios);
 
 		if (got > 0) {
-			put = io_submit(ioq->ioq_ctx, got, evin);
+			put = io_submit(ios->ios_ctx, got, evin);
 			if (put < 0)
 				M0_LOG(M0_ERROR, "got=%d put=%d", got, put);
 			if (put < 0)
 				put = 0;
-			ioq_queue_lock(ioq);
+			ioq_queue_lock(ios);
 			for (i = put; i < got; ++i)
-				ioq_queue_put(ioq, qev[i]);
-			ioq_queue_unlock(ioq);
+				ioq_queue_put(ios, qev[i]);
+			ioq_queue_unlock(ios);
 
 			if (got > put)
-				m0_atomic64_add(&ioq->ioq_avail, got - put);
+				m0_atomic64_add(&ios->ios_avail, got - put);
 		}
 	} while (got > 0);
 }
@@ -493,7 +587,7 @@ int64_t emulate_disk_errors_nr = 0;
    m0_stob_io::si_wait.
  */
 static void ioq_complete(struct m0_stob_ioq *ioq, struct ioq_qev *qev,
-			 long res, long res2)
+			 long res)
 {
 	struct m0_stob_io    *io   = qev->iq_io;
 	struct stob_linux_io *lio  = io->si_stob_private;
@@ -588,6 +682,437 @@ static void ioq_complete(struct m0_stob_ioq *ioq, struct ioq_qev *qev,
 	}
 }
 
+#ifdef HAVE_IO_URING
+
+enum {
+	/**
+	 * How many times ioq_uring_submit() repeats io_uring_enter(2) which
+	 * failed transiently before leaving the entries to the workers.
+	 */
+	IOQ_URING_ENTER_RETRY_NR = 4,
+	/**
+	 * Pause of a worker after the kernel refused to take the entries
+	 * left in the submission ring with -EAGAIN.
+	 */
+	IOQ_URING_EAGAIN_DELAY_NS = 100000,
+};
+
+/** io_uring instance of a m0_stob_ioq_shard. */
+struct ioq_uring {
+	/** File descriptor returned by io_uring_setup(2). */
+	int                     iu_fd;
+	struct io_uring_params  iu_params;
+	void                   *iu_sq_ring;
+	size_t                  iu_sq_ring_size;
+	void                   *iu_cq_ring;
+	size_t                  iu_cq_ring_size;
+	struct io_uring_sqe    *iu_sqes;
+	unsigned               *iu_sq_head;
+	/** Updated under m0_stob_ioq_shard::ios_lock. */
+	unsigned               *iu_sq_tail;
+	unsigned               *iu_sq_flags;
+	unsigned                iu_sq_mask;
+	/** Updated under iu_cq_lock. */
+	unsigned               *iu_cq_head;
+	unsigned               *iu_cq_tail;
+	unsigned                iu_cq_mask;
+	struct io_uring_cqe    *iu_cqes;
+	/** Serialises completion ring reaping. */
+	struct m0_mutex         iu_cq_lock;
+};
+
+static unsigned ioq_uring_load(const unsigned *p)
+{
+	return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void ioq_uring_store(unsigned *p, unsigned val)
+{
+	__atomic_store_n(p, val, __ATOMIC_RELEASE);
+}
+
+static int ioq_uring_setup(unsigned entries, struct io_uring_params *p)
+{
+	int rc = syscall(__NR_io_uring_setup, entries, p);
+
+	return rc < 0 ? -errno : rc;
+}
+
+static int ioq_uring_enter(struct ioq_uring *iu, unsigned to_submit,
+			   unsigned min_complete, unsigned flags,
+			   void *arg, size_t argsz)
+{
+	int rc = syscall(__NR_io_uring_enter, iu->iu_fd, to_submit,
+			 min_complete, flags, arg, argsz);
+
+	return rc < 0 ? -errno : rc;
+}
+
+static int ioq_uring_register(struct ioq_uring *iu, unsigned opcode,
+			      void *arg, unsigned nr)
+{
+	int rc = syscall(__NR_io_uring_register, iu->iu_fd, opcode, arg, nr);
+
+	return rc < 0 ? -errno : rc;
+}
+
+static void *ioq_uring_mmap(struct ioq_uring *iu, size_t size, off_t offset)
+{
+	void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			  MAP_SHARED | MAP_POPULATE, iu->iu_fd, offset);
+
+	return addr == MAP_FAILED ? NULL : addr;
+}
+
+static int ioq_uring_rings_map(struct ioq_uring *iu)
+{
+	struct io_uring_params *p = &iu->iu_params;
+	unsigned               *array;
+	unsigned                i;
+
+	iu->iu_sq_ring_size = p->sq_off.array + p->sq_entries *
+			      sizeof(unsigned);
+	iu->iu_cq_ring_size = p->cq_off.cqes + p->cq_entries *
+			      sizeof(struct io_uring_cqe);
+	if (p->features & IORING_FEAT_SINGLE_MMAP) {
+		iu->iu_sq_ring_size = max_check(iu->iu_sq_ring_size,
+						iu->iu_cq_ring_size);
+		iu->iu_cq_ring_size = iu->iu_sq_ring_size;
+	}
+	iu->iu_sq_ring = ioq_uring_mmap(iu, iu->iu_sq_ring_size,
+					IORING_OFF_SQ_RING);
+	if (iu->iu_sq_ring == NULL)
+		return M0_ERR(-errno);
+	iu->iu_cq_ring = p->features & IORING_FEAT_SINGLE_MMAP ?
+		iu->iu_sq_ring :
+		ioq_uring_mmap(iu, iu->iu_cq_ring_size, IORING_OFF_CQ_RING);
+	if (iu->iu_cq_ring == NULL)
+		return M0_ERR(-errno);
+	iu->iu_sqes = ioq_uring_mmap(iu, p->sq_entries *
+				     sizeof(struct io_uring_sqe),
+				     IORING_OFF_SQES);
+	if (iu->iu_sqes == NULL)
+		return M0_ERR(-errno);
+
+	iu->iu_sq_head  = iu->iu_sq_ring + p->sq_off.head;
+	iu->iu_sq_tail  = iu->iu_sq_ring + p->sq_off.tail;
+	iu->iu_sq_flags = iu->iu_sq_ring + p->sq_off.flags;
+	iu->iu_sq_mask  = *(unsigned *)(iu->iu_sq_ring + p->sq_off.ring_mask);
+	iu->iu_cq_head  = iu->iu_cq_ring + p->cq_off.head;
+	iu->iu_cq_tail  = iu->iu_cq_ring + p->cq_off.tail;
+	iu->iu_cq_mask  = *(unsigned *)(iu->iu_cq_ring + p->cq_off.ring_mask);
+	iu->iu_cqes     = iu->iu_cq_ring + p->cq_off.cqes;
+	/* Submission queue entry i always goes to slot i. */
+	array = iu->iu_sq_ring + p->sq_off.array;
+	for (i = 0; i < p->sq_entries; ++i)
+		array[i] = i;
+	return 0;
+}
+
+/** Registers sparse table of files, slots are filled on stob open. */
+static int ioq_uring_files_init(struct ioq_uring *iu)
+{
+	int *fds;
+	int  rc;
+	int  i;
+
+	M0_ALLOC_ARR(fds, M0_STOB_IOQ_URING_FILES_NR);
+	if (fds == NULL)
+		return M0_ERR(-ENOMEM);
+	for (i = 0; i < M0_STOB_IOQ_URING_FILES_NR; ++i)
+		fds[i] = -1;
+	rc = ioq_uring_register(iu, IORING_REGISTER_FILES, fds,
+				M0_STOB_IOQ_URING_FILES_NR);
+	m0_free(fds);
+	return rc < 0 ? M0_ERR(rc) : 0;
+}
+
+static int ioq_uring_init(struct m0_stob_ioq_shard *ios, bool sqpoll)
+{
+	struct ioq_uring *iu;
+	int               rc;
+
+	M0_ENTRY("ios=%p sqpoll=%d", ios, !!sqpoll);
+
+	if (M0_FI_ENABLED("no_uring"))
+		return M0_ERR(-ENOSYS);
+	M0_ALLOC_PTR(iu);
+	if (iu == NULL)
+		return M0_ERR(-ENOMEM);
+	ios->ios_uring = iu;
+	m0_mutex_init(&iu->iu_cq_lock);
+	if (sqpoll) {
+		iu->iu_params.flags          = IORING_SETUP_SQPOLL;
+		iu->iu_params.sq_thread_idle = M0_STOB_IOQ_URING_SQPOLL_IDLE;
+	}
+	rc = iu->iu_fd = ioq_uring_setup(ios->ios_ioq->ioq_ring_size,
+					 &iu->iu_params);
+	if (rc >= 0)
+		rc = (iu->iu_params.features & IORING_FEAT_EXT_ARG) == 0 ?
+			M0_ERR(-ENOSYS) :
+			ioq_uring_rings_map(iu) ?: ioq_uring_files_init(iu);
+	if (rc != 0)
+		ioq_uring_fini(ios);
+	return M0_RC(rc);
+}
+
+static void ioq_uring_fini(struct m0_stob_ioq_shard *ios)
+{
+	struct ioq_uring *iu = ios->ios_uring;
+
+	if (iu == NULL)
+		return;
+	if (iu->iu_sqes != NULL)
+		munmap(iu->iu_sqes,
+		       iu->iu_params.sq_entries * sizeof(struct io_uring_sqe));
+	if (iu->iu_cq_ring != NULL && iu->iu_cq_ring != iu->iu_sq_ring)
+		munmap(iu->iu_cq_ring, iu->iu_cq_ring_size);
+	if (iu->iu_sq_ring != NULL)
+		munmap(iu->iu_sq_ring, iu->iu_sq_ring_size);
+	/* Registered files are released together with the ring. */
+	if (iu->iu_fd >= 0)
+		close(iu->iu_fd);
+	m0_mutex_fini(&iu->iu_cq_lock);
+	m0_free0(&ios->ios_uring);
+}
+
+static void ioq_uring_sqe_fill(struct io_uring_sqe *sqe, struct ioq_qev *qev)
+{
+	struct m0_stob_linux *lstob = m0_stob_linux_container(qev->iq_io->
+							      si_obj);
+	struct iocb          *iocb  = &qev->iq_iocb;
+
+	M0_SET0(sqe);
+	sqe->opcode = iocb->aio_lio_opcode == IO_CMD_PREADV ?
+		IORING_OP_READV : IORING_OP_WRITEV;
+	if (lstob->sl_fd_idx >= 0) {
+		sqe->fd    = lstob->sl_fd_idx;
+		sqe->flags = IOSQE_FIXED_FILE;
+	} else
+		sqe->fd    = iocb->aio_fildes;
+	sqe->addr      = (uintptr_t)iocb->u.v.vec;
+	sqe->len       = iocb->u.v.nr;
+	sqe->off       = iocb->u.v.offset;
+	sqe->user_data = (uintptr_t)qev;
+}
+
+/**
+   Moves as many fragments as fit from the admission queue to the submission
+   ring and submits them with one system call.
+
+   Fragments placed into the ring are never returned to the admission queue.
+   If io_uring_enter(2) fails transiently, it is repeated up to
+   IOQ_URING_ENTER_RETRY_NR times. Entries which are still not submitted
+   stay in the ring and are submitted by the next io_uring_enter(2) of a
+   worker in ioq_uring_getevents().
+ */
+static void ioq_uring_submit(struct m0_stob_ioq_shard *ios)
+{
+	struct ioq_uring *iu = ios->ios_uring;
+	unsigned          head;
+	unsigned          tail;
+	int               got;
+	int               rc;
+	int               i;
+
+	ioq_queue_lock(ios);
+	head = ioq_uring_load(iu->iu_sq_head);
+	tail = *iu->iu_sq_tail;
+	got  = min32(ios->ios_queued,
+		     min32(m0_atomic64_get(&ios->ios_avail),
+			   iu->iu_params.sq_entries - (tail - head)));
+	m0_atomic64_sub(&ios->ios_avail, got);
+	for (i = 0; i < got; ++i, ++tail)
+		ioq_uring_sqe_fill(&iu->iu_sqes[tail & iu->iu_sq_mask],
+				   ioq_queue_get(ios));
+	ioq_uring_store(iu->iu_sq_tail, tail);
+	ioq_queue_unlock(ios);
+
+	if (iu->iu_params.flags & IORING_SETUP_SQPOLL) {
+		m0_mb();
+		rc = ioq_uring_load(iu->iu_sq_flags) & IORING_SQ_NEED_WAKEUP ?
+			ioq_uring_enter(iu, 0, 0, IORING_ENTER_SQ_WAKEUP,
+					NULL, 0) : 0;
+	} else {
+		for (rc = 0, i = 0; tail != head &&
+			     i < IOQ_URING_ENTER_RETRY_NR; ++i) {
+			rc = ioq_uring_enter(iu, tail - head, 0, 0, NULL, 0);
+			if (!M0_IN(rc, (-EAGAIN, -EBUSY, -EINTR)))
+				break;
+			/* Others may have submitted some entries meanwhile. */
+			head = ioq_uring_load(iu->iu_sq_head);
+			tail = ioq_uring_load(iu->iu_sq_tail);
+		}
+	}
+	if (rc < 0 && !M0_IN(rc, (-EAGAIN, -EBUSY, -EINTR)))
+		M0_LOG(M0_ERROR, "got=%d rc=%d", got, rc);
+	else if (rc < 0)
+		M0_LOG(M0_WARN, "got=%d rc=%d, left to the workers", got, rc);
+}
+
+/**
+   Number of entries in the submission ring which were not submitted
+   because io_uring_enter(2) in ioq_uring_submit() failed. 0 with SQPOLL,
+   where the kernel thread submits them.
+ */
+static unsigned ioq_uring_sq_pending(struct ioq_uring *iu)
+{
+	if (iu->iu_params.flags & IORING_SETUP_SQPOLL)
+		return 0;
+	return ioq_uring_load(iu->iu_sq_tail) - ioq_uring_load(iu->iu_sq_head);
+}
+
+/**
+   Waits for at least one completion event for @timeout and reaps up to @nr
+   events from the completion ring.
+ */
+static int ioq_uring_getevents(struct m0_stob_ioq_shard *ios,
+			       struct ioq_event         *ev,
+			       int                       nr,
+			       const struct timespec    *timeout)
+{
+	struct ioq_uring              *iu = ios->ios_uring;
+	struct io_uring_cqe           *cqe;
+	struct __kernel_timespec       ts = {
+		.tv_sec  = timeout->tv_sec,
+		.tv_nsec = timeout->tv_nsec
+	};
+	struct io_uring_getevents_arg  arg = {
+		.ts = (uintptr_t)&ts
+	};
+	unsigned                       pending;
+	unsigned                       head;
+	unsigned                       tail;
+	int                            got;
+	int                            rc;
+
+	/*
+	 * Submit the entries left by a failed ioq_uring_submit() before
+	 * waiting, so that they don't wait for the timeout. If the kernel
+	 * still can't take them, the call fails at once and the caller
+	 * retries on the next iteration.
+	 */
+	pending = ioq_uring_sq_pending(iu);
+	rc = ioq_uring_enter(iu, pending, 1,
+			     IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+			     &arg, sizeof arg);
+	if (rc < 0 && !M0_IN(rc, (-ETIME, -EAGAIN, -EBUSY, -EINTR)))
+		M0_LOG(M0_ERROR, "rc=%d", rc);
+	else if (rc == -EAGAIN && pending != 0)
+		m0_nanosleep(M0_MKTIME(0, IOQ_URING_EAGAIN_DELAY_NS), NULL);
+
+	m0_mutex_lock(&iu->iu_cq_lock);
+	head = *iu->iu_cq_head;
+	tail = ioq_uring_load(iu->iu_cq_tail);
+	for (got = 0; head != tail && got < nr; ++got, ++head) {
+		cqe = &iu->iu_cqes[head & iu->iu_cq_mask];
+		ev[got].ie_qev = (struct ioq_qev *)(uintptr_t)cqe->user_data;
+		ev[got].ie_res = cqe->res;
+	}
+	ioq_uring_store(iu->iu_cq_head, head);
+	m0_mutex_unlock(&iu->iu_cq_lock);
+	return got;
+}
+
+static int ioq_uring_files_update(struct ioq_uring *iu, int idx, int fd)
+{
+	struct io_uring_files_update update = {
+		.offset = idx,
+		.fds    = (uintptr_t)&fd
+	};
+
+	return ioq_uring_register(iu, IORING_REGISTER_FILES_UPDATE,
+				  &update, 1);
+}
+
+/** Sets slot @idx of the registered files tables of shards [0, nr). */
+static int ioq_uring_files_set(struct m0_stob_ioq *ioq, int nr, int idx,
+			       int fd)
+{
+	int rc;
+	int i;
+
+	for (i = 0; i < nr; ++i) {
+		rc = ioq_uring_files_update(ioq->ioq_shard[i].ios_uring,
+					    idx, fd);
+		if (rc != 1) {
+			M0_LOG(M0_WARN, "shard=%d idx=%d fd=%d rc=%d",
+			       i, idx, fd, rc);
+			return i;
+		}
+	}
+	return nr;
+}
+
+static int ioq_uring_fd_register(struct m0_stob_ioq *ioq, int fd)
+{
+	struct m0_bitmap *files = &ioq->ioq_files;
+	int               nr = ioq->ioq_shard_nr;
+	int               done;
+	int               idx;
+
+	m0_mutex_lock(&ioq->ioq_files_lock);
+	for (idx = 0; idx < files->b_nr && m0_bitmap_get(files, idx); ++idx)
+		;
+	if (idx < files->b_nr) {
+		done = ioq_uring_files_set(ioq, nr, idx, fd);
+		if (done == nr) {
+			m0_bitmap_set(files, idx, true);
+		} else {
+			ioq_uring_files_set(ioq, done, idx, -1);
+			idx = -1;
+		}
+	} else
+		idx = -1;
+	m0_mutex_unlock(&ioq->ioq_files_lock);
+	return idx;
+}
+
+static void ioq_uring_fd_unregister(struct m0_stob_ioq *ioq, int idx)
+{
+	m0_mutex_lock(&ioq->ioq_files_lock);
+	M0_PRE(m0_bitmap_get(&ioq->ioq_files, idx));
+	ioq_uring_files_set(ioq, ioq->ioq_shard_nr, idx, -1);
+	m0_bitmap_set(&ioq->ioq_files, idx, false);
+	m0_mutex_unlock(&ioq->ioq_files_lock);
+}
+
+#else /* !HAVE_IO_URING */
+
+static int ioq_uring_init(struct m0_stob_ioq_shard *ios, bool sqpoll)
+{
+	return M0_ERR(-ENOSYS);
+}
+
+static void ioq_uring_fini(struct m0_stob_ioq_shard *ios)
+{
+}
+
+static void ioq_uring_submit(struct m0_stob_ioq_shard *ios)
+{
+	M0_IMPOSSIBLE("io_uring is not supported");
+}
+
+static int ioq_uring_getevents(struct m0_stob_ioq_shard *ios,
+			       struct ioq_event         *ev,
+			       int                       nr,
+			       const struct timespec    *timeout)
+{
+	M0_IMPOSSIBLE("io_uring is not supported");
+	return 0;
+}
+
+static int ioq_uring_fd_register(struct m0_stob_ioq *ioq, int fd)
+{
+	return -1;
+}
+
+static void ioq_uring_fd_unregister(struct m0_stob_ioq *ioq, int idx)
+{
+}
+
+#endif /* HAVE_IO_URING */
+
 static const struct timespec ioq_timeout_default = {
 	.tv_sec  = 1,
 	.tv_nsec = 0
@@ -601,132 +1126,258 @@ static unsigned long stob_ioq_timer_cb(unsigned long data)
 	return 0;
 }
 
-static int stob_ioq_thread_init(struct m0_stob_ioq *ioq)
+static int stob_ioq_thread_init(struct m0_stob_ioq_shard *ios)
 {
-	struct m0_timer_locality *timer_loc;
-	int                       thread_index;
+	struct m0_timer_locality *timer_loc = &ios->ios_stop_timer_loc;
 	int rc;
 
-	thread_index = m0_thread_self() - ioq->ioq_thread;
-	timer_loc = &ioq->ioq_stop_timer_loc[thread_index];
 	m0_timer_locality_init(timer_loc);
 	rc = m0_timer_thread_attach(timer_loc);
 	if (rc != 0) {
 		m0_timer_locality_fini(timer_loc);
 		return M0_ERR(rc);
 	}
-	rc = m0_timer_init(&ioq->ioq_stop_timer[thread_index], M0_TIMER_HARD,
+	rc = m0_timer_init(&ios->ios_stop_timer, M0_TIMER_HARD,
 	                   timer_loc, &stob_ioq_timer_cb,
-	                   (unsigned long)&ioq->ioq_stop_sem[thread_index]);
+	                   (unsigned long)&ios->ios_stop_sem);
 	if (rc != 0) {
 		m0_timer_thread_detach(timer_loc);
 		m0_timer_locality_fini(timer_loc);
 		return M0_ERR(rc);
 	}
-	m0_semaphore_init(&ioq->ioq_stop_sem[thread_index], 0);
+	m0_semaphore_init(&ios->ios_stop_sem, 0);
 	return M0_RC(rc);
 }
 
+static int ioq_aio_getevents(struct m0_stob_ioq_shard *ios,
+			     struct ioq_event         *ev,
+			     int                       nr,
+			     const struct timespec    *timeout)
+{
+	struct io_event evout[M0_STOB_IOQ_BATCH_OUT_SIZE];
+	struct timespec ts = *timeout;
+	int             got;
+	int             i;
+
+	M0_PRE(nr <= ARRAY_SIZE(evout));
+
+	got = io_getevents(ios->ios_ctx, 1, nr, evout, &ts);
+	for (i = 0; i < got; ++i) {
+		ev[i].ie_qev = container_of(evout[i].obj, struct ioq_qev,
+					    iq_iocb);
+		ev[i].ie_res = evout[i].res;
+	}
+	return got;
+}
+
 /**
-   Linux adieu worker thread.
+   Linux adieu worker thread of a shard.
 
    Listens to the completion events from the ring buffer. Delivers completion
    events to the users. Moves fragments from the admission queue to the ring
    buffer.
  */
-static void stob_ioq_thread(struct m0_stob_ioq *ioq)
+static void stob_ioq_thread(struct m0_stob_ioq_shard *ios)
 {
 	int got;
 	int avail;
 	int i;
-	struct io_event      evout[M0_STOB_IOQ_BATCH_OUT_SIZE];
-	struct timespec      timeout;
+	struct m0_stob_ioq  *ioq = ios->ios_ioq;
+	struct ioq_event     evout[M0_STOB_IOQ_BATCH_OUT_SIZE];
 	struct m0_addb2_hist inflight = {};
 	struct m0_addb2_hist queued   = {};
 	struct m0_addb2_hist gotten   = {};
-	int                  thread_index;
 
-	thread_index = m0_thread_self() - ioq->ioq_thread;
-	M0_ADDB2_PUSH(M0_AVI_STOB_IOQ, thread_index);
+	M0_ADDB2_PUSH(M0_AVI_STOB_IOQ, ios - ioq->ioq_shard);
 	m0_addb2_hist_add_auto(&inflight, 1000, M0_AVI_STOB_IOQ_INFLIGHT, -1);
 	m0_addb2_hist_add_auto(&queued,   1000, M0_AVI_STOB_IOQ_QUEUED, -1);
 	m0_addb2_hist_add_auto(&gotten,   1000, M0_AVI_STOB_IOQ_GOT, -1);
-	while (!m0_semaphore_trydown(&ioq->ioq_stop_sem[thread_index])) {
-		timeout = ioq_timeout_default;
-		got = io_getevents(ioq->ioq_ctx, 1, ARRAY_SIZE(evout),
-				   evout, &timeout);
+	while (!m0_semaphore_trydown(&ios->ios_stop_sem)) {
+		got = ioq->ioq_engine == M0_STOB_IOQ_URING ?
+			ioq_uring_getevents(ios, evout, ARRAY_SIZE(evout),
+					    &ioq_timeout_default) :
+			ioq_aio_getevents(ios, evout, ARRAY_SIZE(evout),
+					  &ioq_timeout_default);
 		if (got > 0) {
-			avail = m0_atomic64_add_return(&ioq->ioq_avail, got);
-			M0_ASSERT(avail <= M0_STOB_IOQ_RING_SIZE);
+			avail = m0_atomic64_add_return(&ios->ios_avail, got);
+			M0_ASSERT(avail <= ioq->ioq_ring_size);
 		}
 		for (i = 0; i < got; ++i) {
-			struct ioq_qev  *qev;
-			struct io_event *iev;
+			struct ioq_qev *qev = evout[i].ie_qev;
 
-			iev = &evout[i];
-			qev = container_of(iev->obj, struct ioq_qev, iq_iocb);
 			M0_ASSERT(!m0_queue_link_is_in(&qev->iq_linkage));
-			ioq_complete(ioq, qev, iev->res, iev->res2);
+			ioq_complete(ioq, qev, evout[i].ie_res);
 		}
-		ioq_queue_submit(ioq);
+		ioq_queue_submit(ios);
 		m0_addb2_hist_mod(&gotten, got);
-		m0_addb2_hist_mod(&queued, ioq->ioq_queued);
-		m0_addb2_hist_mod(&inflight, M0_STOB_IOQ_RING_SIZE -
-				     m0_atomic64_get(&ioq->ioq_avail));
+		m0_addb2_hist_mod(&queued, ios->ios_queued);
+		m0_addb2_hist_mod(&inflight, ioq->ioq_ring_size -
+				     m0_atomic64_get(&ios->ios_avail));
 		m0_addb2_force(M0_MKTIME(5, 0));
 	}
 	m0_addb2_pop(M0_AVI_STOB_IOQ);
-	m0_semaphore_fini(&ioq->ioq_stop_sem[thread_index]);
-	m0_timer_stop(&ioq->ioq_stop_timer[thread_index]);
-	m0_timer_fini(&ioq->ioq_stop_timer[thread_index]);
-	m0_timer_thread_detach(&ioq->ioq_stop_timer_loc[thread_index]);
-	m0_timer_locality_fini(&ioq->ioq_stop_timer_loc[thread_index]);
+	m0_semaphore_fini(&ios->ios_stop_sem);
+	m0_timer_stop(&ios->ios_stop_timer);
+	m0_timer_fini(&ios->ios_stop_timer);
+	m0_timer_thread_detach(&ios->ios_stop_timer_loc);
+	m0_timer_locality_fini(&ios->ios_stop_timer_loc);
+}
+
+static void ioq_shard_init(struct m0_stob_ioq       *ioq,
+			   struct m0_stob_ioq_shard *ios)
+{
+	ios->ios_ioq    = ioq;
+	ios->ios_ctx    = NULL;
+	ios->ios_uring  = NULL;
+	ios->ios_queued = 0;
+	m0_atomic64_set(&ios->ios_avail, ioq->ioq_ring_size);
+	m0_queue_init(&ios->ios_queue);
+	m0_mutex_init(&ios->ios_lock);
 }
 
-M0_INTERNAL int m0_stob_ioq_init(struct m0_stob_ioq *ioq)
+static void ioq_shard_fini(struct m0_stob_ioq_shard *ios)
 {
-	int result;
+	if (ios->ios_ctx != NULL)
+		io_destroy(ios->ios_ctx);
+	ioq_uring_fini(ios);
+	m0_queue_fini(&ios->ios_queue);
+	m0_mutex_fini(&ios->ios_lock);
+}
+
+/**
+   Confines the worker thread of shard @idx to the processors of the NUMA node
+   of locality @idx, which launches the requests served by the shard. Failure
+   is not fatal, the thread is left unconfined then.
+ */
+static void ioq_shard_place(struct m0_stob_ioq_shard *ios, uint32_t idx)
+{
+	struct m0_processor_descr pd;
+	struct m0_bitmap          map;
+	m0_processor_nr_t         nr = m0_processor_nr_max();
+	m0_processor_nr_t         i;
+	uint32_t                  node;
+	int                       rc;
+
+	if (m0_processor_describe(idx, &pd) != 0 ||
+	    pd.pd_numa_node == M0_PROCESSORS_INVALID_ID ||
+	    m0_bitmap_init(&map, nr) != 0)
+		return;
+	node = pd.pd_numa_node;
+	for (i = 0; i < nr; ++i)
+		m0_bitmap_set(&map, i, m0_processor_describe(i, &pd) == 0 &&
+			      pd.pd_numa_node == node);
+	rc = m0_thread_confine(&ios->ios_thread, &map);
+	if (rc != 0)
+		M0_LOG(M0_WARN, "shard=%u node=%u rc=%d", idx, node, rc);
+	m0_bitmap_fini(&map);
+}
+
+/** Sets io_uring up in all shards, or in none of them. */
+static int ioq_uring_shards_init(struct m0_stob_ioq *ioq, bool sqpoll)
+{
+	int result = 0;
 	int i;
 
-	ioq->ioq_ctx      = NULL;
-	m0_atomic64_set(&ioq->ioq_avail, M0_STOB_IOQ_RING_SIZE);
-	ioq->ioq_queued   = 0;
-
-	m0_queue_init(&ioq->ioq_queue);
-	m0_mutex_init(&ioq->ioq_lock);
-
-	result = io_setup(M0_STOB_IOQ_RING_SIZE, &ioq->ioq_ctx);
-	if (result == 0) {
-		for (i = 0; i < ARRAY_SIZE(ioq->ioq_thread); ++i) {
-			result = M0_THREAD_INIT(&ioq->ioq_thread[i],
-			                        struct m0_stob_ioq *,
-			                        &stob_ioq_thread_init,
-						&stob_ioq_thread, ioq,
-						"ioq_thread%d", i);
-			if (result != 0)
-				break;
-			m0_stob_ioq_directio_setup(ioq, false);
-		}
+	for (i = 0; i < ioq->ioq_shard_nr && result == 0; ++i)
+		result = ioq_uring_init(&ioq->ioq_shard[i], sqpoll);
+	if (result != 0) {
+		while (--i >= 0)
+			ioq_uring_fini(&ioq->ioq_shard[i]);
 	}
-	if (result != 0)
+	return result;
+}
+
+M0_INTERNAL int m0_stob_ioq_init(struct m0_stob_ioq     *ioq,
+				 enum m0_stob_ioq_engine engine,
+				 bool                    sqpoll)
+{
+	struct m0_stob_ioq_shard *ios;
+	int                       result;
+	int                       i;
+
+	ioq->ioq_engine    = M0_STOB_IOQ_AIO;
+	ioq->ioq_shard_nr  = m0_localities_nr();
+	ioq->ioq_ring_size = max32u(M0_STOB_IOQ_RING_SIZE / ioq->ioq_shard_nr,
+				    M0_STOB_IOQ_SHARD_RING_MIN);
+	m0_mutex_init(&ioq->ioq_files_lock);
+	M0_ALLOC_ARR(ioq->ioq_shard, ioq->ioq_shard_nr);
+	if (ioq->ioq_shard == NULL) {
+		m0_stob_ioq_fini(ioq);
+		return M0_ERR(-ENOMEM);
+	}
+	for (i = 0; i < ioq->ioq_shard_nr; ++i)
+		ioq_shard_init(ioq, &ioq->ioq_shard[i]);
+	result = m0_bitmap_init(&ioq->ioq_files, M0_STOB_IOQ_URING_FILES_NR);
+	if (result != 0) {
+		m0_stob_ioq_fini(ioq);
+		return M0_ERR(result);
+	}
+
+	if (engine == M0_STOB_IOQ_URING) {
+		result = ioq_uring_shards_init(ioq, sqpoll);
+		if (result == 0)
+			ioq->ioq_engine = M0_STOB_IOQ_URING;
+		else
+			M0_LOG(M0_WARN, "io_uring is not available, rc=%d, "
+			       "using AIO", result);
+	}
+	result = 0;
+	for (i = 0; i < ioq->ioq_shard_nr && result == 0; ++i) {
+		ios = &ioq->ioq_shard[i];
+		if (ioq->ioq_engine == M0_STOB_IOQ_AIO)
+			result = io_setup(ioq->ioq_ring_size,
+					  &ios->ios_ctx);
+		if (result != 0)
+			break;
+		result = M0_THREAD_INIT(&ios->ios_thread,
+					struct m0_stob_ioq_shard *,
+					&stob_ioq_thread_init,
+					&stob_ioq_thread, ios,
+					"ioq_thread%d", i);
+		/* With a single shard there is no locality to follow. */
+		if (result == 0 && ioq->ioq_shard_nr > 1)
+			ioq_shard_place(ios, i);
+	}
+	if (result == 0)
+		m0_stob_ioq_directio_setup(ioq, false);
+	else
 		m0_stob_ioq_fini(ioq);
 	return result;
 }
 
 M0_INTERNAL void m0_stob_ioq_fini(struct m0_stob_ioq *ioq)
 {
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(ioq->ioq_stop_timer); ++i)
-		m0_timer_start(&ioq->ioq_stop_timer[i], M0_TIME_IMMEDIATELY);
-	for (i = 0; i < ARRAY_SIZE(ioq->ioq_thread); ++i) {
-		if (ioq->ioq_thread[i].t_func != NULL)
-			m0_thread_join(&ioq->ioq_thread[i]);
+	struct m0_stob_ioq_shard *ios;
+	int                       i;
+
+	for (i = 0; ioq->ioq_shard != NULL && i < ioq->ioq_shard_nr; ++i) {
+		ios = &ioq->ioq_shard[i];
+		if (ios->ios_thread.t_func != NULL)
+			m0_timer_start(&ios->ios_stop_timer,
+				       M0_TIME_IMMEDIATELY);
+	}
+	for (i = 0; ioq->ioq_shard != NULL && i < ioq->ioq_shard_nr; ++i) {
+		ios = &ioq->ioq_shard[i];
+		if (ios->ios_thread.t_func != NULL)
+			m0_thread_join(&ios->ios_thread);
+		ioq_shard_fini(ios);
 	}
-	if (ioq->ioq_ctx != NULL)
-		io_destroy(ioq->ioq_ctx);
-	m0_queue_fini(&ioq->ioq_queue);
-	m0_mutex_fini(&ioq->ioq_lock);
+	m0_free0(&ioq->ioq_shard);
+	if (ioq->ioq_files.b_words != NULL)
+		m0_bitmap_fini(&ioq->ioq_files);
+	m0_mutex_fini(&ioq->ioq_files_lock);
+}
+
+M0_INTERNAL int m0_stob_ioq_fd_register(struct m0_stob_ioq *ioq, int fd)
+{
+	return ioq->ioq_engine == M0_STOB_IOQ_URING ?
+		ioq_uring_fd_register(ioq, fd) : -1;
+}
+
+M0_INTERNAL void m0_stob_ioq_fd_unregister(struct m0_stob_ioq *ioq, int idx)
+{
+	M0_PRE(ioq->ioq_engine == M0_STOB_IOQ_URING);
+	ioq_uring_fd_unregister(ioq, idx);
 }
 
 M0_INTERNAL uint32_t m0_stob_ioq_bshift(struct m0_stob_ioq *ioq)
@@ -34,6 +34,7 @@
 #include "lib/queue.h"     /* m0_queue */
 #include "lib/timer.h"     /* m0_timer */
 #include "lib/semaphore.h" /* m0_semaphore */
+#include "lib/bitmap.h"    /* m0_bitmap */
 
 /**
  * @defgroup stoblinux
@@ -43,55 +44,111 @@
 
 struct m0_stob;
 struct m0_stob_io;
+struct ioq_uring;
+
+/** Kernel interface used by m0_stob_ioq to execute I/O. */
+enum m0_stob_ioq_engine {
+	/** Linux AIO: io_submit(2) and io_getevents(2). */
+	M0_STOB_IOQ_AIO,
+	/**
+	 * io_uring(7). Needs HAVE_IO_URING at build time and Linux 5.11 or
+	 * later at run time, otherwise M0_STOB_IOQ_AIO is used.
+	 */
+	M0_STOB_IOQ_URING,
+};
 
 enum {
-	/** Default number of threads to create in a storage object domain. */
-	M0_STOB_IOQ_NR_THREADS     = 8,
-	/** Default size of a ring buffer shared by adieu and the kernel. */
+	/** Default total size of the ring buffers shared by adieu and the
+	    kernel. It is divided evenly between the shards, so that sharding
+	    does not multiply the kernel AIO slots used by a domain. */
 	M0_STOB_IOQ_RING_SIZE      = 1024,
+	/** Minimal size of the ring buffer of a shard. */
+	M0_STOB_IOQ_SHARD_RING_MIN = 32,
 	/** Size of a batch in which requests are moved from the admission queue
 	    to the ring buffer. */
 	M0_STOB_IOQ_BATCH_IN_SIZE  = 8,
 	/** Size of a batch in which completion events are extracted from the
 	    ring buffer. */
 	M0_STOB_IOQ_BATCH_OUT_SIZE = 8,
+	/** Size of the table of files registered with io_uring. */
+	M0_STOB_IOQ_URING_FILES_NR = 1024,
+	/** Idle time (in ms) after which io_uring SQPOLL thread sleeps. */
+	M0_STOB_IOQ_URING_SQPOLL_IDLE = 1000,
 };
 
-struct m0_stob_ioq {
-	/**
-	 *  Controls whether to use O_DIRECT flag for open(2).
-	 *  Can be set with m0_stob_ioq_directio_setup().
-	 *  Initial value is set to 'false'.
-	 */
-	bool                     ioq_use_directio;
-	/** Set up when domain is being shut down. adieu worker threads
-	    (ioq_thread()) check this field on each iteration. */
+/**
+ * Independent part of m0_stob_ioq: admission queue, ring buffer and worker
+ * thread. There is a shard per locality. Fragments are submitted to the shard
+ * of the locality where the request is launched, so requests from different
+ * localities don't contend, unless the ring buffer of that shard is full.
+ */
+struct m0_stob_ioq_shard {
+	/** Queue this shard belongs to. */
+	struct m0_stob_ioq      *ios_ioq;
 	/**
 	    Ring buffer shared between adieu and the kernel.
 
 	    It contains adieu request fragments currently being executed by the
 	    kernel. The kernel delivers AIO completion events through this
 	    buffer. */
-	io_context_t             ioq_ctx;
+	io_context_t             ios_ctx;
+	/** io_uring instance, used when ioq_engine is M0_STOB_IOQ_URING. */
+	struct ioq_uring        *ios_uring;
 	/** Free slots in the ring buffer. */
-	struct m0_atomic64       ioq_avail;
+	struct m0_atomic64       ios_avail;
 	/** Used slots in the ring buffer. */
-	int                      ioq_queued;
-	/** Worker threads. */
-	struct m0_thread         ioq_thread[M0_STOB_IOQ_NR_THREADS];
+	int                      ios_queued;
+	/** Worker thread. */
+	struct m0_thread         ios_thread;
 
-	/** Mutex protecting all ioq_ fields (except for the ring buffer that is
+	/** Mutex protecting all ios_ fields (except for the ring buffer that is
 	    updated by the kernel asynchronously). */
-	struct m0_mutex          ioq_lock;
+	struct m0_mutex          ios_lock;
 	/** Admission queue where adieu request fragments are kept until there
 	    is free space in the ring buffer.  */
-	struct m0_queue          ioq_queue;
-	struct m0_semaphore      ioq_stop_sem[M0_STOB_IOQ_NR_THREADS];
-	struct m0_timer          ioq_stop_timer[M0_STOB_IOQ_NR_THREADS];
-	struct m0_timer_locality ioq_stop_timer_loc[M0_STOB_IOQ_NR_THREADS];
+	struct m0_queue          ios_queue;
+	struct m0_semaphore      ios_stop_sem;
+	struct m0_timer          ios_stop_timer;
+	struct m0_timer_locality ios_stop_timer_loc;
 };
 
-M0_INTERNAL int m0_stob_ioq_init(struct m0_stob_ioq *ioq);
+struct m0_stob_ioq {
+	/**
+	 *  Controls whether to use O_DIRECT flag for open(2).
+	 *  Can be set with m0_stob_ioq_directio_setup().
+	 *  Initial value is set to 'false'.
+	 */
+	bool                     ioq_use_directio;
+	/** Engine used by this queue, see m0_stob_ioq_init(). */
+	enum m0_stob_ioq_engine  ioq_engine;
+	/** Shards, one per locality, see m0_localities_nr(). */
+	struct m0_stob_ioq_shard *ioq_shard;
+	/** Number of elements in ioq_shard. */
+	uint32_t                 ioq_shard_nr;
+	/**
+	 * Size of the ring buffer of each shard: M0_STOB_IOQ_RING_SIZE divided
+	 * between the shards, but at least M0_STOB_IOQ_SHARD_RING_MIN.
+	 */
+	uint32_t                 ioq_ring_size;
+	/**
+	 * Used slots of the registered files tables. A file has the same index
+	 * in the tables of all shards.
+	 */
+	struct m0_bitmap         ioq_files;
+	/** Protects ioq_files. */
+	struct m0_mutex          ioq_files_lock;
+};
+
+/**
+ * Initialises the queue.
+ *
+ * If @engine is M0_STOB_IOQ_URING but io_uring is not available, the queue
+ * falls back to M0_STOB_IOQ_AIO. @sqpoll asks the kernel to poll io_uring
+ * submission queue in a kernel thread, it is ignored for AIO.
+ */
+M0_INTERNAL int m0_stob_ioq_init(struct m0_stob_ioq     *ioq,
+				 enum m0_stob_ioq_engine engine,
+				 bool                    sqpoll);
 M0_INTERNAL void m0_stob_ioq_fini(struct m0_stob_ioq *ioq);
 M0_INTERNAL void m0_stob_ioq_directio_setup(struct m0_stob_ioq *ioq,
 					    bool use_directio);
@@ -101,6 +158,18 @@ M0_INTERNAL uint32_t m0_stob_ioq_bshift(struct m0_stob_ioq *ioq);
 M0_INTERNAL m0_bcount_t m0_stob_ioq_bsize(struct m0_stob_ioq *ioq);
 M0_INTERNAL m0_bcount_t m0_stob_ioq_bmask(struct m0_stob_ioq *ioq);
 
+/**
+ * Registers file descriptor with the queue, so that the kernel doesn't look
+ * it up on every I/O.
+ *
+ * Returns index of the registered file or -1 if the file is not registered
+ * (the engine doesn't support it or the table is full). I/O for a file which
+ * is not registered still works.
+ */
+M0_INTERNAL int m0_stob_ioq_fd_register(struct m0_stob_ioq *ioq, int fd);
+/** Unregisters file registered by m0_stob_ioq_fd_register(). */
+M0_INTERNAL void m0_stob_ioq_fd_unregister(struct m0_stob_ioq *ioq, int idx);
+
 M0_INTERNAL int m0_stob_linux_io_init(struct m0_stob *stob,
 				      struct m0_stob_io *io);
 
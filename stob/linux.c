@@ -71,6 +71,12 @@
    somewhere in str_cfg_init for m0_stob_domain_init() or
    m0_stob_domain_create().
 
+   <b>I/O engine</b>
+
+   Linux AIO is used by default. "ioq=uring" in str_cfg_init selects io_uring,
+   "sqpoll=true" additionally enables kernel-side submission queue polling.
+   Files of the domain are registered with io_uring when they are opened.
+
    <b>Symlinks</b>
 
    To make stob pointing to other file on the filesystem just pass filename
@@ -196,10 +202,16 @@ static int stob_linux_domain_cfg_init_parse(const char *str_cfg_init,
 			.sldc_file_mode	   = 0700,
 			.sldc_file_flags   = 0,
 			.sldc_use_directio = false,
+			.sldc_ioq_engine   = M0_STOB_IOQ_AIO,
+			.sldc_ioq_sqpoll   = false,
 		};
 		if (str_cfg_init != NULL) {
 			cfg->sldc_use_directio = strstr(str_cfg_init,
 						"directio=true") != NULL;
+			if (strstr(str_cfg_init, "ioq=uring") != NULL)
+				cfg->sldc_ioq_engine = M0_STOB_IOQ_URING;
+			cfg->sldc_ioq_sqpoll = strstr(str_cfg_init,
+						"sqpoll=true") != NULL;
 		}
 	}
 	if (rc == 0)
@@ -246,7 +258,9 @@ static int stob_linux_domain_init(struct m0_stob_type *type,
 
 	rc = rc ?: stob_linux_domain_key_get_set(path, &dom_key, true);
 	rc = rc ?: m0_stob_domain__dom_key_is_valid(dom_key) ? 0 : -EINVAL;
-	rc = rc ?: m0_stob_ioq_init(&ldom->sld_ioq);
+	rc = rc ?: m0_stob_ioq_init(&ldom->sld_ioq,
+				    ldom->sld_cfg.sldc_ioq_engine,
+				    ldom->sld_cfg.sldc_ioq_sqpoll);
 	if (rc == 0) {
 		m0_stob_ioq_directio_setup(&ldom->sld_ioq,
 					   ldom->sld_cfg.sldc_use_directio);
@@ -387,6 +401,7 @@ static int stob_linux_open(struct m0_stob *stob,
 
 	stob->so_ops = &stob_linux_ops;
 	lstob->sl_dom = ldom;
+	lstob->sl_fd_idx = -1;
 
 	file_stob = stob_linux_file_stob(ldom->sld_path, stob_fid);
 	if (file_stob == NULL)
@@ -399,6 +414,9 @@ static int stob_linux_open(struct m0_stob *stob,
 	lstob->sl_fd = rc ?: open(file_stob, flags,
 				  ldom->sld_cfg.sldc_file_mode);
 	rc = lstob->sl_fd == -1 ? -errno : stob_linux_stat(lstob);
+	if (rc == 0)
+		lstob->sl_fd_idx = m0_stob_ioq_fd_register(&ldom->sld_ioq,
+							   lstob->sl_fd);
 
 	m0_free(file_stob);
 
@@ -416,6 +434,11 @@ static void stob_linux_close(struct m0_stob_linux *lstob)
 {
 	int rc;
 
+	if (lstob->sl_fd_idx != -1) {
+		m0_stob_ioq_fd_unregister(&lstob->sl_dom->sld_ioq,
+					  lstob->sl_fd_idx);
+		lstob->sl_fd_idx = -1;
+	}
 	if (lstob->sl_fd != -1) {
 		rc = close(lstob->sl_fd);
 		M0_ASSERT(rc == 0);
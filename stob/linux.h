@@ -39,9 +39,13 @@
  */
 
 struct m0_stob_linux_domain_cfg {
-	mode_t sldc_file_mode;
-	int    sldc_file_flags;
-	bool   sldc_use_directio;
+	mode_t                  sldc_file_mode;
+	int                     sldc_file_flags;
+	bool                    sldc_use_directio;
+	/** I/O engine of the domain ioq, "ioq=uring" selects io_uring. */
+	enum m0_stob_ioq_engine sldc_ioq_engine;
+	/** Use io_uring SQPOLL mode, set with "sqpoll=true". */
+	bool                    sldc_ioq_sqpoll;
 };
 
 struct m0_stob_linux_domain {
@@ -58,6 +62,8 @@ struct m0_stob_linux {
 	struct m0_stob_linux_domain *sl_dom;
 	/** fd from returned open(2) */
 	int			     sl_fd;
+	/** index of sl_fd in the domain ioq registered files or -1 */
+	int			     sl_fd_idx;
 	/** file mode as returned by stat(2) */
 	mode_t			     sl_mode;
 	/** fid of the corresponding m0_conf_sdev object */
@@ -170,8 +170,12 @@ struct m0_stob {
 	struct m0_chan            so_ref_chan;
 	/* so_ref_chan protection. */
 	struct m0_mutex           so_ref_mutex;
+	/** Linkage into the idle LRU list of a stob cache shard. */
 	struct m0_tlink		  so_cache_linkage;
 	uint64_t		  so_cache_magic;
+	/** Linkage into the fid hash of a stob cache shard. */
+	struct m0_hlink		  so_cache_hlink;
+	uint64_t		  so_cache_hmagic;
 	void			 *so_private;
 };
 
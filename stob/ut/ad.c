@@ -19,6 +19,8 @@
  */
 
 
+#include <stdio.h>		/* printf */
+
 #include "lib/arith.h"		/* min64u */
 #include "lib/misc.h"		/* M0_SET0 */
 #include "lib/memory.h"
@@ -278,7 +280,7 @@ static int test_ad_fini(void)
 	return 0;
 }
 
-static void test_write(int nr, struct m0_dtx *tx)
+static void test_write_to(struct m0_stob *obj, int nr, struct m0_dtx *tx)
 {
 	struct m0_sm_group *grp = m0_be_ut_backend_sm_group_lookup(&ut_be);
 	struct m0_fol_frag *fol_frag;
@@ -303,7 +305,7 @@ static void test_write(int nr, struct m0_dtx *tx)
 	io.si_stob.iv_vec.v_nr = nr;
 	io.si_stob.iv_vec.v_count = stob_vc;
 	io.si_stob.iv_index = stob_vi;
-	rc = m0_stob_io_private_setup(&io, obj_fore);
+	rc = m0_stob_io_private_setup(&io, obj);
 	M0_UT_ASSERT(rc == 0);
 	m0_stob_ad_balloc_set(&io, M0_BALLOC_NORMAL_ZONE);
 
@@ -320,7 +322,7 @@ static void test_write(int nr, struct m0_dtx *tx)
 	rc = m0_dtx_open_sync(tx);
 	M0_ASSERT(rc == 0);
 
-	rc = m0_stob_io_prepare_and_launch(&io, obj_fore, tx, NULL);
+	rc = m0_stob_io_prepare_and_launch(&io, obj, tx, NULL);
 	M0_ASSERT(rc == 0);
 
 	if (is_local_tx) {
@@ -340,6 +342,11 @@ static void test_write(int nr, struct m0_dtx *tx)
 	m0_stob_io_fini(&io);
 }
 
+static void test_write(int nr, struct m0_dtx *tx)
+{
+	test_write_to(obj_fore, nr, tx);
+}
+
 static void test_read(int nr)
 {
 	int rc;
@@ -569,6 +576,14 @@ void m0_stob_ut_adieu_ad(void)
 	M0_ASSERT(rc == 0);
 }
 
+enum {
+	UB_ITER   = 100,
+	/** Number of stobs written by interleaved streams. */
+	UB_STREAM = 4,
+};
+
+static struct m0_stob *ub_stob[UB_STREAM];
+
 static void ub_write(int i)
 {
 	test_write(NR - 1, NULL);
@@ -579,18 +594,78 @@ static void ub_read(int i)
 	test_read(NR - 1);
 }
 
+/**
+ * Appends a block to each of UB_STREAM stobs in turn, like concurrent
+ * sequential writers do.
+ */
+static void ub_write_interleaved(int i)
+{
+	m0_bindex_t index = stob_vi[0];
+	int         j;
+
+	stob_vi[0] = (buf_size * i) >> block_shift;
+	for (j = 0; j < UB_STREAM; ++j)
+		test_write_to(ub_stob[j], 1, NULL);
+	stob_vi[0] = index;
+}
+
+/** Returns the number of physically contiguous runs the stob is mapped to. */
+static uint32_t ub_runs_count(struct m0_stob *obj)
+{
+	struct m0_stob_ad_domain *adom;
+	struct m0_be_emap_cursor  it;
+	struct m0_be_emap_seg    *seg;
+	m0_bindex_t               offset = 0;
+	m0_bindex_t               next   = AET_HOLE;
+	uint32_t                  runs   = 0;
+	bool                      last;
+	int                       rc;
+
+	adom = stob_ad_domain2ad(m0_stob_dom_get(obj));
+	do {
+		rc = stob_ad_cursor(adom, obj, offset, &it);
+		M0_UB_ASSERT(rc == 0);
+		seg = m0_be_emap_seg_get(&it);
+		if (seg->ee_val != AET_HOLE && seg->ee_val != next)
+			++runs;
+		next = seg->ee_val == AET_HOLE ? AET_HOLE :
+			seg->ee_val + m0_ext_length(&seg->ee_ext);
+		offset = seg->ee_ext.e_end;
+		last   = m0_be_emap_ext_is_last(&seg->ee_ext);
+		m0_be_emap_close(&it);
+	} while (!last);
+	return runs;
+}
+
 static int ub_init(const char *opts M0_UNUSED)
 {
-	return test_ad_init(false);
+	struct m0_stob_id stob_id;
+	int               rc;
+	int               i;
+
+	rc = test_ad_init(false);
+	for (i = 0; i < UB_STREAM && rc == 0; ++i) {
+		m0_stob_id_make(0, 0x57ea + i, &dom_fore->sd_id, &stob_id);
+		rc = m0_stob_find(&stob_id, &ub_stob[i]) ?:
+		     m0_stob_locate(ub_stob[i]) ?:
+		     m0_ut_stob_create(ub_stob[i], NULL, &ut_be.but_dom);
+	}
+	return rc;
 }
 
 static void ub_fini(void)
 {
+	int i;
+
+	printf("\tinterleaved: contiguous runs per stob:");
+	for (i = 0; i < UB_STREAM; ++i) {
+		printf(" %"PRIu32, ub_runs_count(ub_stob[i]));
+		m0_stob_put(ub_stob[i]);
+	}
+	printf("\n");
 	(void)test_ad_fini();
 }
 
-enum { UB_ITER = 100 };
-
 struct m0_ub_set m0_ad_ub = {
 	.us_name = "ad-ub",
 	.us_init = ub_init,
@@ -608,6 +683,10 @@ struct m0_ub_set m0_ad_ub = {
 		  .ub_iter = UB_ITER,
 		  .ub_round = ub_read },
 
+		{ .ub_name = "write-interleaved",
+		  .ub_iter = UB_ITER,
+		  .ub_round = ub_write_interleaved },
+
 		{ .ub_name = NULL }
 	}
 };
@@ -34,8 +34,10 @@
 #include "ut/ut.h"
 #include "lib/assert.h"
 #include "lib/arith.h"
+#include "lib/locality.h" /* m0_localities_nr */
 #include "stob/domain.h"
 #include "stob/io.h"
+#include "stob/linux.h"   /* m0_stob_linux_domain_container */
 #include "stob/stob.h"
 #include "fol/fol.h"
 #include "balloc/balloc.h" /* M0_BALLOC_NON_SPARE_ZONE */
@@ -77,6 +79,7 @@ static uint32_t block_shift;
 static uint32_t buf_size;
 
 static int test_adieu_init(const char *location,
+			   const char *dom_init_cfg,
 			   const char *dom_cfg,
 			   const char *stob_cfg)
 {
@@ -84,8 +87,8 @@ static int test_adieu_init(const char *location,
 	int               rc;
 	struct m0_stob_id stob_id;
 
-	rc = m0_stob_domain_create(location,
-				   NULL, M0_STOB_UT_DOMAIN_KEY, dom_cfg, &dom);
+	rc = m0_stob_domain_create(location, dom_init_cfg,
+				   M0_STOB_UT_DOMAIN_KEY, dom_cfg, &dom);
 	M0_ASSERT(rc == 0);
 	M0_ASSERT(dom != NULL);
 
@@ -250,12 +253,55 @@ static void test_adieu(const char *path)
 	}
 }
 
+/** Checks that all shards of linux stob domain ioq are drained. */
+static void test_ioq_idle(void)
+{
+	struct m0_stob_ioq *ioq = &m0_stob_linux_domain_container(dom)->sld_ioq;
+	int                 i;
+
+	M0_UT_ASSERT(ioq->ioq_shard_nr == m0_localities_nr());
+	for (i = 0; i < ioq->ioq_shard_nr; ++i) {
+		M0_UT_ASSERT(ioq->ioq_shard[i].ios_queued == 0);
+		M0_UT_ASSERT(m0_atomic64_get(&ioq->ioq_shard[i].ios_avail) ==
+			     ioq->ioq_ring_size);
+	}
+}
+
 void m0_stob_ut_adieu_linux(void)
 {
 	int rc;
 
-	rc = test_adieu_init(linux_location, NULL, NULL);
+	rc = test_adieu_init(linux_location, NULL, NULL, NULL);
+	M0_ASSERT(rc == 0);
+	test_adieu(linux_path);
+	test_ioq_idle();
+	test_adieu_fini();
+}
+
+void m0_stob_ut_adieu_linux_uring(void)
+{
+	struct m0_stob_linux_domain *ldom;
+	int                          rc;
+
+	rc = test_adieu_init(linux_location, "ioq=uring", NULL, NULL);
+	M0_ASSERT(rc == 0);
+	ldom = m0_stob_linux_domain_container(dom);
+	/* io_uring may be unavailable, AIO is used then. */
+	M0_UT_ASSERT(M0_IN(ldom->sld_ioq.ioq_engine,
+			   (M0_STOB_IOQ_URING, M0_STOB_IOQ_AIO)));
+	M0_UT_ASSERT(ergo(ldom->sld_ioq.ioq_engine == M0_STOB_IOQ_URING,
+			  m0_stob_linux_container(obj)->sl_fd_idx >= 0));
+	test_adieu(linux_path);
+	test_ioq_idle();
+	test_adieu_fini();
+
+	/* Fall back to AIO. */
+	m0_fi_enable_once("ioq_uring_init", "no_uring");
+	rc = test_adieu_init(linux_location, "ioq=uring", NULL, NULL);
 	M0_ASSERT(rc == 0);
+	ldom = m0_stob_linux_domain_container(dom);
+	M0_UT_ASSERT(ldom->sld_ioq.ioq_engine == M0_STOB_IOQ_AIO);
+	M0_UT_ASSERT(m0_stob_linux_container(obj)->sl_fd_idx == -1);
 	test_adieu(linux_path);
 	test_adieu_fini();
 }
@@ -264,7 +310,7 @@ void m0_stob_ut_adieu_perf(void)
 {
 	int rc;
 
-	rc = test_adieu_init(perf_location, NULL, NULL);
+	rc = test_adieu_init(perf_location, NULL, NULL, NULL);
 	M0_ASSERT(rc == 0);
 	test_adieu(perf_path);
 	test_adieu_fini();
@@ -341,7 +387,7 @@ static void ub_iovec_sort_invert()
 
 static int ub_init(const char *opts M0_UNUSED)
 {
-	return test_adieu_init(linux_location, NULL, NULL);
+	return test_adieu_init(linux_location, NULL, NULL, NULL);
 }
 
 static void ub_fini(void)
@@ -64,7 +64,7 @@ static void stob_ut_cache_thread(struct stob_ut_cache_ctx *ctx)
 		stob = &stob_ut_cache_stobs[j];
 		/* add to cache if it hasn't been added yet */
 		/* delete if it has already been added */
-		m0_stob_cache_lock(cache);
+		m0_stob_cache_lock(cache, m0_stob_fid_get(stob));
 		found = m0_stob_cache_lookup(cache, m0_stob_fid_get(stob));
 		if (found == NULL) {
 			m0_stob_cache_add(cache, stob);
@@ -80,16 +80,18 @@ static void stob_ut_cache_thread(struct stob_ut_cache_ctx *ctx)
 		 */
 		if (found != NULL && found2 != NULL)
 			m0_stob_cache_idle(cache, stob);
-		m0_stob_cache_unlock(cache);
+		m0_stob_cache_unlock(cache, m0_stob_fid_get(stob));
 		M0_UT_ASSERT(ergo(found == NULL, found2 != NULL));
 		M0_UT_ASSERT(M0_IN(stob, (found, found2)));
 	}
 }
 
+static struct m0_stob *stob_ut_cache_evicted;
+
 static void stob_ut_cache_evict_cb(struct m0_stob_cache *cache,
 				   struct m0_stob *stob)
 {
-	/* XXX check that it is called */
+	stob_ut_cache_evicted = stob;
 }
 
 M0_UT_THREADS_DEFINE(stob_cache, stob_ut_cache_thread);
@@ -129,14 +131,14 @@ static void stob_ut_cache_test(size_t thread_nr,
 	M0_UT_THREADS_STOP(stob_cache);
 
 	/* clear stob cache */
-	m0_stob_cache_lock(&stob_ut_cache);
 	for (i = 0; i < ARRAY_SIZE(stob_ut_cache_stobs); ++i) {
 		stob_fid = m0_stob_fid_get(&stob_ut_cache_stobs[i]);
+		m0_stob_cache_lock(&stob_ut_cache, stob_fid);
 		stob = m0_stob_cache_lookup(&stob_ut_cache, stob_fid);
 		if (stob != NULL)
 			m0_stob_cache_idle(&stob_ut_cache, stob);
+		m0_stob_cache_unlock(&stob_ut_cache, stob_fid);
 	}
-	m0_stob_cache_unlock(&stob_ut_cache);
 
 	m0_stob_cache_fini(&stob_ut_cache);
 	m0_free(ctxs);
@@ -153,6 +155,69 @@ void m0_stob_ut_cache_idle_size0(void)
 	stob_ut_cache_test(STOB_UT_CACHE_THREAD_NR, STOB_UT_CACHE_ITER_NR, 0);
 }
 
+static void stob_ut_cache_op(struct m0_stob *stob, bool idle)
+{
+	const struct m0_fid *fid = m0_stob_fid_get(stob);
+	struct m0_stob      *found;
+
+	m0_stob_cache_lock(&stob_ut_cache, fid);
+	found = m0_stob_cache_lookup(&stob_ut_cache, fid);
+	if (found == NULL)
+		m0_stob_cache_add(&stob_ut_cache, stob);
+	else
+		M0_UT_ASSERT(found == stob);
+	if (idle)
+		m0_stob_cache_idle(&stob_ut_cache, stob);
+	m0_stob_cache_unlock(&stob_ut_cache, fid);
+}
+
+/* Checks LRU eviction and statistics of a single shard. */
+void m0_stob_ut_cache_lru(void)
+{
+	struct m0_stob_cache_shard *shard;
+	struct m0_stob             *stobs = stob_ut_cache_stobs;
+	struct m0_fid              *fid;
+	uint64_t                    key;
+	int                         i;
+	int                         rc;
+
+	M0_SET0(&stob_ut_cache);
+	M0_SET_ARR0(stob_ut_cache_stobs);
+	/* Two idle stobs per shard. */
+	rc = m0_stob_cache_init(&stob_ut_cache, 2 * M0_STOB_CACHE_SHARD_NR,
+				&stob_ut_cache_evict_cb);
+	M0_UT_ASSERT(rc == 0);
+	/* Select fids of the first shard. */
+	for (i = 0, key = 0; i < 4; ++i) {
+		fid = &stobs[i].so_id.si_fid;
+		do {
+			*fid = M0_FID_INIT(0, ++key);
+		} while (m0_fid_hash(fid) % M0_STOB_CACHE_SHARD_NR != 0);
+	}
+	shard = &stob_ut_cache.sc_shard[0];
+
+	stob_ut_cache_evicted = NULL;
+	for (i = 0; i < 3; ++i)
+		stob_ut_cache_op(&stobs[i], true);
+	/* stobs[0] is the least recently used one. */
+	M0_UT_ASSERT(stob_ut_cache_evicted == &stobs[0]);
+	M0_UT_ASSERT(shard->scs_misses == 3);
+	M0_UT_ASSERT(shard->scs_evictions == 1);
+
+	/* Use stobs[1], so stobs[2] becomes the oldest one. */
+	stob_ut_cache_op(&stobs[1], true);
+	M0_UT_ASSERT(shard->scs_idle_hits == 1);
+	stob_ut_cache_op(&stobs[3], false);
+	stob_ut_cache_op(&stobs[3], false);
+	M0_UT_ASSERT(shard->scs_busy_hits == 1);
+	stob_ut_cache_op(&stobs[3], true);
+	M0_UT_ASSERT(stob_ut_cache_evicted == &stobs[2]);
+	M0_UT_ASSERT(shard->scs_idle_used == 2);
+
+	m0_stob_cache_fini(&stob_ut_cache);
+	M0_UT_ASSERT(M0_IN(stob_ut_cache_evicted, (&stobs[1], &stobs[3])));
+}
+
 /*
  *  Local variables:
  *  c-indentation-style: "K&R"
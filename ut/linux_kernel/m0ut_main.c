@@ -67,6 +67,7 @@ extern struct m0_ut_suite dtm_transmit_ut;
 extern struct m0_ut_suite failure_domains_tree_ut;
 extern struct m0_ut_suite failure_domains_ut;
 extern struct m0_ut_suite file_io_ut;
+extern struct m0_ut_suite fom_steal_ut;
 extern struct m0_ut_suite fom_timedwait_ut;
 extern struct m0_ut_suite frm_ut;
 extern struct m0_ut_suite ha_ut;
@@ -116,6 +117,7 @@ static void tests_add(struct m0_ut_module *m)
 	m0_ut_add(m, &dtm_dtx_ut, true);
 	m0_ut_add(m, &failure_domains_tree_ut, true);
 	m0_ut_add(m, &failure_domains_ut, true);
+	m0_ut_add(m, &fom_steal_ut, true);
 	m0_ut_add(m, &fom_timedwait_ut, true);
 	m0_ut_add(m, &frm_ut, true);
 	m0_ut_add(m, &ha_ut, true);
@@ -33,11 +33,13 @@ extern struct m0_ub_set m0_ad_ub;
 extern struct m0_ub_set m0_adieu_ub;
 extern struct m0_ub_set m0_atomic_ub;
 extern struct m0_ub_set m0_bitmap_ub;
+extern struct m0_ub_set m0_conf_ub;
 extern struct m0_ub_set m0_fol_ub;
 extern struct m0_ub_set m0_fom_ub;
 extern struct m0_ub_set m0_list_ub;
 extern struct m0_ub_set m0_memory_ub;
 extern struct m0_ub_set m0_parity_math_ub;
+extern struct m0_ub_set m0_rm_ub;
 //extern struct m0_ub_set m0_rpc_ub;
 extern struct m0_ub_set m0_thread_ub;
 extern struct m0_ub_set m0_time_ub;
@@ -105,11 +107,13 @@ static void ub_add(const struct ub_args *args)
 	m0_ub_set_add(&m0_time_ub);
 	m0_ub_set_add(&m0_thread_ub);
 //	m0_ub_set_add(&m0_rpc_ub);
+	m0_ub_set_add(&m0_rm_ub);
 	m0_ub_set_add(&m0_parity_math_ub);
 	m0_ub_set_add(&m0_memory_ub);
 	m0_ub_set_add(&m0_list_ub);
 	m0_ub_set_add(&m0_fom_ub);
 	m0_ub_set_add(&m0_fol_ub);
+	m0_ub_set_add(&m0_conf_ub);
 //XXX_BE_DB 	m0_ub_set_add(&m0_bitmap_ub);
 //XXX_BE_DB 	m0_ub_set_add(&m0_atomic_ub);
 	m0_ub_set_add(&m0_adieu_ub);